@@ -0,0 +1,345 @@
+/*
+** jl_account.c - accounting of the memory the game allocates
+**
+** (c)1993 Paul Grebenc
+**
+** The images, GELS, keyboard, audio, GameInfo and asset pack are allocated through
+** alloc_mem() and freed through free_mem() instead of AllocMem() and
+** FreeMem(), each tagged with who it is for (ACCOUNT_IMAGES and so on).
+** Once start_accounting() has been called every block is kept track of:
+** the bytes each owner has allocated now and at most, CHIP and other
+** memory apart, the most that was allocated at once, and how many blocks
+** were allocated in each frame (see account_frame()).  A block freed at a
+** different size from the one it was allocated at, or that was never
+** allocated, is reported at once.  end_accounting() reports the blocks
+** never freed.
+**
+** With the guard on (start_guard()), an allocation made while the game
+** has it armed (see start_game() in jupitergame.c, which reserves every
+** Bob a game needs before arming it) is a bug: it is reported, with a
+** backtrace on the Linux host, and the program aborts.
+**
+** The accounting is for one game at a time and is not locked, so the
+** tools that play games on many threads leave it off, and then the calls
+** are plain AllocMem() and FreeMem().
+*/
+
+
+/** INCLUDES & DEFINES **/
+
+#include "jupiterdefs.h"
+
+#define BLOCKS          (256)    /* most blocks kept track of at once */
+
+#define CHIP            (0)
+#define OTHER           (1)
+
+struct Block {
+   APTR memory;         /* NULL if the slot is free */
+   ULONG size;
+   int owner;
+   int type;            /* CHIP or OTHER */
+};
+
+
+/** PROTOTYPES **/
+
+void start_accounting(void);
+void end_accounting(BOOL report);
+void account_frame(void);
+void start_guard(void);
+BOOL arm_guard(BOOL arm);
+APTR alloc_mem(int owner, ULONG size, ULONG flags);
+void free_mem(int owner, APTR memory, ULONG size);
+
+static struct Block *find_block(APTR memory);
+
+
+/** GLOBAL VARIABLES **/
+
+static char *owner_names[ACCOUNT_OWNERS] = {
+   "images", "gels", "keyboard", "audio", "game", "pack"
+};
+
+static char *type_names[2] = { "CHIP", "other" };
+
+static BOOL accounting = FALSE;
+static BOOL guarding = FALSE;
+static BOOL armed = FALSE;
+
+static struct Block blocks[BLOCKS];
+static LONG untracked;        /* blocks there was no room for */
+
+/* bytes of each owner and type, now and at most, and of all owners */
+static ULONG live[ACCOUNT_OWNERS][2];
+static ULONG peak[ACCOUNT_OWNERS][2];
+static ULONG all_live[2];
+static ULONG all_peak[2];
+static ULONG allocs[ACCOUNT_OWNERS];
+
+/* blocks allocated in the frame under way, and at most in one frame */
+static ULONG frame_allocs;
+static ULONG most_allocs;
+static ULONG frames, busy_frames;
+
+
+/*-----------------------------------------------------------------------*/
+
+
+/*
+** start_accounting()
+**
+** Start keeping track of what is allocated through alloc_mem().  Blocks
+** allocated before are freed without being checked.
+*/
+void start_accounting()
+{
+   memset(blocks, 0, sizeof(blocks));
+   memset(live, 0, sizeof(live));
+   memset(peak, 0, sizeof(peak));
+   memset(all_live, 0, sizeof(all_live));
+   memset(all_peak, 0, sizeof(all_peak));
+   memset(allocs, 0, sizeof(allocs));
+   untracked = 0;
+   frame_allocs = most_allocs = frames = busy_frames = 0;
+
+   accounting = TRUE;
+}
+
+
+/*
+** end_accounting()
+**
+** Stop keeping track, print every block that was never freed and, if
+** report is TRUE, what each owner allocated.
+*/
+void end_accounting(BOOL report)
+{
+   int n, owner;
+
+   if (!accounting)
+   {
+      return;
+   }
+   accounting = FALSE;
+
+   for (n=0; n < BLOCKS; n++)
+   {
+      if (blocks[n].memory != NULL)
+      {
+         printf("Leak: %lu bytes of %s memory for %s at $%lx\n",
+            (unsigned long)blocks[n].size, type_names[blocks[n].type],
+            owner_names[blocks[n].owner], (unsigned long)blocks[n].memory);
+      }
+   }
+
+   if (!report)
+   {
+      return;
+   }
+
+   printf("memory for  blocks  CHIP now  CHIP peak  other now  other peak\n");
+   for (owner=0; owner < ACCOUNT_OWNERS; owner++)
+   {
+      printf("%-10s %7lu %9lu %10lu %10lu %11lu\n", owner_names[owner],
+         (unsigned long)allocs[owner],
+         (unsigned long)live[owner][CHIP], (unsigned long)peak[owner][CHIP],
+         (unsigned long)live[owner][OTHER], (unsigned long)peak[owner][OTHER]);
+   }
+   printf("%-10s %7s %9lu %10lu %10lu %11lu\n", "all", "",
+      (unsigned long)all_live[CHIP], (unsigned long)all_peak[CHIP],
+      (unsigned long)all_live[OTHER], (unsigned long)all_peak[OTHER]);
+   printf("%lu of %lu frames allocated, at most %lu blocks in a frame\n",
+      (unsigned long)busy_frames, (unsigned long)frames,
+      (unsigned long)most_allocs);
+   if (untracked > 0)
+   {
+      printf("%ld blocks were not kept track of\n", (long)untracked);
+   }
+}
+
+
+/*
+** account_frame()
+**
+** Mark the end of a frame, for the count of blocks allocated in each.
+*/
+void account_frame()
+{
+   if (!accounting)
+   {
+      return;
+   }
+
+   frames++;
+   if (frame_allocs > 0)
+   {
+      busy_frames++;
+      if (frame_allocs > most_allocs)
+      {
+         most_allocs = frame_allocs;
+      }
+   }
+   frame_allocs = 0;
+}
+
+
+/*
+** start_guard()
+**
+** Turn the guard on, so that alloc_mem() aborts while it is armed.
+*/
+void start_guard()
+{
+   guarding = TRUE;
+}
+
+
+/*
+** arm_guard()
+**
+** Arm the guard (if it is on) once nothing more should be allocated, or
+** disarm it again.  The guard is for a game played on its own: when it
+** is off, as it is for the tools that play games on several threads,
+** nothing is written.
+**
+** RETURNS:  TRUE if it was armed, to put it back as it was with.
+*/
+BOOL arm_guard(BOOL arm)
+{
+   BOOL was;
+   
+   if (!guarding)
+   {
+      return FALSE;
+   }
+   
+   was = armed;
+   armed = arm;
+   
+   return was;
+}
+
+
+/*
+** alloc_mem()
+**
+** AllocMem() size bytes of memory of flags (MEMF_CHIP and so on) for
+** owner (ACCOUNT_IMAGES and so on).  Free it with free_mem().
+**
+** RETURNS:  Address of the memory, NULL if it could not be allocated.
+*/
+APTR alloc_mem(int owner, ULONG size, ULONG flags)
+{
+   APTR memory;
+   struct Block *block;
+   int type;
+
+   if (armed)
+   {
+      printf("%s allocated %lu bytes during play\n", owner_names[owner],
+         (unsigned long)size);
+      fflush(stdout);
+#ifdef __linux__
+      host_backtrace();
+#endif
+      abort();
+   }
+
+   memory = AllocMem(size, flags);
+   if ((memory == NULL) || !accounting)
+   {
+      return memory;
+   }
+
+   if (NULL == (block = find_block(NULL)))
+   {
+      untracked++;
+      return memory;
+   }
+
+   type = (flags & MEMF_CHIP) ? CHIP : OTHER;
+   block->memory = memory;
+   block->size = size;
+   block->owner = owner;
+   block->type = type;
+
+   allocs[owner]++;
+   frame_allocs++;
+
+   live[owner][type] += size;
+   if (live[owner][type] > peak[owner][type])
+   {
+      peak[owner][type] = live[owner][type];
+   }
+   all_live[type] += size;
+   if (all_live[type] > all_peak[type])
+   {
+      all_peak[type] = all_live[type];
+   }
+
+   return memory;
+}
+
+
+/*
+** free_mem()
+**
+** FreeMem() size bytes at memory, allocated by alloc_mem() for owner.
+** A size or owner other than it was allocated with is reported.
+*/
+void free_mem(int owner, APTR memory, ULONG size)
+{
+   struct Block *block;
+
+   if (accounting && (memory != NULL))
+   {
+      if (NULL == (block = find_block(memory)))
+      {
+         if (untracked == 0)
+         {
+            printf("%s freed %lu bytes at $%lx that were not allocated\n",
+               owner_names[owner], (unsigned long)size,
+               (unsigned long)memory);
+         }
+      }
+      else
+      {
+         if ((block->size != size) || (block->owner != owner))
+         {
+            printf("%s freed %lu bytes at $%lx that %s allocated as %lu\n",
+               owner_names[owner], (unsigned long)size,
+               (unsigned long)memory, owner_names[block->owner],
+               (unsigned long)block->size);
+         }
+
+         live[block->owner][block->type] -= block->size;
+         all_live[block->type] -= block->size;
+         block->memory = NULL;
+      }
+   }
+
+   FreeMem(memory, size);
+}
+
+
+/*
+** find_block()
+**
+** RETURNS:  The slot of the block at memory (or a free slot, if memory
+**           is NULL), NULL if there is none.
+*/
+static struct Block *find_block(APTR memory)
+{
+   int n;
+
+   for (n=0; n < BLOCKS; n++)
+   {
+      if (blocks[n].memory == memory)
+      {
+         return &blocks[n];
+      }
+   }
+
+   return NULL;
+}
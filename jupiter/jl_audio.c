@@ -17,51 +17,44 @@
 
 /** PROTOTYPES **/
 
-int setup_audio(void);
-void cleanup_audio(void);
+int setup_audio(struct GameInfo *gameinfo);
+void cleanup_audio(struct GameInfo *gameinfo);
 
-void play_start_music(void);
+int play_start_music(struct GameInfo *gameinfo);
 
-void play_crash_sound(void);
-void end_crash_sound(void);
+void play_crash_sound(struct GameInfo *gameinfo);
+int end_crash_sound(struct GameInfo *gameinfo);
 
-void play_pop_sound(void);
-void end_pop_sound(void);
+void play_pop_sound(struct GameInfo *gameinfo);
+void end_pop_sound(struct GameInfo *gameinfo);
 
-void begin_main_thruster_sound(void);
-void end_main_thruster_sound(void);
+void begin_main_thruster_sound(struct GameInfo *gameinfo);
+void end_main_thruster_sound(struct GameInfo *gameinfo);
 
-void begin_left_thruster_sound(void);
-void end_left_thruster_sound(void);
+void begin_left_thruster_sound(struct GameInfo *gameinfo);
+void end_left_thruster_sound(struct GameInfo *gameinfo);
 
-void begin_right_thruster_sound(void);
-void end_right_thruster_sound(void);
+void begin_right_thruster_sound(struct GameInfo *gameinfo);
+void end_right_thruster_sound(struct GameInfo *gameinfo);
 
+int wait_sound(struct GameInfo *gameinfo);
 
-/** GLOBAL VARIABLES **/
+/* jl_account.c */
+extern APTR alloc_mem(int owner, ULONG size, ULONG flags);
+extern void free_mem(int owner, APTR memory, ULONG size);
 
-extern struct Library *DOSBase;
+/* jl_trace.c */
+extern void trace_begin(struct GameInfo *gameinfo, char *name);
+extern void trace_end(struct GameInfo *gameinfo, char *name);
+extern void trace_mark(struct GameInfo *gameinfo, char *name);
 
-struct IOAudio *AudioIO1;  /* left */
-struct IOAudio *AudioIO2;  /* right */
-struct IOAudio *AudioIO3;  /* start/stop */
-struct IOAudio *AudioIO4;  /* left */
-struct IOAudio *AudioIO5;  /* right */
 
-struct MsgPort *AudioMP1;
-struct MsgPort *AudioMP2;
-struct MsgPort *AudioMP3;
-struct MsgPort *AudioMP4;
-struct MsgPort *AudioMP5;
+/** GLOBAL VARIABLES **/
 
-int audio_flag = FALSE;
+extern struct Library *DOSBase;
 
-extern UWORD chip start_tune_a[11919];
-extern UWORD chip start_tune_b[344];
-extern UBYTE chip crash_sound[9716];
-extern UBYTE chip tick_sound[760];
-extern UBYTE chip main_thruster_sound[3028];
-extern UBYTE chip side_thruster_sound[2958];
+/* the samples, built in or from the asset pack */
+extern struct Asset assets[ASSETS];
 
 
 
@@ -73,95 +66,101 @@ extern UBYTE chip side_thruster_sound[2958];
 ** RETURNS:  TRUE if successful (and sets audio_flag TRUE),
 **           FALSE if unsuccessful (and sets audio_flag FALSE).
 */
-int setup_audio()
+int setup_audio(struct GameInfo *gameinfo)
 {
    ULONG device;
    UBYTE channels[] = { 15, 14, 13 };
    
    
-   AudioIO1 = (struct IOAudio *)AllocMem(sizeof(struct IOAudio),
+   gameinfo->AudioIO1 = (struct IOAudio *)alloc_mem(ACCOUNT_AUDIO, sizeof(struct IOAudio),
                MEMF_PUBLIC | MEMF_CLEAR);
-   if (AudioIO1 != NULL)
+   if (gameinfo->AudioIO1 != NULL)
    {
-      AudioIO2 = (struct IOAudio *)AllocMem(sizeof(struct IOAudio),
+      gameinfo->AudioIO2 = (struct IOAudio *)alloc_mem(ACCOUNT_AUDIO, sizeof(struct IOAudio),
                   MEMF_PUBLIC | MEMF_CLEAR);
-      if (AudioIO2 != NULL)
+      if (gameinfo->AudioIO2 != NULL)
       {
-         AudioIO3 = (struct IOAudio *)AllocMem(sizeof(struct IOAudio),
+         gameinfo->AudioIO3 = (struct IOAudio *)alloc_mem(ACCOUNT_AUDIO, sizeof(struct IOAudio),
                      MEMF_PUBLIC | MEMF_CLEAR);
-         if (AudioIO3 != NULL)
+         if (gameinfo->AudioIO3 != NULL)
          {
-            AudioIO4 = (struct IOAudio *)AllocMem(sizeof(struct IOAudio),
+            gameinfo->AudioIO4 = (struct IOAudio *)alloc_mem(ACCOUNT_AUDIO, sizeof(struct IOAudio),
                         MEMF_PUBLIC | MEMF_CLEAR);
-            if (AudioIO4 != NULL)
+            if (gameinfo->AudioIO4 != NULL)
             {
-               AudioIO5 = (struct IOAudio *)AllocMem(sizeof(struct IOAudio),
+               gameinfo->AudioIO5 = (struct IOAudio *)alloc_mem(ACCOUNT_AUDIO, sizeof(struct IOAudio),
                            MEMF_PUBLIC | MEMF_CLEAR);
-               if (AudioIO5 != NULL)
+               if (gameinfo->AudioIO5 != NULL)
                {
-                  AudioMP1 = CreatePort(0,0);
-                  if (AudioMP1 != NULL)
+                  gameinfo->AudioMP1 = CreatePort(0,0);
+                  if (gameinfo->AudioMP1 != NULL)
                   {
-                     AudioMP2 = CreatePort(0,0);
-                     if (AudioMP2 != NULL)
+                     gameinfo->AudioMP2 = CreatePort(0,0);
+                     if (gameinfo->AudioMP2 != NULL)
                      {
-                        AudioMP3 = CreatePort(0,0);
-                        if (AudioMP3 != NULL)
+                        gameinfo->AudioMP3 = CreatePort(0,0);
+                        if (gameinfo->AudioMP3 != NULL)
                         {
-                           AudioMP4 = CreatePort(0,0);
-                           if (AudioMP4 != NULL)
+                           gameinfo->AudioMP4 = CreatePort(0,0);
+                           if (gameinfo->AudioMP4 != NULL)
                            {
-                              AudioMP5 = CreatePort(0,0);
-                              if (AudioMP5 != NULL)
+                              gameinfo->AudioMP5 = CreatePort(0,0);
+                              if (gameinfo->AudioMP5 != NULL)
                               {
-                                 AudioIO1->ioa_Request.io_Message.mn_ReplyPort = AudioMP1;
-                                 AudioIO1->ioa_Request.io_Message.mn_Node.ln_Pri = 100;
-                                 AudioIO1->ioa_Request.io_Command = ADCMD_ALLOCATE;
-                                 AudioIO1->ioa_Request.io_Flags = ADIOF_NOWAIT;
-                                 AudioIO1->ioa_AllocKey = 0;
-                                 AudioIO1->ioa_Data = channels;
-                                 AudioIO1->ioa_Length = sizeof(channels);
+                                 gameinfo->AudioIO1->ioa_Request.io_Message.mn_ReplyPort =
+                                    gameinfo->AudioMP1;
+                                 gameinfo->AudioIO1->ioa_Request.io_Message.mn_Node.ln_Pri = 100;
+                                 gameinfo->AudioIO1->ioa_Request.io_Command = ADCMD_ALLOCATE;
+                                 gameinfo->AudioIO1->ioa_Request.io_Flags = ADIOF_NOWAIT;
+                                 gameinfo->AudioIO1->ioa_AllocKey = 0;
+                                 gameinfo->AudioIO1->ioa_Data = channels;
+                                 gameinfo->AudioIO1->ioa_Length = sizeof(channels);
                                  
-                                 device = OpenDevice(AUDIONAME, 0L, (struct IORequest *)AudioIO1, 0L);
+                                 device = OpenDevice(AUDIONAME, 0L,
+                                    (struct IORequest *)gameinfo->AudioIO1, 0L);
                                  
                                  if (device == NULL)
                                  {
-                                    audio_flag = TRUE;   /* audio.device opened */
+                                    gameinfo->audio_flag = TRUE;   /* audio.device opened */
                                     
                                     /* create a 2nd - 5th IOAudio structure w/diff ports */
-                                    *AudioIO2 = *AudioIO1;
-                                    *AudioIO3 = *AudioIO1;
-                                    *AudioIO4 = *AudioIO1;
-                                    *AudioIO5 = *AudioIO1;
-                                    AudioIO2->ioa_Request.io_Message.mn_ReplyPort = AudioMP2;
-                                    AudioIO3->ioa_Request.io_Message.mn_ReplyPort = AudioMP3;
-                                    AudioIO4->ioa_Request.io_Message.mn_ReplyPort = AudioMP4;
-                                    AudioIO5->ioa_Request.io_Message.mn_ReplyPort = AudioMP5;
+                                    *gameinfo->AudioIO2 = *gameinfo->AudioIO1;
+                                    *gameinfo->AudioIO3 = *gameinfo->AudioIO1;
+                                    *gameinfo->AudioIO4 = *gameinfo->AudioIO1;
+                                    *gameinfo->AudioIO5 = *gameinfo->AudioIO1;
+                                    gameinfo->AudioIO2->ioa_Request.io_Message.mn_ReplyPort =
+                                       gameinfo->AudioMP2;
+                                    gameinfo->AudioIO3->ioa_Request.io_Message.mn_ReplyPort =
+                                       gameinfo->AudioMP3;
+                                    gameinfo->AudioIO4->ioa_Request.io_Message.mn_ReplyPort =
+                                       gameinfo->AudioMP4;
+                                    gameinfo->AudioIO5->ioa_Request.io_Message.mn_ReplyPort =
+                                       gameinfo->AudioMP5;
                                     /* */
                                     
                                     return TRUE;
                                  }
-                                 DeletePort(AudioMP5);
+                                 DeletePort(gameinfo->AudioMP5);
                               }
-                              DeletePort(AudioMP4);
+                              DeletePort(gameinfo->AudioMP4);
                            }
-                           DeletePort(AudioMP3);
+                           DeletePort(gameinfo->AudioMP3);
                         }
-                        DeletePort(AudioMP2);
+                        DeletePort(gameinfo->AudioMP2);
                      }
-                     DeletePort(AudioMP1);
+                     DeletePort(gameinfo->AudioMP1);
                   }
-                  FreeMem(AudioIO5, sizeof(struct IOAudio));
+                  free_mem(ACCOUNT_AUDIO, gameinfo->AudioIO5, sizeof(struct IOAudio));
                }
-               FreeMem(AudioIO4, sizeof(struct IOAudio));
+               free_mem(ACCOUNT_AUDIO, gameinfo->AudioIO4, sizeof(struct IOAudio));
             }
-            FreeMem(AudioIO3, sizeof(struct IOAudio));
+            free_mem(ACCOUNT_AUDIO, gameinfo->AudioIO3, sizeof(struct IOAudio));
          }
-         FreeMem(AudioIO2, sizeof(struct IOAudio));
+         free_mem(ACCOUNT_AUDIO, gameinfo->AudioIO2, sizeof(struct IOAudio));
       }
-      FreeMem(AudioIO1, sizeof(struct IOAudio));
+      free_mem(ACCOUNT_AUDIO, gameinfo->AudioIO1, sizeof(struct IOAudio));
    }
-   audio_flag = FALSE;
+   gameinfo->audio_flag = FALSE;
    return FALSE;
 }
 
@@ -172,23 +171,23 @@ int setup_audio()
 ** Free everything allocated by setup_audio & close audio.device if
 ** audio_flag = TRUE (if audio.device was opened).
 */
-void cleanup_audio()
+void cleanup_audio(struct GameInfo *gameinfo)
 {
    
-   if (audio_flag == TRUE)
+   if (gameinfo->audio_flag == TRUE)
    {
       /* free everything */
-      CloseDevice((struct IORequest *)AudioIO1);
-      DeletePort(AudioMP1);
-      DeletePort(AudioMP2);
-      DeletePort(AudioMP3);
-      DeletePort(AudioMP4);
-      DeletePort(AudioMP5);
-      FreeMem(AudioIO1, sizeof(struct IOAudio));
-      FreeMem(AudioIO2, sizeof(struct IOAudio));
-      FreeMem(AudioIO3, sizeof(struct IOAudio));
-      FreeMem(AudioIO4, sizeof(struct IOAudio));
-      FreeMem(AudioIO5, sizeof(struct IOAudio));
+      CloseDevice((struct IORequest *)gameinfo->AudioIO1);
+      DeletePort(gameinfo->AudioMP1);
+      DeletePort(gameinfo->AudioMP2);
+      DeletePort(gameinfo->AudioMP3);
+      DeletePort(gameinfo->AudioMP4);
+      DeletePort(gameinfo->AudioMP5);
+      free_mem(ACCOUNT_AUDIO, gameinfo->AudioIO1, sizeof(struct IOAudio));
+      free_mem(ACCOUNT_AUDIO, gameinfo->AudioIO2, sizeof(struct IOAudio));
+      free_mem(ACCOUNT_AUDIO, gameinfo->AudioIO3, sizeof(struct IOAudio));
+      free_mem(ACCOUNT_AUDIO, gameinfo->AudioIO4, sizeof(struct IOAudio));
+      free_mem(ACCOUNT_AUDIO, gameinfo->AudioIO5, sizeof(struct IOAudio));
       /* */
    }
 }
@@ -198,131 +197,128 @@ void cleanup_audio()
 ** play_start_music()
 **
 ** If audio_flag = TRUE, play the tune for the beginning of each game,
-** else delay for 3 seconds and return.
+** else delay for 3 seconds.  Called with note and note_step cleared,
+** then again after each wait until it returns WAIT_NONE.
+**
+** RETURNS:  WAIT_DELAY (for gameinfo->delay ticks) or WAIT_PORT (for
+**           gameinfo->port) while playing, WAIT_NONE when finished.
 */
-void play_start_music()
+int play_start_music(struct GameInfo *gameinfo)
 {
-   struct Message *AudioMSG;
+   UBYTE *data;
+   ULONG length;
+   UWORD cycles;
+   int wait;
    
-   int x, pause[12] = { 7, 22, 18, 14, 11, 7, 3, 3, 3, 3, 3, 3 };
+   int pause[12] = { 7, 22, 18, 14, 11, 7, 3, 3, 3, 3, 3, 3 };
    
    
-   if (audio_flag == TRUE)
+   if ((gameinfo->note == 0) && (gameinfo->note_step == 0))
    {
-      /* play the first part of the starting tune */
-      
-      /* stop all sound so we can set up for tune */
-      AudioIO3->ioa_Request.io_Command = CMD_STOP;
-      AudioIO3->ioa_Request.io_Unit = (struct Unit *)0x03;
-      AudioIO3->ioa_Request.io_Flags = IOF_QUICK;
-      
-      BeginIO((struct IORequest *)AudioIO3);
-      /* */
-      
-      /* set up to play first part of tune (left channel) */
-      AudioIO1->ioa_Request.io_Command = CMD_WRITE;
-      AudioIO1->ioa_Request.io_Flags = ADIOF_PERVOL;
-      AudioIO1->ioa_Request.io_Unit = (struct Unit *)0x01;
-      AudioIO1->ioa_Data = (UBYTE *)&start_tune_a;
-      AudioIO1->ioa_Length = sizeof(start_tune_a);
-      AudioIO1->ioa_Period = CLOCK/8000;
-      AudioIO1->ioa_Volume = 64;
-      AudioIO1->ioa_Cycles = 2;
-      
-      BeginIO((struct IORequest *)AudioIO1);
-      /* */
-      
-      /* set up to play first part of tune (right channel) */
-      AudioIO2->ioa_Request.io_Command = CMD_WRITE;
-      AudioIO2->ioa_Request.io_Flags = ADIOF_PERVOL;
-      AudioIO2->ioa_Request.io_Unit = (struct Unit *)0x02;
-      AudioIO2->ioa_Data = (UBYTE *)&start_tune_a;
-      AudioIO2->ioa_Length = sizeof(start_tune_a);
-      AudioIO2->ioa_Period = CLOCK/8000;
-      AudioIO2->ioa_Volume = 64;
-      AudioIO2->ioa_Cycles = 2;
-      
-      BeginIO((struct IORequest *)AudioIO2);
-      /* */
-      
-      /* start sound again so we can hear this */
-      AudioIO3->ioa_Request.io_Command = CMD_START;
-      AudioIO3->ioa_Request.io_Unit = (struct Unit *)0x03;
-      AudioIO3->ioa_Request.io_Flags = IOF_QUICK;
-      
-      BeginIO((struct IORequest *)AudioIO3);
-      /* */
-      
-      /* wait for first part of tune to finish */
-      WaitPort(AudioMP1);
-      AudioMSG = GetMsg(AudioMP1);
-      WaitPort(AudioMP2);
-      AudioMSG = GetMsg(AudioMP2);
-      /* */
-      
-      /* */
-      
-      /* play the end part of the tune */
-      for (x=0; x<12; x++)
+      trace_begin(gameinfo, "start music");
+   }
+   
+   if (gameinfo->audio_flag != TRUE)
+   {
+      if (gameinfo->note++ == 0)
       {
-         /* put delay in between each beep */
-         Delay(pause[x]);
-         
-         /* stop all sound so we can set up for tune */
-         AudioIO3->ioa_Request.io_Command = CMD_STOP;
-         AudioIO3->ioa_Request.io_Unit = (struct Unit *)0x03;
-         AudioIO3->ioa_Request.io_Flags = IOF_QUICK;
-         
-         BeginIO((struct IORequest *)AudioIO3);
-         /* */
-         
-         /* set up to play first part of tune (left channel) */
-         AudioIO1->ioa_Request.io_Command = CMD_WRITE;
-         AudioIO1->ioa_Request.io_Flags = ADIOF_PERVOL;
-         AudioIO1->ioa_Request.io_Unit = (struct Unit *)0x01;
-         AudioIO1->ioa_Data = (UBYTE *)&start_tune_b;
-         AudioIO1->ioa_Length = sizeof(start_tune_b);
-         AudioIO1->ioa_Period = CLOCK/8000;
-         AudioIO1->ioa_Volume = 64;
-         AudioIO1->ioa_Cycles = 1;
-         
-         BeginIO((struct IORequest *)AudioIO1);
-         /* */
-         
-         /* set up to play first part of tune (right channel) */
-         AudioIO2->ioa_Request.io_Command = CMD_WRITE;
-         AudioIO2->ioa_Request.io_Flags = ADIOF_PERVOL;
-         AudioIO2->ioa_Request.io_Unit = (struct Unit *)0x02;
-         AudioIO2->ioa_Data = (UBYTE *)&start_tune_b;
-         AudioIO2->ioa_Length = sizeof(start_tune_b);
-         AudioIO2->ioa_Period = CLOCK/8000;
-         AudioIO2->ioa_Volume = 64;
-         AudioIO2->ioa_Cycles = 1;
-         
-         BeginIO((struct IORequest *)AudioIO2);
-         /* */
-         
-         /* start sound again so we can hear this */
-         AudioIO3->ioa_Request.io_Command = CMD_START;
-         AudioIO3->ioa_Request.io_Unit = (struct Unit *)0x03;
-         AudioIO3->ioa_Request.io_Flags = IOF_QUICK;
-         
-         BeginIO((struct IORequest *)AudioIO3);
-         /* */
-         
-         /* wait for first part of tune to finish */
-         WaitPort(AudioMP1);
-         AudioMSG = GetMsg(AudioMP1);
-         WaitPort(AudioMP2);
-         AudioMSG = GetMsg(AudioMP2);
-         /* */
+         gameinfo->delay = 150;
+         return WAIT_DELAY;
       }
-      /* */
+      trace_end(gameinfo, "start music");
+      return WAIT_NONE;
    }
-   else
+   
+   /* note 0 is the first part of the tune, notes 1 to 12 the end part */
+   while (gameinfo->note <= 12)
    {
-      Delay(150);
+      switch (gameinfo->note_step)
+      {
+         case 0:
+            gameinfo->note_step = 1;
+            
+            /* put delay in between each beep */
+            if (gameinfo->note > 0)
+            {
+               gameinfo->delay = pause[gameinfo->note-1];
+               return WAIT_DELAY;
+            }
+            break;
+         case 1:
+            if (gameinfo->note == 0)
+            {
+               data = assets[ASSET_START_TUNE_A].data;
+               length = assets[ASSET_START_TUNE_A].size;
+               cycles = 2;
+            }
+            else
+            {
+               data = assets[ASSET_START_TUNE_B].data;
+               length = assets[ASSET_START_TUNE_B].size;
+               cycles = 1;
+            }
+            
+            /* stop all sound so we can set up for tune */
+            gameinfo->AudioIO3->ioa_Request.io_Command = CMD_STOP;
+            gameinfo->AudioIO3->ioa_Request.io_Unit = (struct Unit *)0x03;
+            gameinfo->AudioIO3->ioa_Request.io_Flags = IOF_QUICK;
+            
+            BeginIO((struct IORequest *)gameinfo->AudioIO3);
+            /* */
+            
+            /* set up to play this part of tune (left channel) */
+            gameinfo->AudioIO1->ioa_Request.io_Command = CMD_WRITE;
+            gameinfo->AudioIO1->ioa_Request.io_Flags = ADIOF_PERVOL;
+            gameinfo->AudioIO1->ioa_Request.io_Unit = (struct Unit *)0x01;
+            gameinfo->AudioIO1->ioa_Data = data;
+            gameinfo->AudioIO1->ioa_Length = length;
+            gameinfo->AudioIO1->ioa_Period = CLOCK/8000;
+            gameinfo->AudioIO1->ioa_Volume = 64;
+            gameinfo->AudioIO1->ioa_Cycles = cycles;
+            
+            BeginIO((struct IORequest *)gameinfo->AudioIO1);
+            /* */
+            
+            /* set up to play this part of tune (right channel) */
+            gameinfo->AudioIO2->ioa_Request.io_Command = CMD_WRITE;
+            gameinfo->AudioIO2->ioa_Request.io_Flags = ADIOF_PERVOL;
+            gameinfo->AudioIO2->ioa_Request.io_Unit = (struct Unit *)0x02;
+            gameinfo->AudioIO2->ioa_Data = data;
+            gameinfo->AudioIO2->ioa_Length = length;
+            gameinfo->AudioIO2->ioa_Period = CLOCK/8000;
+            gameinfo->AudioIO2->ioa_Volume = 64;
+            gameinfo->AudioIO2->ioa_Cycles = cycles;
+            
+            BeginIO((struct IORequest *)gameinfo->AudioIO2);
+            /* */
+            
+            /* start sound again so we can hear this */
+            gameinfo->AudioIO3->ioa_Request.io_Command = CMD_START;
+            gameinfo->AudioIO3->ioa_Request.io_Unit = (struct Unit *)0x03;
+            gameinfo->AudioIO3->ioa_Request.io_Flags = IOF_QUICK;
+            
+            BeginIO((struct IORequest *)gameinfo->AudioIO3);
+            /* */
+            
+            gameinfo->note_step = 2;
+            break;
+         case 2:
+            /* wait for this part of tune to finish */
+            wait = wait_sound(gameinfo);
+            if (wait != WAIT_NONE)
+            {
+               return wait;
+            }
+            /* */
+            
+            gameinfo->note++;
+            gameinfo->note_step = 0;
+            break;
+      }
    }
+   
+   trace_end(gameinfo, "start music");
+   return WAIT_NONE;
 }
 
 
@@ -331,50 +327,52 @@ void play_start_music()
 **
 ** If audio_flag = TRUE, play the probe crash sound, else return.
 */
-void play_crash_sound()
+void play_crash_sound(struct GameInfo *gameinfo)
 {
-   if (audio_flag == TRUE)
+   trace_mark(gameinfo, "play crash sound");
+   
+   if (gameinfo->audio_flag == TRUE)
    {
       /* stop all sound so we can set up for crash sound */
-      AudioIO3->ioa_Request.io_Command = CMD_STOP;
-      AudioIO3->ioa_Request.io_Unit = (struct Unit *)0x03;
-      AudioIO3->ioa_Request.io_Flags = IOF_QUICK;
+      gameinfo->AudioIO3->ioa_Request.io_Command = CMD_STOP;
+      gameinfo->AudioIO3->ioa_Request.io_Unit = (struct Unit *)0x03;
+      gameinfo->AudioIO3->ioa_Request.io_Flags = IOF_QUICK;
       
-      BeginIO((struct IORequest *)AudioIO3);
+      BeginIO((struct IORequest *)gameinfo->AudioIO3);
       /* */
       
       /* set up to play crash on left channel */
-      AudioIO1->ioa_Request.io_Command = CMD_WRITE;
-      AudioIO1->ioa_Request.io_Flags = ADIOF_PERVOL;
-      AudioIO1->ioa_Request.io_Unit = (struct Unit *)0x01;
-      AudioIO1->ioa_Data = (UBYTE *)&crash_sound;
-      AudioIO1->ioa_Length = sizeof(crash_sound);
-      AudioIO1->ioa_Period = CLOCK/7000;
-      AudioIO1->ioa_Volume = 64;
-      AudioIO1->ioa_Cycles = 1;
-      
-      BeginIO((struct IORequest *)AudioIO1);
+      gameinfo->AudioIO1->ioa_Request.io_Command = CMD_WRITE;
+      gameinfo->AudioIO1->ioa_Request.io_Flags = ADIOF_PERVOL;
+      gameinfo->AudioIO1->ioa_Request.io_Unit = (struct Unit *)0x01;
+      gameinfo->AudioIO1->ioa_Data = assets[ASSET_CRASH].data;
+      gameinfo->AudioIO1->ioa_Length = assets[ASSET_CRASH].size;
+      gameinfo->AudioIO1->ioa_Period = CLOCK/7000;
+      gameinfo->AudioIO1->ioa_Volume = 64;
+      gameinfo->AudioIO1->ioa_Cycles = 1;
+      
+      BeginIO((struct IORequest *)gameinfo->AudioIO1);
       /* */
       
       /* set up to play crash on right channel */
-      AudioIO2->ioa_Request.io_Command = CMD_WRITE;
-      AudioIO2->ioa_Request.io_Flags = ADIOF_PERVOL;
-      AudioIO2->ioa_Request.io_Unit = (struct Unit *)0x02;
-      AudioIO2->ioa_Data = (UBYTE *)&crash_sound;
-      AudioIO2->ioa_Length = sizeof(crash_sound);
-      AudioIO2->ioa_Period = CLOCK/7000;
-      AudioIO2->ioa_Volume = 64;
-      AudioIO2->ioa_Cycles = 1;
-      
-      BeginIO((struct IORequest *)AudioIO2);
+      gameinfo->AudioIO2->ioa_Request.io_Command = CMD_WRITE;
+      gameinfo->AudioIO2->ioa_Request.io_Flags = ADIOF_PERVOL;
+      gameinfo->AudioIO2->ioa_Request.io_Unit = (struct Unit *)0x02;
+      gameinfo->AudioIO2->ioa_Data = assets[ASSET_CRASH].data;
+      gameinfo->AudioIO2->ioa_Length = assets[ASSET_CRASH].size;
+      gameinfo->AudioIO2->ioa_Period = CLOCK/7000;
+      gameinfo->AudioIO2->ioa_Volume = 64;
+      gameinfo->AudioIO2->ioa_Cycles = 1;
+      
+      BeginIO((struct IORequest *)gameinfo->AudioIO2);
       /* */
       
       /* start sound again so we can hear this */
-      AudioIO3->ioa_Request.io_Command = CMD_START;
-      AudioIO3->ioa_Request.io_Unit = (struct Unit *)0x03;
-      AudioIO3->ioa_Request.io_Flags = IOF_QUICK;
+      gameinfo->AudioIO3->ioa_Request.io_Command = CMD_START;
+      gameinfo->AudioIO3->ioa_Request.io_Unit = (struct Unit *)0x03;
+      gameinfo->AudioIO3->ioa_Request.io_Flags = IOF_QUICK;
       
-      BeginIO((struct IORequest *)AudioIO3);
+      BeginIO((struct IORequest *)gameinfo->AudioIO3);
       /* */
    }
 }
@@ -384,18 +382,20 @@ void play_crash_sound()
 ** end_crash_sound()
 **
 ** If audio_flag = TRUE, wait for probe crash sound to end, else return.
+** Called again after each wait until it returns WAIT_NONE.
+**
+** RETURNS:  WAIT_PORT (for gameinfo->port) until the sound has ended,
+**           then WAIT_NONE.
 */
-void end_crash_sound()
+int end_crash_sound(struct GameInfo *gameinfo)
 {
-   struct Message *AudioMSG;
-   
-   if (audio_flag == TRUE)
+   if ((gameinfo->audio_flag == TRUE) && (WAIT_NONE != wait_sound(gameinfo)))
    {
-      WaitPort(AudioMP1);
-      AudioMSG = GetMsg(AudioMP1);
-      WaitPort(AudioMP2);
-      AudioMSG = GetMsg(AudioMP2);
+      return WAIT_PORT;
    }
+   
+   trace_mark(gameinfo, "end crash sound");
+   return WAIT_NONE;
 }
 
 
@@ -405,50 +405,52 @@ void end_crash_sound()
 ** If audio_flag = TRUE, begin playing the pop sound of the score counter,
 ** else return.
 */
-void play_pop_sound()
+void play_pop_sound(struct GameInfo *gameinfo)
 {
-   if (audio_flag == TRUE)
+   trace_mark(gameinfo, "play pop sound");
+   
+   if (gameinfo->audio_flag == TRUE)
    {
       /* stop all sound so we can set up for pop */
-      AudioIO3->ioa_Request.io_Command = CMD_STOP;
-      AudioIO3->ioa_Request.io_Unit = (struct Unit *)0x03;
-      AudioIO3->ioa_Request.io_Flags = IOF_QUICK;
+      gameinfo->AudioIO3->ioa_Request.io_Command = CMD_STOP;
+      gameinfo->AudioIO3->ioa_Request.io_Unit = (struct Unit *)0x03;
+      gameinfo->AudioIO3->ioa_Request.io_Flags = IOF_QUICK;
       
-      BeginIO((struct IORequest *)AudioIO3);
+      BeginIO((struct IORequest *)gameinfo->AudioIO3);
       /* */
       
       /* set up to play the pop (left channel) */
-      AudioIO1->ioa_Request.io_Command = CMD_WRITE;
-      AudioIO1->ioa_Request.io_Flags = ADIOF_PERVOL;
-      AudioIO1->ioa_Request.io_Unit = (struct Unit *)0x01;
-      AudioIO1->ioa_Data = (UBYTE *)&tick_sound;
-      AudioIO1->ioa_Length = sizeof(tick_sound);
-      AudioIO1->ioa_Period = CLOCK/8000;
-      AudioIO1->ioa_Volume = 64;
-      AudioIO1->ioa_Cycles = 0;
-      
-      BeginIO((struct IORequest *)AudioIO1);
+      gameinfo->AudioIO1->ioa_Request.io_Command = CMD_WRITE;
+      gameinfo->AudioIO1->ioa_Request.io_Flags = ADIOF_PERVOL;
+      gameinfo->AudioIO1->ioa_Request.io_Unit = (struct Unit *)0x01;
+      gameinfo->AudioIO1->ioa_Data = assets[ASSET_TICK].data;
+      gameinfo->AudioIO1->ioa_Length = assets[ASSET_TICK].size;
+      gameinfo->AudioIO1->ioa_Period = CLOCK/8000;
+      gameinfo->AudioIO1->ioa_Volume = 64;
+      gameinfo->AudioIO1->ioa_Cycles = 0;
+      
+      BeginIO((struct IORequest *)gameinfo->AudioIO1);
       /* */
       
       /* set up to play the pop (right channel) */
-      AudioIO2->ioa_Request.io_Command = CMD_WRITE;
-      AudioIO2->ioa_Request.io_Flags = ADIOF_PERVOL;
-      AudioIO2->ioa_Request.io_Unit = (struct Unit *)0x02;
-      AudioIO2->ioa_Data = (UBYTE *)&tick_sound;
-      AudioIO2->ioa_Length = sizeof(tick_sound);
-      AudioIO2->ioa_Period = CLOCK/8000;
-      AudioIO2->ioa_Volume = 64;
-      AudioIO2->ioa_Cycles = 0;
-      
-      BeginIO((struct IORequest *)AudioIO2);
+      gameinfo->AudioIO2->ioa_Request.io_Command = CMD_WRITE;
+      gameinfo->AudioIO2->ioa_Request.io_Flags = ADIOF_PERVOL;
+      gameinfo->AudioIO2->ioa_Request.io_Unit = (struct Unit *)0x02;
+      gameinfo->AudioIO2->ioa_Data = assets[ASSET_TICK].data;
+      gameinfo->AudioIO2->ioa_Length = assets[ASSET_TICK].size;
+      gameinfo->AudioIO2->ioa_Period = CLOCK/8000;
+      gameinfo->AudioIO2->ioa_Volume = 64;
+      gameinfo->AudioIO2->ioa_Cycles = 0;
+      
+      BeginIO((struct IORequest *)gameinfo->AudioIO2);
       /* */
       
       /* start sound again so we can hear this */
-      AudioIO3->ioa_Request.io_Command = CMD_START;
-      AudioIO3->ioa_Request.io_Unit = (struct Unit *)0x03;
-      AudioIO3->ioa_Request.io_Flags = IOF_QUICK;
+      gameinfo->AudioIO3->ioa_Request.io_Command = CMD_START;
+      gameinfo->AudioIO3->ioa_Request.io_Unit = (struct Unit *)0x03;
+      gameinfo->AudioIO3->ioa_Request.io_Flags = IOF_QUICK;
       
-      BeginIO((struct IORequest *)AudioIO3);
+      BeginIO((struct IORequest *)gameinfo->AudioIO3);
       /* */
    }
 }
@@ -459,16 +461,18 @@ void play_pop_sound()
 **
 ** Finish up with popping sounds.
 */
-void end_pop_sound()
+void end_pop_sound(struct GameInfo *gameinfo)
 {
-   if (audio_flag == TRUE)
+   trace_mark(gameinfo, "end pop sound");
+   
+   if (gameinfo->audio_flag == TRUE)
    {
       /* stop the counter ticking sound */
-      AudioIO3->ioa_Request.io_Command = ADCMD_FINISH;
-      AudioIO3->ioa_Request.io_Unit = (struct Unit *)0x03;
-      AudioIO3->ioa_Request.io_Flags = IOF_QUICK;
+      gameinfo->AudioIO3->ioa_Request.io_Command = ADCMD_FINISH;
+      gameinfo->AudioIO3->ioa_Request.io_Unit = (struct Unit *)0x03;
+      gameinfo->AudioIO3->ioa_Request.io_Flags = IOF_QUICK;
       
-      BeginIO((struct IORequest *)AudioIO3);
+      BeginIO((struct IORequest *)gameinfo->AudioIO3);
       /* */
    }
 }
@@ -480,50 +484,52 @@ void end_pop_sound()
 ** If audio_flag = TRUE, begin playing the main thruster sound of probe,
 ** else return.
 */
-void begin_main_thruster_sound()
+void begin_main_thruster_sound(struct GameInfo *gameinfo)
 {
-   if (audio_flag == TRUE)
+   trace_mark(gameinfo, "begin main thruster sound");
+   
+   if (gameinfo->audio_flag == TRUE)
    {
       /* stop channels 1 & 2 to set up for sound */
-      AudioIO3->ioa_Request.io_Command = CMD_STOP;
-      AudioIO3->ioa_Request.io_Unit = (struct Unit *)0x03;
-      AudioIO3->ioa_Request.io_Flags = IOF_QUICK;
+      gameinfo->AudioIO3->ioa_Request.io_Command = CMD_STOP;
+      gameinfo->AudioIO3->ioa_Request.io_Unit = (struct Unit *)0x03;
+      gameinfo->AudioIO3->ioa_Request.io_Flags = IOF_QUICK;
       
-      BeginIO((struct IORequest *)AudioIO3);
+      BeginIO((struct IORequest *)gameinfo->AudioIO3);
       /* */
       
       /* setup left channel */
-      AudioIO1->ioa_Request.io_Command = CMD_WRITE;
-      AudioIO1->ioa_Request.io_Flags = ADIOF_PERVOL;
-      AudioIO1->ioa_Request.io_Unit = (struct Unit *)0x01;
-      AudioIO1->ioa_Data = (UBYTE *)&main_thruster_sound;
-      AudioIO1->ioa_Length = sizeof(main_thruster_sound);
-      AudioIO1->ioa_Period = CLOCK/8000;
-      AudioIO1->ioa_Volume = 64;
-      AudioIO1->ioa_Cycles = 0;  /* repeat */
-      
-      BeginIO((struct IORequest *)AudioIO1);
+      gameinfo->AudioIO1->ioa_Request.io_Command = CMD_WRITE;
+      gameinfo->AudioIO1->ioa_Request.io_Flags = ADIOF_PERVOL;
+      gameinfo->AudioIO1->ioa_Request.io_Unit = (struct Unit *)0x01;
+      gameinfo->AudioIO1->ioa_Data = assets[ASSET_MAIN_THRUSTER].data;
+      gameinfo->AudioIO1->ioa_Length = assets[ASSET_MAIN_THRUSTER].size;
+      gameinfo->AudioIO1->ioa_Period = CLOCK/8000;
+      gameinfo->AudioIO1->ioa_Volume = 64;
+      gameinfo->AudioIO1->ioa_Cycles = 0;  /* repeat */
+      
+      BeginIO((struct IORequest *)gameinfo->AudioIO1);
       /* */
       
       /* setup right channel */
-      AudioIO2->ioa_Request.io_Command = CMD_WRITE;
-      AudioIO2->ioa_Request.io_Flags = ADIOF_PERVOL;
-      AudioIO2->ioa_Request.io_Unit = (struct Unit *)0x02;
-      AudioIO2->ioa_Data = (UBYTE *)&main_thruster_sound;
-      AudioIO2->ioa_Length = sizeof(main_thruster_sound);
-      AudioIO2->ioa_Period = CLOCK/8000;
-      AudioIO2->ioa_Volume = 64;
-      AudioIO2->ioa_Cycles = 0;  /* repeat */
-      
-      BeginIO((struct IORequest *)AudioIO2);
+      gameinfo->AudioIO2->ioa_Request.io_Command = CMD_WRITE;
+      gameinfo->AudioIO2->ioa_Request.io_Flags = ADIOF_PERVOL;
+      gameinfo->AudioIO2->ioa_Request.io_Unit = (struct Unit *)0x02;
+      gameinfo->AudioIO2->ioa_Data = assets[ASSET_MAIN_THRUSTER].data;
+      gameinfo->AudioIO2->ioa_Length = assets[ASSET_MAIN_THRUSTER].size;
+      gameinfo->AudioIO2->ioa_Period = CLOCK/8000;
+      gameinfo->AudioIO2->ioa_Volume = 64;
+      gameinfo->AudioIO2->ioa_Cycles = 0;  /* repeat */
+      
+      BeginIO((struct IORequest *)gameinfo->AudioIO2);
       /* */
       
       /* start channels 1 & 2 */
-      AudioIO3->ioa_Request.io_Command = CMD_START;
-      AudioIO3->ioa_Request.io_Unit = (struct Unit *)0x03;
-      AudioIO3->ioa_Request.io_Flags = IOF_QUICK;
+      gameinfo->AudioIO3->ioa_Request.io_Command = CMD_START;
+      gameinfo->AudioIO3->ioa_Request.io_Unit = (struct Unit *)0x03;
+      gameinfo->AudioIO3->ioa_Request.io_Flags = IOF_QUICK;
       
-      BeginIO((struct IORequest *)AudioIO3);
+      BeginIO((struct IORequest *)gameinfo->AudioIO3);
       /* */
    }
 }
@@ -534,16 +540,18 @@ void begin_main_thruster_sound()
 **
 ** Finish main thruster sound.
 */
-void end_main_thruster_sound()
+void end_main_thruster_sound(struct GameInfo *gameinfo)
 {
-   if (audio_flag == TRUE)
+   trace_mark(gameinfo, "end main thruster sound");
+   
+   if (gameinfo->audio_flag == TRUE)
    {
       /* stop the main thruster sound (channels 1 & 2) */
-      AudioIO3->ioa_Request.io_Command = ADCMD_FINISH;
-      AudioIO3->ioa_Request.io_Unit = (struct Unit *)0x03;
-      AudioIO3->ioa_Request.io_Flags = IOF_QUICK;
+      gameinfo->AudioIO3->ioa_Request.io_Command = ADCMD_FINISH;
+      gameinfo->AudioIO3->ioa_Request.io_Unit = (struct Unit *)0x03;
+      gameinfo->AudioIO3->ioa_Request.io_Flags = IOF_QUICK;
       
-      BeginIO((struct IORequest *)AudioIO3);
+      BeginIO((struct IORequest *)gameinfo->AudioIO3);
       /* */
    }
 }
@@ -555,21 +563,23 @@ void end_main_thruster_sound()
 ** If audio_flag = TRUE, begin playing the side thruster sound of probe
 ** through the a left channel, else return.
 */
-void begin_left_thruster_sound()
+void begin_left_thruster_sound(struct GameInfo *gameinfo)
 {
-   if (audio_flag == TRUE)
+   trace_mark(gameinfo, "begin left thruster sound");
+   
+   if (gameinfo->audio_flag == TRUE)
    {
       /* setup left channel */
-      AudioIO4->ioa_Request.io_Command = CMD_WRITE;
-      AudioIO4->ioa_Request.io_Flags = ADIOF_PERVOL;
-      AudioIO4->ioa_Request.io_Unit = (struct Unit *)0x08;
-      AudioIO4->ioa_Data = (UBYTE *)&side_thruster_sound;
-      AudioIO4->ioa_Length = sizeof(side_thruster_sound);
-      AudioIO4->ioa_Period = CLOCK/8000;
-      AudioIO4->ioa_Volume = 64;
-      AudioIO4->ioa_Cycles = 0;  /* repeat */
-      
-      BeginIO((struct IORequest *)AudioIO4);
+      gameinfo->AudioIO4->ioa_Request.io_Command = CMD_WRITE;
+      gameinfo->AudioIO4->ioa_Request.io_Flags = ADIOF_PERVOL;
+      gameinfo->AudioIO4->ioa_Request.io_Unit = (struct Unit *)0x08;
+      gameinfo->AudioIO4->ioa_Data = assets[ASSET_SIDE_THRUSTER].data;
+      gameinfo->AudioIO4->ioa_Length = assets[ASSET_SIDE_THRUSTER].size;
+      gameinfo->AudioIO4->ioa_Period = CLOCK/8000;
+      gameinfo->AudioIO4->ioa_Volume = 64;
+      gameinfo->AudioIO4->ioa_Cycles = 0;  /* repeat */
+      
+      BeginIO((struct IORequest *)gameinfo->AudioIO4);
       /* */
    }
 }
@@ -580,16 +590,18 @@ void begin_left_thruster_sound()
 **
 ** Finish side thruster sound in left channel.
 */
-void end_left_thruster_sound()
+void end_left_thruster_sound(struct GameInfo *gameinfo)
 {
-   if (audio_flag == TRUE)
+   trace_mark(gameinfo, "end left thruster sound");
+   
+   if (gameinfo->audio_flag == TRUE)
    {
       /* stop the main thruster sound (channels 1 & 2) */
-      AudioIO3->ioa_Request.io_Command = ADCMD_FINISH;
-      AudioIO3->ioa_Request.io_Unit = (struct Unit *)0x08;
-      AudioIO3->ioa_Request.io_Flags = IOF_QUICK;
+      gameinfo->AudioIO3->ioa_Request.io_Command = ADCMD_FINISH;
+      gameinfo->AudioIO3->ioa_Request.io_Unit = (struct Unit *)0x08;
+      gameinfo->AudioIO3->ioa_Request.io_Flags = IOF_QUICK;
       
-      BeginIO((struct IORequest *)AudioIO3);
+      BeginIO((struct IORequest *)gameinfo->AudioIO3);
       /* */
    }
 }
@@ -602,21 +614,23 @@ void end_left_thruster_sound()
 ** If audio_flag = TRUE, begin playing the side thruster sound of probe
 ** through the a right channel, else return.
 */
-void begin_right_thruster_sound()
+void begin_right_thruster_sound(struct GameInfo *gameinfo)
 {
-   if (audio_flag == TRUE)
+   trace_mark(gameinfo, "begin right thruster sound");
+   
+   if (gameinfo->audio_flag == TRUE)
    {
       /* setup left channel */
-      AudioIO5->ioa_Request.io_Command = CMD_WRITE;
-      AudioIO5->ioa_Request.io_Flags = ADIOF_PERVOL;
-      AudioIO5->ioa_Request.io_Unit = (struct Unit *)0x04;
-      AudioIO5->ioa_Data = (UBYTE *)&side_thruster_sound;
-      AudioIO5->ioa_Length = sizeof(side_thruster_sound);
-      AudioIO5->ioa_Period = CLOCK/8000;
-      AudioIO5->ioa_Volume = 64;
-      AudioIO5->ioa_Cycles = 0;  /* repeat */
-      
-      BeginIO((struct IORequest *)AudioIO5);
+      gameinfo->AudioIO5->ioa_Request.io_Command = CMD_WRITE;
+      gameinfo->AudioIO5->ioa_Request.io_Flags = ADIOF_PERVOL;
+      gameinfo->AudioIO5->ioa_Request.io_Unit = (struct Unit *)0x04;
+      gameinfo->AudioIO5->ioa_Data = assets[ASSET_SIDE_THRUSTER].data;
+      gameinfo->AudioIO5->ioa_Length = assets[ASSET_SIDE_THRUSTER].size;
+      gameinfo->AudioIO5->ioa_Period = CLOCK/8000;
+      gameinfo->AudioIO5->ioa_Volume = 64;
+      gameinfo->AudioIO5->ioa_Cycles = 0;  /* repeat */
+      
+      BeginIO((struct IORequest *)gameinfo->AudioIO5);
       /* */
    }
 }
@@ -627,20 +641,53 @@ void begin_right_thruster_sound()
 **
 ** Finish side thruster sound in right channel.
 */
-void end_right_thruster_sound()
+void end_right_thruster_sound(struct GameInfo *gameinfo)
 {
-   if (audio_flag == TRUE)
+   trace_mark(gameinfo, "end right thruster sound");
+   
+   if (gameinfo->audio_flag == TRUE)
    {
       /* stop the main thruster sound (channels 1 & 2) */
-      AudioIO3->ioa_Request.io_Command = ADCMD_FINISH;
-      AudioIO3->ioa_Request.io_Unit = (struct Unit *)0x04;
-      AudioIO3->ioa_Request.io_Flags = IOF_QUICK;
+      gameinfo->AudioIO3->ioa_Request.io_Command = ADCMD_FINISH;
+      gameinfo->AudioIO3->ioa_Request.io_Unit = (struct Unit *)0x04;
+      gameinfo->AudioIO3->ioa_Request.io_Flags = IOF_QUICK;
       
-      BeginIO((struct IORequest *)AudioIO3);
+      BeginIO((struct IORequest *)gameinfo->AudioIO3);
       /* */
    }
 }
 
 
-
-
+/*
+** wait_sound()
+**
+** Collect the replies of the left and right channels to the sound last
+** played on both, one at a time.
+**
+** RETURNS:  WAIT_PORT (for gameinfo->port) until both have replied,
+**           then WAIT_NONE.
+*/
+int wait_sound(struct GameInfo *gameinfo)
+{
+   struct Message *AudioMSG;
+   
+   switch (gameinfo->sound_step)
+   {
+      case 0:
+         gameinfo->port = gameinfo->AudioMP1;
+         gameinfo->sound_step = 1;
+         return WAIT_PORT;
+         break;
+      case 1:
+         AudioMSG = GetMsg(gameinfo->AudioMP1);
+         gameinfo->port = gameinfo->AudioMP2;
+         gameinfo->sound_step = 2;
+         return WAIT_PORT;
+         break;
+   }
+   
+   AudioMSG = GetMsg(gameinfo->AudioMP2);
+   gameinfo->sound_step = 0;
+   
+   return WAIT_NONE;
+}
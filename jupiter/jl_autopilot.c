@@ -0,0 +1,521 @@
+/*
+** jl_autopilot.c - flies the probe in place of the keyboard
+**
+** (c)1993 Paul Grebenc
+**
+** For demos and for playing long sessions unattended.  Each frame the
+** autopilot looks ahead by the game's own rules (step_probe() in
+** jl_physics.c).  First it flies on as a careful pilot would, steering
+** for a velocity that depends on where the probe is and which pad it
+** is making for.  Then it makes a beam search over the six ways of
+** holding the thrusters, each held for AUTO_HOLD frames, keeping the
+** AUTO_BEAM cheapest paths at each depth.  A path costs how far the
+** probe strays from the careful pilot's velocities and from where it is
+** making for, and paths that crash or leave the sky are dropped.  States
+** that differ by less than can be seen are found by hashing and only the
+** cheapest is kept.  The careful pilot's choice is flown unless the
+** search finds a better landing, or a way to stay up where it would
+** crash.
+**
+** The search is timed by the E clock and stops when its budget (a
+** millisecond by default) is spent, keeping what the last depth it
+** finished found.  Everything the search needs is in the AutoPilot
+** allocated by setup_autopilot(), so a frame never waits for memory.
+*/
+
+
+/** INCLUDES & DEFINES **/
+
+#include "jupiterdefs.h"
+
+#define PADS            (3)
+
+/* in place of an action, to fly as careful_keys() would */
+#define CAREFUL         (-1)
+
+/* a path that lands is worth this more than one still flying */
+#define LANDING_WORTH   (100000.0)
+
+
+/** PROTOTYPES **/
+
+int setup_autopilot(struct GameInfo *gameinfo, LONG budget);
+void cleanup_autopilot(struct GameInfo *gameinfo);
+int fly_autopilot(struct GameInfo *gameinfo);
+
+static int careful_keys(struct AutoPilot *autopilot, int view,
+   struct ProbeInfo *probeinfo, float *want_x_vel, float *want_y_vel,
+   float *off_x);
+static BOOL fly_node(struct GameInfo *gameinfo, struct AutoNode *node,
+   int action, float *score);
+static BOOL add_node(struct AutoPilot *autopilot, LONG count);
+static void keep_cheapest(struct AutoPilot *autopilot, LONG count);
+static BOOL out_of_time(struct AutoPilot *autopilot, struct EClockVal *start);
+static ULONG ticks_since(struct EClockVal *start);
+static float clamp(float value, float low, float high);
+
+/* jl_physics.c */
+extern int step_probe(struct PhysicsInfo *physics, struct ProbeInfo *probeinfo,
+   int view, int top, int *score);
+
+
+/** GLOBAL VARIABLES **/
+
+/* jl_clock.c */
+extern struct timerequest *open_eclock(void);
+extern void close_eclock(struct timerequest *timerio);
+
+/* CURSOR_* bits of each way of holding the thrusters */
+static int action_keys[AUTO_ACTIONS] = {
+   0, CURSOR_LEFT, CURSOR_RIGHT,
+   CURSOR_UP, CURSOR_UP | CURSOR_LEFT, CURSOR_UP | CURSOR_RIGHT
+};
+
+/* x_pos to come down at in the far view to reach each pad */
+static float far_x[PADS] = { 66.0, 140.0, 206.0 };
+
+/* in each pad view the probe comes down at entry_x to hover_y, then
+** moves over to pad_x and sets down, to keep clear of the walls
+*/
+static float entry_x[PADS] = { 65.0, 140.5, 199.0 };
+static float hover_y[PADS] = { 0.0, 0.0, 122.0 };
+static float pad_x[PADS] = { 65.0, 140.5, 190.5 };
+
+/* y_pos at which the probe stands on each pad, see do_collision() */
+static float floor_y[PADS] = {
+   90.0 + (118 - 42) / 2.0, 10.0 + (75 - 42) / 2.0, 90.0 + (134 - 42) / 2.0
+};
+
+
+/*-----------------------------------------------------------------------*/
+
+
+/*
+** setup_autopilot()
+**
+** Let the autopilot fly the probe of a game, searching for at most
+** budget microseconds a frame.  Opens timer.device for the E clock.
+**
+** RETURNS:  TRUE if successful, FALSE if unsuccessful.
+*/
+int setup_autopilot(struct GameInfo *gameinfo, LONG budget)
+{
+   struct AutoPilot *autopilot;
+   struct EClockVal now;
+   ULONG rate;
+
+   if (autopilot = (struct AutoPilot *)AllocMem(sizeof(struct AutoPilot),
+         MEMF_PUBLIC | MEMF_CLEAR))
+   {
+      if (autopilot->TimerIO = open_eclock())
+      {
+         rate = ReadEClock(&now);
+         autopilot->budget = (rate / 1000) * budget / 1000;
+         autopilot->flight = -1;
+
+         gameinfo->autopilot = autopilot;
+         return TRUE;
+      }
+      FreeMem(autopilot, sizeof(struct AutoPilot));
+   }
+   else
+   {
+      printf("Could not allocate autopilot\n");
+   }
+   return FALSE;
+}
+
+
+/*
+** cleanup_autopilot()
+**
+** Free everything allocated by setup_autopilot(), close timer.device and
+** give the probe back to the keyboard.
+*/
+void cleanup_autopilot(struct GameInfo *gameinfo)
+{
+   struct AutoPilot *autopilot;
+
+   autopilot = gameinfo->autopilot;
+   gameinfo->autopilot = NULL;
+
+   close_eclock(autopilot->TimerIO);
+   FreeMem(autopilot, sizeof(struct AutoPilot));
+}
+
+
+/*
+** fly_autopilot()
+**
+** Search for the best way to hold the thrusters this frame, for as long
+** as the budget allows.  The careful pilot's own flight is looked ahead
+** first, and what it would hold is kept unless the search finds a better
+** landing, or it would crash and the search finds a way to stay up.
+** Each flight makes for the next pad in turn.
+**
+** RETURNS:  CURSOR_* bits of the keys to hold.
+*/
+int fly_autopilot(struct GameInfo *gameinfo)
+{
+   struct AutoPilot *autopilot;
+   struct AutoNode *node;
+   struct EClockVal start;
+   ULONG ticks;
+   LONG count, n;
+   float want_x_vel, want_y_vel, off_x, score, best_landing;
+   int keys, depth, done, action, landing_first, spent;
+   BOOL careful_crashes;
+
+   autopilot = gameinfo->autopilot;
+   ReadEClock(&start);
+
+   if (gameinfo->flights != autopilot->flight)
+   {
+      autopilot->flight = gameinfo->flights;
+      autopilot->pad = autopilot->flight % PADS;
+   }
+
+   /* what to hold if there is no time to look ahead at all */
+   keys = careful_keys(autopilot, gameinfo->view, &gameinfo->probeinfo,
+      &want_x_vel, &want_y_vel, &off_x);
+
+   node = &autopilot->beam[0];
+   node->probeinfo = gameinfo->probeinfo;
+   node->view = gameinfo->view;
+   node->first = CAREFUL;
+   node->cost = 0.0;
+
+   /* how the careful pilot would do */
+   best_landing = -LANDING_WORTH;
+   landing_first = CAREFUL;
+   careful_crashes = FALSE;
+   autopilot->next[0] = *node;
+   for (depth=0; depth < AUTO_DEPTH; depth++)
+   {
+      if (!fly_node(gameinfo, &autopilot->next[0], CAREFUL, &score))
+      {
+         if (score > 0)
+         {
+            best_landing = score - autopilot->next[0].cost;
+            landing_first = CAREFUL;
+         }
+         else
+         {
+            careful_crashes = TRUE;
+         }
+         break;
+      }
+   }
+
+   count = 1;
+   spent = FALSE;
+   for (depth=0, done=0; (depth < AUTO_DEPTH) && (count > 0) && !spent;
+      depth++)
+   {
+      /* a new stamp empties the hash table */
+      autopilot->stamp++;
+
+      n = 0;
+      for (node=autopilot->beam; node < &autopilot->beam[count]; node++)
+      {
+         if (out_of_time(autopilot, &start))
+         {
+            spent = TRUE;
+            break;
+         }
+
+         for (action=0; action < AUTO_ACTIONS; action++)
+         {
+            autopilot->next[n] = *node;
+            if (depth == 0)
+            {
+               autopilot->next[n].first = action;
+            }
+
+            if (fly_node(gameinfo, &autopilot->next[n], action, &score))
+            {
+               n += add_node(autopilot, n);
+            }
+            else if (score - autopilot->next[n].cost > best_landing)
+            {
+               best_landing = score - autopilot->next[n].cost;
+               landing_first = autopilot->next[n].first;
+            }
+         }
+      }
+
+      /* a depth not finished is no use to choose by */
+      if (!spent)
+      {
+         keep_cheapest(autopilot, n);
+         count = (n < AUTO_BEAM) ? n : AUTO_BEAM;
+         done = depth + 1;
+      }
+   }
+
+   if (best_landing > 0)
+   {
+      if (landing_first != CAREFUL)
+      {
+         keys = action_keys[landing_first];
+      }
+      autopilot->landings++;
+   }
+   else if (careful_crashes && (done > 0) && (count > 0))
+   {
+      keys = action_keys[autopilot->beam[0].first];
+   }
+
+   ticks = ticks_since(&start);
+   if (ticks > autopilot->longest)
+   {
+      autopilot->longest = ticks;
+   }
+   autopilot->searches++;
+   autopilot->depths += done;
+
+   return keys;
+}
+
+
+/*
+** careful_keys()
+**
+** The velocities a careful pilot wants, making for the autopilot's pad:
+** across the far view high enough to miss the mountains (and, for pad C,
+** the way into pad B), then down over the pad, slowing as it nears it.
+**
+** RETURNS:  CURSOR_* bits of the keys that pilot would hold.
+*/
+static int careful_keys(struct AutoPilot *autopilot, int view,
+   struct ProbeInfo *probeinfo, float *want_x_vel, float *want_y_vel,
+   float *off_x)
+{
+   float target, away;
+   int keys, pad;
+
+   pad = autopilot->pad;
+   if (view == GO_FAR)
+   {
+      target = far_x[pad];
+      away = target - probeinfo->x_pos;
+      if ((away > 1.5) || (away < -1.5))
+      {
+         *want_y_vel = clamp((5.0 - probeinfo->y_pos) * 0.1, -0.5, 0.5);
+      }
+      else
+      {
+         *want_y_vel = 0.6;
+      }
+   }
+   else
+   {
+      pad = view - GO_PAD_A;
+
+      if (probeinfo->y_pos < hover_y[pad])
+      {
+         target = entry_x[pad];
+         *want_y_vel = clamp((hover_y[pad] - probeinfo->y_pos) * 0.04, 0.1, 0.6);
+      }
+      else
+      {
+         target = pad_x[pad];
+         *want_y_vel = clamp((floor_y[pad] - probeinfo->y_pos) * 0.04, 0.1, 1.0);
+         away = target - probeinfo->x_pos;
+         if ((away > 3.0) || (away < -3.0))
+         {
+            *want_y_vel = clamp(*want_y_vel, -0.2, 0.05);
+         }
+      }
+   }
+   *off_x = target - probeinfo->x_pos;
+   *want_x_vel = clamp(*off_x * 0.05, -1.0, 1.0);
+
+   keys = 0;
+   if (probeinfo->y_vel > *want_y_vel)
+   {
+      keys |= CURSOR_UP;
+   }
+   if (probeinfo->x_vel < *want_x_vel - 0.02)
+   {
+      keys |= CURSOR_LEFT;
+   }
+   else if (probeinfo->x_vel > *want_x_vel + 0.02)
+   {
+      keys |= CURSOR_RIGHT;
+   }
+
+   return keys;
+}
+
+
+/*
+** fly_node()
+**
+** Fly node on for AUTO_HOLD frames holding action (or as the careful
+** pilot would, for CAREFUL), adding to its cost how far it strays each
+** frame from the velocities that pilot wants and from where it is
+** making for.
+**
+** RETURNS:  TRUE if it is still flying, else FALSE with *score set to
+**           what the flight is worth (-LANDING_WORTH unless it landed).
+*/
+static BOOL fly_node(struct GameInfo *gameinfo, struct AutoNode *node,
+   int action, float *score)
+{
+   float want_x_vel, want_y_vel, off_x, miss;
+   int frame, keys, result, points;
+
+   for (frame=0; frame < AUTO_HOLD; frame++)
+   {
+      keys = careful_keys(gameinfo->autopilot, node->view, &node->probeinfo,
+         &want_x_vel, &want_y_vel, &off_x);
+
+      miss = node->probeinfo.x_vel - want_x_vel;
+      node->cost += (miss < 0) ? -miss : miss;
+      miss = node->probeinfo.y_vel - want_y_vel;
+      node->cost += (miss < 0) ? -miss : miss;
+      miss = off_x * 0.05;
+      node->cost += (miss < 0) ? -miss : miss;
+
+      node->probeinfo.user_input = (action == CAREFUL) ? keys : action_keys[action];
+      result = step_probe(&gameinfo->physics, &node->probeinfo, node->view,
+         gameinfo->title_height, &points);
+
+      switch (result)
+      {
+         case LANDED:
+               *score = LANDING_WORTH + points;
+               return FALSE;
+               break;
+         case CRASHED:
+         case OUT_OF_SKY:
+               *score = -LANDING_WORTH;
+               return FALSE;
+               break;
+         case OK:
+               break;
+         default:
+               node->view = result;
+               break;
+      }
+   }
+
+   return TRUE;
+}
+
+
+/*
+** add_node()
+**
+** Look for a node in the same state as autopilot->next[count] among those
+** found at this depth, by a hash of the state as far as can be seen (half
+** a pixel of position, a sixteenth of velocity).  If there is one, the
+** cheaper of the two is kept in its place.
+**
+** RETURNS:  TRUE if it was added as a new state, FALSE otherwise.
+*/
+static BOOL add_node(struct AutoPilot *autopilot, LONG count)
+{
+   struct AutoNode *node;
+   ULONG key, slot;
+
+   node = &autopilot->next[count];
+   key = (ULONG)(LONG)(node->probeinfo.x_pos * 2) * 73856093UL ^
+      (ULONG)(LONG)(node->probeinfo.y_pos * 2) * 19349663UL ^
+      (ULONG)(LONG)(node->probeinfo.x_vel * 16) * 83492791UL ^
+      (ULONG)(LONG)(node->probeinfo.y_vel * 16) * 2654435761UL ^
+      (ULONG)node->view * 40503UL ^ (node->probeinfo.fuel < 0);
+
+   for (slot=key & (AUTO_HASH-1); autopilot->hash_stamp[slot] == autopilot->stamp;
+      slot=(slot+1) & (AUTO_HASH-1))
+   {
+      if (autopilot->hash_key[slot] == key)
+      {
+         if (node->cost < autopilot->next[autopilot->hash_node[slot]].cost)
+         {
+            autopilot->next[autopilot->hash_node[slot]] = *node;
+         }
+         return FALSE;
+      }
+   }
+
+   autopilot->hash_stamp[slot] = autopilot->stamp;
+   autopilot->hash_key[slot] = key;
+   autopilot->hash_node[slot] = count;
+   return TRUE;
+}
+
+
+/*
+** keep_cheapest()
+**
+** Move the AUTO_BEAM cheapest of the count nodes found at this depth,
+** cheapest first, into the beam for the next.
+*/
+static void keep_cheapest(struct AutoPilot *autopilot, LONG count)
+{
+   LONG n, kept, k;
+
+   kept = 0;
+   for (n=0; n < count; n++)
+   {
+      if ((kept == AUTO_BEAM) &&
+         (autopilot->next[n].cost >= autopilot->next[autopilot->order[kept-1]].cost))
+      {
+         continue;
+      }
+      if (kept < AUTO_BEAM)
+      {
+         kept++;
+      }
+      for (k=kept-1; (k > 0) &&
+         (autopilot->next[autopilot->order[k-1]].cost > autopilot->next[n].cost); k--)
+      {
+         autopilot->order[k] = autopilot->order[k-1];
+      }
+      autopilot->order[k] = n;
+   }
+
+   for (k=0; k < kept; k++)
+   {
+      autopilot->beam[k] = autopilot->next[autopilot->order[k]];
+   }
+}
+
+
+/*
+** out_of_time()
+**
+** RETURNS:  TRUE if the search begun at start has used up its budget.
+*/
+static BOOL out_of_time(struct AutoPilot *autopilot, struct EClockVal *start)
+{
+   return (ticks_since(start) >= autopilot->budget);
+}
+
+
+/*
+** ticks_since()
+**
+** RETURNS:  E clock ticks since start.
+*/
+static ULONG ticks_since(struct EClockVal *start)
+{
+   struct EClockVal now;
+
+   ReadEClock(&now);
+
+   return now.ev_lo - start->ev_lo;
+}
+
+
+/*
+** clamp()
+**
+** RETURNS:  value, kept between low and high.
+*/
+static float clamp(float value, float low, float high)
+{
+   return (value < low) ? low : ((value > high) ? high : value);
+}
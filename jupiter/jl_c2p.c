@@ -0,0 +1,289 @@
+/*
+** jl_c2p.c - planar to chunky conversion for the Linux host
+**
+** (c)1993 Paul Grebenc
+**
+** Turns the bitplanes of a BitMap into one byte per pixel (the pen) and
+** pens into 32 bit RGBA through a palette, for anything on the host that
+** wants to look at a frame.  With SSE2 each word of each plane becomes 16
+** bytes in a handful of instructions; the plain C versions are used
+** elsewhere.
+*/
+
+
+/** INCLUDES & DEFINES **/
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "jupiterdefs.h"
+
+/* widest BitMap planar_to_rgba() converts a row of at a time */
+#define MAX_ROW_PIXELS  (1024)
+
+
+/** GLOBAL VARIABLES **/
+
+/* Workbench colors of the pens in jupiterdefs.h, as for LoadRGB4() */
+UWORD host_colors[4] = {
+   0x0aaa,  /* GREY  */
+   0x0000,  /* BLACK */
+   0x0fff,  /* WHITE */
+   0x068b   /* BLUE  */
+};
+
+
+/*-----------------------------------------------------------------------*/
+
+
+/*
+** rgb4_to_rgba()
+**
+** Build a palette of RGBA pixels (bytes red, green, blue and alpha in that
+** order in memory) from count 12 bit Amiga color words.
+*/
+void rgb4_to_rgba(UWORD *colors, LONG count, ULONG *palette)
+{
+   UBYTE *rgba;
+   LONG n;
+
+   for (n=0; n < count; n++)
+   {
+      rgba = (UBYTE *)&palette[n];
+      rgba[0] = ((colors[n] >> 8) & 0xf) * 0x11;
+      rgba[1] = ((colors[n] >> 4) & 0xf) * 0x11;
+      rgba[2] = (colors[n] & 0xf) * 0x11;
+      rgba[3] = 0xff;
+   }
+}
+
+
+/*
+** planar_to_chunky()
+**
+** Convert every plane of bm into one byte per pixel, BytesPerRow*8 pixels
+** across, with rows modulo bytes apart in chunky.
+*/
+void planar_to_chunky(struct BitMap *bm, UBYTE *chunky, LONG modulo)
+{
+   UWORD *plane_row;
+   UBYTE *out;
+   int words;
+   int row, plane, k;
+#ifdef __SSE2__
+   __m128i bits, pen, word, acc;
+#else
+   UWORD w;
+   int bit;
+#endif
+
+   words = bm->BytesPerRow >> 1;
+
+#ifdef __SSE2__
+   /* the bit each byte of a word picks out, leftmost pixel first */
+   bits = _mm_set_epi8(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, (char)0x80,
+                       0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, (char)0x80);
+#endif
+
+   for (row=0; row < bm->Rows; row++)
+   {
+      out = chunky + row*modulo;
+
+      for (k=0; k < words; k++)
+      {
+#ifdef __SSE2__
+         acc = _mm_setzero_si128();
+
+         for (plane=0; plane < bm->Depth; plane++)
+         {
+            plane_row = (UWORD *)bm->Planes[plane] + row*words;
+
+            /* high byte into bytes 0-7, low byte into bytes 8-15 */
+            word = _mm_cvtsi32_si128(plane_row[k]);
+            word = _mm_unpacklo_epi8(word, word);
+            word = _mm_unpacklo_epi16(word, word);
+            word = _mm_shuffle_epi32(word, _MM_SHUFFLE(0, 0, 1, 1));
+
+            /* 0xff in each byte whose bit is set, then the plane's bit */
+            word = _mm_cmpeq_epi8(_mm_and_si128(word, bits), bits);
+            pen = _mm_set1_epi8(1 << plane);
+            acc = _mm_or_si128(acc, _mm_and_si128(word, pen));
+         }
+
+         _mm_storeu_si128((__m128i *)(out + k*16), acc);
+#else
+         memset(out + k*16, 0, 16);
+
+         for (plane=0; plane < bm->Depth; plane++)
+         {
+            plane_row = (UWORD *)bm->Planes[plane] + row*words;
+            w = plane_row[k];
+
+            for (bit=0; bit < 16; bit++)
+            {
+               out[k*16 + bit] |= ((w >> (15 - bit)) & 1) << plane;
+            }
+         }
+#endif
+      }
+   }
+}
+
+
+/*
+** chunky_to_rgba()
+**
+** Look up count pens in palette.  With SSE2 and no more than 4 colors the
+** pixels are picked 16 at a time by comparing against each pen, pens out
+** of range giving 0.
+*/
+void chunky_to_rgba(UBYTE *chunky, ULONG *rgba, LONG count, ULONG *palette,
+   int colors)
+{
+   LONG n;
+#ifdef __SSE2__
+   __m128i pens, match, half, quarter;
+   __m128i out[4];
+   __m128i color;
+   int pen, j;
+
+   n = 0;
+
+   if (colors <= 4)
+   {
+      for (; n+16 <= count; n += 16)
+      {
+         pens = _mm_loadu_si128((__m128i *)(chunky + n));
+         out[0] = out[1] = out[2] = out[3] = _mm_setzero_si128();
+
+         for (pen=0; pen < colors; pen++)
+         {
+            match = _mm_cmpeq_epi8(pens, _mm_set1_epi8(pen));
+            color = _mm_set1_epi32(palette[pen]);
+
+            /* widen the byte matches to one dword per pixel */
+            for (j=0; j < 2; j++)
+            {
+               half = j ? _mm_unpackhi_epi8(match, match)
+                        : _mm_unpacklo_epi8(match, match);
+
+               quarter = _mm_unpacklo_epi16(half, half);
+               out[j*2] = _mm_or_si128(out[j*2], _mm_and_si128(quarter, color));
+
+               quarter = _mm_unpackhi_epi16(half, half);
+               out[j*2+1] = _mm_or_si128(out[j*2+1], _mm_and_si128(quarter, color));
+            }
+         }
+
+         for (j=0; j < 4; j++)
+         {
+            _mm_storeu_si128((__m128i *)(rgba + n + j*4), out[j]);
+         }
+      }
+   }
+
+   for (; n < count; n++)
+   {
+      rgba[n] = (chunky[n] < colors) ? palette[chunky[n]] : 0;
+   }
+#else
+   for (n=0; n < count; n++)
+   {
+      rgba[n] = (chunky[n] < colors) ? palette[chunky[n]] : 0;
+   }
+#endif
+}
+
+
+/*
+** planar_to_rgba()
+**
+** Convert a whole BitMap to RGBA pixels, BytesPerRow*8 to a row, one row
+** at a time so that the pens never leave the cache.
+*/
+void planar_to_rgba(struct BitMap *bm, ULONG *rgba, ULONG *palette,
+   int colors)
+{
+   struct BitMap row_bitmap;
+   UBYTE chunky[MAX_ROW_PIXELS];
+   LONG width;
+   int row, plane;
+
+   width = bm->BytesPerRow * 8;
+   if (width > MAX_ROW_PIXELS)
+   {
+      return;
+   }
+
+   /* a one row BitMap over each row of bm in turn */
+   row_bitmap = *bm;
+   row_bitmap.Rows = 1;
+
+   for (row=0; row < bm->Rows; row++)
+   {
+      for (plane=0; plane < bm->Depth; plane++)
+      {
+         row_bitmap.Planes[plane] = bm->Planes[plane] + row*bm->BytesPerRow;
+      }
+
+      planar_to_chunky(&row_bitmap, chunky, width);
+      chunky_to_rgba(chunky, rgba + row*width, width, palette, colors);
+   }
+}
+
+
+/*
+** planar_to_rgba_damage()
+**
+** Convert only the damaged rectangles of bm into an RGBA frame laid out
+** as by planar_to_rgba(), leaving the rest of rgba as it was.  Each
+** rectangle is widened to whole words.
+*/
+void planar_to_rgba_damage(struct BitMap *bm, ULONG *rgba, ULONG *palette,
+   int colors, struct DamageList *dl)
+{
+   struct BitMap row_bitmap;
+   UBYTE chunky[MAX_ROW_PIXELS];
+   struct Rectangle *rect;
+   LONG width;
+   int first, last;
+   int row, plane, n;
+
+   width = bm->BytesPerRow * 8;
+   if (width > MAX_ROW_PIXELS)
+   {
+      return;
+   }
+
+   row_bitmap = *bm;
+   row_bitmap.Rows = 1;
+
+   for (n=0; n < dl->Count; n++)
+   {
+      rect = &dl->Rects[n];
+
+      /* the words the rectangle covers, and the rows, inside bm */
+      first = (rect->MinX < 0) ? 0 : rect->MinX >> 4;
+      last = (rect->MaxX >= width) ? (width >> 4) - 1 : rect->MaxX >> 4;
+      if (first > last)
+      {
+         continue;
+      }
+      row_bitmap.BytesPerRow = (last - first + 1) * 2;
+
+      for (row = (rect->MinY < 0) ? 0 : rect->MinY;
+         (row <= rect->MaxY) && (row < bm->Rows); row++)
+      {
+         for (plane=0; plane < bm->Depth; plane++)
+         {
+            row_bitmap.Planes[plane] = bm->Planes[plane] +
+               row*bm->BytesPerRow + first*2;
+         }
+
+         planar_to_chunky(&row_bitmap, chunky, row_bitmap.BytesPerRow * 8);
+         chunky_to_rgba(chunky, rgba + row*width + first*16,
+            row_bitmap.BytesPerRow * 8, palette, colors);
+      }
+   }
+}
@@ -0,0 +1,189 @@
+/*
+** jl_clock.c - the clock a game is played to
+**
+** (c)1993 Paul Grebenc
+**
+** Everything step_game() waits for is waited for here: frames, delays
+** (the beeps of the starting tune, the pauses after a crash, a landing
+** and the end of a game) and the replies of audio.device.  The real
+** clock waits as the game always has.  A scaled clock plays speed times
+** faster, waiting for one frame in every speed and for a speed'th part of
+** each delay.  The instant clock never waits for time at all.
+**
+** Replies at a port are events, not time, and are waited for by every
+** clock.  Sound is only played to the real clock; on any other the game
+** is silent, so the tune and crash are timed by delays instead.
+*/
+
+
+/** INCLUDES & DEFINES **/
+
+#include "jupiterdefs.h"
+
+
+/** PROTOTYPES **/
+
+void set_clock(struct GameInfo *gameinfo, int type, int speed);
+void wait_clock(struct GameInfo *gameinfo, int wait);
+struct timerequest *open_eclock(void);
+void close_eclock(struct timerequest *timerio);
+
+/* jl_phases.c */
+extern void begin_phase(struct GameInfo *gameinfo, int phase);
+extern void end_phase(struct GameInfo *gameinfo, int phase);
+
+/* jl_account.c */
+extern void account_frame(void);
+
+
+/** GLOBAL VARIABLES **/
+
+/* timer.device, for ReadEClock(), see open_eclock() */
+struct Device *TimerBase;
+
+
+/*-----------------------------------------------------------------------*/
+
+
+/*
+** set_clock()
+**
+** Set the clock the game is played to: CLOCK_REAL, CLOCK_SCALED at speed
+** times real time, or CLOCK_INSTANT.  Game time is started again at 0.
+*/
+void set_clock(struct GameInfo *gameinfo, int type, int speed)
+{
+   if ((type == CLOCK_SCALED) && (speed <= 1))
+   {
+      type = CLOCK_REAL;
+   }
+
+   gameinfo->clock_type = type;
+   gameinfo->clock_speed = (type == CLOCK_SCALED) ? speed : 1;
+   gameinfo->clock_frames = 0;
+   gameinfo->clock_owed = 0L;
+   gameinfo->clock_ticks = 0L;
+}
+
+
+/*
+** wait_clock()
+**
+** Wait for what step_game() returned (WAIT_TOF, WAIT_DELAY or WAIT_PORT)
+** as the game's clock would.  Game time goes on by a tick for each frame
+** and by the length of each delay whatever the clock.
+*/
+void wait_clock(struct GameInfo *gameinfo, int wait)
+{
+   LONG ticks;
+
+   switch (wait)
+   {
+      case WAIT_TOF:
+         gameinfo->clock_ticks++;
+         account_frame();
+
+         if (gameinfo->clock_type == CLOCK_REAL)
+         {
+            begin_phase(gameinfo, PHASE_WAIT);
+            WaitTOF();
+            end_phase(gameinfo, PHASE_WAIT);
+         }
+         else if (gameinfo->clock_type == CLOCK_SCALED)
+         {
+            if (++gameinfo->clock_frames >= gameinfo->clock_speed)
+            {
+               gameinfo->clock_frames = 0;
+               begin_phase(gameinfo, PHASE_WAIT);
+               WaitTOF();
+               end_phase(gameinfo, PHASE_WAIT);
+            }
+         }
+         break;
+      case WAIT_DELAY:
+         gameinfo->clock_ticks += gameinfo->delay;
+
+         if (gameinfo->clock_type == CLOCK_REAL)
+         {
+            Delay(gameinfo->delay);
+         }
+         else if (gameinfo->clock_type == CLOCK_SCALED)
+         {
+            /* carry what is too short to wait for over to the next delay */
+            gameinfo->clock_owed += gameinfo->delay;
+            ticks = gameinfo->clock_owed / gameinfo->clock_speed;
+            gameinfo->clock_owed -= ticks * gameinfo->clock_speed;
+
+            if (ticks > 0)
+            {
+               Delay(ticks);
+            }
+         }
+         break;
+      case WAIT_PORT:
+         WaitPort(gameinfo->port);
+         break;
+   }
+}
+
+
+/*
+** open_eclock()
+**
+** Open timer.device, so that the E clock can be read with ReadEClock().
+** Use close_eclock() to close it.
+**
+** RETURNS:  Address of the timerequest it was opened with if successful,
+**           NULL if unsuccessful.
+*/
+struct timerequest *open_eclock(void)
+{
+   struct MsgPort *port;
+   struct timerequest *timerio;
+
+   if (port = CreatePort(NULL, NULL))
+   {
+      if (timerio = (struct timerequest *)CreateExtIO(port,
+            sizeof(struct timerequest)))
+      {
+         if (!OpenDevice(TIMERNAME, UNIT_ECLOCK, (struct IORequest *)timerio,
+               NULL))
+         {
+            TimerBase = timerio->tr_node.io_Device;
+            return timerio;
+         }
+         else
+         {
+            printf("Could not open timer.device\n");
+         }
+         DeleteExtIO((struct IORequest *)timerio);
+      }
+      else
+      {
+         printf("Could not create I/O request for timer.device\n");
+      }
+      DeletePort(port);
+   }
+   else
+   {
+      printf("Could not create message port for timer.device\n");
+   }
+   return NULL;
+}
+
+
+/*
+** close_eclock()
+**
+** Close timer.device as opened by open_eclock().
+*/
+void close_eclock(struct timerequest *timerio)
+{
+   struct MsgPort *port;
+
+   port = timerio->tr_node.io_Message.mn_ReplyPort;
+
+   CloseDevice((struct IORequest *)timerio);
+   DeleteExtIO((struct IORequest *)timerio);
+   DeletePort(port);
+}
@@ -0,0 +1,387 @@
+/*
+** jl_env.c - many games played side by side, for learning to fly
+**
+** (c)1993 Paul Grebenc
+**
+** An Environment holds any number of games flown by step_probe(), and so
+** by the rules of the game itself, without windows.  reset_env() starts
+** every game and step_env() flies every game one frame with the thrusters
+** given for it, writing what each game looks like now, the points it
+** scored and whether it ended straight into the caller's arrays, which
+** are handed over once by open_env().  Nothing is allocated after that.
+**
+** A game goes as in jupitergame.c: flight after flight, each starting at
+** the top of the far view, until the probe is out of fuel.  A landing
+** scores what do_landed() gives (points times the pad's bonus) and tallies
+** a little fuel back as do_tally() does.  A crash costs ENV_CRASH_FUEL of
+** fuel, as do_crash_sound() takes, and that is also its reward, as a
+** loss.  Leaving the sky costs nothing but the flight.  A game that ends
+** is started again at once, so its observation is the start of the next
+** game, with done set.
+**
+** render_env() draws each game as a small occupancy image instead, for
+** agents that learn from pixels: its view's land and pad and the probe,
+** at whatever size is asked for, straight from the collision masks (see
+** mark_view() in jl_physics.c).  The land and pad of a view are drawn
+** once a call, into the image of the first game showing it, and copied
+** to the images of the rest.
+**
+** Where each flight starts, x_pos and x_vel, is drawn from a random
+** number sequence of each game's own, so that games can be seeded apart
+** or alike with seed_env().
+**
+** Trainers link it as the tools do, with jupitergame.c and the rest but
+** not jupitermain.c, whose screen queries the host layer answers:
+**    cc -std=gnu99 -O2 -pthread -o trainer trainer.c jupitergame.c jl_*.c -lm
+** and must call decompress_images() before open_env().
+*/
+
+
+/** INCLUDES & DEFINES **/
+
+#include "jupiterdefs.h"
+
+/* where the view is drawn, for step_probe() */
+#define TITLE_HEIGHT    (11)
+
+/* where flights start, between these x_pos and up to this x_vel either
+** way, at the y_pos of the physics
+*/
+#define START_LOW       (10.0)
+#define START_HIGH      (230.0)
+#define START_X_VEL     (1.0)
+
+#define FULL_FUEL       (219.0)
+
+#define PADS            (3)
+
+
+/** PROTOTYPES **/
+
+struct Environment *open_env(LONG games, struct PhysicsInfo *physics,
+   float *observations, float *rewards, UBYTE *dones);
+void close_env(struct Environment *env);
+void seed_env(struct Environment *env, ULONG seed);
+void reset_env(struct Environment *env);
+void step_env(struct Environment *env, UBYTE *actions);
+void render_env(struct Environment *env, UBYTE *images, int width,
+   int height);
+
+static void start_game(struct Environment *env, struct EnvGame *game);
+static void start_flight(struct Environment *env, struct EnvGame *game);
+static void observe(struct EnvGame *game, float *observation);
+static float next_random(ULONG *seed);
+
+/* jl_physics.c */
+extern int step_probe(struct PhysicsInfo *physics, struct ProbeInfo *probeinfo,
+   int view, int top, int *score);
+extern void place_probe(struct ProbeInfo *probeinfo, int view, int top,
+   WORD *x, WORD *y);
+extern void mark_view(int view, UBYTE *image, int width, int height);
+extern void mark_probe(int view, int top, int x, int y, UBYTE *image,
+   int width, int height);
+
+
+/** GLOBAL VARIABLES **/
+
+/* x_pos and y_pos of the probe standing on the middle of each pad */
+static float pad_x[PADS] = { 65.0, 140.5, 190.5 };
+static float pad_y[PADS] = {
+   90.0 + (118 - 42) / 2.0, 10.0 + (75 - 42) / 2.0, 90.0 + (134 - 42) / 2.0
+};
+
+
+/*-----------------------------------------------------------------------*/
+
+
+/*
+** open_env()
+**
+** Make an Environment of games flown by physics (copied), which writes
+** into observations (games * ENV_OBSERVATION floats), rewards and dones
+** (games each), all the caller's.  The games are seeded 1 to games; call
+** reset_env() to start them.  Use close_env() to free it.
+**
+** RETURNS:  Address of the Environment if successful, NULL if unsuccessful.
+*/
+struct Environment *open_env(LONG games, struct PhysicsInfo *physics,
+   float *observations, float *rewards, UBYTE *dones)
+{
+   struct Environment *env;
+
+   if (env = (struct Environment *)AllocMem(sizeof(struct Environment),
+         MEMF_PUBLIC | MEMF_CLEAR))
+   {
+      if (env->game = (struct EnvGame *)AllocMem(games * sizeof(struct EnvGame),
+            MEMF_PUBLIC | MEMF_CLEAR))
+      {
+         env->physics = *physics;
+         env->games = games;
+         env->observations = observations;
+         env->rewards = rewards;
+         env->dones = dones;
+
+         seed_env(env, 0);
+         return env;
+      }
+      FreeMem(env, sizeof(struct Environment));
+   }
+   return NULL;
+}
+
+
+/*
+** close_env()
+**
+** Free an Environment made by open_env().  The caller's arrays are left
+** alone.
+*/
+void close_env(struct Environment *env)
+{
+   FreeMem(env->game, env->games * sizeof(struct EnvGame));
+   FreeMem(env, sizeof(struct Environment));
+}
+
+
+/*
+** seed_env()
+**
+** Seed the games seed+1 to seed+games, so that where their flights start
+** can be played again.  Takes effect from the next flight each starts.
+*/
+void seed_env(struct Environment *env, ULONG seed)
+{
+   LONG n;
+
+   for (n=0; n < env->games; n++)
+   {
+      env->game[n].seed = seed + n + 1;
+   }
+}
+
+
+/*
+** reset_env()
+**
+** Start every game afresh, writing their observations, and clearing
+** their rewards and dones.
+*/
+void reset_env(struct Environment *env)
+{
+   LONG n;
+
+   for (n=0; n < env->games; n++)
+   {
+      start_game(env, &env->game[n]);
+      observe(&env->game[n], &env->observations[n * ENV_OBSERVATION]);
+      env->rewards[n] = 0.0;
+      env->dones[n] = FALSE;
+   }
+}
+
+
+/*
+** step_env()
+**
+** Fly every game one frame holding actions[n] (CURSOR_* bits) in game n,
+** and write what came of it: each game's observation, the points it
+** scored or lost, and whether it is over (in which case it has been
+** started again).
+*/
+void step_env(struct Environment *env, UBYTE *actions)
+{
+   struct EnvGame *game;
+   float *reward;
+   int result, points, count;
+
+   for (game=env->game, reward=env->rewards; game < &env->game[env->games];
+      game++, reward++)
+   {
+      *reward = 0.0;
+
+      game->probeinfo.user_input = actions[game - env->game];
+      result = step_probe(&env->physics, &game->probeinfo, game->view,
+         TITLE_HEIGHT, &points);
+
+      switch (result)
+      {
+         case OK:
+               break;
+         case LANDED:
+               *reward = points;
+
+               /* a quarter of fuel for every ten points, see do_tally() */
+               for (count=10; count <= points; count+=10)
+               {
+                  if (game->probeinfo.fuel < FULL_FUEL)
+                  {
+                     game->probeinfo.fuel+=0.25;
+                  }
+               }
+               break;
+         case CRASHED:
+               *reward = -ENV_CRASH_FUEL;
+               game->probeinfo.fuel-=ENV_CRASH_FUEL;
+               break;
+         case OUT_OF_SKY:
+               break;
+         default:
+               game->view = result;
+               break;
+      }
+
+      /* the next flight, unless do_game_setup() would find the probe out
+      ** of fuel and end the game
+      */
+      env->dones[game - env->game] = FALSE;
+      if ((result == LANDED) || (result == CRASHED) || (result == OUT_OF_SKY))
+      {
+         if (game->probeinfo.fuel <= 0.0)
+         {
+            env->dones[game - env->game] = TRUE;
+            start_game(env, game);
+         }
+         else
+         {
+            start_flight(env, game);
+         }
+      }
+
+      observe(game, &env->observations[(game - env->game) * ENV_OBSERVATION]);
+   }
+}
+
+
+/*
+** render_env()
+**
+** Draw every game into images, width by height cells each one after
+** another, as an occupancy image of its view (ENV_EMPTY, ENV_LAND,
+** ENV_PAD or ENV_PROBE in each cell).
+*/
+void render_env(struct Environment *env, UBYTE *images, int width,
+   int height)
+{
+   UBYTE *drawn[4];
+   UBYTE *image;
+   LONG n, size;
+   WORD x, y;
+   int view;
+
+   size = width * height;
+
+   for (view=0; view < 4; view++)
+   {
+      drawn[view] = NULL;
+   }
+
+   /* the land and pad of each view, drawn once */
+   for (n=0, image=images; n < env->games; n++, image+=size)
+   {
+      view = env->game[n].view - GO_FAR;
+      if (drawn[view] == NULL)
+      {
+         mark_view(env->game[n].view, image, width, height);
+         drawn[view] = image;
+      }
+      else
+      {
+         memcpy(image, drawn[view], size);
+      }
+   }
+
+   for (n=0, image=images; n < env->games; n++, image+=size)
+   {
+      place_probe(&env->game[n].probeinfo, env->game[n].view, TITLE_HEIGHT,
+         &x, &y);
+      mark_probe(env->game[n].view, TITLE_HEIGHT, x, y, image, width, height);
+   }
+}
+
+
+/*
+** start_game()
+**
+** Fill the tank and start the first flight of a game.
+*/
+static void start_game(struct Environment *env, struct EnvGame *game)
+{
+   game->probeinfo.fuel = FULL_FUEL;
+   start_flight(env, game);
+}
+
+
+/*
+** start_flight()
+**
+** Start the probe of a game at the top of the far view, somewhere new.
+*/
+static void start_flight(struct Environment *env, struct EnvGame *game)
+{
+   game->probeinfo.x_pos = START_LOW +
+      (START_HIGH - START_LOW) * next_random(&game->seed);
+   game->probeinfo.y_pos = env->physics.y_pos;
+   game->probeinfo.x_vel = START_X_VEL * (2.0 * next_random(&game->seed) - 1.0);
+   game->probeinfo.y_vel = 0.0;
+   game->probeinfo.user_input = 0;
+   game->view = GO_FAR;
+}
+
+
+/*
+** observe()
+**
+** Write what a game looks like into observation (ENV_OBSERVATION floats).
+** In a pad view the pad is the one in view, in the far view the nearest.
+*/
+static void observe(struct EnvGame *game, float *observation)
+{
+   float x, y, best_x, best_y;
+   int pad;
+
+   if (game->view == GO_FAR)
+   {
+      best_x = pad_x[0] - game->probeinfo.x_pos;
+      best_y = pad_y[0] - game->probeinfo.y_pos;
+      for (pad=1; pad < PADS; pad++)
+      {
+         x = pad_x[pad] - game->probeinfo.x_pos;
+         y = pad_y[pad] - game->probeinfo.y_pos;
+         if (x*x + y*y < best_x*best_x + best_y*best_y)
+         {
+            best_x = x;
+            best_y = y;
+         }
+      }
+   }
+   else
+   {
+      best_x = pad_x[game->view - GO_PAD_A] - game->probeinfo.x_pos;
+      best_y = pad_y[game->view - GO_PAD_A] - game->probeinfo.y_pos;
+   }
+
+   observation[0] = game->probeinfo.x_pos;
+   observation[1] = game->probeinfo.y_pos;
+   observation[2] = game->probeinfo.x_vel;
+   observation[3] = game->probeinfo.y_vel;
+   observation[4] = game->probeinfo.fuel;
+   observation[5] = game->view - GO_FAR;
+   observation[6] = best_x;
+   observation[7] = best_y;
+}
+
+
+/*
+** next_random()
+**
+** Step a game's own random number sequence (a 32 bit linear congruential
+** one, the same on every machine).
+**
+** RETURNS:  A number from 0 up to but not including 1.
+*/
+static float next_random(ULONG *seed)
+{
+   *seed = *seed * 1664525UL + 1013904223UL;
+
+   return (*seed >> 8) / 16777216.0;
+}
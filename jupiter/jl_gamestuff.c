@@ -12,9 +12,10 @@
 
 /** PROTOTYPES **/
 
-void update_velocity_scale(struct ProbeInfo *probeinfo);
-void update_fuel_bar(struct ProbeInfo *probeinfo);
-void update_score(LONG *score, LONG *hiscore);
+void update_velocity_scale(struct GameInfo *gameinfo,
+   struct ProbeInfo *probeinfo);
+void update_fuel_bar(struct GameInfo *gameinfo, struct ProbeInfo *probeinfo);
+void update_score(struct GameInfo *gameinfo);
 
 
 /** GLOBAL VARIABLES **/
@@ -22,10 +23,6 @@ void update_score(LONG *score, LONG *hiscore);
 extern struct Library *IntuitionBase;
 extern struct Library *GfxBase;
 
-extern struct Window *window;
-
-extern int title_height;
-
 /*-----------------------------------------------------------------------*/
 
 
@@ -35,36 +32,35 @@ extern int title_height;
 ** Move line on the vertical velocity scale at the right on the game
 ** window if velocity has changed.
 */
-void update_velocity_scale(struct ProbeInfo *probeinfo)
+void update_velocity_scale(struct GameInfo *gameinfo,
+   struct ProbeInfo *probeinfo)
 {
-   static int old_scale_pos = 0;
-   static LONG old_color = BLUE;
    int new_scale_pos;
    
    /* y-coord of pos on the scale = 89+title_height+((y_vel/2.0)*80.0) */
-   new_scale_pos = 89+title_height + (probeinfo->y_vel * 40.0);
+   new_scale_pos = 89+gameinfo->title_height + (probeinfo->y_vel * 40.0);
    
-   if (new_scale_pos != old_scale_pos)
+   if (new_scale_pos != gameinfo->old_scale_pos)
    {
-      SetDrMd(window->RPort, JAM1);
+      SetDrMd(gameinfo->window->RPort, JAM1);
       
       /* erase old line */
-      SetAPen(window->RPort, old_color);
-      Move(window->RPort, 295, old_scale_pos);
-      Draw(window->RPort, 309, old_scale_pos);
+      SetAPen(gameinfo->window->RPort, gameinfo->old_color);
+      Move(gameinfo->window->RPort, 295, gameinfo->old_scale_pos);
+      Draw(gameinfo->window->RPort, 309, gameinfo->old_scale_pos);
       /* */
       
       /* store the color below the new position of the line */
-      old_color = ReadPixel(window->RPort, 295, new_scale_pos);
+      gameinfo->old_color = ReadPixel(gameinfo->window->RPort, 295, new_scale_pos);
       
       /* draw new line */
-      SetAPen(window->RPort, BLACK);
-      Move(window->RPort, 295, new_scale_pos);
-      Draw(window->RPort, 309, new_scale_pos);
+      SetAPen(gameinfo->window->RPort, BLACK);
+      Move(gameinfo->window->RPort, 295, new_scale_pos);
+      Draw(gameinfo->window->RPort, 309, new_scale_pos);
       /* */
       
       /* store position of the new line */
-      old_scale_pos = new_scale_pos;
+      gameinfo->old_scale_pos = new_scale_pos;
    }
 }
 
@@ -75,16 +71,15 @@ void update_velocity_scale(struct ProbeInfo *probeinfo)
 ** Update the length of the fuel bar by lengthening or shortening the blue
 ** rectangle based on remaining amount of fuel.
 */
-void update_fuel_bar(struct ProbeInfo *probeinfo)
+void update_fuel_bar(struct GameInfo *gameinfo, struct ProbeInfo *probeinfo)
 {
-   static int old_fuel = 219;
    int new_fuel;
    
    new_fuel = (int)probeinfo->fuel;
    
-   if (old_fuel > new_fuel)   /* fuel level has been lowered */
+   if (gameinfo->old_fuel > new_fuel)   /* fuel level has been lowered */
    {
-      SetDrMd(window->RPort, JAM1);
+      SetDrMd(gameinfo->window->RPort, JAM1);
       
       /* check if probe is out of fuel */
       if (new_fuel <= 0)
@@ -92,44 +87,48 @@ void update_fuel_bar(struct ProbeInfo *probeinfo)
          new_fuel = 0;
          
          /* erase whatever was left of the fuel bar */
-         SetAPen(window->RPort, BLACK);
-         RectFill(window->RPort, 60, 178+title_height, 279, 185+title_height);
+         SetAPen(gameinfo->window->RPort, BLACK);
+         RectFill(gameinfo->window->RPort, 60, 178+gameinfo->title_height, 279,
+            185+gameinfo->title_height);
          /* */
          
          /* print "OUT OF FUEL" */
-         SetAPen(window->RPort, BLUE);
-         Move(window->RPort, 126, 185+title_height);
-         Text(window->RPort, "OUT OF FUEL", 11);
+         SetAPen(gameinfo->window->RPort, BLUE);
+         Move(gameinfo->window->RPort, 126, 185+gameinfo->title_height);
+         Text(gameinfo->window->RPort, "OUT OF FUEL", 11);
          /* */
       }
       /* there's still some fuel */
       else
       {
-         SetAPen(window->RPort, BLACK);
-         RectFill(window->RPort, 60+new_fuel, 178+title_height, 60+old_fuel, 185+title_height);
+         SetAPen(gameinfo->window->RPort, BLACK);
+         RectFill(gameinfo->window->RPort, 60+new_fuel,
+            178+gameinfo->title_height, 60+gameinfo->old_fuel, 185+gameinfo->title_height);
       }
       /* */
       
-      old_fuel = new_fuel;
+      gameinfo->old_fuel = new_fuel;
    }
    else
    {
-      if (old_fuel < new_fuel)   /* fuel level has been raised */
+      if (gameinfo->old_fuel < new_fuel)   /* fuel level has been raised */
       {
-         SetDrMd(window->RPort, JAM1);
+         SetDrMd(gameinfo->window->RPort, JAM1);
          
          /* check if probe was previously out of fuel */
-         if (old_fuel == 0)
+         if (gameinfo->old_fuel == 0)
          {
-            SetAPen(window->RPort, BLACK);
-            RectFill(window->RPort, 60, 178+title_height, 279, 185+title_height);
+            SetAPen(gameinfo->window->RPort, BLACK);
+            RectFill(gameinfo->window->RPort, 60, 178+gameinfo->title_height,
+               279, 185+gameinfo->title_height);
          }
          /* */
          
-         SetAPen(window->RPort, BLUE);
-         RectFill(window->RPort, 60+old_fuel, 178+title_height, 60+new_fuel, 185+title_height);
+         SetAPen(gameinfo->window->RPort, BLUE);
+         RectFill(gameinfo->window->RPort, 60+gameinfo->old_fuel,
+            178+gameinfo->title_height, 60+new_fuel, 185+gameinfo->title_height);
          
-         old_fuel = new_fuel;
+         gameinfo->old_fuel = new_fuel;
       }
    }
 }
@@ -141,7 +140,7 @@ void update_fuel_bar(struct ProbeInfo *probeinfo)
 ** Update the current score, and also update the hi score if necessary.
 ** Take care of the score counters looping back to 00000 after 99999.
 */
-void update_score(LONG *score, LONG *hiscore)
+void update_score(struct GameInfo *gameinfo)
 {
    char s[13];    /* dest. in LONG->ASCII conversion */
    char output[16];  /* final output string */
@@ -150,18 +149,18 @@ void update_score(LONG *score, LONG *hiscore)
    
    
    /* loop score counters if necessary */
-   if (*score > *hiscore)
+   if (gameinfo->score > gameinfo->hiscore)
    {
-      if (*score > 99999)
+      if (gameinfo->score > 99999)
       {
-         *score-=100000;
+         gameinfo->score-=100000;
       }
-      *hiscore = *score;
+      gameinfo->hiscore = gameinfo->score;
    }
    /* */
    
    /* setup string to be printed */
-   n = stcl_d(s,*score);
+   n = stcl_d(s,gameinfo->score);
    
    for (x=0; x < (5-n); x++)
    {
@@ -172,19 +171,19 @@ void update_score(LONG *score, LONG *hiscore)
    /* */
    
    /* print score */
-   SetDrMd(window->RPort, JAM2);
-   SetAPen(window->RPort, WHITE);
-   SetBPen(window->RPort, BLACK);
+   SetDrMd(gameinfo->window->RPort, JAM2);
+   SetAPen(gameinfo->window->RPort, WHITE);
+   SetBPen(gameinfo->window->RPort, BLACK);
    
-   Move(window->RPort, 66, 176+title_height);
-   Text(window->RPort, output, 5);
+   Move(gameinfo->window->RPort, 66, 176+gameinfo->title_height);
+   Text(gameinfo->window->RPort, output, 5);
    /*
    
    /* check for new hiscore and print if new */
-   if (*score == *hiscore)
+   if (gameinfo->score == gameinfo->hiscore)
    {
-      Move(window->RPort, 212, 176+title_height);
-      Text(window->RPort, output, 5);
+      Move(gameinfo->window->RPort, 212, 176+gameinfo->title_height);
+      Text(gameinfo->window->RPort, output, 5);
    }
    /* */
 }
@@ -14,179 +14,514 @@
 
 extern int get_workbench_depth(void);
 
-int setup_gels(void);
-void cleanup_gels(void);
-struct Bob *create_bob(NEWBOB *nBob);
+int setup_gels(struct GameInfo *gameinfo);
+void cleanup_gels(struct GameInfo *gameinfo);
+struct Bob *create_bob(struct GameInfo *gameinfo, NEWBOB *nBob);
 void free_bob(struct Bob *bob);
-void redraw_bobs(void);
+void redraw_bobs(struct GameInfo *gameinfo);
+int reserve_gels(struct GameInfo *gameinfo, WORD width, WORD height, int count);
+void release_gels(struct GameInfo *gameinfo);
+void renew_gels(struct GameInfo *gameinfo);
+
+static struct GelsInfo *alloc_gels(void);
+static void clear_gels(struct GelsInfo *gInfo);
+static void free_gels(struct GelsInfo *gInfo);
+static struct Bob *alloc_bob(WORD width, WORD height);
+static void dispose_bob(struct Bob *bob);
+
+/* jl_account.c */
+extern APTR alloc_mem(int owner, ULONG size, ULONG flags);
+extern void free_mem(int owner, APTR memory, ULONG size);
+extern BOOL arm_guard(BOOL arm);
+
+/* jl_trace.c */
+extern void trace_begin(struct GameInfo *gameinfo, char *name);
+extern void trace_end(struct GameInfo *gameinfo, char *name);
 
 /** GLOBAL VARIABLES **/
 
 extern struct Library *IntuitionBase;
 extern struct Library *GfxBase;
 
-extern struct Window *window;
-
 /*-----------------------------------------------------------------------*/
 
 
 /*
 ** setup_gels()
 **
-** Set up the GELS system for use in game.
+** Set up the GELS system for use in game.  The GelsInfo kept by
+** cleanup_gels(), if any, is used again.
 **
 ** RETURNS:  TRUE if successful, FALSE if unsuccessful.
 */
-int setup_gels()
+int setup_gels(struct GameInfo *gameinfo)
+{
+   struct GelsInfo *gInfo;
+   
+   trace_begin(gameinfo, "setup_gels");
+   
+   if (NULL != (gInfo = gameinfo->spare_gels))
+   {
+      gameinfo->spare_gels = NULL;
+      clear_gels(gInfo);
+   }
+   else
+   {
+      gInfo = alloc_gels();
+   }
+   
+   if (gInfo != NULL)
+   {
+      gInfo->sprRsrvd = 0x00;
+      gameinfo->window->RPort->GelsInfo = gInfo;
+      InitGels(gInfo->gelHead, gInfo->gelTail, gInfo);
+      
+      trace_end(gameinfo, "setup_gels");
+      return TRUE;
+   }
+   
+   trace_end(gameinfo, "setup_gels");
+   return FALSE;
+}
+
+
+/*
+** cleanup_gels()
+**
+** Clean up the GELS system.  While gameinfo->reserve_gels is TRUE the
+** GelsInfo is kept for the next setup_gels() instead of being freed.
+*/
+void cleanup_gels(struct GameInfo *gameinfo)
+{
+   struct GelsInfo *gInfo;
+   
+   gInfo = gameinfo->window->RPort->GelsInfo;
+   
+   gameinfo->window->RPort->GelsInfo = NULL;
+   if (gameinfo->reserve_gels && (gameinfo->spare_gels == NULL))
+   {
+      gameinfo->spare_gels = gInfo;
+   }
+   else
+   {
+      free_gels(gInfo);
+   }
+}
+
+
+/*
+** reserve_gels()
+**
+** Make a GelsInfo and count Bobs width words by height lines ahead of
+** time, and from now on keep what cleanup_gels() and free_bob() free for
+** setup_gels() and create_bob() to use again, so that a game whose every
+** Bob has been reserved allocates nothing once it is under way.  May be
+** called for each size of Bob.  Undone by release_gels().
+**
+** RETURNS:  TRUE if successful, FALSE if unsuccessful.
+*/
+int reserve_gels(struct GameInfo *gameinfo, WORD width, WORD height, int count)
+{
+   struct Bob *bob;
+   
+   gameinfo->reserve_gels = TRUE;
+   
+   if (gameinfo->spare_gels == NULL)
+   {
+      if (NULL == (gameinfo->spare_gels = alloc_gels()))
+      {
+         return FALSE;
+      }
+   }
+   
+   while (count-- > 0)
+   {
+      if (gameinfo->spares == SPARE_BOBS)
+      {
+         printf("Could not reserve more than %d Bobs\n", SPARE_BOBS);
+         return FALSE;
+      }
+      if (NULL == (bob = alloc_bob(width, height)))
+      {
+         return FALSE;
+      }
+      gameinfo->spare_bobs[gameinfo->spares++] = bob;
+   }
+   
+   return TRUE;
+}
+
+
+/*
+** release_gels()
+**
+** Free the GelsInfo and Bobs kept for reuse and stop keeping them.
+*/
+void release_gels(struct GameInfo *gameinfo)
+{
+   gameinfo->reserve_gels = FALSE;
+   
+   while (gameinfo->spares > 0)
+   {
+      dispose_bob(gameinfo->spare_bobs[--gameinfo->spares]);
+   }
+   
+   if (gameinfo->spare_gels != NULL)
+   {
+      free_gels(gameinfo->spare_gels);
+      gameinfo->spare_gels = NULL;
+   }
+}
+
+
+/*
+** create_bob()
+**
+** Create a Bob from the information given in nBob, belonging to the game
+** in gameinfo (its VSprite's VUserExt points there for the collision
+** routines).  A Bob of the same size kept for reuse is taken if there is
+** one, and made over as though new.
+** Use free_bob() to free this GEL.
+**
+** RETURNS:  Address of resulting Bob structure if successful,
+**           NULL if unsuccessful.
+*/
+struct Bob *create_bob(struct GameInfo *gameinfo, NEWBOB *nBob)
+{
+   struct Bob *bob;
+   struct VSprite *vsprite;
+   WORD *save_buffer;
+   WORD *border_line;
+   WORD *image_shadow;
+   BUserStuff depth;
+   BOOL armed;
+   int n;
+   
+   trace_begin(gameinfo, "create_bob");
+   
+   bob = NULL;
+   for (n=0; n < gameinfo->spares; n++)
+   {
+      vsprite = gameinfo->spare_bobs[n]->BobVSprite;
+      if ((vsprite->Width == nBob->nb_WordWidth) &&
+         (vsprite->Height == nBob->nb_LineHeight))
+      {
+         bob = gameinfo->spare_bobs[n];
+         gameinfo->spare_bobs[n] = gameinfo->spare_bobs[--gameinfo->spares];
+         break;
+      }
+   }
+   
+   /* a spare whose save buffer was made for another depth of the
+   ** Workbench screen is made again, even in a guarded game: it is the
+   ** screen that has changed, not what the game needs
+   */
+   if ((bob != NULL) && (bob->BUserExt != get_workbench_depth()))
+   {
+      dispose_bob(bob);
+      armed = arm_guard(FALSE);
+      bob = alloc_bob(nBob->nb_WordWidth, nBob->nb_LineHeight);
+      arm_guard(armed);
+   }
+   else if (bob == NULL)
+   {
+      bob = alloc_bob(nBob->nb_WordWidth, nBob->nb_LineHeight);
+   }
+   
+   if (bob != NULL)
+   {
+      /* start from cleared structures, as a new Bob would */
+      vsprite = bob->BobVSprite;
+      save_buffer = bob->SaveBuffer;
+      border_line = vsprite->BorderLine;
+      image_shadow = bob->ImageShadow;
+      depth = bob->BUserExt;
+      
+      memset(bob, 0, sizeof(struct Bob));
+      memset(vsprite, 0, sizeof(struct VSprite));
+      /* */
+      
+      vsprite->Y = nBob->nb_Y;
+      vsprite->X = nBob->nb_X;
+      vsprite->Flags = nBob->nb_BFlags;
+      vsprite->Width = nBob->nb_WordWidth;
+      vsprite->Depth = nBob->nb_ImageDepth;
+      vsprite->Height = nBob->nb_LineHeight;
+      vsprite->MeMask = nBob->nb_MeMask;
+      vsprite->HitMask = nBob->nb_HitMask;
+      vsprite->ImageData = nBob->nb_Image;
+      vsprite->BorderLine = border_line;
+      vsprite->CollMask = image_shadow;
+      vsprite->SprColors = NULL;
+      
+      InitMasks(vsprite);
+      
+      vsprite->PlanePick = nBob->nb_PlanePick;
+      vsprite->PlaneOnOff = 0x00;
+      vsprite->VSBob = bob;
+      vsprite->VUserExt = (APTR)gameinfo;
+      
+      bob->BobVSprite = vsprite;
+      bob->SaveBuffer = save_buffer;
+      bob->ImageShadow = image_shadow;
+      bob->BUserExt = depth;
+      bob->Flags = NULL;
+      bob->Before = NULL;
+      bob->After = NULL;
+      bob->BobComp = NULL;
+      bob->DBuffer = NULL;
+
+      if (nBob->nb_CollMask != NULL)
+      {
+         vsprite->CollMask = nBob->nb_CollMask;
+      }
+   }
+   
+   trace_end(gameinfo, "create_bob");
+   return bob;
+}
+
+
+/*
+** free_bob()
+**
+** Free the Bob created by create_bob(), or keep it for reuse if its game
+** is reserving them (see reserve_gels()), even if the depth of the
+** Workbench screen has changed since it was made (create_bob() makes such
+** a Bob again before it is used).  The Bob must be off the gels
+** list, not just RemBob()'d, if it may be used again before the next
+** setup_gels().
+*/
+void free_bob(struct Bob *bob)
+{
+   struct GameInfo *gameinfo;
+   
+   gameinfo = (struct GameInfo *)bob->BobVSprite->VUserExt;
+   
+   if (gameinfo->reserve_gels && (gameinfo->spares < SPARE_BOBS))
+   {
+      gameinfo->spare_bobs[gameinfo->spares++] = bob;
+   }
+   else
+   {
+      dispose_bob(bob);
+   }
+}
+
+
+/*
+** renew_gels()
+**
+** Make again, for the depth of the Workbench screen there is now, every
+** Bob kept for reuse that was made for another.  For after the screen
+** has been read again (see read_screen_info() in jupitermain.c), which
+** is the one time a guarded game may allocate (see arm_guard()).  A Bob
+** that cannot be made again is left to create_bob() to make.
+*/
+void renew_gels(struct GameInfo *gameinfo)
+{
+   struct Bob *bob;
+   BOOL armed;
+   int n;
+   
+   armed = arm_guard(FALSE);
+   for (n=0; n < gameinfo->spares; )
+   {
+      bob = gameinfo->spare_bobs[n];
+      if (bob->BUserExt == get_workbench_depth())
+      {
+         n++;
+         continue;
+      }
+      
+      gameinfo->spare_bobs[n] = alloc_bob(bob->BobVSprite->Width,
+                                    bob->BobVSprite->Height);
+      dispose_bob(bob);
+      if (gameinfo->spare_bobs[n] == NULL)
+      {
+         gameinfo->spare_bobs[n] = gameinfo->spare_bobs[--gameinfo->spares];
+      }
+      else
+      {
+         n++;
+      }
+   }
+   arm_guard(armed);
+}
+
+
+/*
+** redraw_bobs()
+**
+** Redraws bobs in the window.  For use after their x and y coordinates
+** have been changed to move bobs to their new positions.
+** The caller waits for the next frame (WAIT_TOF) before going on.
+*/
+void redraw_bobs(struct GameInfo *gameinfo)
+{
+   trace_begin(gameinfo, "redraw_bobs");
+   SortGList(gameinfo->window->RPort);
+   DrawGList(gameinfo->window->RPort, ViewPortAddress(gameinfo->window));
+   trace_end(gameinfo, "redraw_bobs");
+}
+
+
+/*
+** alloc_gels()
+**
+** Allocate a GelsInfo and what it points to.  Its head and tail VSprites
+** are left in gelHead and gelTail, for InitGels().
+**
+** RETURNS:  Address of the GelsInfo if successful, NULL if unsuccessful.
+*/
+static struct GelsInfo *alloc_gels()
 {
    struct GelsInfo *gInfo;
    struct VSprite *vsHead;
    struct VSprite *vsTail;
    
-   if (NULL != (gInfo = (struct GelsInfo *)AllocMem(sizeof(struct GelsInfo), MEMF_CLEAR)))
+   if (NULL != (gInfo = (struct GelsInfo *)alloc_mem(ACCOUNT_GELS, sizeof(struct GelsInfo), MEMF_CLEAR)))
    {
-      if (NULL != (gInfo->nextLine = (WORD *)AllocMem(sizeof(WORD)*8, MEMF_CLEAR)))
+      if (NULL != (gInfo->nextLine = (WORD *)alloc_mem(ACCOUNT_GELS, sizeof(WORD)*8, MEMF_CLEAR)))
       {
-         if (NULL != (gInfo->lastColor = (WORD **)AllocMem(sizeof(LONG)*8, MEMF_CLEAR)))
+         if (NULL != (gInfo->lastColor = (WORD **)alloc_mem(ACCOUNT_GELS, sizeof(LONG)*8, MEMF_CLEAR)))
          {
             if (NULL != (gInfo->collHandler = (struct collTable *)
-                  AllocMem(sizeof(struct collTable), MEMF_CLEAR)))
+                  alloc_mem(ACCOUNT_GELS, sizeof(struct collTable), MEMF_CLEAR)))
             {
                if (NULL != (vsHead = (struct VSprite *)
-                     AllocMem((LONG)sizeof(struct VSprite), MEMF_CLEAR)))
+                     alloc_mem(ACCOUNT_GELS, (LONG)sizeof(struct VSprite), MEMF_CLEAR)))
                {
                   if (NULL != (vsTail = (struct VSprite *)
-                        AllocMem((LONG)sizeof(struct VSprite), MEMF_CLEAR)))
+                        alloc_mem(ACCOUNT_GELS, (LONG)sizeof(struct VSprite), MEMF_CLEAR)))
                   {
-                     gInfo->sprRsrvd = 0x00;
-                     window->RPort->GelsInfo = gInfo;
-                     InitGels(vsHead, vsTail, gInfo);
-                     
-                     return TRUE;
+                     gInfo->gelHead = vsHead;
+                     gInfo->gelTail = vsTail;
+                     return gInfo;
                   }
                   else
                   {
                      printf("Could not allocate vsTail\n");
                   }
-                  FreeMem(vsHead,(LONG)sizeof(*vsHead));
+                  free_mem(ACCOUNT_GELS, vsHead,(LONG)sizeof(*vsHead));
                }
                else
                {
                   printf("Could not allocate vsHead\n");
                }
-               FreeMem(gInfo->collHandler,(LONG)sizeof(struct collTable));
+               free_mem(ACCOUNT_GELS, gInfo->collHandler,(LONG)sizeof(struct collTable));
             }
             else
             {
                printf("Could not allocate GelsInfo->collHandler\n");
             }
-            FreeMem(gInfo->lastColor, (LONG)sizeof(LONG)*8);
+            free_mem(ACCOUNT_GELS, gInfo->lastColor, (LONG)sizeof(LONG)*8);
          }
          else
          {
             printf("Could not allocate GelsInfo->lastColor\n");
          }
-         FreeMem(gInfo->nextLine, (LONG)sizeof(WORD)*8);
+         free_mem(ACCOUNT_GELS, gInfo->nextLine, (LONG)sizeof(WORD)*8);
       }
       else
       {
          printf("Could not allocate GelsInfo->nextLine\n");
       }
-      FreeMem(gInfo, (LONG)sizeof(struct GelsInfo));
+      free_mem(ACCOUNT_GELS, gInfo, (LONG)sizeof(struct GelsInfo));
    }
    else
    {
       printf("Could not allocate GelsInfo\n");
    }
    
-   return FALSE;
+   return NULL;
 }
 
 
 /*
-** cleanup_gels()
+** clear_gels()
 **
-** Clean up the GELS system.
+** Clear a GelsInfo made by alloc_gels() and what it points to, as they
+** were when allocated.
 */
-void cleanup_gels()
+static void clear_gels(struct GelsInfo *gInfo)
 {
-   struct GelsInfo *gInfo;
+   struct GelsInfo cleared;
    
-   gInfo = window->RPort->GelsInfo;
+   memset(gInfo->nextLine, 0, sizeof(WORD)*8);
+   memset(gInfo->lastColor, 0, sizeof(LONG)*8);
+   memset(gInfo->collHandler, 0, sizeof(struct collTable));
+   memset(gInfo->gelHead, 0, sizeof(struct VSprite));
+   memset(gInfo->gelTail, 0, sizeof(struct VSprite));
    
-   window->RPort->GelsInfo = NULL;
-   FreeMem(gInfo->collHandler, (LONG)sizeof(struct collTable));
-   FreeMem(gInfo->lastColor, (LONG)sizeof(LONG)*8);
-   FreeMem(gInfo->nextLine, (LONG)sizeof(WORD)*8);
-   FreeMem(gInfo->gelHead, (LONG)sizeof(struct VSprite));
-   FreeMem(gInfo->gelTail, (LONG)sizeof(struct VSprite));
-   FreeMem(gInfo, (LONG)sizeof(struct GelsInfo));
+   memset(&cleared, 0, sizeof(cleared));
+   cleared.nextLine = gInfo->nextLine;
+   cleared.lastColor = gInfo->lastColor;
+   cleared.collHandler = gInfo->collHandler;
+   cleared.gelHead = gInfo->gelHead;
+   cleared.gelTail = gInfo->gelTail;
+   *gInfo = cleared;
 }
 
 
 /*
-** create_bob()
+** free_gels()
 **
-** Create a Bob from the information given in nBob.
-** Use free_bob() to free this GEL.
+** Free a GelsInfo made by alloc_gels().
+*/
+static void free_gels(struct GelsInfo *gInfo)
+{
+   free_mem(ACCOUNT_GELS, gInfo->collHandler, (LONG)sizeof(struct collTable));
+   free_mem(ACCOUNT_GELS, gInfo->lastColor, (LONG)sizeof(LONG)*8);
+   free_mem(ACCOUNT_GELS, gInfo->nextLine, (LONG)sizeof(WORD)*8);
+   free_mem(ACCOUNT_GELS, gInfo->gelHead, (LONG)sizeof(struct VSprite));
+   free_mem(ACCOUNT_GELS, gInfo->gelTail, (LONG)sizeof(struct VSprite));
+   free_mem(ACCOUNT_GELS, gInfo, (LONG)sizeof(struct GelsInfo));
+}
+
+
+/*
+** alloc_bob()
 **
-** RETURNS:  Address of resulting Bob structure if successful,
-**           NULL if unsuccessful.
+** Allocate a Bob width words by height lines, with its VSprite, save
+** buffer, border line and collision mask, for create_bob() to fill in.
+** The VSprite's Width and Height and the depth the save buffer was made
+** for (in BUserExt, as the Workbench screen may change) are set, for
+** finding and freeing it.
+**
+** RETURNS:  Address of the Bob if successful, NULL if unsuccessful.
 */
-struct Bob *create_bob(NEWBOB *nBob)
+static struct Bob *alloc_bob(WORD width, WORD height)
 {
    struct Bob *bob;
    struct VSprite *vsprite;
+   int depth;
    LONG rassize;
    LONG line_size;
    LONG plane_size;
    
    /* calculate values */
-   rassize = (LONG)sizeof(UWORD) * nBob->nb_WordWidth * 
-      nBob->nb_LineHeight * (get_workbench_depth());
-   line_size = sizeof(WORD) * nBob->nb_WordWidth;
-   plane_size = line_size * nBob->nb_LineHeight;
+   depth = get_workbench_depth();
+   rassize = (LONG)sizeof(UWORD) * width * height * depth;
+   line_size = sizeof(WORD) * width;
+   plane_size = line_size * height;
    /* */
    
-   if (NULL != (bob = (struct Bob *)AllocMem((LONG)sizeof(struct Bob), MEMF_CLEAR)))
+   if (NULL != (bob = (struct Bob *)alloc_mem(ACCOUNT_GELS, (LONG)sizeof(struct Bob), MEMF_CLEAR)))
    {
-      if (NULL != (bob->SaveBuffer = (WORD *)AllocMem(rassize, MEMF_CHIP)))
+      if (NULL != (bob->SaveBuffer = (WORD *)alloc_mem(ACCOUNT_GELS, rassize, MEMF_CHIP)))
       {
-         if (NULL != (vsprite = (struct VSprite *)AllocMem((LONG)sizeof(struct VSprite), MEMF_CLEAR)))
+         if (NULL != (vsprite = (struct VSprite *)alloc_mem(ACCOUNT_GELS, (LONG)sizeof(struct VSprite), MEMF_CLEAR)))
          {
-            if (NULL != (vsprite->BorderLine = (WORD *)AllocMem(line_size, MEMF_CHIP)))
+            if (NULL != (vsprite->BorderLine = (WORD *)alloc_mem(ACCOUNT_GELS, line_size, MEMF_CHIP)))
             {
-               if(NULL != (vsprite->CollMask = (WORD *)AllocMem(plane_size, MEMF_CHIP)))
+               if(NULL != (bob->ImageShadow = (WORD *)alloc_mem(ACCOUNT_GELS, plane_size, MEMF_CHIP)))
                {
-                  vsprite->Y = nBob->nb_Y;
-                  vsprite->X = nBob->nb_X;
-                  vsprite->Flags = nBob->nb_BFlags;
-                  vsprite->Width = nBob->nb_WordWidth;
-                  vsprite->Depth = nBob->nb_ImageDepth;
-                  vsprite->Height = nBob->nb_LineHeight;
-                  vsprite->MeMask = nBob->nb_MeMask;
-                  vsprite->HitMask = nBob->nb_HitMask;
-                  vsprite->ImageData = nBob->nb_Image;
-                  vsprite->SprColors = NULL;
-                  
-                  InitMasks(vsprite);
-                  
-                  vsprite->PlanePick = nBob->nb_PlanePick;
-                  vsprite->PlaneOnOff = 0x00;
-                  vsprite->VSBob = bob;
-                  
+                  vsprite->Width = width;
+                  vsprite->Height = height;
+                  vsprite->CollMask = bob->ImageShadow;
                   bob->BobVSprite = vsprite;
-                  bob->ImageShadow = vsprite->CollMask;
-                  bob->Flags = NULL;
-                  bob->Before = NULL;
-                  bob->After = NULL;
-                  bob->BobComp = NULL;
-                  bob->DBuffer = NULL;
-
-                  if (nBob->nb_CollMask != NULL)
-                  {
-                     vsprite->CollMask = nBob->nb_CollMask;
-                  }
+                  bob->BUserExt = depth;
                   
                   return (bob);
                }
@@ -194,25 +529,25 @@ struct Bob *create_bob(NEWBOB *nBob)
                {
                   printf("Could not allocate vsprite->CollMask\n");
                }
-               FreeMem(vsprite->BorderLine, line_size);
+               free_mem(ACCOUNT_GELS, vsprite->BorderLine, line_size);
             }
             else
             {
                printf("Could not allocate vsprite->BorderLine\n");
             }
-            FreeMem(vsprite, (LONG)sizeof(struct VSprite));
+            free_mem(ACCOUNT_GELS, vsprite, (LONG)sizeof(struct VSprite));
          }
          else
          {
             printf("Could not allocate bob->SaveBuffer\n");
          }
-         FreeMem(bob->SaveBuffer, rassize);
+         free_mem(ACCOUNT_GELS, bob->SaveBuffer, rassize);
       }
       else
       {
          printf("Could not allocate bob\n");
       }
-      FreeMem(bob, (LONG)sizeof(struct Bob));
+      free_mem(ACCOUNT_GELS, bob, (LONG)sizeof(struct Bob));
    }
    
    return NULL;
@@ -220,45 +555,28 @@ struct Bob *create_bob(NEWBOB *nBob)
 
 
 /*
-** free_bob()
+** dispose_bob()
 **
-** Free the Bob created by create_bob().
+** Free a Bob made by alloc_bob().
 */
-void free_bob(struct Bob *bob)
+static void dispose_bob(struct Bob *bob)
 {
-   int rasdepth;
    LONG rassize;
    LONG line_size;
    LONG plane_size;
    
-   /* Calculate size of Bob's savebuffer. */
-   rasdepth = get_workbench_depth();
+   /* Calculate size of Bob's savebuffer, at the depth it was made for. */
    rassize = sizeof(WORD) * bob->BobVSprite->Width *
-      bob->BobVSprite->Height * (get_workbench_depth());
+      bob->BobVSprite->Height * bob->BUserExt;
    /* */
    
-   FreeMem(bob->SaveBuffer, rassize);
+   free_mem(ACCOUNT_GELS, bob->SaveBuffer, rassize);
    
    line_size = (LONG)sizeof(WORD) * bob->BobVSprite->Width;
    plane_size = line_size * bob->BobVSprite->Height;
    
-   FreeMem(bob->BobVSprite->BorderLine, line_size);
-   FreeMem(bob->ImageShadow, plane_size);
-   FreeMem(bob->BobVSprite, (LONG)sizeof(struct VSprite));
-   FreeMem(bob, (LONG)sizeof(struct Bob));
-}
-
-
-/*
-** redraw_bobs()
-**
-** Redraws bobs in the window.  For use after their x and y coordinates
-** have been changed to move bobs to their new positions.
-** Does a WaitTOF() after redrawing.
-*/
-void redraw_bobs()
-{
-   SortGList(window->RPort);
-   DrawGList(window->RPort, ViewPortAddress(window));
-   WaitTOF();
+   free_mem(ACCOUNT_GELS, bob->BobVSprite->BorderLine, line_size);
+   free_mem(ACCOUNT_GELS, bob->ImageShadow, plane_size);
+   free_mem(ACCOUNT_GELS, bob->BobVSprite, (LONG)sizeof(struct VSprite));
+   free_mem(ACCOUNT_GELS, bob, (LONG)sizeof(struct Bob));
 }
@@ -0,0 +1,334 @@
+/*
+** jl_heatmap.c - where flights end, for the Linux host
+**
+** (c)1993 Paul Grebenc
+**
+** Counts where probes crash and land in each view, where they leave the
+** top of the sky and how far from the middle of each pad they set down,
+** from the FlightInfo of each flight.  A HeatMap is a fixed block of
+** counters however many flights go into it.  Nothing in it is shared:
+** each thread of a batch keeps its own and they are added together with
+** merge_heatmap() once the threads are done, so no thread ever waits for
+** another.  write_heatmaps() draws the counts over the images of the
+** views as PPM files.
+*/
+
+
+/** INCLUDES & DEFINES **/
+
+#include <math.h>
+
+#include "jupiterdefs.h"
+
+/* size of the view images (see do_far_view()) */
+#define VIEW_WIDTH      (17*16)
+#define VIEW_HEIGHT     (179)
+
+/* drawn over the views */
+#define CRASH_RGB       (0xff2000)
+#define LANDING_RGB     (0x20ff40)
+#define EXIT_RGB        (0xffe000)
+
+/* greatest share of a pixel the background keeps under the heat */
+#define BACK_SHARE      (0.6)
+
+
+/** PROTOTYPES **/
+
+struct HeatMap *alloc_heatmap(void);
+void free_heatmap(struct HeatMap *heatmap);
+void add_flight(struct HeatMap *heatmap, struct FlightInfo *flight);
+void merge_heatmap(struct HeatMap *to, struct HeatMap *from);
+int write_heatmaps(struct HeatMap *heatmap, char *prefix);
+
+static int write_view(struct HeatMap *heatmap, int view, char *name);
+static ULONG most(ULONG *counts, LONG count);
+static double heat(ULONG count, ULONG max);
+static void blend(UBYTE *rgb, ULONG color, double amount);
+
+
+/** GLOBAL VARIABLES **/
+
+/* jl_memory.c */
+extern UWORD *farview_image;
+extern UWORD *padaview_image;
+extern UWORD *padbview_image;
+extern UWORD *padcview_image;
+
+static char *view_suffix[HEAT_VIEWS] = { "far", "pada", "padb", "padc" };
+
+
+/*-----------------------------------------------------------------------*/
+
+
+/*
+** alloc_heatmap()
+**
+** Allocate a HeatMap with every count at 0.  Use free_heatmap() to free
+** it.
+**
+** RETURNS:  Address of the HeatMap if successful, NULL if unsuccessful.
+*/
+struct HeatMap *alloc_heatmap()
+{
+   return (struct HeatMap *)AllocMem(sizeof(struct HeatMap),
+      MEMF_PUBLIC | MEMF_CLEAR);
+}
+
+
+/*
+** free_heatmap()
+**
+** Free a HeatMap allocated by alloc_heatmap().
+*/
+void free_heatmap(struct HeatMap *heatmap)
+{
+   FreeMem(heatmap, sizeof(struct HeatMap));
+}
+
+
+/*
+** add_flight()
+**
+** Count where a flight that has ended came to rest.  Flights still going
+** (or quit) are not counted.
+*/
+void add_flight(struct HeatMap *heatmap, struct FlightInfo *flight)
+{
+   int view, col, row, offset;
+
+   view = flight->view - GO_FAR;
+   col = flight->x / HEAT_CELL;
+   row = flight->y / HEAT_CELL;
+
+   if ((view < 0) || (view >= HEAT_VIEWS))
+   {
+      return;
+   }
+   col = (col < 0) ? 0 : ((col >= HEAT_COLS) ? HEAT_COLS-1 : col);
+   row = (row < 0) ? 0 : ((row >= HEAT_ROWS) ? HEAT_ROWS-1 : row);
+
+   switch (flight->result)
+   {
+      case CRASHED:
+            heatmap->crashes[view][row][col]++;
+            break;
+      case LANDED:
+            heatmap->landings[view][row][col]++;
+
+            offset = flight->pad_offset + HEAT_OFFSETS/2;
+            offset = (offset < 0) ? 0 :
+               ((offset >= HEAT_OFFSETS) ? HEAT_OFFSETS-1 : offset);
+            if (view > 0)
+            {
+               heatmap->offsets[view-1][offset]++;
+            }
+            break;
+      case OUT_OF_SKY:
+            heatmap->exits[col]++;
+            break;
+      default:
+            return;
+            break;
+   }
+
+   heatmap->flights++;
+}
+
+
+/*
+** merge_heatmap()
+**
+** Add the counts of from to those of to.
+*/
+void merge_heatmap(struct HeatMap *to, struct HeatMap *from)
+{
+   ULONG *a, *b;
+   LONG n;
+
+   /* a HeatMap is nothing but counts */
+   a = (ULONG *)to;
+   b = (ULONG *)from;
+   for (n=0; n < sizeof(struct HeatMap)/sizeof(ULONG); n++)
+   {
+      a[n] += b[n];
+   }
+}
+
+
+/*
+** write_heatmaps()
+**
+** Write the crashes and landings in each view over its image, with the
+** exits from the sky along the top of the far view, to prefix_far.ppm,
+** prefix_pada.ppm and so on, and the landing offsets on each pad to
+** prefix_offsets.csv.
+**
+** RETURNS:  TRUE if successful, FALSE if a file could not be written.
+*/
+int write_heatmaps(struct HeatMap *heatmap, char *prefix)
+{
+   FILE *file;
+   char name[256];
+   int view, offset;
+
+   for (view=0; view < HEAT_VIEWS; view++)
+   {
+      sprintf(name, "%.200s_%s.ppm", prefix, view_suffix[view]);
+      if (write_view(heatmap, view, name) == FALSE)
+      {
+         return FALSE;
+      }
+   }
+
+   sprintf(name, "%.200s_offsets.csv", prefix);
+   if (NULL == (file = fopen(name, "w")))
+   {
+      return FALSE;
+   }
+   fprintf(file, "offset,A,B,C\n");
+   for (offset=0; offset < HEAT_OFFSETS; offset++)
+   {
+      fprintf(file, "%d,%u,%u,%u\n", offset - HEAT_OFFSETS/2,
+         (unsigned int)heatmap->offsets[0][offset],
+         (unsigned int)heatmap->offsets[1][offset],
+         (unsigned int)heatmap->offsets[2][offset]);
+   }
+   fclose(file);
+
+   return TRUE;
+}
+
+
+/*
+** write_view()
+**
+** Write one view as a PPM, its image dimmed under the counts.  Each kind
+** of count is scaled to its own most in the view, on a log scale so that
+** a few flights still show beside many.
+**
+** RETURNS:  TRUE if successful, FALSE if the file could not be written.
+*/
+static int write_view(struct HeatMap *heatmap, int view, char *name)
+{
+   static UWORD **images[HEAT_VIEWS] = {
+      &farview_image, &padaview_image, &padbview_image, &padcview_image
+   };
+   struct BitMap bm;
+   ULONG palette[4];
+   UBYTE *pens, *rgb, *pixel;
+   ULONG max_crash, max_landing, max_exit;
+   FILE *file;
+   int x, y, col, row;
+
+   pens = (UBYTE *)malloc(VIEW_WIDTH * VIEW_HEIGHT);
+   rgb = (UBYTE *)malloc(VIEW_WIDTH * VIEW_HEIGHT * 3);
+   if ((pens == NULL) || (rgb == NULL))
+   {
+      free(pens);
+      free(rgb);
+      return FALSE;
+   }
+
+   /* the image is two planes one after the other, as for a Bob */
+   InitBitMap(&bm, 2, VIEW_WIDTH, VIEW_HEIGHT);
+   bm.Planes[0] = (PLANEPTR)*images[view];
+   bm.Planes[1] = (PLANEPTR)(*images[view] + (VIEW_WIDTH/16) * VIEW_HEIGHT);
+   planar_to_chunky(&bm, pens, VIEW_WIDTH);
+   rgb4_to_rgba(host_colors, 4, palette);
+
+   max_crash = most(&heatmap->crashes[view][0][0], HEAT_ROWS*HEAT_COLS);
+   max_landing = most(&heatmap->landings[view][0][0], HEAT_ROWS*HEAT_COLS);
+   max_exit = most(heatmap->exits, HEAT_COLS);
+
+   for (y=0; y < VIEW_HEIGHT; y++)
+   {
+      row = y / HEAT_CELL;
+      for (x=0; x < VIEW_WIDTH; x++)
+      {
+         col = x / HEAT_CELL;
+         pixel = &rgb[(y * VIEW_WIDTH + x) * 3];
+
+         memcpy(pixel, &palette[pens[y * VIEW_WIDTH + x]], 3);
+         blend(pixel, 0x000000, 1.0 - BACK_SHARE);
+
+         blend(pixel, CRASH_RGB,
+            heat(heatmap->crashes[view][row][col], max_crash));
+         blend(pixel, LANDING_RGB,
+            heat(heatmap->landings[view][row][col], max_landing));
+         if ((view == 0) && (y < 4))
+         {
+            blend(pixel, EXIT_RGB, heat(heatmap->exits[col], max_exit));
+         }
+      }
+   }
+
+   file = fopen(name, "wb");
+   if (file != NULL)
+   {
+      fprintf(file, "P6\n%d %d\n255\n", VIEW_WIDTH, VIEW_HEIGHT);
+      fwrite(rgb, 3, VIEW_WIDTH * VIEW_HEIGHT, file);
+      fclose(file);
+   }
+
+   free(pens);
+   free(rgb);
+
+   return (file != NULL);
+}
+
+
+/*
+** most()
+**
+** RETURNS:  The greatest of count counts.
+*/
+static ULONG most(ULONG *counts, LONG count)
+{
+   ULONG max;
+   LONG n;
+
+   max = 0;
+   for (n=0; n < count; n++)
+   {
+      if (counts[n] > max)
+      {
+         max = counts[n];
+      }
+   }
+
+   return max;
+}
+
+
+/*
+** heat()
+**
+** RETURNS:  How strongly to draw count, from 0 (none) to 1 (max).
+*/
+static double heat(ULONG count, ULONG max)
+{
+   if (count == 0)
+   {
+      return 0.0;
+   }
+
+   return 0.25 + 0.75 * log(1.0 + count) / log(1.0 + max);
+}
+
+
+/*
+** blend()
+**
+** Move the RGB bytes at rgb amount (0 to 1) of the way to color.
+*/
+static void blend(UBYTE *rgb, ULONG color, double amount)
+{
+   int n, c;
+
+   for (n=0; n < 3; n++)
+   {
+      c = (color >> (16 - 8*n)) & 0xff;
+      rgb[n] = (UBYTE)(rgb[n] + (c - rgb[n]) * amount);
+   }
+}
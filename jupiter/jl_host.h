@@ -0,0 +1,662 @@
+/*
+** jl_host.h - Amiga types, structures and system calls as emulated by the
+**             Linux host layer (jl_host*.c)
+**
+** (c)1993 Paul Grebenc
+**
+** jupiterdefs.h includes this in place of the Amiga headers when compiled
+** under Linux, so the game sources build unchanged against an in-memory
+** planar display.  Only the parts of exec, graphics, intuition, gadtools
+** and layers used by Jupiter Lander are provided.
+**
+** Build (Linux):
+**    cc -std=gnu99 -O2 -pthread -o jupiter jupitermain.c jupitergame.c \
+**       jupiterintro.c jl_*.c -lm
+*/
+
+#ifndef JL_HOST_H
+#define JL_HOST_H
+
+#define EXEC_TYPES_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+/* Amiga NULL is a plain 0L, which the game compares against integers */
+#undef NULL
+#define NULL 0L
+
+/* SAS/C memory class keyword, meaningless on the host */
+#define chip
+#define __chip
+
+
+/** TYPES **/
+
+typedef void           *APTR;
+typedef int             LONG;
+typedef unsigned int    ULONG;
+typedef short           WORD;
+typedef unsigned short  UWORD;
+typedef signed char     BYTE;
+typedef unsigned char   UBYTE;
+typedef short           SHORT;
+typedef unsigned short  USHORT;
+typedef short           BOOL;
+typedef char           *STRPTR;
+typedef UBYTE          *PLANEPTR;
+typedef ULONG           Tag;
+
+#define VOID void
+
+#define TRUE   1
+#define FALSE  0
+
+
+/** EXEC **/
+
+#define MEMF_ANY     (0L)
+#define MEMF_PUBLIC  (1L<<0)
+#define MEMF_CHIP    (1L<<1)
+#define MEMF_FAST    (1L<<2)
+#define MEMF_CLEAR   (1L<<16)
+
+#define CMD_INVALID  0
+#define CMD_RESET    1
+#define CMD_READ     2
+#define CMD_WRITE    3
+#define CMD_UPDATE   4
+#define CMD_CLEAR    5
+#define CMD_STOP     6
+#define CMD_START    7
+#define CMD_FLUSH    8
+#define CMD_NONSTD   9
+
+#define IOF_QUICK    (1<<0)
+
+#define IOERR_OPENFAIL  (-1)
+
+struct Node {
+   struct Node *ln_Succ;
+   struct Node *ln_Pred;
+   UBYTE ln_Type;
+   BYTE  ln_Pri;
+   char *ln_Name;
+};
+
+struct Message {
+   struct Node     mn_Node;
+   struct MsgPort *mn_ReplyPort;
+   UWORD           mn_Length;
+};
+
+struct MsgPort {
+   struct Node     mp_Node;
+   UBYTE           mp_Flags;
+   UBYTE           mp_SigBit;
+   struct Message *mp_Head;   /* host: queued messages, oldest first */
+   struct Message *mp_Tail;
+};
+
+struct Library {
+   struct Node lib_Node;
+   UWORD lib_Version;
+};
+
+struct Device {
+   struct Library dd_Library;
+};
+
+struct Unit {
+   struct MsgPort unit_MsgPort;
+};
+
+struct Task {
+   struct Node tc_Node;
+};
+
+struct IORequest {
+   struct Message io_Message;
+   struct Device *io_Device;
+   struct Unit   *io_Unit;
+   UWORD io_Command;
+   UBYTE io_Flags;
+   BYTE  io_Error;
+};
+
+struct IOStdReq {
+   struct Message io_Message;
+   struct Device *io_Device;
+   struct Unit   *io_Unit;
+   UWORD io_Command;
+   UBYTE io_Flags;
+   BYTE  io_Error;
+   ULONG io_Actual;
+   ULONG io_Length;
+   APTR  io_Data;
+   ULONG io_Offset;
+};
+
+#define FOREVER for(;;)
+
+
+/** DOS **/
+
+#define RETURN_OK    0
+#define RETURN_WARN  5
+#define RETURN_ERROR 10
+#define RETURN_FAIL  20
+
+#define TICKS_PER_SECOND 50
+
+
+/** DEVICES **/
+
+#define AUDIONAME       "audio.device"
+
+#define ADCMD_FREE      (CMD_NONSTD+0)
+#define ADCMD_SETPREC   (CMD_NONSTD+1)
+#define ADCMD_FINISH    (CMD_NONSTD+2)
+#define ADCMD_PERVOL    (CMD_NONSTD+3)
+#define ADCMD_LOCK      (CMD_NONSTD+4)
+#define ADCMD_WAITCYCLE (CMD_NONSTD+5)
+#define ADCMD_ALLOCATE  32
+
+#define ADIOF_PERVOL    (1<<4)
+#define ADIOF_SYNCCYCLE (1<<5)
+#define ADIOF_NOWAIT    (1<<6)
+
+struct IOAudio {
+   struct IORequest ioa_Request;
+   WORD    ioa_AllocKey;
+   UBYTE  *ioa_Data;
+   ULONG   ioa_Length;
+   UWORD   ioa_Period;
+   UWORD   ioa_Volume;
+   UWORD   ioa_Cycles;
+   struct Message ioa_WriteMsg;
+};
+
+#define KBD_READEVENT   (CMD_NONSTD+0)
+#define KBD_READMATRIX  (CMD_NONSTD+1)
+
+
+/** GRAPHICS **/
+
+#define JAM1        0
+#define JAM2        1
+#define COMPLEMENT  2
+#define INVERSVID   4
+
+#define FPF_ROMFONT   (1<<0)
+#define FPF_DESIGNED  (1<<6)
+#define FSF_BOLD      (1<<1)
+
+struct BitMap {
+   UWORD    BytesPerRow;
+   UWORD    Rows;
+   UBYTE    Flags;
+   UBYTE    Depth;
+   UWORD    pad;
+   PLANEPTR Planes[8];
+};
+
+struct Rectangle {
+   WORD MinX, MinY;
+   WORD MaxX, MaxY;
+};
+
+struct Region {
+   struct Rectangle bounds;
+};
+
+struct Layer {
+   struct Region *ClipRegion;
+};
+
+struct TextAttr {
+   STRPTR ta_Name;
+   UWORD  ta_YSize;
+   UBYTE  ta_Style;
+   UBYTE  ta_Flags;
+};
+
+struct TextFont {
+   struct Message tf_Message;
+   UWORD tf_YSize;
+   UBYTE tf_Style;
+   UBYTE tf_Flags;
+   UWORD tf_XSize;
+   UWORD tf_Baseline;
+   UWORD tf_BoldSmear;
+   UWORD tf_Accessors;
+   UBYTE tf_LoChar;
+   UBYTE tf_HiChar;
+   APTR  tf_CharData;   /* host: 8 bytes per glyph, tf_LoChar first */
+};
+
+/* host: rectangles changed by drawing (see jl_hostdamage.c) */
+#define MAX_DAMAGE   16
+
+struct DamageList {
+   WORD Count;
+   struct Rectangle Rects[MAX_DAMAGE];
+};
+
+struct DamageInfo {
+   struct DamageList Frame;   /* since host_take_damage() */
+   struct DamageList Gels;    /* since DrawGList() */
+};
+
+struct RastPort {
+   struct Layer    *Layer;
+   struct BitMap   *BitMap;
+   struct GelsInfo *GelsInfo;
+   BYTE  FgPen;
+   BYTE  BgPen;
+   BYTE  AOlPen;
+   BYTE  DrawMode;
+   WORD  cp_x;
+   WORD  cp_y;
+   struct TextFont *Font;
+   UBYTE AlgoStyle;
+   UWORD TxHeight;
+   UWORD TxWidth;
+   UWORD TxBaseline;
+   struct DamageInfo *Damage;   /* host: NULL if not tracked */
+};
+
+struct ViewPort {
+   WORD DWidth, DHeight;
+};
+
+
+/** GELS **/
+
+#ifndef VUserStuff
+#define VUserStuff SHORT
+#endif
+
+#ifndef BUserStuff
+#define BUserStuff SHORT
+#endif
+
+/* VSprite flags */
+#define VSPRITE      0x0001
+#define SAVEBACK     0x0002
+#define OVERLAY      0x0004
+#define MUSTDRAW     0x0008
+#define BACKSAVED    0x0100
+#define BOBUPDATE    0x0200
+#define GELGONE      0x0400
+#define VSOVERFLOW   0x0800
+
+/* Bob flags */
+#define SAVEBOB      0x0001
+#define BOBISCOMP    0x0002
+#define BWAITING     0x0100
+#define BDRAWN       0x0200
+#define BOBSAWAY     0x0400
+#define BOBNIX       0x0800
+#define SAVEPRESERVE 0x1000
+#define OUTSTEP      0x2000
+
+/* collision codes for the border */
+#define BORDERHIT    0
+#define TOPHIT       1
+#define BOTTOMHIT    2
+#define LEFTHIT      4
+#define RIGHTHIT     8
+
+struct VSprite {
+   struct VSprite *NextVSprite;
+   struct VSprite *PrevVSprite;
+   struct VSprite *DrawPath;
+   struct VSprite *ClearPath;
+   WORD  OldY, OldX;
+   WORD  Flags;
+   WORD  Y, X;
+   WORD  Height;
+   WORD  Width;
+   WORD  Depth;
+   WORD  MeMask;
+   WORD  HitMask;
+   WORD *ImageData;
+   WORD *BorderLine;
+   WORD *CollMask;
+   WORD *SprColors;
+   struct Bob *VSBob;
+   BYTE  PlanePick;
+   BYTE  PlaneOnOff;
+   VUserStuff VUserExt;
+   WORD *DrawnImage;   /* host: ImageData when last drawn */
+   WORD  Redraw;       /* host: REDRAW_* for the current DrawGList() */
+};
+
+/* host: how much of a gel DrawGList() restores and draws */
+#define REDRAW_NONE     0
+#define REDRAW_CLIPPED  1   /* draw only inside the redraw region */
+#define REDRAW_ALL      2
+
+struct Bob {
+   WORD  Flags;
+   WORD *SaveBuffer;
+   WORD *ImageShadow;
+   struct Bob *Before;
+   struct Bob *After;
+   struct VSprite *BobVSprite;
+   struct AnimComp *BobComp;
+   struct DBufPacket *DBuffer;
+   BUserStuff BUserExt;
+};
+
+struct collTable {
+   void (*collPtrs[16])();
+};
+
+struct GelsInfo {
+   BYTE  sprRsrvd;
+   UBYTE Flags;
+   struct VSprite *gelHead, *gelTail;
+   WORD *nextLine;
+   WORD **lastColor;
+   struct collTable *collHandler;
+   WORD  leftmost, rightmost, topmost, bottommost;
+   APTR  firstBlissObj, lastBlissObj;
+};
+
+/* Amiga defines this as a macro, the Bob goes at the next DrawGList() */
+#define RemBob(b) ((b)->Flags |= BOBSAWAY)
+
+/* host: an image with all 16 shifts built (see jl_hostshift.c) */
+struct ShiftedImage {
+   UWORD *Image;                 /* the image as given to the VSprite */
+   WORD   Width, Height, Depth;  /* of Image, Width in words */
+   UWORD *Data;                  /* Depth planes and a mask, per shift */
+   LONG   Size;                  /* bytes at Data */
+};
+
+/* plane (Depth for the mask) of shift s, Width+1 words to a line */
+#define SHIFTED_PLANE(si, s, plane) \
+   ((si)->Data + ((s)*((si)->Depth+1) + (plane)) * ((si)->Width+1) * (si)->Height)
+
+
+/** INTUITION **/
+
+#define TAG_DONE     (0L)
+#define TAG_END      (0L)
+#define TAG_USER     ((ULONG)(1L<<31))
+
+#define WA_Dummy        (TAG_USER + 99)
+#define WA_Left         (WA_Dummy + 0x01)
+#define WA_Top          (WA_Dummy + 0x02)
+#define WA_Width        (WA_Dummy + 0x03)
+#define WA_Height       (WA_Dummy + 0x04)
+#define WA_IDCMP        (WA_Dummy + 0x07)
+#define WA_Title        (WA_Dummy + 0x0B)
+#define WA_ScreenTitle  (WA_Dummy + 0x0C)
+#define WA_DragBar      (WA_Dummy + 0x1F)
+#define WA_DepthGadget  (WA_Dummy + 0x20)
+#define WA_CloseGadget  (WA_Dummy + 0x21)
+#define WA_Activate     (WA_Dummy + 0x24)
+#define WA_SmartRefresh (WA_Dummy + 0x27)
+
+#define IDCMP_REFRESHWINDOW   0x00000004L
+#define IDCMP_GADGETDOWN      0x00000020L
+#define IDCMP_GADGETUP        0x00000040L
+#define IDCMP_CLOSEWINDOW     0x00000200L
+#define IDCMP_RAWKEY          0x00000400L
+#define IDCMP_NEWPREFS        0x00004000L
+#define IDCMP_ACTIVEWINDOW    0x00040000L
+#define IDCMP_INACTIVEWINDOW  0x00080000L
+#define IDCMP_VANILLAKEY      0x00200000L
+#define IDCMP_INTUITICKS      0x00400000L
+
+struct Gadget {
+   struct Gadget *NextGadget;
+   UWORD GadgetID;
+};
+
+struct IntuiText {
+   UBYTE FrontPen, BackPen;
+   UBYTE DrawMode;
+   WORD  LeftEdge;
+   WORD  TopEdge;
+   struct TextAttr *ITextFont;
+   UBYTE *IText;
+   struct IntuiText *NextText;
+};
+
+struct IntuiMessage {
+   struct Message ExecMessage;
+   ULONG Class;
+   UWORD Code;
+   UWORD Qualifier;
+   APTR  IAddress;
+   WORD  MouseX, MouseY;
+   struct Window *IDCMPWindow;
+};
+
+struct DrawInfo {
+   UWORD dri_Version;
+   UWORD dri_NumPens;
+   UWORD *dri_Pens;
+   struct TextFont *dri_Font;
+   UWORD dri_Depth;
+};
+
+struct Screen {
+   WORD  Width, Height;
+   struct ViewPort ViewPort;
+   struct DrawInfo *DrawInfo;   /* host: shared, never freed */
+};
+
+struct Window {
+   WORD  LeftEdge, TopEdge;
+   WORD  Width, Height;
+   struct RastPort *RPort;
+   BYTE  BorderLeft, BorderTop, BorderRight, BorderBottom;
+   struct Screen *WScreen;
+   struct MsgPort *UserPort;
+   ULONG IDCMPFlags;
+   struct Layer *WLayer;
+   UBYTE *Title;
+   struct Gadget *FirstGadget;
+};
+
+
+/** GADTOOLS **/
+
+#define BUTTON_KIND     1
+
+#define PLACETEXT_IN    0x0010
+
+#define GT_TagBase      (TAG_USER + 0x80000)
+#define GT_Underscore   (GT_TagBase + 64)
+
+#define BUTTONIDCMP     (IDCMP_GADGETUP)
+
+#define TIMERNAME       "timer.device"
+#define UNIT_ECLOCK     (2)
+
+struct timerequest {
+   struct IORequest tr_node;
+   struct {
+      ULONG tv_secs;
+      ULONG tv_micro;
+   } tr_time;
+};
+
+struct EClockVal {
+   ULONG ev_hi;
+   ULONG ev_lo;
+};
+
+struct NewGadget {
+   WORD  ng_LeftEdge, ng_TopEdge;
+   WORD  ng_Width, ng_Height;
+   UBYTE *ng_GadgetText;
+   struct TextAttr *ng_TextAttr;
+   UWORD ng_GadgetID;
+   ULONG ng_Flags;
+   APTR  ng_VisualInfo;
+   APTR  ng_UserData;
+};
+
+
+/** PROTOTYPES **/
+
+/* jl_hostexec.c - exec, dos and devices */
+APTR AllocMem(ULONG byteSize, ULONG requirements);
+void FreeMem(APTR memoryBlock, ULONG byteSize);
+struct Task *FindTask(STRPTR name);
+BYTE SetTaskPri(struct Task *task, LONG priority);
+struct MsgPort *CreatePort(STRPTR name, LONG pri);
+void DeletePort(struct MsgPort *port);
+struct IORequest *CreateExtIO(struct MsgPort *port, LONG size);
+void DeleteExtIO(struct IORequest *ioReq);
+BYTE OpenDevice(STRPTR devName, ULONG unit, struct IORequest *ioRequest,
+   ULONG flags);
+void CloseDevice(struct IORequest *ioRequest);
+BYTE DoIO(struct IORequest *ioRequest);
+void BeginIO(struct IORequest *ioRequest);
+void PutMsg(struct MsgPort *port, struct Message *message);
+struct Message *GetMsg(struct MsgPort *port);
+void ReplyMsg(struct Message *message);
+struct Message *WaitPort(struct MsgPort *port);
+ULONG Wait(ULONG signalSet);
+void Delay(LONG timeout);
+ULONG ReadEClock(struct EClockVal *dest);
+int stcl_d(char *out, LONG lvalue);
+int stci_d(char *out, int ivalue);
+
+void host_set_input(int (*read_input)(APTR data), APTR data);
+void host_swap_words(UWORD *words, LONG bytes);
+void host_backtrace(void);
+double host_seconds(void);
+
+/* jl_hostintui.c - intuition, gadtools, layers and display setup */
+struct Library *OpenLibrary(STRPTR libName, ULONG version);
+void CloseLibrary(struct Library *library);
+struct Window *OpenWindowTags(APTR newWindow, ULONG tag1Type, ...);
+void CloseWindow(struct Window *window);
+struct Screen *LockPubScreen(STRPTR name);
+void UnlockPubScreen(STRPTR name, struct Screen *screen);
+struct DrawInfo *GetScreenDrawInfo(struct Screen *screen);
+void FreeScreenDrawInfo(struct Screen *screen, struct DrawInfo *drawInfo);
+void read_screen_info(void);
+int get_window_title_height(void);
+int get_workbench_depth(void);
+struct TextFont *OpenFont(struct TextAttr *textAttr);
+void CloseFont(struct TextFont *textFont);
+void SetFont(struct RastPort *rp, struct TextFont *textFont);
+struct ViewPort *ViewPortAddress(struct Window *window);
+void WaitTOF(void);
+void InitBitMap(struct BitMap *bitMap, LONG depth, LONG width, LONG height);
+struct Region *NewRegion(void);
+BOOL OrRectRegion(struct Region *region, struct Rectangle *rectangle);
+void DisposeRegion(struct Region *region);
+struct Region *InstallClipRegion(struct Layer *layer, struct Region *region);
+struct Gadget *CreateContext(struct Gadget **glistptr);
+struct Gadget *CreateGadget(ULONG kind, struct Gadget *gad,
+   struct NewGadget *ng, ULONG tag1, ...);
+void FreeGadgets(struct Gadget *gad);
+APTR GetVisualInfo(struct Screen *screen, ULONG tag1, ...);
+void FreeVisualInfo(APTR vi);
+UWORD AddGList(struct Window *window, struct Gadget *gadget, ULONG position,
+   LONG numGad, APTR requester);
+UWORD RemoveGList(struct Window *remPtr, struct Gadget *gadget, LONG numGad);
+void RefreshGList(struct Gadget *gadgets, struct Window *window,
+   APTR requester, LONG numGad);
+void GT_RefreshWindow(struct Window *win, APTR req);
+struct IntuiMessage *GT_GetIMsg(struct MsgPort *iport);
+void GT_ReplyIMsg(struct IntuiMessage *imsg);
+void GT_BeginRefresh(struct Window *win);
+void GT_EndRefresh(struct Window *win, LONG complete);
+
+void host_post_idcmp(struct Window *window, ULONG class, UWORD code);
+
+/* jl_hostdraw.c - graphics drawing */
+void SetAPen(struct RastPort *rp, ULONG pen);
+void SetBPen(struct RastPort *rp, ULONG pen);
+void SetDrMd(struct RastPort *rp, ULONG drawMode);
+void Move(struct RastPort *rp, LONG x, LONG y);
+void SetRast(struct RastPort *rp, ULONG pen);
+void RectFill(struct RastPort *rp, LONG xMin, LONG yMin, LONG xMax, LONG yMax);
+void Draw(struct RastPort *rp, LONG x, LONG y);
+LONG ReadPixel(struct RastPort *rp, LONG x, LONG y);
+void Text(struct RastPort *rp, STRPTR string, ULONG count);
+void BltPattern(struct RastPort *rp, PLANEPTR mask, LONG xl, LONG yl,
+   LONG xr, LONG yr, LONG byteCnt);
+void BltBitMapRastPort(struct BitMap *srcBitMap, LONG xSrc, LONG ySrc,
+   struct RastPort *destRP, LONG xDest, LONG yDest, LONG xSize, LONG ySize,
+   ULONG minterm);
+void PrintIText(struct RastPort *rp, struct IntuiText *iText, LONG left,
+   LONG top);
+
+extern UBYTE host_topaz_data[];
+
+void host_get_clip(struct RastPort *rp, struct Rectangle *clip);
+
+/* jl_c2p.c - planar to chunky conversion */
+void rgb4_to_rgba(UWORD *colors, LONG count, ULONG *palette);
+void planar_to_chunky(struct BitMap *bm, UBYTE *chunky, LONG modulo);
+void chunky_to_rgba(UBYTE *chunky, ULONG *rgba, LONG count, ULONG *palette,
+   int colors);
+void planar_to_rgba(struct BitMap *bm, ULONG *rgba, ULONG *palette,
+   int colors);
+void planar_to_rgba_damage(struct BitMap *bm, ULONG *rgba, ULONG *palette,
+   int colors, struct DamageList *dl);
+
+extern UWORD host_colors[4];
+
+/* jl_hostshift.c - pre-shifted sprite images */
+BOOL host_preshift_sprites(void);
+void host_free_shifted(void);
+struct ShiftedImage *host_preshift_image(UWORD *image, int words, int height,
+   int depth);
+struct ShiftedImage *host_find_shifted(UWORD *image);
+LONG host_shifted_bytes(UWORD *image);
+
+extern int host_use_shifted;
+
+/* jl_hostdamage.c - damaged rectangles */
+void damage_clear(struct DamageList *dl);
+void damage_add(struct DamageList *dl, LONG minX, LONG minY, LONG maxX,
+   LONG maxY);
+BOOL damage_hits(struct DamageList *dl, struct Rectangle *rect);
+void host_damage(struct RastPort *rp, LONG minX, LONG minY, LONG maxX,
+   LONG maxY);
+void host_take_damage(struct RastPort *rp, struct DamageList *dl);
+
+/* jl_hostgels.c - GELS */
+void InitGels(struct VSprite *head, struct VSprite *tail,
+   struct GelsInfo *gelsInfo);
+void InitMasks(struct VSprite *vSprite);
+void AddBob(struct Bob *bob, struct RastPort *rp);
+void SortGList(struct RastPort *rp);
+void DrawGList(struct RastPort *rp, struct ViewPort *vp);
+void DoCollision(struct RastPort *rp);
+void SetCollision(ULONG num, void (*routine)(), struct GelsInfo *gelsInfo);
+
+extern int host_skip_static;
+
+/* jl_hostcount.c - performance counters */
+#define HOST_PARTS            (10)  /* the PHASES of a frame, then these */
+#define HOST_PART_DECOMPRESS  (7)
+#define HOST_PART_COLLISION   (8)   /* DoCollision() */
+#define HOST_PART_DRAW        (9)   /* DrawGList() */
+#define HOST_VIEWS            (5)   /* GO_FAR to GO_PAD_C, then none */
+
+BOOL host_start_counters(void);
+void host_stop_counters(void);
+BOOL host_counting(void);
+void host_begin_count(int view);
+void host_end_count(int part);
+
+int masks_overlap(UWORD *mask_a, int words_a, int height_a, int x_a, int y_a,
+   UWORD *mask_b, int words_b, int height_b, int x_b, int y_b);
+
+#endif
@@ -0,0 +1,304 @@
+/*
+** jl_hostcount.c - the CPU's performance counters, for the Linux host
+**
+** (c)1993 Paul Grebenc
+**
+** The frame timers (jl_phases.c) tell how long each part of a frame takes,
+** but not why: whether the planar blits and mask ANDs wait on memory or on
+** the CPU.  host_start_counters() opens the performance counters of the
+** calling thread through perf_event_open(2): cycles, instructions, cache
+** misses and branch mispredictions, counted in user mode only so that an
+** ordinary user may.  Each part of a frame, decompress() and the GELS
+** collision and drawing kernels are counted between host_begin_count() and
+** host_end_count(), apart for each view, and host_stop_counters() prints
+** the counts per call.
+**
+** Counts are read with one read(2) of the group, so a part costs two
+** system calls.  Counters the CPU (or a virtual machine) lacks are left
+** out and shown as "-".  Until host_start_counters() succeeds the calls
+** do nothing.
+*/
+
+
+/** INCLUDES & DEFINES **/
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "jupiterdefs.h"
+
+#define COUNTERS        (4)
+#define NESTING         (4)      /* deepest host_begin_count() goes */
+
+typedef unsigned long long COUNT;
+
+
+/** PROTOTYPES **/
+
+static int open_counter(int counter, int group);
+static void read_counters(COUNT *values);
+
+
+/** GLOBAL VARIABLES **/
+
+static ULONG counter_config[COUNTERS] = {
+   PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+   PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+};
+
+static char *part_names[HOST_PARTS] = {
+   "input", "move", "scale", "collide", "flames", "draw", "wait",
+   "decompress", "DoCollision", "DrawGList"
+};
+
+static char *view_names[HOST_VIEWS] = {
+   "far", "pad A", "pad B", "pad C", "-"
+};
+
+static int counter_fd[COUNTERS] = { -1, -1, -1, -1 };
+static int counter_slot[COUNTERS];  /* in a read of the group, or -1 */
+static int group_fd = -1;
+static int group_size;
+
+/* totals of each part in each view */
+static COUNT totals[HOST_PARTS][HOST_VIEWS][COUNTERS];
+static ULONG calls[HOST_PARTS][HOST_VIEWS];
+
+/* what has been begun and not yet ended */
+static COUNT begun[NESTING][COUNTERS];
+static int begun_view[NESTING];
+static int depth;
+
+
+/*-----------------------------------------------------------------------*/
+
+
+/*
+** host_start_counters()
+**
+** Open the performance counters for the calling thread and start them.
+**
+** RETURNS:  TRUE if at least one could be opened, FALSE if not (perf
+**           events not allowed or not supported).
+*/
+BOOL host_start_counters(void)
+{
+   int counter;
+
+   if (group_fd != -1)
+   {
+      return TRUE;
+   }
+
+   group_size = 0;
+   for (counter=0; counter < COUNTERS; counter++)
+   {
+      counter_slot[counter] = -1;
+      if (-1 != (counter_fd[counter] = open_counter(counter, group_fd)))
+      {
+         if (group_fd == -1)
+         {
+            group_fd = counter_fd[counter];
+         }
+         counter_slot[counter] = group_size++;
+      }
+   }
+
+   if (group_fd == -1)
+   {
+      printf("Could not open performance counters (see "
+         "/proc/sys/kernel/perf_event_paranoid)\n");
+      return FALSE;
+   }
+
+   ioctl(group_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+   ioctl(group_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+   return TRUE;
+}
+
+
+/*
+** host_stop_counters()
+**
+** Print the counts per call of every part in every view it ran in, then
+** close the counters.
+*/
+void host_stop_counters(void)
+{
+   COUNT *total;
+   int part, view, counter;
+
+   if (group_fd == -1)
+   {
+      return;
+   }
+
+   printf("part        view     calls     cycles     instrs   IPC"
+      "  cache miss branch miss  (per call)\n");
+   for (part=0; part < HOST_PARTS; part++)
+   {
+      for (view=0; view < HOST_VIEWS; view++)
+      {
+         if (calls[part][view] == 0)
+         {
+            continue;
+         }
+         total = totals[part][view];
+
+         printf("%-11s %-5s %8lu", part_names[part], view_names[view],
+            (unsigned long)calls[part][view]);
+         for (counter=0; counter < COUNTERS; counter++)
+         {
+            if (counter_slot[counter] == -1)
+            {
+               printf(" %10s", "-");
+            }
+            else
+            {
+               printf(" %10.0f", (double)total[counter] / calls[part][view]);
+            }
+
+            /* instructions a cycle, after the instructions */
+            if (counter == 1)
+            {
+               if ((counter_slot[0] == -1) || (counter_slot[1] == -1) ||
+                  (total[0] == 0))
+               {
+                  printf(" %5s", "-");
+               }
+               else
+               {
+                  printf(" %5.2f", (double)total[1] / total[0]);
+               }
+            }
+         }
+         printf("\n");
+      }
+   }
+
+   for (counter=COUNTERS-1; counter >= 0; counter--)
+   {
+      if (counter_fd[counter] != -1)
+      {
+         close(counter_fd[counter]);
+         counter_fd[counter] = -1;
+      }
+   }
+   group_fd = -1;
+}
+
+
+/*
+** host_counting()
+**
+** RETURNS:  TRUE if the counters have been started (and so only count
+**           the thread that started them), FALSE if not.
+*/
+BOOL host_counting()
+{
+   return (group_fd != -1);
+}
+
+
+/*
+** host_begin_count()
+**
+** Start counting a part in view (0 to HOST_VIEWS-1), or in the view of
+** the part it is inside of if view is -1.  Parts may be inside others,
+** up to NESTING deep.
+*/
+void host_begin_count(int view)
+{
+   if ((group_fd == -1) || (depth == NESTING))
+   {
+      return;
+   }
+
+   if (view == -1)
+   {
+      view = (depth > 0) ? begun_view[depth-1] : HOST_VIEWS - 1;
+   }
+   begun_view[depth] = view;
+
+   read_counters(begun[depth]);
+   depth++;
+}
+
+
+/*
+** host_end_count()
+**
+** Add what was counted since the last host_begin_count() to part
+** (HOST_PART_* or a phase of a frame, PHASE_INPUT and so on).
+*/
+void host_end_count(int part)
+{
+   COUNT now[COUNTERS];
+   int counter;
+
+   if ((group_fd == -1) || (depth == 0))
+   {
+      return;
+   }
+
+   read_counters(now);
+   depth--;
+
+   for (counter=0; counter < COUNTERS; counter++)
+   {
+      totals[part][begun_view[depth]][counter] += now[counter] -
+         begun[depth][counter];
+   }
+   calls[part][begun_view[depth]]++;
+}
+
+
+/*
+** open_counter()
+**
+** Open one counter of the calling thread, in user mode, stopped, as part
+** of group (or as the leader of a new group if group is -1).
+**
+** RETURNS:  The counter's file descriptor, or -1 if it could not be opened.
+*/
+static int open_counter(int counter, int group)
+{
+   struct perf_event_attr attr;
+
+   memset(&attr, 0, sizeof(attr));
+   attr.size = sizeof(attr);
+   attr.type = PERF_TYPE_HARDWARE;
+   attr.config = counter_config[counter];
+   attr.disabled = (group == -1);
+   attr.exclude_kernel = 1;
+   attr.exclude_hv = 1;
+   attr.read_format = PERF_FORMAT_GROUP;
+
+   return syscall(SYS_perf_event_open, &attr, 0, -1, group, 0);
+}
+
+
+/*
+** read_counters()
+**
+** Read every counter of the group at once into values (COUNTERS of them,
+** those not open read as 0).
+*/
+static void read_counters(COUNT *values)
+{
+   COUNT group[1 + COUNTERS];
+   int counter;
+
+   if (read(group_fd, group, sizeof(group)) < (int)sizeof(COUNT))
+   {
+      group[0] = 0;
+   }
+
+   for (counter=0; counter < COUNTERS; counter++)
+   {
+      values[counter] = (counter_slot[counter] < (int)group[0]) &&
+         (counter_slot[counter] != -1) ? group[1 + counter_slot[counter]] : 0;
+   }
+}
@@ -0,0 +1,212 @@
+/*
+** jl_hostdamage.c - damaged rectangle lists for the Linux host
+**
+** (c)1993 Paul Grebenc
+**
+** Every host drawing call reports the rectangle it changed to the
+** DamageInfo of its RastPort.  Two lists are kept: Frame collects all
+** changes until whoever shows the window takes them with
+** host_take_damage(), and Gels collects what the drawing calls changed
+** since the last DrawGList(), which uses it to decide which Bobs it can
+** leave alone.  Overlapping or touching rectangles are merged, and when a
+** list is full the new one is merged into whichever rectangle grows the
+** least.
+*/
+
+
+/** INCLUDES & DEFINES **/
+
+#include "jupiterdefs.h"
+
+
+/** PROTOTYPES **/
+
+static BOOL rects_touch(struct Rectangle *a, struct Rectangle *b);
+static void rect_union(struct Rectangle *a, struct Rectangle *b);
+static LONG rect_area(struct Rectangle *r);
+
+
+/*-----------------------------------------------------------------------*/
+
+
+/*
+** damage_clear()
+**
+** Empty a damage list.
+*/
+void damage_clear(struct DamageList *dl)
+{
+   dl->Count = 0;
+}
+
+
+/*
+** damage_add()
+**
+** Add the rectangle minX,minY to maxX,maxY (inclusive) to a damage list.
+*/
+void damage_add(struct DamageList *dl, LONG minX, LONG minY, LONG maxX,
+   LONG maxY)
+{
+   struct Rectangle rect;
+   struct Rectangle grown;
+   LONG growth, best_growth;
+   int n, best;
+
+   if ((minX > maxX) || (minY > maxY))
+   {
+      return;
+   }
+
+   rect.MinX = minX;
+   rect.MinY = minY;
+   rect.MaxX = maxX;
+   rect.MaxY = maxY;
+
+   /* soak up every rectangle that touches, the union may reach more */
+   n = 0;
+   while (n < dl->Count)
+   {
+      if (rects_touch(&rect, &dl->Rects[n]))
+      {
+         rect_union(&rect, &dl->Rects[n]);
+         dl->Rects[n] = dl->Rects[--dl->Count];
+         n = 0;
+      }
+      else
+      {
+         n++;
+      }
+   }
+   /* */
+
+   if (dl->Count < MAX_DAMAGE)
+   {
+      dl->Rects[dl->Count++] = rect;
+      return;
+   }
+
+   /* full, merge with the rectangle that grows the least */
+   best = 0;
+   best_growth = 0;
+   for (n=0; n < dl->Count; n++)
+   {
+      grown = dl->Rects[n];
+      rect_union(&grown, &rect);
+      growth = rect_area(&grown) - rect_area(&dl->Rects[n]);
+
+      if ((n == 0) || (growth < best_growth))
+      {
+         best = n;
+         best_growth = growth;
+      }
+   }
+
+   rect = dl->Rects[best];
+   dl->Rects[best] = dl->Rects[--dl->Count];
+   damage_add(dl, rect.MinX < minX ? rect.MinX : minX,
+      rect.MinY < minY ? rect.MinY : minY,
+      rect.MaxX > maxX ? rect.MaxX : maxX,
+      rect.MaxY > maxY ? rect.MaxY : maxY);
+   /* */
+}
+
+
+/*
+** damage_hits()
+**
+** RETURNS:  TRUE if rect overlaps anything in the damage list.
+*/
+BOOL damage_hits(struct DamageList *dl, struct Rectangle *rect)
+{
+   int n;
+
+   for (n=0; n < dl->Count; n++)
+   {
+      if ((rect->MinX <= dl->Rects[n].MaxX) && (rect->MaxX >= dl->Rects[n].MinX) &&
+         (rect->MinY <= dl->Rects[n].MaxY) && (rect->MaxY >= dl->Rects[n].MinY))
+      {
+         return TRUE;
+      }
+   }
+
+   return FALSE;
+}
+
+
+/*
+** host_damage()
+**
+** Report a changed rectangle of rp, already clipped to its BitMap.
+*/
+void host_damage(struct RastPort *rp, LONG minX, LONG minY, LONG maxX,
+   LONG maxY)
+{
+   if (rp->Damage != NULL)
+   {
+      damage_add(&rp->Damage->Frame, minX, minY, maxX, maxY);
+      damage_add(&rp->Damage->Gels, minX, minY, maxX, maxY);
+   }
+}
+
+
+/*
+** host_take_damage()
+**
+** Copy what has changed in rp since the last call into dl and start
+** over.  Without damage tracking the whole BitMap is reported.
+*/
+void host_take_damage(struct RastPort *rp, struct DamageList *dl)
+{
+   if (rp->Damage != NULL)
+   {
+      *dl = rp->Damage->Frame;
+      damage_clear(&rp->Damage->Frame);
+   }
+   else
+   {
+      damage_clear(dl);
+      damage_add(dl, 0, 0, rp->BitMap->BytesPerRow*8 - 1, rp->BitMap->Rows - 1);
+   }
+}
+
+
+/*
+** rects_touch()
+**
+** RETURNS:  TRUE if a and b overlap or share an edge.
+*/
+static BOOL rects_touch(struct Rectangle *a, struct Rectangle *b)
+{
+   return (BOOL)((a->MinX <= b->MaxX + 1) && (a->MaxX + 1 >= b->MinX) &&
+      (a->MinY <= b->MaxY + 1) && (a->MaxY + 1 >= b->MinY));
+}
+
+
+/*
+** rect_union()
+**
+** Grow a to cover b as well.
+*/
+static void rect_union(struct Rectangle *a, struct Rectangle *b)
+{
+   if (b->MinX < a->MinX)
+      a->MinX = b->MinX;
+   if (b->MinY < a->MinY)
+      a->MinY = b->MinY;
+   if (b->MaxX > a->MaxX)
+      a->MaxX = b->MaxX;
+   if (b->MaxY > a->MaxY)
+      a->MaxY = b->MaxY;
+}
+
+
+/*
+** rect_area()
+**
+** RETURNS:  Pixels covered by r.
+*/
+static LONG rect_area(struct Rectangle *r)
+{
+   return (LONG)(r->MaxX - r->MinX + 1) * (r->MaxY - r->MinY + 1);
+}
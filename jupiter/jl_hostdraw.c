@@ -0,0 +1,842 @@
+/*
+** jl_hostdraw.c - RastPort drawing calls for the Linux host
+**
+** (c)1993 Paul Grebenc
+**
+** Everything is drawn straight into the planar BitMap of the RastPort a
+** word (16 pixels) at a time.  Fills, text and patterns all come down to
+** put_pattern(), which merges a one bit deep pattern into every plane
+** according to the pens and drawing mode, the way the blitter would with
+** the pen bits on its A and C channels.  Solid fills in JAM1 and JAM2 only
+** ever store whole words.  Every change is reported with host_damage().
+*/
+
+
+/** INCLUDES & DEFINES **/
+
+#include "jupiterdefs.h"
+
+/* characters of a string rendered per call to put_pattern() */
+#define TEXT_CHUNK      (64)
+#define TEXT_WORDS      ((TEXT_CHUNK*8 + 1 + 15) / 16)
+
+#define GLYPH_HEIGHT    (8)
+
+
+/** PROTOTYPES **/
+
+static void put_pattern(struct RastPort *rp, struct Rectangle *clip,
+   int x0, int y0, int x1, int y1, UWORD *pattern, int pat_x, int modulo);
+static void put_solid(struct RastPort *rp, struct Rectangle *clip,
+   int x0, int y0, int x1, int y1);
+static void put_pixel(struct RastPort *rp, struct Rectangle *clip,
+   int x, int y);
+static inline UWORD fetch_bits(UWORD *row, int bit, int words);
+
+
+/** GLOBAL VARIABLES **/
+
+/* 8x8 glyphs for characters 32 to 126, the top row first, bit 7 leftmost */
+UBYTE host_topaz_data[95*8] = {
+   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,   /*   */
+   0x18,0x18,0x18,0x18,0x18,0x00,0x18,0x00,   /* ! */
+   0x6c,0x6c,0x24,0x00,0x00,0x00,0x00,0x00,   /* " */
+   0x6c,0x6c,0xfe,0x6c,0xfe,0x6c,0x6c,0x00,   /* # */
+   0x10,0x7e,0xd0,0x7c,0x16,0xfc,0x10,0x00,   /* $ */
+   0xc6,0xcc,0x18,0x30,0x60,0xcc,0x8c,0x00,   /* % */
+   0x38,0x6c,0x38,0x76,0xdc,0xcc,0x76,0x00,   /* & */
+   0x18,0x18,0x30,0x00,0x00,0x00,0x00,0x00,   /* ' */
+   0x0c,0x18,0x30,0x30,0x30,0x18,0x0c,0x00,   /* ( */
+   0x30,0x18,0x0c,0x0c,0x0c,0x18,0x30,0x00,   /* ) */
+   0x00,0x66,0x3c,0xff,0x3c,0x66,0x00,0x00,   /* * */
+   0x00,0x18,0x18,0x7e,0x18,0x18,0x00,0x00,   /* + */
+   0x00,0x00,0x00,0x00,0x00,0x18,0x18,0x30,   /* , */
+   0x00,0x00,0x00,0x7e,0x00,0x00,0x00,0x00,   /* - */
+   0x00,0x00,0x00,0x00,0x00,0x18,0x18,0x00,   /* . */
+   0x03,0x06,0x0c,0x18,0x30,0x60,0xc0,0x00,   /* / */
+   0x7c,0xc6,0xce,0xde,0xf6,0xe6,0x7c,0x00,   /* 0 */
+   0x18,0x38,0x18,0x18,0x18,0x18,0x7e,0x00,   /* 1 */
+   0x7c,0xc6,0x06,0x1c,0x70,0xc0,0xfe,0x00,   /* 2 */
+   0x7c,0xc6,0x06,0x3c,0x06,0xc6,0x7c,0x00,   /* 3 */
+   0x1c,0x3c,0x6c,0xcc,0xfe,0x0c,0x0c,0x00,   /* 4 */
+   0xfe,0xc0,0xfc,0x06,0x06,0xc6,0x7c,0x00,   /* 5 */
+   0x3c,0x60,0xc0,0xfc,0xc6,0xc6,0x7c,0x00,   /* 6 */
+   0xfe,0x06,0x0c,0x18,0x30,0x30,0x30,0x00,   /* 7 */
+   0x7c,0xc6,0xc6,0x7c,0xc6,0xc6,0x7c,0x00,   /* 8 */
+   0x7c,0xc6,0xc6,0x7e,0x06,0x0c,0x78,0x00,   /* 9 */
+   0x00,0x18,0x18,0x00,0x00,0x18,0x18,0x00,   /* : */
+   0x00,0x18,0x18,0x00,0x00,0x18,0x18,0x30,   /* ; */
+   0x0c,0x18,0x30,0x60,0x30,0x18,0x0c,0x00,   /* < */
+   0x00,0x00,0x7e,0x00,0x7e,0x00,0x00,0x00,   /* = */
+   0x60,0x30,0x18,0x0c,0x18,0x30,0x60,0x00,   /* > */
+   0x7c,0xc6,0x06,0x1c,0x18,0x00,0x18,0x00,   /* ? */
+   0x7c,0xc6,0xde,0xde,0xde,0xc0,0x7c,0x00,   /* @ */
+   0x38,0x6c,0xc6,0xc6,0xfe,0xc6,0xc6,0x00,   /* A */
+   0xfc,0xc6,0xc6,0xfc,0xc6,0xc6,0xfc,0x00,   /* B */
+   0x3c,0x66,0xc0,0xc0,0xc0,0x66,0x3c,0x00,   /* C */
+   0xf8,0xcc,0xc6,0xc6,0xc6,0xcc,0xf8,0x00,   /* D */
+   0xfe,0xc0,0xc0,0xfc,0xc0,0xc0,0xfe,0x00,   /* E */
+   0xfe,0xc0,0xc0,0xfc,0xc0,0xc0,0xc0,0x00,   /* F */
+   0x3c,0x60,0xc0,0xce,0xc6,0x66,0x3e,0x00,   /* G */
+   0xc6,0xc6,0xc6,0xfe,0xc6,0xc6,0xc6,0x00,   /* H */
+   0x7e,0x18,0x18,0x18,0x18,0x18,0x7e,0x00,   /* I */
+   0x0e,0x06,0x06,0x06,0xc6,0xc6,0x7c,0x00,   /* J */
+   0xc6,0xcc,0xd8,0xf0,0xd8,0xcc,0xc6,0x00,   /* K */
+   0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xfe,0x00,   /* L */
+   0xc6,0xee,0xfe,0xd6,0xc6,0xc6,0xc6,0x00,   /* M */
+   0xc6,0xe6,0xf6,0xde,0xce,0xc6,0xc6,0x00,   /* N */
+   0x7c,0xc6,0xc6,0xc6,0xc6,0xc6,0x7c,0x00,   /* O */
+   0xfc,0xc6,0xc6,0xfc,0xc0,0xc0,0xc0,0x00,   /* P */
+   0x7c,0xc6,0xc6,0xc6,0xd6,0xcc,0x76,0x00,   /* Q */
+   0xfc,0xc6,0xc6,0xfc,0xd8,0xcc,0xc6,0x00,   /* R */
+   0x7c,0xc6,0xc0,0x7c,0x06,0xc6,0x7c,0x00,   /* S */
+   0x7e,0x18,0x18,0x18,0x18,0x18,0x18,0x00,   /* T */
+   0xc6,0xc6,0xc6,0xc6,0xc6,0xc6,0x7c,0x00,   /* U */
+   0xc6,0xc6,0xc6,0xc6,0x6c,0x38,0x10,0x00,   /* V */
+   0xc6,0xc6,0xc6,0xd6,0xfe,0xee,0xc6,0x00,   /* W */
+   0xc6,0x6c,0x38,0x38,0x38,0x6c,0xc6,0x00,   /* X */
+   0x66,0x66,0x66,0x3c,0x18,0x18,0x18,0x00,   /* Y */
+   0xfe,0x06,0x0c,0x18,0x30,0x60,0xfe,0x00,   /* Z */
+   0x3c,0x30,0x30,0x30,0x30,0x30,0x3c,0x00,   /* [ */
+   0xc0,0x60,0x30,0x18,0x0c,0x06,0x03,0x00,   /* backslash */
+   0x3c,0x0c,0x0c,0x0c,0x0c,0x0c,0x3c,0x00,   /* ] */
+   0x10,0x38,0x6c,0xc6,0x00,0x00,0x00,0x00,   /* ^ */
+   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xff,   /* _ */
+   0x30,0x18,0x08,0x00,0x00,0x00,0x00,0x00,   /* ` */
+   0x00,0x00,0x78,0x06,0x7e,0xc6,0x7e,0x00,   /* a */
+   0xc0,0xc0,0xfc,0xc6,0xc6,0xc6,0xfc,0x00,   /* b */
+   0x00,0x00,0x7c,0xc0,0xc0,0xc0,0x7c,0x00,   /* c */
+   0x06,0x06,0x7e,0xc6,0xc6,0xc6,0x7e,0x00,   /* d */
+   0x00,0x00,0x7c,0xc6,0xfe,0xc0,0x7c,0x00,   /* e */
+   0x1c,0x30,0x7c,0x30,0x30,0x30,0x30,0x00,   /* f */
+   0x00,0x00,0x7e,0xc6,0xc6,0x7e,0x06,0x7c,   /* g */
+   0xc0,0xc0,0xfc,0xc6,0xc6,0xc6,0xc6,0x00,   /* h */
+   0x18,0x00,0x38,0x18,0x18,0x18,0x3c,0x00,   /* i */
+   0x06,0x00,0x0e,0x06,0x06,0xc6,0xc6,0x7c,   /* j */
+   0xc0,0xc0,0xcc,0xd8,0xf0,0xd8,0xcc,0x00,   /* k */
+   0x38,0x18,0x18,0x18,0x18,0x18,0x3c,0x00,   /* l */
+   0x00,0x00,0xd8,0xfe,0xd6,0xd6,0xc6,0x00,   /* m */
+   0x00,0x00,0xfc,0xc6,0xc6,0xc6,0xc6,0x00,   /* n */
+   0x00,0x00,0x7c,0xc6,0xc6,0xc6,0x7c,0x00,   /* o */
+   0x00,0x00,0xfc,0xc6,0xc6,0xfc,0xc0,0xc0,   /* p */
+   0x00,0x00,0x7e,0xc6,0xc6,0x7e,0x06,0x06,   /* q */
+   0x00,0x00,0xdc,0xe0,0xc0,0xc0,0xc0,0x00,   /* r */
+   0x00,0x00,0x7e,0xc0,0x7c,0x06,0xfc,0x00,   /* s */
+   0x30,0x30,0x7c,0x30,0x30,0x30,0x1c,0x00,   /* t */
+   0x00,0x00,0xc6,0xc6,0xc6,0xc6,0x7e,0x00,   /* u */
+   0x00,0x00,0xc6,0xc6,0xc6,0x6c,0x38,0x00,   /* v */
+   0x00,0x00,0xc6,0xd6,0xd6,0xfe,0x6c,0x00,   /* w */
+   0x00,0x00,0xc6,0x6c,0x38,0x6c,0xc6,0x00,   /* x */
+   0x00,0x00,0xc6,0xc6,0xc6,0x7e,0x06,0x7c,   /* y */
+   0x00,0x00,0xfe,0x0c,0x38,0x60,0xfe,0x00,   /* z */
+   0x0e,0x18,0x18,0x70,0x18,0x18,0x0e,0x00,   /* { */
+   0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x00,   /* | */
+   0x70,0x18,0x18,0x0e,0x18,0x18,0x70,0x00,   /* } */
+   0x76,0xdc,0x00,0x00,0x00,0x00,0x00,0x00,   /* ~ */
+};
+
+
+/*-----------------------------------------------------------------------*/
+
+
+/*
+** host_get_clip()
+**
+** Work out the rectangle drawing in rp is limited to, the BitMap and any
+** clip region installed in its layer.
+*/
+void host_get_clip(struct RastPort *rp, struct Rectangle *clip)
+{
+   struct Region *region;
+
+   clip->MinX = 0;
+   clip->MinY = 0;
+   clip->MaxX = rp->BitMap->BytesPerRow*8 - 1;
+   clip->MaxY = rp->BitMap->Rows - 1;
+
+   if ((rp->Layer != NULL) && (NULL != (region = rp->Layer->ClipRegion)))
+   {
+      if (region->bounds.MinX > clip->MinX)
+         clip->MinX = region->bounds.MinX;
+      if (region->bounds.MinY > clip->MinY)
+         clip->MinY = region->bounds.MinY;
+      if (region->bounds.MaxX < clip->MaxX)
+         clip->MaxX = region->bounds.MaxX;
+      if (region->bounds.MaxY < clip->MaxY)
+         clip->MaxY = region->bounds.MaxY;
+   }
+}
+
+
+/*
+** SetAPen()
+**
+** Set the pen used to draw with.
+*/
+void SetAPen(struct RastPort *rp, ULONG pen)
+{
+   rp->FgPen = pen;
+}
+
+
+/*
+** SetBPen()
+**
+** Set the pen used for the background of JAM2 text and patterns.
+*/
+void SetBPen(struct RastPort *rp, ULONG pen)
+{
+   rp->BgPen = pen;
+}
+
+
+/*
+** SetDrMd()
+**
+** Set the drawing mode, JAM1, JAM2 or COMPLEMENT with INVERSVID.
+*/
+void SetDrMd(struct RastPort *rp, ULONG drawMode)
+{
+   rp->DrawMode = drawMode;
+}
+
+
+/*
+** Move()
+**
+** Move the pen position without drawing.
+*/
+void Move(struct RastPort *rp, LONG x, LONG y)
+{
+   rp->cp_x = x;
+   rp->cp_y = y;
+}
+
+
+/*
+** SetRast()
+**
+** Fill the whole BitMap with one pen.  Every plane is a single run of
+** bytes, so this is only a memset per plane.
+*/
+void SetRast(struct RastPort *rp, ULONG pen)
+{
+   struct BitMap *bm;
+   int plane;
+
+   bm = rp->BitMap;
+
+   for (plane=0; plane < bm->Depth; plane++)
+   {
+      memset(bm->Planes[plane], (pen & (1 << plane)) ? 0xff : 0x00,
+         (size_t)bm->BytesPerRow * bm->Rows);
+   }
+
+   host_damage(rp, 0, 0, bm->BytesPerRow*8 - 1, bm->Rows - 1);
+}
+
+
+/*
+** RectFill()
+**
+** Fill a rectangle (inclusive coordinates) with the pen in rp.
+*/
+void RectFill(struct RastPort *rp, LONG xMin, LONG yMin, LONG xMax, LONG yMax)
+{
+   struct Rectangle clip;
+
+   host_get_clip(rp, &clip);
+
+   put_solid(rp, &clip, xMin, yMin, xMax, yMax);
+}
+
+
+/*
+** Draw()
+**
+** Draw a line from the pen position to x,y and move the pen there.
+** Horizontal and vertical lines are filled as rectangles, anything else
+** is stepped out a pixel at a time.
+*/
+void Draw(struct RastPort *rp, LONG x, LONG y)
+{
+   struct Rectangle clip;
+   int x0, y0;
+   int dx, dy, sx, sy;
+   int err, e2;
+   int min_x, min_y, max_x, max_y;
+
+   host_get_clip(rp, &clip);
+
+   x0 = rp->cp_x;
+   y0 = rp->cp_y;
+
+   if ((y0 == y) || (x0 == x))
+   {
+      put_solid(rp, &clip, (x0 < x) ? x0 : x, (y0 < y) ? y0 : y,
+         (x0 < x) ? x : x0, (y0 < y) ? y : y0);
+   }
+   else
+   {
+      /* the box around the line, clipped, is what gets damaged */
+      min_x = (x0 < x) ? x0 : x;
+      max_x = (x0 < x) ? x : x0;
+      min_y = (y0 < y) ? y0 : y;
+      max_y = (y0 < y) ? y : y0;
+      host_damage(rp, (min_x < clip.MinX) ? clip.MinX : min_x,
+         (min_y < clip.MinY) ? clip.MinY : min_y,
+         (max_x > clip.MaxX) ? clip.MaxX : max_x,
+         (max_y > clip.MaxY) ? clip.MaxY : max_y);
+
+      dx = (x > x0) ? x - x0 : x0 - x;
+      dy = (y > y0) ? y0 - y : y - y0;
+      sx = (x > x0) ? 1 : -1;
+      sy = (y > y0) ? 1 : -1;
+      err = dx + dy;
+
+      FOREVER
+      {
+         put_pixel(rp, &clip, x0, y0);
+
+         if ((x0 == x) && (y0 == y))
+         {
+            break;
+         }
+
+         e2 = 2*err;
+         if (e2 >= dy)
+         {
+            err += dy;
+            x0 += sx;
+         }
+         if (e2 <= dx)
+         {
+            err += dx;
+            y0 += sy;
+         }
+      }
+   }
+
+   rp->cp_x = x;
+   rp->cp_y = y;
+}
+
+
+/*
+** ReadPixel()
+**
+** RETURNS:  The pen at x,y, or -1 if it is outside of the BitMap.
+*/
+LONG ReadPixel(struct RastPort *rp, LONG x, LONG y)
+{
+   struct BitMap *bm;
+   UWORD *word;
+   UWORD bit;
+   LONG pen;
+   int plane;
+
+   bm = rp->BitMap;
+
+   if ((x < 0) || (y < 0) || (x >= bm->BytesPerRow*8) || (y >= bm->Rows))
+   {
+      return -1;
+   }
+
+   bit = 0x8000 >> (x & 15);
+   pen = 0;
+
+   for (plane=0; plane < bm->Depth; plane++)
+   {
+      word = (UWORD *)bm->Planes[plane] + y*(bm->BytesPerRow >> 1) + (x >> 4);
+      if (*word & bit)
+      {
+         pen |= 1 << plane;
+      }
+   }
+
+   return pen;
+}
+
+
+/*
+** Text()
+**
+** Render count characters of string at the pen position (the pen is on
+** the baseline) and move the pen past them.  The characters are set into
+** a row buffer a chunk at a time and drawn as one pattern, smeared one
+** pixel to the right if the bold style is on.
+*/
+void Text(struct RastPort *rp, STRPTR string, ULONG count)
+{
+   struct Rectangle clip;
+   UWORD rows[GLYPH_HEIGHT][TEXT_WORDS];
+   UBYTE *char_data;
+   UBYTE *glyph;
+   UBYTE c;
+   int bold;
+   int chars, n, row, k;
+   int x, y;
+
+   host_get_clip(rp, &clip);
+
+   char_data = (UBYTE *)rp->Font->tf_CharData;
+   if (char_data == NULL)
+   {
+      char_data = host_topaz_data;
+   }
+
+   bold = ((rp->AlgoStyle | rp->Font->tf_Style) & FSF_BOLD) ? 1 : 0;
+
+   y = rp->cp_y - rp->TxBaseline;
+
+   while (count > 0)
+   {
+      chars = (count > TEXT_CHUNK) ? TEXT_CHUNK : count;
+      x = rp->cp_x;
+
+      memset(rows, 0, sizeof(rows));
+
+      for (n=0; n < chars; n++)
+      {
+         c = (UBYTE)string[n];
+         if ((c < rp->Font->tf_LoChar) || (c > rp->Font->tf_HiChar))
+         {
+            c = ' ';
+         }
+         glyph = char_data + (c - rp->Font->tf_LoChar)*GLYPH_HEIGHT;
+
+         /* glyphs are a byte wide, two to each word of the row buffer */
+         for (row=0; row < GLYPH_HEIGHT; row++)
+         {
+            rows[row][n >> 1] |= (n & 1) ? glyph[row] : glyph[row] << 8;
+         }
+      }
+
+      if (bold)
+      {
+         for (row=0; row < GLYPH_HEIGHT; row++)
+         {
+            for (k=TEXT_WORDS-1; k >= 0; k--)
+            {
+               rows[row][k] |= (rows[row][k] >> 1) |
+                  ((k > 0) ? (UWORD)(rows[row][k-1] << 15) : 0);
+            }
+         }
+      }
+
+      put_pattern(rp, &clip, x, y, x + chars*8 - 1 + bold, y + GLYPH_HEIGHT - 1,
+         &rows[0][0], 0, TEXT_WORDS);
+
+      rp->cp_x += chars*8;
+      string += chars;
+      count -= chars;
+   }
+}
+
+
+/*
+** BltPattern()
+**
+** Fill the rectangle xl,yl to xr,yr through a one plane mask of byteCnt
+** bytes per row, with the pens and drawing mode of rp.  Only the word
+** aligned masks the game uses are supported.
+*/
+void BltPattern(struct RastPort *rp, PLANEPTR mask, LONG xl, LONG yl,
+   LONG xr, LONG yr, LONG byteCnt)
+{
+   struct Rectangle clip;
+
+   host_get_clip(rp, &clip);
+
+   if (mask == NULL)
+   {
+      put_solid(rp, &clip, xl, yl, xr, yr);
+   }
+   else
+   {
+      put_pattern(rp, &clip, xl, yl, xr, yr, (UWORD *)mask, 0, byteCnt >> 1);
+   }
+}
+
+
+/*
+** BltBitMapRastPort()
+**
+** Blit a rectangle of srcBitMap into destRP, combining source (B) and
+** destination (C) words with the low four bits of the minterm, as the
+** blitter does with its A channel set to all ones.  Planes missing from
+** the source read as zero.
+*/
+void BltBitMapRastPort(struct BitMap *srcBitMap, LONG xSrc, LONG ySrc,
+   struct RastPort *destRP, LONG xDest, LONG yDest, LONG xSize, LONG ySize,
+   ULONG minterm)
+{
+   struct Rectangle clip;
+   struct BitMap *bm;
+   UWORD *src_row;
+   UWORD *dest_row;
+   UWORD b, c, r, d;
+   UWORD left_mask, right_mask;
+   UWORD m[4];
+   int x0, y0, x1, y1;
+   int src_words, dest_words;
+   int first_k, last_k;
+   int plane, row, k;
+
+   bm = destRP->BitMap;
+   host_get_clip(destRP, &clip);
+
+   /* clip the destination, moving the source with it */
+   x0 = (xDest < clip.MinX) ? clip.MinX : xDest;
+   y0 = (yDest < clip.MinY) ? clip.MinY : yDest;
+   x1 = (xDest + xSize - 1 > clip.MaxX) ? clip.MaxX : xDest + xSize - 1;
+   y1 = (yDest + ySize - 1 > clip.MaxY) ? clip.MaxY : yDest + ySize - 1;
+
+   if ((x0 > x1) || (y0 > y1))
+   {
+      return;
+   }
+
+   xSrc += x0 - xDest;
+   ySrc += y0 - yDest;
+   /* */
+
+   host_damage(destRP, x0, y0, x1, y1);
+
+   src_words = srcBitMap->BytesPerRow >> 1;
+   dest_words = bm->BytesPerRow >> 1;
+   first_k = x0 >> 4;
+   last_k = x1 >> 4;
+   left_mask = 0xffff >> (x0 & 15);
+   right_mask = 0xffff << (15 - (x1 & 15));
+
+   /* one word of ones or zeros per minterm bit, for B and C being ~b~c to bc */
+   for (k=0; k < 4; k++)
+   {
+      m[k] = (minterm & (0x10 << k)) ? 0xffff : 0;
+   }
+
+   for (plane=0; plane < bm->Depth; plane++)
+   {
+      for (row=0; row <= y1-y0; row++)
+      {
+         dest_row = (UWORD *)bm->Planes[plane] + (y0+row)*dest_words;
+
+         src_row = NULL;
+         if ((plane < srcBitMap->Depth) && (srcBitMap->Planes[plane] != NULL))
+         {
+            src_row = (UWORD *)srcBitMap->Planes[plane] + (ySrc+row)*src_words;
+         }
+
+         for (k=first_k; k <= last_k; k++)
+         {
+            r = 0xffff;
+            if (k == first_k)
+               r &= left_mask;
+            if (k == last_k)
+               r &= right_mask;
+
+            b = 0;
+            if (src_row != NULL)
+            {
+               b = fetch_bits(src_row, xSrc + k*16 - x0, src_words);
+            }
+            c = dest_row[k];
+
+            d = (b & c & m[3]) | (b & ~c & m[2]) | (~b & c & m[1]) |
+               (~b & ~c & m[0]);
+
+            dest_row[k] = (c & ~r) | (d & r);
+         }
+      }
+   }
+}
+
+
+/*
+** PrintIText()
+**
+** Render a list of IntuiText relative to left,top.  The pens, drawing
+** mode and pen position of rp are left as they were.
+*/
+void PrintIText(struct RastPort *rp, struct IntuiText *iText, LONG left,
+   LONG top)
+{
+   BYTE fg_pen, bg_pen, draw_mode;
+   UBYTE algo_style;
+   WORD cp_x, cp_y;
+
+   fg_pen = rp->FgPen;
+   bg_pen = rp->BgPen;
+   draw_mode = rp->DrawMode;
+   algo_style = rp->AlgoStyle;
+   cp_x = rp->cp_x;
+   cp_y = rp->cp_y;
+
+   for (; iText != NULL; iText = iText->NextText)
+   {
+      rp->FgPen = iText->FrontPen;
+      rp->BgPen = iText->BackPen;
+      rp->DrawMode = iText->DrawMode;
+      rp->AlgoStyle = (iText->ITextFont != NULL) ? iText->ITextFont->ta_Style : 0;
+
+      Move(rp, left + iText->LeftEdge, top + iText->TopEdge + rp->TxBaseline);
+      Text(rp, (STRPTR)iText->IText, strlen((char *)iText->IText));
+   }
+
+   rp->FgPen = fg_pen;
+   rp->BgPen = bg_pen;
+   rp->DrawMode = draw_mode;
+   rp->AlgoStyle = algo_style;
+   rp->cp_x = cp_x;
+   rp->cp_y = cp_y;
+}
+
+
+/*
+** put_pattern()
+**
+** Merge the rectangle x0,y0 to x1,y1 of a one bit deep pattern into every
+** plane of rp.  Bit pat_x of each pattern row lands on x0, and rows are
+** modulo words apart.  Per plane, with the pattern p and the rectangle r:
+**
+**    JAM1        dest = p ? pen : dest
+**    JAM2        dest = p ? pen : bgpen
+**    COMPLEMENT  dest = p ? ~dest : dest
+**
+** INVERSVID inverts the pattern first.
+*/
+static void put_pattern(struct RastPort *rp, struct Rectangle *clip,
+   int x0, int y0, int x1, int y1, UWORD *pattern, int pat_x, int modulo)
+{
+   struct BitMap *bm;
+   UWORD *dest_row;
+   UWORD *pat_row;
+   UWORD left_mask, right_mask;
+   UWORD p, r, fg, bg;
+   int dest_words;
+   int first_k, last_k;
+   int plane, row, k;
+
+   /* clip, moving the pattern with the rectangle */
+   if (x0 < clip->MinX)
+   {
+      pat_x += clip->MinX - x0;
+      x0 = clip->MinX;
+   }
+   if (y0 < clip->MinY)
+   {
+      pattern += (clip->MinY - y0) * modulo;
+      y0 = clip->MinY;
+   }
+   if (x1 > clip->MaxX)
+      x1 = clip->MaxX;
+   if (y1 > clip->MaxY)
+      y1 = clip->MaxY;
+
+   if ((x0 > x1) || (y0 > y1))
+   {
+      return;
+   }
+   /* */
+
+   host_damage(rp, x0, y0, x1, y1);
+
+   bm = rp->BitMap;
+   dest_words = bm->BytesPerRow >> 1;
+   first_k = x0 >> 4;
+   last_k = x1 >> 4;
+   left_mask = 0xffff >> (x0 & 15);
+   right_mask = 0xffff << (15 - (x1 & 15));
+
+   for (plane=0; plane < bm->Depth; plane++)
+   {
+      fg = (rp->FgPen & (1 << plane)) ? 0xffff : 0;
+      bg = (rp->BgPen & (1 << plane)) ? 0xffff : 0;
+
+      for (row=0; row <= y1-y0; row++)
+      {
+         dest_row = (UWORD *)bm->Planes[plane] + (y0+row)*dest_words;
+         pat_row = pattern + row*modulo;
+
+         for (k=first_k; k <= last_k; k++)
+         {
+            r = 0xffff;
+            if (k == first_k)
+               r &= left_mask;
+            if (k == last_k)
+               r &= right_mask;
+
+            p = fetch_bits(pat_row, pat_x + k*16 - x0, modulo);
+            if (rp->DrawMode & INVERSVID)
+               p = ~p;
+
+            if (rp->DrawMode & COMPLEMENT)
+            {
+               dest_row[k] ^= p & r;
+            }
+            else if (rp->DrawMode & JAM2)
+            {
+               dest_row[k] = (dest_row[k] & ~r) | (((fg & p) | (bg & ~p)) & r);
+            }
+            else
+            {
+               dest_row[k] = (dest_row[k] & ~(p & r)) | (fg & p & r);
+            }
+         }
+      }
+   }
+}
+
+
+/*
+** put_solid()
+**
+** Fill the rectangle x0,y0 to x1,y1 of every plane of rp with the pen.
+** The words between the two edges of a row are stored whole.
+*/
+static void put_solid(struct RastPort *rp, struct Rectangle *clip,
+   int x0, int y0, int x1, int y1)
+{
+   struct BitMap *bm;
+   UWORD *dest_row;
+   UWORD left_mask, right_mask;
+   UWORD fg;
+   int dest_words;
+   int first_k, last_k;
+   int plane, row, k;
+
+   if (x0 < clip->MinX)
+      x0 = clip->MinX;
+   if (y0 < clip->MinY)
+      y0 = clip->MinY;
+   if (x1 > clip->MaxX)
+      x1 = clip->MaxX;
+   if (y1 > clip->MaxY)
+      y1 = clip->MaxY;
+
+   if ((x0 > x1) || (y0 > y1))
+   {
+      return;
+   }
+
+   host_damage(rp, x0, y0, x1, y1);
+
+   bm = rp->BitMap;
+   dest_words = bm->BytesPerRow >> 1;
+   first_k = x0 >> 4;
+   last_k = x1 >> 4;
+   left_mask = 0xffff >> (x0 & 15);
+   right_mask = 0xffff << (15 - (x1 & 15));
+
+   if (first_k == last_k)
+   {
+      left_mask &= right_mask;
+   }
+
+   for (plane=0; plane < bm->Depth; plane++)
+   {
+      fg = (rp->FgPen & (1 << plane)) ? 0xffff : 0;
+
+      for (row=y0; row <= y1; row++)
+      {
+         dest_row = (UWORD *)bm->Planes[plane] + row*dest_words;
+
+         if (rp->DrawMode & COMPLEMENT)
+         {
+            dest_row[first_k] ^= left_mask;
+            if (first_k != last_k)
+            {
+               for (k=first_k+1; k < last_k; k++)
+               {
+                  dest_row[k] = ~dest_row[k];
+               }
+               dest_row[last_k] ^= right_mask;
+            }
+         }
+         else
+         {
+            dest_row[first_k] = (dest_row[first_k] & ~left_mask) | (fg & left_mask);
+            if (first_k != last_k)
+            {
+               for (k=first_k+1; k < last_k; k++)
+               {
+                  dest_row[k] = fg;
+               }
+               dest_row[last_k] = (dest_row[last_k] & ~right_mask) | (fg & right_mask);
+            }
+         }
+      }
+   }
+}
+
+
+/*
+** put_pixel()
+**
+** Set one pixel to the pen (or complement it).
+*/
+static void put_pixel(struct RastPort *rp, struct Rectangle *clip,
+   int x, int y)
+{
+   struct BitMap *bm;
+   UWORD *word;
+   UWORD bit;
+   int plane;
+
+   if ((x < clip->MinX) || (x > clip->MaxX) ||
+      (y < clip->MinY) || (y > clip->MaxY))
+   {
+      return;
+   }
+
+   bm = rp->BitMap;
+   bit = 0x8000 >> (x & 15);
+
+   for (plane=0; plane < bm->Depth; plane++)
+   {
+      word = (UWORD *)bm->Planes[plane] + y*(bm->BytesPerRow >> 1) + (x >> 4);
+
+      if (rp->DrawMode & COMPLEMENT)
+         *word ^= bit;
+      else if (rp->FgPen & (1 << plane))
+         *word |= bit;
+      else
+         *word &= ~bit;
+   }
+}
+
+
+/*
+** fetch_bits()
+**
+** RETURNS:  The 16 bits of a row of words starting at bit (which may be
+**           negative), bits off either end of the row reading as zero.
+*/
+static inline UWORD fetch_bits(UWORD *row, int bit, int words)
+{
+   ULONG pair;
+   int index;
+
+   index = bit >> 4;
+
+   /* the usual case, both words inside the row */
+   if ((index >= 0) && (index+1 < words))
+   {
+      pair = ((ULONG)row[index] << 16) | row[index+1];
+      return (UWORD)((pair << (bit & 15)) >> 16);
+   }
+
+   if ((bit & 15) == 0)
+   {
+      return ((index >= 0) && (index < words)) ? row[index] : 0;
+   }
+
+   pair = 0;
+   if ((index >= 0) && (index < words))
+      pair = (ULONG)row[index] << 16;
+   if ((index+1 >= 0) && (index+1 < words))
+      pair |= row[index+1];
+
+   return (UWORD)((pair << (bit & 15)) >> 16);
+}
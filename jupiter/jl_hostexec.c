@@ -0,0 +1,510 @@
+/*
+** jl_hostexec.c - exec, dos and device calls for the Linux host
+**
+** (c)1993 Paul Grebenc
+*/
+
+
+/** INCLUDES & DEFINES **/
+
+#include <execinfo.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "jupiterdefs.h"
+
+/* E clock ticks a second on a PAL Amiga */
+#define ECLOCK_RATE     (709379)
+
+
+/** PROTOTYPES **/
+
+static int default_input(APTR data);
+static void read_matrix(struct IOStdReq *ioreq);
+
+
+/** GLOBAL VARIABLES **/
+
+static struct Task host_task;
+
+static struct Device keyboard_device;
+static struct Device timer_device;
+
+/* where read_keyboard() gets its cursor bits from, one per thread */
+static __thread int (*input_function)(APTR data) = default_input;
+static __thread APTR input_data = NULL;
+
+
+/*-----------------------------------------------------------------------*/
+
+
+/*
+** AllocMem()
+**
+** There is no CHIP ram on the host, every memory type comes from the heap.
+**
+** RETURNS:  Address of the block, NULL if unsuccessful.
+*/
+APTR AllocMem(ULONG byteSize, ULONG requirements)
+{
+   if (requirements & MEMF_CLEAR)
+   {
+      return calloc(1, byteSize);
+   }
+
+   return malloc(byteSize);
+}
+
+
+/*
+** FreeMem()
+**
+** Free a block obtained from AllocMem().
+*/
+void FreeMem(APTR memoryBlock, ULONG byteSize)
+{
+   free(memoryBlock);
+}
+
+
+/*
+** FindTask()
+**
+** RETURNS:  The one task the host knows about.
+*/
+struct Task *FindTask(STRPTR name)
+{
+   return &host_task;
+}
+
+
+/*
+** SetTaskPri()
+**
+** Task priorities are left to the host scheduler.
+**
+** RETURNS:  The old priority (always 0).
+*/
+BYTE SetTaskPri(struct Task *task, LONG priority)
+{
+   return 0;
+}
+
+
+/*
+** CreatePort()
+**
+** RETURNS:  An empty message port, NULL if unsuccessful.
+*/
+struct MsgPort *CreatePort(STRPTR name, LONG pri)
+{
+   struct MsgPort *port;
+
+   port = (struct MsgPort *)calloc(1, sizeof(struct MsgPort));
+   if (port != NULL)
+   {
+      port->mp_Node.ln_Name = name;
+      port->mp_Node.ln_Pri = pri;
+   }
+
+   return port;
+}
+
+
+/*
+** DeletePort()
+**
+** Free a port made by CreatePort().
+*/
+void DeletePort(struct MsgPort *port)
+{
+   free(port);
+}
+
+
+/*
+** CreateExtIO()
+**
+** RETURNS:  A cleared I/O request of size bytes replying to port.
+*/
+struct IORequest *CreateExtIO(struct MsgPort *port, LONG size)
+{
+   struct IORequest *ioreq;
+
+   ioreq = (struct IORequest *)calloc(1, size);
+   if (ioreq != NULL)
+   {
+      ioreq->io_Message.mn_ReplyPort = port;
+      ioreq->io_Message.mn_Length = size;
+   }
+
+   return ioreq;
+}
+
+
+/*
+** DeleteExtIO()
+**
+** Free a request made by CreateExtIO().
+*/
+void DeleteExtIO(struct IORequest *ioReq)
+{
+   free(ioReq);
+}
+
+
+/*
+** OpenDevice()
+**
+** Only keyboard.device and timer.device (for ReadEClock()) exist on the
+** host.  audio.device fails to open, which the game already handles by
+** playing without sound.
+**
+** RETURNS:  0 if successful, IOERR_OPENFAIL if unsuccessful.
+*/
+BYTE OpenDevice(STRPTR devName, ULONG unit, struct IORequest *ioRequest,
+   ULONG flags)
+{
+   if (0 == strcmp(devName, "keyboard.device"))
+   {
+      ioRequest->io_Device = &keyboard_device;
+      ioRequest->io_Error = 0;
+      return 0;
+   }
+   if (0 == strcmp(devName, TIMERNAME))
+   {
+      ioRequest->io_Device = &timer_device;
+      ioRequest->io_Error = 0;
+      return 0;
+   }
+
+   ioRequest->io_Device = NULL;
+   ioRequest->io_Error = IOERR_OPENFAIL;
+   return IOERR_OPENFAIL;
+}
+
+
+/*
+** CloseDevice()
+**
+** Nothing is held open on the host.
+*/
+void CloseDevice(struct IORequest *ioRequest)
+{
+   ioRequest->io_Device = NULL;
+}
+
+
+/*
+** DoIO()
+**
+** Perform an I/O request synchronously.
+**
+** RETURNS:  io_Error of the request.
+*/
+BYTE DoIO(struct IORequest *ioRequest)
+{
+   ioRequest->io_Error = 0;
+
+   if ((ioRequest->io_Device == &keyboard_device) &&
+      (ioRequest->io_Command == KBD_READMATRIX))
+   {
+      read_matrix((struct IOStdReq *)ioRequest);
+   }
+
+   return ioRequest->io_Error;
+}
+
+
+/*
+** BeginIO()
+**
+** Start an I/O request.  Requests to devices that did not open are
+** completed at once.
+*/
+void BeginIO(struct IORequest *ioRequest)
+{
+   DoIO(ioRequest);
+
+   if (!(ioRequest->io_Flags & IOF_QUICK))
+   {
+      ReplyMsg(&ioRequest->io_Message);
+   }
+}
+
+
+/*
+** PutMsg()
+**
+** Queue a message at the end of a port.
+*/
+void PutMsg(struct MsgPort *port, struct Message *message)
+{
+   message->mn_Node.ln_Succ = NULL;
+
+   if (port->mp_Tail != NULL)
+   {
+      port->mp_Tail->mn_Node.ln_Succ = &message->mn_Node;
+   }
+   else
+   {
+      port->mp_Head = message;
+   }
+   port->mp_Tail = message;
+}
+
+
+/*
+** GetMsg()
+**
+** RETURNS:  The oldest message queued at port, NULL if there is none.
+*/
+struct Message *GetMsg(struct MsgPort *port)
+{
+   struct Message *message;
+
+   message = port->mp_Head;
+   if (message != NULL)
+   {
+      port->mp_Head = (struct Message *)message->mn_Node.ln_Succ;
+      if (port->mp_Head == NULL)
+      {
+         port->mp_Tail = NULL;
+      }
+      message->mn_Node.ln_Succ = NULL;
+   }
+
+   return message;
+}
+
+
+/*
+** ReplyMsg()
+**
+** Send a message back to its reply port.  Messages without one were made
+** by the host (see host_post_idcmp()) and are freed.
+*/
+void ReplyMsg(struct Message *message)
+{
+   if (message->mn_ReplyPort != NULL)
+   {
+      PutMsg(message->mn_ReplyPort, message);
+   }
+   else
+   {
+      free(message);
+   }
+}
+
+
+/*
+** WaitPort()
+**
+** Wait for a message to arrive at port.  Nothing on the host replies
+** later than BeginIO() does, so the port is never waited on for long.
+**
+** RETURNS:  The first message at port, without removing it.
+*/
+struct Message *WaitPort(struct MsgPort *port)
+{
+   while (port->mp_Head == NULL)
+   {
+      WaitTOF();
+   }
+
+   return port->mp_Head;
+}
+
+
+/*
+** Wait()
+**
+** Host signals are not tracked, so give up a frame and report every
+** signal asked for.  The caller's GetMsg() loop finds out what arrived.
+**
+** RETURNS:  signalSet
+*/
+ULONG Wait(ULONG signalSet)
+{
+   WaitTOF();
+
+   return signalSet;
+}
+
+
+/*
+** Delay()
+**
+** Sleep for timeout ticks (50 per second).
+*/
+void Delay(LONG timeout)
+{
+   struct timespec ts;
+
+   if (timeout > 0)
+   {
+      ts.tv_sec = timeout / TICKS_PER_SECOND;
+      ts.tv_nsec = (timeout % TICKS_PER_SECOND) * (1000000000L / TICKS_PER_SECOND);
+      nanosleep(&ts, NULL);
+   }
+}
+
+
+/*
+** ReadEClock()
+**
+** Read the monotonic clock as a count of E clock ticks, at the rate of a
+** PAL Amiga.
+**
+** RETURNS:  E clock ticks a second.
+*/
+ULONG ReadEClock(struct EClockVal *dest)
+{
+   struct timespec now;
+   unsigned long long ticks;
+
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   ticks = (unsigned long long)now.tv_sec * ECLOCK_RATE +
+      (unsigned long long)now.tv_nsec * ECLOCK_RATE / 1000000000ULL;
+
+   dest->ev_hi = (ULONG)(ticks >> 32);
+   dest->ev_lo = (ULONG)ticks;
+
+   return ECLOCK_RATE;
+}
+
+
+/*
+** stcl_d()
+**
+** SAS/C long to decimal ASCII conversion.
+**
+** RETURNS:  Number of characters written (not counting the '\0').
+*/
+int stcl_d(char *out, LONG lvalue)
+{
+   return sprintf(out, "%d", (int)lvalue);
+}
+
+
+/*
+** stci_d()
+**
+** SAS/C int to decimal ASCII conversion.
+**
+** RETURNS:  Number of characters written (not counting the '\0').
+*/
+int stci_d(char *out, int ivalue)
+{
+   return sprintf(out, "%d", ivalue);
+}
+
+
+/*
+** host_set_input()
+**
+** Set the function that supplies the keys held down (CURSOR_* bits) for
+** keyboard matrix reads made by the calling thread.  Pass NULL to go back
+** to no keys held.
+*/
+void host_set_input(int (*read_input)(APTR data), APTR data)
+{
+   input_function = (read_input != NULL) ? read_input : default_input;
+   input_data = data;
+}
+
+
+/*
+** host_swap_words()
+**
+** Put big-endian words, as written by decompress(), into host order.
+*/
+void host_swap_words(UWORD *words, LONG bytes)
+{
+   LONG n;
+
+   for (n=0; n < bytes/2; n++)
+   {
+      words[n] = (UWORD)((words[n] << 8) | (words[n] >> 8));
+   }
+}
+
+
+/*
+** host_backtrace()
+**
+** Print the calls that led here to stderr.  Link with -rdynamic for the
+** names of the functions, else give the addresses to addr2line.
+*/
+void host_backtrace()
+{
+   void *calls[32];
+   int count;
+
+   count = backtrace(calls, 32);
+   backtrace_symbols_fd(calls, count, STDERR_FILENO);
+}
+
+
+/*
+** host_seconds()
+**
+** For the tools that time themselves.
+**
+** RETURNS:  Seconds on the monotonic clock.
+*/
+double host_seconds()
+{
+   struct timespec now;
+
+   clock_gettime(CLOCK_MONOTONIC, &now);
+
+   return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+
+/*
+** default_input()
+**
+** RETURNS:  No keys held.
+*/
+static int default_input(APTR data)
+{
+   return 0;
+}
+
+
+/*
+** read_matrix()
+**
+** Build the keyboard matrix that read_keyboard() expects from the
+** current input function.
+*/
+static void read_matrix(struct IOStdReq *ioreq)
+{
+   UBYTE *matrix;
+   int keys;
+
+   matrix = (UBYTE *)ioreq->io_Data;
+   memset(matrix, 0, ioreq->io_Length);
+
+   keys = input_function(input_data);
+
+   if (ioreq->io_Length > 12)
+   {
+      if (keys & CURSOR_LEFT)
+      {
+         matrix[4] |= 0x01;   /* A */
+      }
+      if (keys & CURSOR_RIGHT)
+      {
+         matrix[4] |= 0x04;   /* D */
+      }
+      if (keys & CURSOR_UP)
+      {
+         matrix[12] |= 0x02;  /* right SHIFT */
+      }
+   }
+
+   ioreq->io_Actual = ioreq->io_Length;
+}
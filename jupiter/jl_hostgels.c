@@ -0,0 +1,934 @@
+/*
+** jl_hostgels.c - the GELS Bob system for the Linux host
+**
+** (c)1993 Paul Grebenc
+**
+** Bobs are drawn into the planar BitMap of the RastPort a word at a time,
+** shifting the image, shadow and save buffer words into place the way the
+** blitter would.  SAVEBACK, OVERLAY, PlanePick/PlaneOnOff and the
+** MeMask/HitMask collision routines behave as they do on the Amiga, and
+** RemBob() only marks a Bob to go at the next DrawGList().
+**
+** With damage tracking (jl_hostdamage.c) DrawGList() leaves alone the
+** Bobs that have not moved, changed image or been drawn over, so that a
+** still backdrop such as the terrain costs nothing from frame to frame.
+** Turning host_skip_static off redraws everything.
+*/
+
+
+/** INCLUDES & DEFINES **/
+
+#include "jupiterdefs.h"
+
+
+/** PROTOTYPES **/
+
+static void blit_plane(struct BitMap *bm, int plane, struct Rectangle *clip,
+   int x, int y, UWORD *src, UWORD fill, UWORD *mask, int words, int height);
+static void merge_plane(struct BitMap *bm, int plane, struct Rectangle *clip,
+   int dx0, int y, UWORD *src, UWORD fill, UWORD *mask, int words, int height);
+static void save_plane(struct BitMap *bm, int plane, int x, int y,
+   UWORD *save, int words, int height);
+static void draw_bob(struct RastPort *rp, struct Rectangle *clip,
+   struct VSprite *vs);
+static void mark_redraw(struct RastPort *rp, struct DamageList *region);
+static void redraw_all(struct VSprite *vs, struct DamageList *region);
+static BOOL region_meets(struct DamageList *region, struct VSprite *vs);
+static BOOL gel_meets(struct VSprite *vs, int x, int y, struct Rectangle *rect);
+static void damage_gel(struct RastPort *rp, struct Rectangle *clip, int x,
+   int y, struct VSprite *vs);
+static void unlink_gel(struct VSprite *vs);
+static void check_border(struct GelsInfo *gInfo, struct VSprite *vs);
+
+
+/** GLOBAL VARIABLES **/
+
+/* cleared by jupiterbench to time DrawGList() redrawing every Bob */
+int host_skip_static = TRUE;
+
+
+/*-----------------------------------------------------------------------*/
+
+
+/*
+** InitGels()
+**
+** Link the head and tail VSprites that bound the gel list and attach them
+** to gelsInfo.
+*/
+void InitGels(struct VSprite *head, struct VSprite *tail,
+   struct GelsInfo *gelsInfo)
+{
+   head->NextVSprite = tail;
+   head->PrevVSprite = NULL;
+   head->X = head->Y = -32768;
+
+   tail->NextVSprite = NULL;
+   tail->PrevVSprite = head;
+   tail->X = tail->Y = 32767;
+
+   gelsInfo->gelHead = head;
+   gelsInfo->gelTail = tail;
+}
+
+
+/*
+** InitMasks()
+**
+** Build the collision mask (the OR of all image planes) and the border
+** line (the OR of all lines of the collision mask) of a VSprite.
+*/
+void InitMasks(struct VSprite *vSprite)
+{
+   UWORD *image;
+   UWORD *collmask;
+   UWORD *border;
+   LONG plane_size;
+   int words, row, k, plane;
+   UWORD m;
+
+   words = vSprite->Width;
+   plane_size = (LONG)words * vSprite->Height;
+   image = (UWORD *)vSprite->ImageData;
+   collmask = (UWORD *)vSprite->CollMask;
+   border = (UWORD *)vSprite->BorderLine;
+
+   for (k=0; k < words; k++)
+   {
+      border[k] = 0;
+   }
+
+   for (row=0; row < vSprite->Height; row++)
+   {
+      for (k=0; k < words; k++)
+      {
+         m = 0;
+         for (plane=0; plane < vSprite->Depth; plane++)
+         {
+            m |= image[plane*plane_size + row*words + k];
+         }
+         collmask[row*words + k] = m;
+         border[k] |= m;
+      }
+   }
+}
+
+
+/*
+** AddBob()
+**
+** Put a Bob in the gel list of rp, sorted by Y and then X.  A Bob that
+** was RemBob()'d but has not been drawn since simply stays in the list.
+*/
+void AddBob(struct Bob *bob, struct RastPort *rp)
+{
+   struct VSprite *vs;
+   struct VSprite *after;
+
+   vs = bob->BobVSprite;
+   bob->Flags &= ~BOBSAWAY;
+
+   if (vs->NextVSprite != NULL)
+   {
+      return;
+   }
+
+   vs->VSBob = bob;
+   vs->Flags &= ~(VSPRITE | BACKSAVED | GELGONE);
+
+   /* find the last gel that sorts before this one */
+   after = rp->GelsInfo->gelHead;
+   while ((after->NextVSprite->NextVSprite != NULL) &&
+      ((after->NextVSprite->Y < vs->Y) ||
+      ((after->NextVSprite->Y == vs->Y) && (after->NextVSprite->X <= vs->X))))
+   {
+      after = after->NextVSprite;
+   }
+   /* */
+
+   vs->PrevVSprite = after;
+   vs->NextVSprite = after->NextVSprite;
+   after->NextVSprite->PrevVSprite = vs;
+   after->NextVSprite = vs;
+}
+
+
+/*
+** SortGList()
+**
+** Re-sort the gel list by Y and then X after gels have been moved.
+*/
+void SortGList(struct RastPort *rp)
+{
+   struct VSprite *head;
+   struct VSprite *vs;
+   struct VSprite *next;
+   struct VSprite *after;
+
+   head = rp->GelsInfo->gelHead;
+
+   /* insertion sort, the list is nearly in order from frame to frame */
+   for (vs = head->NextVSprite; vs->NextVSprite != NULL; vs = next)
+   {
+      next = vs->NextVSprite;
+
+      after = vs->PrevVSprite;
+      while ((after != head) &&
+         ((after->Y > vs->Y) || ((after->Y == vs->Y) && (after->X > vs->X))))
+      {
+         after = after->PrevVSprite;
+      }
+
+      if (after != vs->PrevVSprite)
+      {
+         unlink_gel(vs);
+         vs->PrevVSprite = after;
+         vs->NextVSprite = after->NextVSprite;
+         after->NextVSprite->PrevVSprite = vs;
+         after->NextVSprite = vs;
+      }
+   }
+   /* */
+}
+
+
+/*
+** DrawGList()
+**
+** Restore the backgrounds saved behind Bobs (in reverse order), drop the
+** Bobs that were RemBob()'d, then save the new backgrounds and draw every
+** Bob in the list in order.
+**
+** When the RastPort tracks damage, only the Bobs mark_redraw() picks are
+** restored and drawn, backdrops without SAVEBACK are drawn only inside
+** the region the others cover, and all that is touched goes into the
+** frame damage.  The result is the same as redrawing everything.
+*/
+void DrawGList(struct RastPort *rp, struct ViewPort *vp)
+{
+   struct GelsInfo *gInfo;
+   struct VSprite *vs;
+   struct VSprite *prev;
+   struct Bob *bob;
+   struct Rectangle clip;
+   struct Rectangle part;
+   struct DamageList region;
+   LONG plane_size;
+   int plane, n;
+
+   host_begin_count(-1);
+
+   gInfo = rp->GelsInfo;
+   host_get_clip(rp, &clip);
+
+   mark_redraw(rp, &region);
+
+   /* put back what was behind the Bobs, last drawn first */
+   for (vs = gInfo->gelTail->PrevVSprite; vs != gInfo->gelHead; vs = prev)
+   {
+      prev = vs->PrevVSprite;
+      bob = vs->VSBob;
+
+      if ((vs->Redraw == REDRAW_ALL) && (vs->Flags & BACKSAVED))
+      {
+         plane_size = (LONG)vs->Width * vs->Height;
+         for (plane=0; plane < rp->BitMap->Depth; plane++)
+         {
+            blit_plane(rp->BitMap, plane, &clip, vs->OldX, vs->OldY,
+               (UWORD *)bob->SaveBuffer + plane*plane_size, 0, NULL,
+               vs->Width, vs->Height);
+         }
+         vs->Flags &= ~BACKSAVED;
+         damage_gel(rp, &clip, vs->OldX, vs->OldY, vs);
+      }
+
+      if (bob->Flags & BOBSAWAY)
+      {
+         unlink_gel(vs);
+         bob->Flags &= ~(BOBSAWAY | BDRAWN);
+      }
+   }
+   /* */
+
+   /* save the backgrounds and draw, first to last */
+   for (vs = gInfo->gelHead->NextVSprite; vs != gInfo->gelTail; vs = vs->NextVSprite)
+   {
+      bob = vs->VSBob;
+
+      if (vs->Redraw == REDRAW_CLIPPED)
+      {
+         for (n=0; n < region.Count; n++)
+         {
+            part = clip;
+            if (region.Rects[n].MinX > part.MinX)
+               part.MinX = region.Rects[n].MinX;
+            if (region.Rects[n].MinY > part.MinY)
+               part.MinY = region.Rects[n].MinY;
+            if (region.Rects[n].MaxX < part.MaxX)
+               part.MaxX = region.Rects[n].MaxX;
+            if (region.Rects[n].MaxY < part.MaxY)
+               part.MaxY = region.Rects[n].MaxY;
+
+            if ((part.MinX <= part.MaxX) && (part.MinY <= part.MaxY) &&
+               gel_meets(vs, vs->X, vs->Y, &part))
+            {
+               draw_bob(rp, &part, vs);
+               damage_gel(rp, &part, vs->X, vs->Y, vs);
+            }
+         }
+         continue;
+      }
+
+      if (vs->Redraw == REDRAW_NONE)
+      {
+         continue;
+      }
+
+      if (vs->Flags & SAVEBACK)
+      {
+         plane_size = (LONG)vs->Width * vs->Height;
+         for (plane=0; plane < rp->BitMap->Depth; plane++)
+         {
+            save_plane(rp->BitMap, plane, vs->X, vs->Y,
+               (UWORD *)bob->SaveBuffer + plane*plane_size,
+               vs->Width, vs->Height);
+         }
+         vs->Flags |= BACKSAVED;
+      }
+
+      draw_bob(rp, &clip, vs);
+      damage_gel(rp, &clip, vs->X, vs->Y, vs);
+
+      vs->OldX = vs->X;
+      vs->OldY = vs->Y;
+      vs->DrawnImage = vs->ImageData;
+      bob->Flags |= BDRAWN;
+   }
+   /* */
+
+   if (rp->Damage != NULL)
+   {
+      damage_clear(&rp->Damage->Gels);
+   }
+
+   host_end_count(HOST_PART_DRAW);
+}
+
+
+/*
+** DoCollision()
+**
+** Test every pair of gels in the (sorted) list.  When the HitMask of the
+** upper-left gel shares bits with the MeMask of the other and their
+** collision masks overlap, the routine for the lowest shared bit is
+** called as routine(upper_left, other).  Gels with bit 0 of HitMask set
+** are also tested against the GelsInfo boundaries.
+*/
+void DoCollision(struct RastPort *rp)
+{
+   struct GelsInfo *gInfo;
+   struct VSprite *a;
+   struct VSprite *b;
+   void (*routine)();
+   int hit;
+   int bit;
+
+   host_begin_count(-1);
+
+   gInfo = rp->GelsInfo;
+
+   for (a = gInfo->gelHead->NextVSprite; a != gInfo->gelTail; a = a->NextVSprite)
+   {
+      if (a->HitMask & 0x01)
+      {
+         check_border(gInfo, a);
+      }
+
+      for (b = a->NextVSprite; b != gInfo->gelTail; b = b->NextVSprite)
+      {
+         /* the list is sorted, nothing further down can reach a */
+         if (b->Y >= a->Y + a->Height)
+         {
+            break;
+         }
+
+         hit = (a->HitMask & b->MeMask) & 0xfffe;
+         if ((hit == 0) ||
+            (b->X >= a->X + a->Width*16) || (a->X >= b->X + b->Width*16))
+         {
+            continue;
+         }
+
+         if (masks_overlap((UWORD *)a->CollMask, a->Width, a->Height, a->X, a->Y,
+               (UWORD *)b->CollMask, b->Width, b->Height, b->X, b->Y))
+         {
+            for (bit=1; !(hit & (1<<bit)); bit++)
+               ;
+            routine = gInfo->collHandler->collPtrs[bit];
+            if (routine != NULL)
+            {
+               (*routine)(a, b);
+            }
+         }
+      }
+   }
+
+   host_end_count(HOST_PART_COLLISION);
+}
+
+
+/*
+** SetCollision()
+**
+** Set the routine called by DoCollision() for collision bit num.
+*/
+void SetCollision(ULONG num, void (*routine)(), struct GelsInfo *gelsInfo)
+{
+   gelsInfo->collHandler->collPtrs[num] = routine;
+}
+
+
+/*
+** masks_overlap()
+**
+** Compare two one-plane collision masks at their screen positions,
+** fetching the words of b shifted into line with each word of a.
+**
+** RETURNS:  TRUE if any set bits coincide, FALSE otherwise.
+*/
+int masks_overlap(UWORD *mask_a, int words_a, int height_a, int x_a, int y_a,
+   UWORD *mask_b, int words_b, int height_b, int x_b, int y_b)
+{
+   int top, bottom;
+   int row, k;
+   int offset, index, shift;
+   UWORD *row_a;
+   UWORD *row_b;
+   ULONG pair;
+
+   top = (y_a > y_b) ? y_a : y_b;
+   bottom = (y_a + height_a < y_b + height_b) ? y_a + height_a : y_b + height_b;
+
+   for (row=top; row < bottom; row++)
+   {
+      row_a = mask_a + (row - y_a) * words_a;
+      row_b = mask_b + (row - y_b) * words_b;
+
+      for (k=0; k < words_a; k++)
+      {
+         if (row_a[k] == 0)
+         {
+            continue;
+         }
+
+         /* bit offset into b's row of the first pixel of this word of a */
+         offset = x_a + k*16 - x_b;
+         index = offset >> 4;
+         shift = offset & 15;
+
+         if ((index < -1) || (index >= words_b))
+         {
+            continue;
+         }
+
+         pair = 0;
+         if (index >= 0)
+         {
+            pair = (ULONG)row_b[index] << 16;
+         }
+         if (index+1 < words_b)
+         {
+            pair |= row_b[index+1];
+         }
+
+         if (row_a[k] & (UWORD)((pair << shift) >> 16))
+         {
+            return TRUE;
+         }
+      }
+   }
+
+   return FALSE;
+}
+
+
+/*
+** blit_plane()
+**
+** Merge words*16 by height pixels into one plane of bm at x,y:
+**
+**    dest = (dest & ~mask) | (src & mask)
+**
+** src is fill in every word if NULL, mask is the whole rectangle if NULL.
+** Source and mask words are shifted right into place as they are read.
+*/
+static void blit_plane(struct BitMap *bm, int plane, struct Rectangle *clip,
+   int x, int y, UWORD *src, UWORD fill, UWORD *mask, int words, int height)
+{
+   UWORD *dest_row;
+   UWORD *src_row;
+   UWORD *mask_row;
+   UWORD left_mask, right_mask;
+   ULONG prev_s, prev_m, cur_s, cur_m;
+   UWORD s, m;
+   int modulo;
+   int shift, dx0, dx;
+   int first_row, last_row;
+   int first_k, last_k;
+   int row, k;
+
+   modulo = bm->BytesPerRow >> 1;
+   shift = x & 15;
+   dx0 = x >> 4;
+
+   /* clip rows and word columns, partial words are masked below */
+   first_row = (y < clip->MinY) ? clip->MinY - y : 0;
+   last_row = (y + height - 1 > clip->MaxY) ? clip->MaxY - y : height - 1;
+
+   first_k = (clip->MinX >> 4) - dx0;
+   last_k = (clip->MaxX >> 4) - dx0;
+   if (first_k < 0)
+      first_k = 0;
+   if (last_k > words - (shift == 0))
+      last_k = words - (shift == 0);
+
+   left_mask = 0xffff >> (clip->MinX & 15);
+   right_mask = 0xffff << (15 - (clip->MaxX & 15));
+
+   if (first_k > last_k)
+   {
+      return;
+   }
+   /* */
+
+   for (row=first_row; row <= last_row; row++)
+   {
+      dest_row = (UWORD *)bm->Planes[plane] + (y + row) * modulo;
+      src_row = (src != NULL) ? src + row*words : NULL;
+      mask_row = (mask != NULL) ? mask + row*words : NULL;
+
+      /* the word before the first one merged */
+      prev_s = 0;
+      prev_m = 0;
+      if (first_k > 0)
+      {
+         prev_s = (src_row != NULL) ? src_row[first_k-1] : fill;
+         prev_m = (mask_row != NULL) ? mask_row[first_k-1] : 0xffff;
+      }
+
+      for (k=first_k; k <= last_k; k++)
+      {
+         if (k < words)
+         {
+            cur_s = (src_row != NULL) ? src_row[k] : fill;
+            cur_m = (mask_row != NULL) ? mask_row[k] : 0xffff;
+         }
+         else
+         {
+            cur_s = 0;
+            cur_m = 0;
+         }
+
+         s = (UWORD)(((prev_s << 16) | cur_s) >> shift);
+         m = (UWORD)(((prev_m << 16) | cur_m) >> shift);
+         prev_s = cur_s;
+         prev_m = cur_m;
+
+         dx = dx0 + k;
+         if (dx == (clip->MinX >> 4))
+            m &= left_mask;
+         if (dx == (clip->MaxX >> 4))
+            m &= right_mask;
+
+         dest_row[dx] = (dest_row[dx] & ~m) | (s & m);
+      }
+   }
+}
+
+
+/*
+** merge_plane()
+**
+** Merge words*16 by height pixels that are already shifted into place
+** into one plane of bm, starting at word column dx0:
+**
+**    dest = (dest & ~mask) | (src & mask)
+**
+** src is fill in every word if NULL.
+*/
+static void merge_plane(struct BitMap *bm, int plane, struct Rectangle *clip,
+   int dx0, int y, UWORD *src, UWORD fill, UWORD *mask, int words, int height)
+{
+   UWORD *dest_row;
+   UWORD *src_row;
+   UWORD *mask_row;
+   UWORD s, m;
+   int modulo;
+   int first_row, last_row;
+   int first_k, last_k;
+   int row, k;
+
+   modulo = bm->BytesPerRow >> 1;
+
+   /* clip rows and word columns, partial words are masked below */
+   first_row = (y < clip->MinY) ? clip->MinY - y : 0;
+   last_row = (y + height - 1 > clip->MaxY) ? clip->MaxY - y : height - 1;
+
+   first_k = (clip->MinX >> 4) - dx0;
+   last_k = (clip->MaxX >> 4) - dx0;
+   if (first_k < 0)
+      first_k = 0;
+   if (last_k > words - 1)
+      last_k = words - 1;
+
+   if (first_k > last_k)
+   {
+      return;
+   }
+   /* */
+
+   for (row=first_row; row <= last_row; row++)
+   {
+      dest_row = (UWORD *)bm->Planes[plane] + (y + row) * modulo + dx0;
+      src_row = src + row*words;
+      mask_row = mask + row*words;
+
+      for (k=first_k; k <= last_k; k++)
+      {
+         s = (src != NULL) ? src_row[k] : fill;
+         m = mask_row[k];
+
+         if (dx0 + k == (clip->MinX >> 4))
+            m &= 0xffff >> (clip->MinX & 15);
+         if (dx0 + k == (clip->MaxX >> 4))
+            m &= 0xffff << (15 - (clip->MaxX & 15));
+
+         dest_row[k] = (dest_row[k] & ~m) | (s & m);
+      }
+   }
+}
+
+
+/*
+** save_plane()
+**
+** Copy the words*16 pixels at x,y of every row of one plane of bm into
+** save, shifting them left into word alignment.  Pixels outside the
+** BitMap are saved as 0 (they are never drawn or restored).
+*/
+static void save_plane(struct BitMap *bm, int plane, int x, int y,
+   UWORD *save, int words, int height)
+{
+   UWORD *src_row;
+   ULONG pair;
+   int modulo;
+   int shift, dx0, dx;
+   int row, k;
+
+   modulo = bm->BytesPerRow >> 1;
+   shift = x & 15;
+   dx0 = x >> 4;
+
+   for (row=0; row < height; row++, save += words)
+   {
+      if ((y + row < 0) || (y + row >= bm->Rows))
+      {
+         continue;
+      }
+
+      src_row = (UWORD *)bm->Planes[plane] + (y + row) * modulo;
+
+      for (k=0; k < words; k++)
+      {
+         dx = dx0 + k;
+
+         pair = 0;
+         if ((dx >= 0) && (dx < modulo))
+         {
+            pair = (ULONG)src_row[dx] << 16;
+         }
+         if ((dx+1 >= 0) && (dx+1 < modulo))
+         {
+            pair |= src_row[dx+1];
+         }
+
+         save[k] = (UWORD)((pair << shift) >> 16);
+      }
+   }
+}
+
+
+/*
+** draw_bob()
+**
+** Draw the image of a Bob's VSprite.  Picked planes take the next image
+** plane, the others are filled from PlaneOnOff.  With OVERLAY only the
+** pixels set in the shadow are touched, otherwise the whole rectangle is.
+** OVERLAY Bobs whose image has been pre-shifted are drawn from the shifted
+** copies, whose mask is the shadow InitMasks() would make.
+*/
+static void draw_bob(struct RastPort *rp, struct Rectangle *clip,
+   struct VSprite *vs)
+{
+   struct ShiftedImage *si;
+   UWORD *image;
+   UWORD *shadow;
+   LONG plane_size;
+   int plane;
+   int image_plane;
+   int shift;
+
+   image = (UWORD *)vs->ImageData;
+   plane_size = (LONG)vs->Width * vs->Height;
+
+   if ((vs->Flags & OVERLAY) && (NULL != (si = host_find_shifted(image))) &&
+      (si->Width == vs->Width) && (si->Height == vs->Height) &&
+      (si->Depth == vs->Depth))
+   {
+      shift = vs->X & 15;
+      shadow = SHIFTED_PLANE(si, shift, si->Depth);
+
+      image_plane = 0;
+      for (plane=0; plane < rp->BitMap->Depth; plane++)
+      {
+         if ((vs->PlanePick & (1<<plane)) && (image_plane < vs->Depth))
+         {
+            merge_plane(rp->BitMap, plane, clip, vs->X >> 4, vs->Y,
+               SHIFTED_PLANE(si, shift, image_plane), 0, shadow,
+               vs->Width + 1, vs->Height);
+         }
+         else
+         {
+            merge_plane(rp->BitMap, plane, clip, vs->X >> 4, vs->Y, NULL,
+               (!(vs->PlanePick & (1<<plane)) && (vs->PlaneOnOff & (1<<plane))) ?
+                  0xffff : 0x0000,
+               shadow, vs->Width + 1, vs->Height);
+         }
+         if (vs->PlanePick & (1<<plane))
+         {
+            image_plane++;
+         }
+      }
+
+      return;
+   }
+
+   shadow = NULL;
+   if (vs->Flags & OVERLAY)
+   {
+      shadow = (UWORD *)vs->VSBob->ImageShadow;
+      if (shadow == NULL)
+      {
+         shadow = (UWORD *)vs->CollMask;
+      }
+   }
+
+   image_plane = 0;
+   for (plane=0; plane < rp->BitMap->Depth; plane++)
+   {
+      if (vs->PlanePick & (1<<plane))
+      {
+         if (image_plane < vs->Depth)
+         {
+            blit_plane(rp->BitMap, plane, clip, vs->X, vs->Y,
+               image + image_plane*plane_size, 0, shadow, vs->Width, vs->Height);
+         }
+         else
+         {
+            blit_plane(rp->BitMap, plane, clip, vs->X, vs->Y,
+               NULL, 0x0000, shadow, vs->Width, vs->Height);
+         }
+         image_plane++;
+      }
+      else
+      {
+         blit_plane(rp->BitMap, plane, clip, vs->X, vs->Y, NULL,
+            (vs->PlaneOnOff & (1<<plane)) ? 0xffff : 0x0000,
+            shadow, vs->Width, vs->Height);
+      }
+   }
+}
+
+
+/*
+** mark_redraw()
+**
+** Decide how much of each gel DrawGList() has to redraw, and collect the
+** region (old and new places) of the gels redrawn in full.  A gel can be
+** left alone if it was drawn last time at the same place with the same
+** image and nothing has been drawn over it since.  Otherwise, or if it
+** saves its background and meets the region, it is restored and drawn in
+** full, which adds to the region.  A gel without SAVEBACK that meets the
+** region need only be drawn again inside it: everywhere else the pixels
+** are just as it left them.  Damage tracking has to be on for anything to
+** be left alone.
+*/
+static void mark_redraw(struct RastPort *rp, struct DamageList *region)
+{
+   struct GelsInfo *gInfo;
+   struct VSprite *vs;
+   struct Rectangle rect;
+   BOOL changed;
+
+   gInfo = rp->GelsInfo;
+   damage_clear(region);
+
+   for (vs = gInfo->gelHead->NextVSprite; vs != gInfo->gelTail; vs = vs->NextVSprite)
+   {
+      rect.MinX = vs->X;
+      rect.MinY = vs->Y;
+      rect.MaxX = vs->X + vs->Width*16 - 1;
+      rect.MaxY = vs->Y + vs->Height - 1;
+
+      vs->Redraw = REDRAW_NONE;
+
+      if (!(host_skip_static && (rp->Damage != NULL) &&
+         (vs->VSBob->Flags & BDRAWN) && !(vs->VSBob->Flags & BOBSAWAY) &&
+         (vs->X == vs->OldX) && (vs->Y == vs->OldY) &&
+         (vs->ImageData == vs->DrawnImage) &&
+         !damage_hits(&rp->Damage->Gels, &rect)))
+      {
+         redraw_all(vs, region);
+      }
+   }
+
+   /* gels that save their background are redrawn whole if they meet it */
+   do
+   {
+      changed = FALSE;
+
+      for (vs = gInfo->gelHead->NextVSprite; vs != gInfo->gelTail; vs = vs->NextVSprite)
+      {
+         if ((vs->Redraw == REDRAW_NONE) && (vs->Flags & SAVEBACK) &&
+            region_meets(region, vs))
+         {
+            redraw_all(vs, region);
+            changed = TRUE;
+         }
+      }
+   } while (changed);
+   /* */
+
+   for (vs = gInfo->gelHead->NextVSprite; vs != gInfo->gelTail; vs = vs->NextVSprite)
+   {
+      if ((vs->Redraw == REDRAW_NONE) && region_meets(region, vs))
+      {
+         vs->Redraw = REDRAW_CLIPPED;
+      }
+   }
+}
+
+
+/*
+** redraw_all()
+**
+** Mark vs to be restored and drawn in full and add where it was and will
+** be to the region.
+*/
+static void redraw_all(struct VSprite *vs, struct DamageList *region)
+{
+   vs->Redraw = REDRAW_ALL;
+
+   damage_add(region, vs->X, vs->Y, vs->X + vs->Width*16 - 1,
+      vs->Y + vs->Height - 1);
+
+   if (vs->VSBob->Flags & BDRAWN)
+   {
+      damage_add(region, vs->OldX, vs->OldY, vs->OldX + vs->Width*16 - 1,
+         vs->OldY + vs->Height - 1);
+   }
+}
+
+
+/*
+** region_meets()
+**
+** RETURNS:  TRUE if vs, where it is now, overlaps the region.
+*/
+static BOOL region_meets(struct DamageList *region, struct VSprite *vs)
+{
+   int n;
+
+   for (n=0; n < region->Count; n++)
+   {
+      if (gel_meets(vs, vs->X, vs->Y, &region->Rects[n]))
+      {
+         return TRUE;
+      }
+   }
+
+   return FALSE;
+}
+
+
+/*
+** gel_meets()
+**
+** RETURNS:  TRUE if vs placed at x,y overlaps rect.
+*/
+static BOOL gel_meets(struct VSprite *vs, int x, int y, struct Rectangle *rect)
+{
+   return (BOOL)((x <= rect->MaxX) && (rect->MinX < x + vs->Width*16) &&
+      (y <= rect->MaxY) && (rect->MinY < y + vs->Height));
+}
+
+
+/*
+** damage_gel()
+**
+** Add the rectangle of vs placed at x,y, clipped, to the frame damage of
+** rp.
+*/
+static void damage_gel(struct RastPort *rp, struct Rectangle *clip, int x,
+   int y, struct VSprite *vs)
+{
+   if (rp->Damage != NULL)
+   {
+      damage_add(&rp->Damage->Frame,
+         (x < clip->MinX) ? clip->MinX : x,
+         (y < clip->MinY) ? clip->MinY : y,
+         (x + vs->Width*16 - 1 > clip->MaxX) ? clip->MaxX : x + vs->Width*16 - 1,
+         (y + vs->Height - 1 > clip->MaxY) ? clip->MaxY : y + vs->Height - 1);
+   }
+}
+
+
+/*
+** unlink_gel()
+**
+** Take a gel out of the list it is in.
+*/
+static void unlink_gel(struct VSprite *vs)
+{
+   vs->PrevVSprite->NextVSprite = vs->NextVSprite;
+   vs->NextVSprite->PrevVSprite = vs->PrevVSprite;
+   vs->NextVSprite = NULL;
+   vs->PrevVSprite = NULL;
+}
+
+
+/*
+** check_border()
+**
+** Call the BORDERHIT routine if vs reaches past the GelsInfo boundaries.
+*/
+static void check_border(struct GelsInfo *gInfo, struct VSprite *vs)
+{
+   void (*routine)();
+   int flags = 0;
+
+   if (vs->Y < gInfo->topmost)
+      flags |= TOPHIT;
+   if (vs->Y + vs->Height - 1 > gInfo->bottommost)
+      flags |= BOTTOMHIT;
+   if (vs->X < gInfo->leftmost)
+      flags |= LEFTHIT;
+   if (vs->X + vs->Width*16 - 1 > gInfo->rightmost)
+      flags |= RIGHTHIT;
+
+   routine = gInfo->collHandler->collPtrs[BORDERHIT];
+   if ((flags != 0) && (routine != NULL))
+   {
+      (*routine)(vs, flags);
+   }
+}
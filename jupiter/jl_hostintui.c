@@ -0,0 +1,672 @@
+/*
+** jl_hostintui.c - intuition, gadtools, layers and display calls for the
+**                  Linux host
+**
+** (c)1993 Paul Grebenc
+**
+** Windows are opened on an imaginary 4 color Workbench screen.  Each one
+** gets its own planar BitMap in memory for the RastPort to draw into.
+*/
+
+
+/** INCLUDES & DEFINES **/
+
+#include <stdarg.h>
+#include <time.h>
+
+#include "jupiterdefs.h"
+
+
+/** DEFINES **/
+
+#define SCREEN_WIDTH    640
+#define SCREEN_HEIGHT   256
+#define SCREEN_DEPTH    2
+
+#define BORDER_LEFT     4
+#define BORDER_RIGHT    4
+#define BORDER_BOTTOM   2
+
+
+/** PROTOTYPES **/
+
+static struct BitMap *alloc_window_bitmap(LONG width, LONG height);
+static void free_window_bitmap(struct BitMap *bitmap);
+
+
+/** GLOBAL VARIABLES **/
+
+static struct Library host_library;
+
+struct TextFont host_topaz = {
+   { { NULL, NULL, 0, 0, "topaz.font" }, NULL, 0 },
+   8, 0, FPF_ROMFONT | FPF_DESIGNED, 8, 6, 1, 0, 32, 126, host_topaz_data
+};
+
+static struct DrawInfo host_drawinfo = {
+   2, 0, NULL, &host_topaz, SCREEN_DEPTH
+};
+
+static struct Screen host_screen = {
+   SCREEN_WIDTH, SCREEN_HEIGHT, { SCREEN_WIDTH, SCREEN_HEIGHT }, &host_drawinfo
+};
+
+/* time of the next vertical blank, one per thread */
+static __thread struct timespec next_tof = { 0, 0 };
+
+
+/*-----------------------------------------------------------------------*/
+
+
+/*
+** OpenLibrary()
+**
+** RETURNS:  A library base that the host calls never look at.
+*/
+struct Library *OpenLibrary(STRPTR libName, ULONG version)
+{
+   return &host_library;
+}
+
+
+/*
+** CloseLibrary()
+*/
+void CloseLibrary(struct Library *library)
+{
+}
+
+
+/*
+** OpenWindowTags()
+**
+** Open a window on the host screen.  Only the size, IDCMP and title tags
+** matter, the rest are accepted and ignored.
+**
+** RETURNS:  Address of the window if successful, NULL if unsuccessful.
+*/
+struct Window *OpenWindowTags(APTR newWindow, ULONG tag1Type, ...)
+{
+   struct Window *window;
+   va_list ap;
+   ULONG tag;
+
+   window = (struct Window *)calloc(1, sizeof(struct Window));
+   if (window == NULL)
+   {
+      return NULL;
+   }
+
+   window->Width = 200;
+   window->Height = 100;
+   window->WScreen = &host_screen;
+   window->BorderLeft = BORDER_LEFT;
+   window->BorderTop = host_topaz.tf_YSize + 3;
+   window->BorderRight = BORDER_RIGHT;
+   window->BorderBottom = BORDER_BOTTOM;
+
+   /* walk the tag list, pointer values have to be fetched as pointers */
+   va_start(ap, tag1Type);
+   for (tag = tag1Type; tag != TAG_END; tag = va_arg(ap, ULONG))
+   {
+      switch (tag)
+      {
+         case WA_Title:
+               window->Title = va_arg(ap, UBYTE *);
+               break;
+         case WA_ScreenTitle:
+               va_arg(ap, UBYTE *);
+               break;
+         case WA_Left:
+               window->LeftEdge = va_arg(ap, ULONG);
+               break;
+         case WA_Top:
+               window->TopEdge = va_arg(ap, ULONG);
+               break;
+         case WA_Width:
+               window->Width = va_arg(ap, ULONG);
+               break;
+         case WA_Height:
+               window->Height = va_arg(ap, ULONG);
+               break;
+         case WA_IDCMP:
+               window->IDCMPFlags = va_arg(ap, ULONG);
+               break;
+         default:
+               va_arg(ap, ULONG);
+               break;
+      }
+   }
+   va_end(ap);
+   /* */
+
+   if (NULL != (window->RPort = (struct RastPort *)calloc(1, sizeof(struct RastPort))))
+   {
+      if (NULL != (window->WLayer = (struct Layer *)calloc(1, sizeof(struct Layer))))
+      {
+         if (NULL != (window->UserPort = CreatePort(NULL, 0)))
+         {
+            if (NULL != (window->RPort->BitMap =
+                  alloc_window_bitmap(window->Width, window->Height)))
+            {
+               if (NULL != (window->RPort->Damage =
+                     (struct DamageInfo *)calloc(1, sizeof(struct DamageInfo))))
+               {
+                  window->RPort->Layer = window->WLayer;
+                  window->RPort->FgPen = 1;
+                  window->RPort->BgPen = 0;
+                  window->RPort->DrawMode = JAM2;
+                  SetFont(window->RPort, &host_topaz);
+
+                  return window;
+               }
+               free_window_bitmap(window->RPort->BitMap);
+            }
+            DeletePort(window->UserPort);
+         }
+         free(window->WLayer);
+      }
+      free(window->RPort);
+   }
+   free(window);
+
+   return NULL;
+}
+
+
+/*
+** CloseWindow()
+**
+** Close a window from OpenWindowTags(), replying to any messages left.
+*/
+void CloseWindow(struct Window *window)
+{
+   struct Message *msg;
+
+   while (NULL != (msg = GetMsg(window->UserPort)))
+   {
+      ReplyMsg(msg);
+   }
+
+   free(window->RPort->Damage);
+   free_window_bitmap(window->RPort->BitMap);
+   DeletePort(window->UserPort);
+   free(window->WLayer);
+   free(window->RPort);
+   free(window);
+}
+
+
+/*
+** LockPubScreen()
+**
+** RETURNS:  The host screen, whatever the name.
+*/
+struct Screen *LockPubScreen(STRPTR name)
+{
+   return &host_screen;
+}
+
+
+/*
+** UnlockPubScreen()
+*/
+void UnlockPubScreen(STRPTR name, struct Screen *screen)
+{
+}
+
+
+/*
+** GetScreenDrawInfo()
+**
+** RETURNS:  The DrawInfo of screen.
+*/
+struct DrawInfo *GetScreenDrawInfo(struct Screen *screen)
+{
+   return screen->DrawInfo;
+}
+
+
+/*
+** FreeScreenDrawInfo()
+*/
+void FreeScreenDrawInfo(struct Screen *screen, struct DrawInfo *drawInfo)
+{
+}
+
+
+/*
+** read_screen_info()
+**
+** Stands in for the one in jupitermain.c, for the game and for the tools
+** that play without it.  The host screen never changes, so there is
+** nothing to read again: get_workbench_depth() and
+** get_window_title_height() answer from it directly.
+*/
+void read_screen_info()
+{
+}
+
+
+/*
+** get_window_title_height()
+**
+** RETURNS:  Height of a window's title bar on the host screen in pixels.
+*/
+int get_window_title_height()
+{
+   return host_drawinfo.dri_Font->tf_YSize + 3;
+}
+
+
+/*
+** get_workbench_depth()
+**
+** RETURNS:  Depth in bitplanes of the host screen.
+*/
+int get_workbench_depth()
+{
+   return host_drawinfo.dri_Depth;
+}
+
+
+/*
+** OpenFont()
+**
+** RETURNS:  The built in 8 pixel font, whatever was asked for.
+*/
+struct TextFont *OpenFont(struct TextAttr *textAttr)
+{
+   return &host_topaz;
+}
+
+
+/*
+** CloseFont()
+*/
+void CloseFont(struct TextFont *textFont)
+{
+}
+
+
+/*
+** SetFont()
+**
+** Set the font used by Text() in rp.
+*/
+void SetFont(struct RastPort *rp, struct TextFont *textFont)
+{
+   rp->Font = textFont;
+   rp->TxHeight = textFont->tf_YSize;
+   rp->TxWidth = textFont->tf_XSize;
+   rp->TxBaseline = textFont->tf_Baseline;
+}
+
+
+/*
+** ViewPortAddress()
+**
+** RETURNS:  The ViewPort of the host screen.
+*/
+struct ViewPort *ViewPortAddress(struct Window *window)
+{
+   return &window->WScreen->ViewPort;
+}
+
+
+/*
+** WaitTOF()
+**
+** Wait for the next vertical blank of a 50Hz display.  Each thread keeps
+** its own beam so that several games can run side by side.
+*/
+void WaitTOF()
+{
+   struct timespec now;
+
+   clock_gettime(CLOCK_MONOTONIC, &now);
+
+   /* resync if we have fallen more than a frame behind */
+   if ((next_tof.tv_sec < now.tv_sec - 1) ||
+      ((next_tof.tv_sec - now.tv_sec) * 1000000000L +
+         (next_tof.tv_nsec - now.tv_nsec) < -(1000000000L/TICKS_PER_SECOND)))
+   {
+      next_tof = now;
+   }
+
+   next_tof.tv_nsec += 1000000000L / TICKS_PER_SECOND;
+   if (next_tof.tv_nsec >= 1000000000L)
+   {
+      next_tof.tv_nsec -= 1000000000L;
+      next_tof.tv_sec++;
+   }
+
+   clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next_tof, NULL);
+}
+
+
+/*
+** InitBitMap()
+**
+** Initialize a BitMap structure (the planes are left to the caller).
+*/
+void InitBitMap(struct BitMap *bitMap, LONG depth, LONG width, LONG height)
+{
+   bitMap->BytesPerRow = ((width + 15) >> 4) << 1;
+   bitMap->Rows = height;
+   bitMap->Flags = 0;
+   bitMap->Depth = depth;
+   bitMap->pad = 0;
+}
+
+
+/*
+** NewRegion()
+**
+** RETURNS:  An empty region, NULL if unsuccessful.
+*/
+struct Region *NewRegion()
+{
+   struct Region *region;
+
+   region = (struct Region *)calloc(1, sizeof(struct Region));
+   if (region != NULL)
+   {
+      region->bounds.MinX = 1;
+      region->bounds.MaxX = 0;
+   }
+
+   return region;
+}
+
+
+/*
+** OrRectRegion()
+**
+** Add a rectangle to a region.  Host regions only keep their bounds.
+**
+** RETURNS:  TRUE
+*/
+BOOL OrRectRegion(struct Region *region, struct Rectangle *rectangle)
+{
+   if (region->bounds.MinX > region->bounds.MaxX)
+   {
+      region->bounds = *rectangle;
+   }
+   else
+   {
+      if (rectangle->MinX < region->bounds.MinX)
+         region->bounds.MinX = rectangle->MinX;
+      if (rectangle->MinY < region->bounds.MinY)
+         region->bounds.MinY = rectangle->MinY;
+      if (rectangle->MaxX > region->bounds.MaxX)
+         region->bounds.MaxX = rectangle->MaxX;
+      if (rectangle->MaxY > region->bounds.MaxY)
+         region->bounds.MaxY = rectangle->MaxY;
+   }
+
+   return TRUE;
+}
+
+
+/*
+** DisposeRegion()
+*/
+void DisposeRegion(struct Region *region)
+{
+   free(region);
+}
+
+
+/*
+** InstallClipRegion()
+**
+** RETURNS:  The region that was installed before.
+*/
+struct Region *InstallClipRegion(struct Layer *layer, struct Region *region)
+{
+   struct Region *old_region;
+
+   old_region = layer->ClipRegion;
+   layer->ClipRegion = region;
+
+   return old_region;
+}
+
+
+/*
+** CreateContext()
+**
+** RETURNS:  The context gadget that the gadget list starts from.
+*/
+struct Gadget *CreateContext(struct Gadget **glistptr)
+{
+   *glistptr = (struct Gadget *)calloc(1, sizeof(struct Gadget));
+
+   return *glistptr;
+}
+
+
+/*
+** CreateGadget()
+**
+** Gadgets are not drawn on the host, they only carry their ID.
+**
+** RETURNS:  The new gadget, linked after gad, NULL if unsuccessful.
+*/
+struct Gadget *CreateGadget(ULONG kind, struct Gadget *gad,
+   struct NewGadget *ng, ULONG tag1, ...)
+{
+   struct Gadget *newgad;
+
+   if (gad == NULL)
+   {
+      return NULL;
+   }
+
+   newgad = (struct Gadget *)calloc(1, sizeof(struct Gadget));
+   if (newgad != NULL)
+   {
+      newgad->GadgetID = ng->ng_GadgetID;
+      gad->NextGadget = newgad;
+   }
+
+   return newgad;
+}
+
+
+/*
+** FreeGadgets()
+**
+** Free a gadget list made by CreateContext() and CreateGadget().
+*/
+void FreeGadgets(struct Gadget *gad)
+{
+   struct Gadget *next;
+
+   while (gad != NULL)
+   {
+      next = gad->NextGadget;
+      free(gad);
+      gad = next;
+   }
+}
+
+
+/*
+** GetVisualInfo()
+**
+** RETURNS:  A non-NULL handle.
+*/
+APTR GetVisualInfo(struct Screen *screen, ULONG tag1, ...)
+{
+   return (APTR)screen;
+}
+
+
+/*
+** FreeVisualInfo()
+*/
+void FreeVisualInfo(APTR vi)
+{
+}
+
+
+/*
+** AddGList()
+**
+** RETURNS:  Position the gadgets were added at.
+*/
+UWORD AddGList(struct Window *window, struct Gadget *gadget, ULONG position,
+   LONG numGad, APTR requester)
+{
+   window->FirstGadget = gadget;
+
+   return 0;
+}
+
+
+/*
+** RemoveGList()
+**
+** RETURNS:  Position the gadgets were removed from.
+*/
+UWORD RemoveGList(struct Window *remPtr, struct Gadget *gadget, LONG numGad)
+{
+   remPtr->FirstGadget = NULL;
+
+   return 0;
+}
+
+
+/*
+** RefreshGList()
+*/
+void RefreshGList(struct Gadget *gadgets, struct Window *window,
+   APTR requester, LONG numGad)
+{
+}
+
+
+/*
+** GT_RefreshWindow()
+*/
+void GT_RefreshWindow(struct Window *win, APTR req)
+{
+}
+
+
+/*
+** GT_GetIMsg()
+**
+** RETURNS:  The next IntuiMessage at iport, NULL if there is none.
+*/
+struct IntuiMessage *GT_GetIMsg(struct MsgPort *iport)
+{
+   return (struct IntuiMessage *)GetMsg(iport);
+}
+
+
+/*
+** GT_ReplyIMsg()
+*/
+void GT_ReplyIMsg(struct IntuiMessage *imsg)
+{
+   ReplyMsg((struct Message *)imsg);
+}
+
+
+/*
+** GT_BeginRefresh()
+*/
+void GT_BeginRefresh(struct Window *win)
+{
+}
+
+
+/*
+** GT_EndRefresh()
+*/
+void GT_EndRefresh(struct Window *win, LONG complete)
+{
+}
+
+
+/*
+** host_post_idcmp()
+**
+** Send an IntuiMessage of the given class and code to window, as if the
+** user had done something.  The message is freed when it is replied to.
+** A GADGETUP code is taken as the GadgetID of the gadget selected.
+*/
+void host_post_idcmp(struct Window *window, ULONG class, UWORD code)
+{
+   struct IntuiMessage *imsg;
+   struct Gadget *gad;
+
+   imsg = (struct IntuiMessage *)calloc(1, sizeof(struct IntuiMessage));
+   if (imsg != NULL)
+   {
+      imsg->Class = class;
+      imsg->Code = code;
+      imsg->IDCMPWindow = window;
+
+      if (class == IDCMP_GADGETUP)
+      {
+         for (gad = window->FirstGadget; gad != NULL; gad = gad->NextGadget)
+         {
+            if (gad->GadgetID == code)
+            {
+               imsg->IAddress = (APTR)gad;
+            }
+         }
+      }
+
+      PutMsg(window->UserPort, &imsg->ExecMessage);
+   }
+}
+
+
+/*
+** alloc_window_bitmap()
+**
+** RETURNS:  A cleared planar BitMap for a window, NULL if unsuccessful.
+*/
+static struct BitMap *alloc_window_bitmap(LONG width, LONG height)
+{
+   struct BitMap *bitmap;
+   int plane;
+
+   bitmap = (struct BitMap *)calloc(1, sizeof(struct BitMap));
+   if (bitmap != NULL)
+   {
+      InitBitMap(bitmap, SCREEN_DEPTH, width, height);
+
+      for (plane=0; plane < SCREEN_DEPTH; plane++)
+      {
+         bitmap->Planes[plane] = (PLANEPTR)calloc(bitmap->Rows, bitmap->BytesPerRow);
+         if (bitmap->Planes[plane] == NULL)
+         {
+            free_window_bitmap(bitmap);
+            return NULL;
+         }
+      }
+   }
+
+   return bitmap;
+}
+
+
+/*
+** free_window_bitmap()
+*/
+static void free_window_bitmap(struct BitMap *bitmap)
+{
+   int plane;
+
+   for (plane=0; plane < SCREEN_DEPTH; plane++)
+   {
+      free(bitmap->Planes[plane]);
+   }
+   free(bitmap);
+}
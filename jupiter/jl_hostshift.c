@@ -0,0 +1,302 @@
+/*
+** jl_hostshift.c - pre-shifted sprite images for the Linux host
+**
+** (c)1993 Paul Grebenc
+**
+** For each of the small, moving images (probes, flames and crash frames)
+** all 16 horizontal shifts of every plane, and of the mask made from
+** them, are built once at load time.  The host DrawGList() can then put
+** an OVERLAY Bob at any x with plain word merges instead of shifting each
+** row into place.  A shifted plane is one word wider than the image.
+**
+** Which images are cached is decided by sprite_table[] below; the memory
+** taken and the time saved per image are reported by jupiterbench, which
+** times each sprite whether it is cached here or not.  The
+** probes, crash frames and downward flames are cached: each gains from
+** 1.1x to 1.7x.  The side flames, one word wide and 3 or 6 lines high,
+** are not.  Shifting them as they are drawn costs little, and the cached
+** copies measured from 0.8x to 1.4x of it from run to run, no sure gain
+** for their memory.
+*/
+
+
+/** INCLUDES & DEFINES **/
+
+#include "jupiterdefs.h"
+
+/* slots in the lookup table, a power of 2 well above the images cached */
+#define SHIFT_SLOTS     (64)
+
+struct SpriteEntry {
+   UWORD *image;
+   SHORT  words;
+   SHORT  height;
+   SHORT  depth;
+   BOOL   cached;      /* by host_preshift_sprites() */
+};
+
+
+/** PROTOTYPES **/
+
+static int slot_of(UWORD *image);
+
+
+/** GLOBAL VARIABLES **/
+
+/* jl_images.c */
+extern UWORD chip smallprobe_image[1*21*2];
+extern UWORD chip largeprobe_image[1*42*3];
+extern UWORD chip farcrash_image[7][1*21*2];
+extern UWORD chip closecrash_image[7][1*42*3];
+extern UWORD chip farflame_down_image[2][1*5*1];
+extern UWORD chip farflame_left_image[1*3*1];
+extern UWORD chip farflame_right_image[1*3*1];
+extern UWORD chip closeflame_down_image[2][1*10*2];
+extern UWORD chip closeflame_left_image[1*6*1];
+extern UWORD chip closeflame_right_image[1*6*1];
+
+static struct SpriteEntry sprite_table[] = {
+   { smallprobe_image,          2, 21, 1, TRUE },
+   { largeprobe_image,          3, 42, 1, TRUE },
+   { farcrash_image[0],         2, 21, 1, TRUE },
+   { farcrash_image[1],         2, 21, 1, TRUE },
+   { farcrash_image[2],         2, 21, 1, TRUE },
+   { farcrash_image[3],         2, 21, 1, TRUE },
+   { farcrash_image[4],         2, 21, 1, TRUE },
+   { farcrash_image[5],         2, 21, 1, TRUE },
+   { farcrash_image[6],         2, 21, 1, TRUE },
+   { closecrash_image[0],       3, 42, 1, TRUE },
+   { closecrash_image[1],       3, 42, 1, TRUE },
+   { closecrash_image[2],       3, 42, 1, TRUE },
+   { closecrash_image[3],       3, 42, 1, TRUE },
+   { closecrash_image[4],       3, 42, 1, TRUE },
+   { closecrash_image[5],       3, 42, 1, TRUE },
+   { closecrash_image[6],       3, 42, 1, TRUE },
+   { farflame_down_image[0],    1, 5,  1, TRUE },
+   { farflame_down_image[1],    1, 5,  1, TRUE },
+   { farflame_left_image,       1, 3,  1, FALSE },
+   { farflame_right_image,      1, 3,  1, FALSE },
+   { closeflame_down_image[0],  2, 10, 1, TRUE },
+   { closeflame_down_image[1],  2, 10, 1, TRUE },
+   { closeflame_left_image,     1, 6,  1, FALSE },
+   { closeflame_right_image,    1, 6,  1, FALSE },
+};
+
+static struct ShiftedImage *shifted[SHIFT_SLOTS];
+
+/* cleared by jupiterbench to time the unshifted path */
+int host_use_shifted = TRUE;
+
+
+/*-----------------------------------------------------------------------*/
+
+
+/*
+** host_preshift_sprites()
+**
+** Build the shifted copies of every image in sprite_table[] marked to be
+** cached.  Images already cached are left alone.
+**
+** RETURNS:  TRUE if successful, FALSE if out of memory.
+*/
+BOOL host_preshift_sprites()
+{
+   int n;
+
+   for (n=0; n < sizeof(sprite_table)/sizeof(sprite_table[0]); n++)
+   {
+      if (!sprite_table[n].cached)
+      {
+         continue;
+      }
+      if (NULL == host_preshift_image(sprite_table[n].image,
+            sprite_table[n].words, sprite_table[n].height,
+            sprite_table[n].depth))
+      {
+         return FALSE;
+      }
+   }
+
+   return TRUE;
+}
+
+
+/*
+** host_free_shifted()
+**
+** Free every cached image.
+*/
+void host_free_shifted()
+{
+   int n;
+
+   for (n=0; n < SHIFT_SLOTS; n++)
+   {
+      if (shifted[n] != NULL)
+      {
+         FreeMem(shifted[n]->Data, shifted[n]->Size);
+         FreeMem(shifted[n], sizeof(struct ShiftedImage));
+         shifted[n] = NULL;
+      }
+   }
+}
+
+
+/*
+** host_preshift_image()
+**
+** Build the 16 shifts of an image of depth planes, words wide and height
+** lines high.  Shift s of a plane is the image moved s pixels right into
+** words+1 words; the mask is the OR of the planes, shifted the same way.
+**
+** RETURNS:  The cached image, NULL if out of memory or the table is full.
+*/
+struct ShiftedImage *host_preshift_image(UWORD *image, int words, int height,
+   int depth)
+{
+   struct ShiftedImage *si;
+   UWORD *src;
+   UWORD *dest;
+   ULONG carry, w;
+   LONG plane_size;
+   int slot, shift, plane, row, k;
+
+   slot = slot_of(image);
+   if (slot < 0)
+   {
+      return NULL;
+   }
+   if (shifted[slot] != NULL)
+   {
+      return shifted[slot];
+   }
+
+   if (NULL == (si = (struct ShiftedImage *)AllocMem(sizeof(struct ShiftedImage), MEMF_CLEAR)))
+   {
+      return NULL;
+   }
+
+   plane_size = (LONG)(words + 1) * height;
+   si->Image = image;
+   si->Width = words;
+   si->Height = height;
+   si->Depth = depth;
+   si->Size = 16 * (depth + 1) * plane_size * sizeof(UWORD);
+
+   if (NULL == (si->Data = (UWORD *)AllocMem(si->Size, MEMF_CLEAR)))
+   {
+      FreeMem(si, sizeof(struct ShiftedImage));
+      return NULL;
+   }
+
+   for (shift=0; shift < 16; shift++)
+   {
+      for (plane=0; plane < depth; plane++)
+      {
+         src = image + plane*words*height;
+         dest = SHIFTED_PLANE(si, shift, plane);
+
+         for (row=0; row < height; row++)
+         {
+            carry = 0;
+            for (k=0; k < words; k++)
+            {
+               w = src[row*words + k];
+               dest[row*(words+1) + k] = (UWORD)((carry | w) >> shift);
+               carry = w << 16;
+            }
+            dest[row*(words+1) + words] = (UWORD)(carry >> shift);
+         }
+      }
+
+      /* the mask, every plane of this shift ORed together */
+      dest = SHIFTED_PLANE(si, shift, depth);
+      for (plane=0; plane < depth; plane++)
+      {
+         src = SHIFTED_PLANE(si, shift, plane);
+         for (k=0; k < plane_size; k++)
+         {
+            dest[k] |= src[k];
+         }
+      }
+   }
+
+   shifted[slot] = si;
+
+   return si;
+}
+
+
+/*
+** host_find_shifted()
+**
+** RETURNS:  The cached shifts of image, NULL if it is not cached or the
+**           cache is turned off.
+*/
+struct ShiftedImage *host_find_shifted(UWORD *image)
+{
+   int slot;
+
+   if (!host_use_shifted)
+   {
+      return NULL;
+   }
+
+   slot = slot_of(image);
+
+   return (slot >= 0) ? shifted[slot] : NULL;
+}
+
+
+/*
+** host_shifted_bytes()
+**
+** RETURNS:  Memory taken by the cached copies of image, or of every
+**           cached image if image is NULL.
+*/
+LONG host_shifted_bytes(UWORD *image)
+{
+   LONG bytes;
+   int n;
+
+   bytes = 0;
+
+   for (n=0; n < SHIFT_SLOTS; n++)
+   {
+      if ((shifted[n] != NULL) && ((image == NULL) || (shifted[n]->Image == image)))
+      {
+         bytes += shifted[n]->Size + sizeof(struct ShiftedImage);
+      }
+   }
+
+   return bytes;
+}
+
+
+/*
+** slot_of()
+**
+** Find the slot of the lookup table that holds image, or the empty slot
+** it would go in (open addressing on the image address).
+**
+** RETURNS:  The slot, -1 if the table is full.
+*/
+static int slot_of(UWORD *image)
+{
+   unsigned long hash;
+   int n, slot;
+
+   hash = (unsigned long)image;
+   hash ^= hash >> 7;
+
+   for (n=0; n < SHIFT_SLOTS; n++)
+   {
+      slot = (hash + n) & (SHIFT_SLOTS - 1);
+      if ((shifted[slot] == NULL) || (shifted[slot]->Image == image))
+      {
+         return slot;
+      }
+   }
+
+   return -1;
+}
@@ -5,9 +5,13 @@
 */
 
 
+#ifdef __linux__
+#include "jl_host.h"
+#else
 #ifndef EXEC_TYPES_H
 #include <exec/types.h>
 #endif
+#endif
 
 
 /***********************************/
@@ -18,16 +18,13 @@
 
 /** PROTOTYPES **/
 
-int setup_keyboard(void);
-void cleanup_keyboard(void);
-int read_keyboard(void);
+int setup_keyboard(struct GameInfo *gameinfo);
+void cleanup_keyboard(struct GameInfo *gameinfo);
+int read_keyboard(struct GameInfo *gameinfo);
 
-
-/** GLOBAL VARIABLES **/
-
-struct IOStdReq *KeyIO;
-struct MsgPort *KeyMP;
-UBYTE *keyMatrix;
+/* jl_account.c */
+extern APTR alloc_mem(int owner, ULONG size, ULONG flags);
+extern void free_mem(int owner, APTR memory, ULONG size);
 
 
 /*-----------------------------------------------------------------------*/
@@ -40,15 +37,17 @@ UBYTE *keyMatrix;
 **
 ** RETURNS:  TRUE if successful, FALSE if unsuccessful.
 */
-int setup_keyboard()
+int setup_keyboard(struct GameInfo *gameinfo)
 {
-   if (KeyMP = CreatePort(NULL, NULL))
+   if (gameinfo->KeyMP = CreatePort(NULL, NULL))
    {
-      if (KeyIO = (struct IOStdReq *)CreateExtIO(KeyMP, sizeof(struct IOStdReq)))
+      if (gameinfo->KeyIO = (struct IOStdReq *)CreateExtIO(gameinfo->KeyMP,
+            sizeof(struct IOStdReq)))
       {
-         if (!OpenDevice("keyboard.device", NULL, (struct IORequest *)KeyIO, NULL))
+         if (!OpenDevice("keyboard.device", NULL,
+               (struct IORequest *)gameinfo->KeyIO, NULL))
          {
-            if (keyMatrix = AllocMem(MATRIX_SIZE, MEMF_PUBLIC | MEMF_CLEAR))
+            if (gameinfo->keyMatrix = alloc_mem(ACCOUNT_KEYBOARD, MATRIX_SIZE, MEMF_PUBLIC | MEMF_CLEAR))
             {
                return TRUE;
             }
@@ -56,19 +55,19 @@ int setup_keyboard()
             {
                printf("Could not allocate keyMatrix\n");
             }
-            CloseDevice((struct IORequest *)KeyIO);
+            CloseDevice((struct IORequest *)gameinfo->KeyIO);
          }
          else
          {
             printf("Could not open keyboard.device\n");
          }
-         DeleteExtIO((struct IORequest *)KeyIO);
+         DeleteExtIO((struct IORequest *)gameinfo->KeyIO);
       }
       else
       {
          printf("Could not create I/O request for keyboard.device\n");
       }
-      DeletePort(KeyMP);
+      DeletePort(gameinfo->KeyMP);
    }
    else
    {
@@ -83,12 +82,12 @@ int setup_keyboard()
 **
 ** Free everything allocated by setup_keyboard, close keyboard.device.
 */
-void cleanup_keyboard()
+void cleanup_keyboard(struct GameInfo *gameinfo)
 {
-   FreeMem(keyMatrix, MATRIX_SIZE);
-   CloseDevice((struct IORequest *)KeyIO);
-   DeleteExtIO((struct IORequest *)KeyIO);
-   DeletePort(KeyMP);
+   free_mem(ACCOUNT_KEYBOARD, gameinfo->keyMatrix, MATRIX_SIZE);
+   CloseDevice((struct IORequest *)gameinfo->KeyIO);
+   DeleteExtIO((struct IORequest *)gameinfo->KeyIO);
+   DeletePort(gameinfo->KeyMP);
 }
 
 
@@ -99,28 +98,28 @@ void cleanup_keyboard()
 **
 ** RETURNS:  Returns a code containing a bit set for each key pressed.
 */
-int read_keyboard()
+int read_keyboard(struct GameInfo *gameinfo)
 {
    int result=0;
    
    /* read keyboard matrix */
-   KeyIO->io_Command = KBD_READMATRIX;
-   KeyIO->io_Data = (APTR)keyMatrix;
-   KeyIO->io_Length = MATRIX_SIZE;
+   gameinfo->KeyIO->io_Command = KBD_READMATRIX;
+   gameinfo->KeyIO->io_Data = (APTR)gameinfo->keyMatrix;
+   gameinfo->KeyIO->io_Length = MATRIX_SIZE;
    
-   DoIO((struct IORequest *)KeyIO);
+   DoIO((struct IORequest *)gameinfo->KeyIO);
    /* */
    
    /* check keyboard matrix and set corresponding bits in result */
-   if (keyMatrix[4] & 0x01)
+   if (gameinfo->keyMatrix[4] & 0x01)
    {
       result |= CURSOR_LEFT;
    }
-   if (keyMatrix[4] & 0x04)
+   if (gameinfo->keyMatrix[4] & 0x04)
    {
       result |= CURSOR_RIGHT;
    }
-   if (keyMatrix[12] & 0x02)
+   if (gameinfo->keyMatrix[12] & 0x02)
    {
       result |= CURSOR_UP;
    }
@@ -2,11 +2,25 @@
 ** jl_memory.c - handles decompression of program images
 **
 ** (c)1993 Paul Grebenc
+**
+** Once cache_images() has named a cache file, the images decompressed are
+** written to it, and the next time they are read back from it in one go
+** instead of being decompressed.  The cache holds a key made from the
+** compressed images it was made from (built in or from the asset pack)
+** and a sum of the images in it, so one that is stale, from another
+** version or damaged is not used; the images are decompressed and the
+** cache written again.
 */
 
 
 /** INCLUDES & DEFINES **/
 
+#ifdef __linux__
+#define _GNU_SOURCE              /* for sched_getaffinity() */
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 #include "jupiterdefs.h"
 
 
@@ -14,17 +28,60 @@
 
 #define FOREVER for(;;)
 
-#define IMAGESIZE (2*17*181)*2
-#define MASKSIZE (1*17*181)*2
-#define TITLESIZE (1*20*187)*2
+#define CACHE_MAGIC     (0x4a4c4943)   /* "JLIC" */
+#define CACHE_VERSION   (1)
+#define CACHE_ORDER     (0x0102)       /* reads as 0x0201 if swapped */
+
+#define HASH_SEED       (2166136261UL) /* for hash_bytes() to start from */
+
+#define DECODERS        (4)            /* most threads decoding at once */
+
+/* a cache file: a CacheHeader, then each image as it is in memory, in
+** the order of images[]
+*/
+struct CacheHeader {
+   ULONG magic;
+   UWORD version;
+   UWORD order;         /* CACHE_ORDER */
+   ULONG key;           /* hash_bytes() of the compressed images */
+   ULONG sum;           /* hash_words() of the images in the file */
+   ULONG size;          /* of the images in the file */
+};
+
+struct Image {
+   UWORD **image;
+   ULONG size;
+   int asset;           /* it is decompressed from */
+};
+
 
 
 /** PROTOTYPES **/
 
+void cache_images(char *name);
 void decompress_images(void);
+void start_images(void);
+void finish_images(void);
 void free_images(void);
 void decompress(UBYTE *source, UBYTE *dest);
 
+static void start_decoders(int last);
+static void decode_job(int job);
+#ifdef __linux__
+static void *decoder(void *unused);
+static void join_decoders(void);
+#endif
+
+static BOOL read_cache(void);
+static void write_cache(void);
+static ULONG cache_key(void);
+static ULONG hash_bytes(ULONG hash, UBYTE *bytes, ULONG size);
+static ULONG hash_words(ULONG hash, UWORD *words, ULONG size);
+
+/* jl_account.c */
+extern APTR alloc_mem(int owner, ULONG size, ULONG flags);
+extern void free_mem(int owner, APTR memory, ULONG size);
+
 
 /** GLOBAL VARIABLES **/
 
@@ -39,100 +96,133 @@ extern UWORD *padbview_mask;
 extern UWORD *padcview_image;
 extern UWORD *padcview_mask;
 
-extern UBYTE title_image_plane_1_comp[3378];
-extern UBYTE title_image_plane_2_comp[4416];
-extern UBYTE farview_image_comp[2924];
-extern UBYTE farview_mask_comp[2560];
-extern UBYTE padaview_image_comp[2107];
-extern UBYTE padaview_mask_comp[1887];
-extern UBYTE padbview_image_comp[962];
-extern UBYTE padbview_mask_comp[739];
-extern UBYTE padcview_image_comp[2264];
-extern UBYTE padcview_mask_comp[1113];
+extern struct Asset assets[ASSETS];
+
+static struct Image images[] = {
+   { &title_image_plane_1, TITLESIZE, ASSET_TITLE_1 },
+   { &title_image_plane_2, TITLESIZE, ASSET_TITLE_2 },
+   { &farview_image, IMAGESIZE, ASSET_FARVIEW },
+   { &farview_mask, MASKSIZE, ASSET_FARVIEW_MASK },
+   { &padaview_image, IMAGESIZE, ASSET_PADAVIEW },
+   { &padaview_mask, MASKSIZE, ASSET_PADAVIEW_MASK },
+   { &padbview_image, IMAGESIZE, ASSET_PADBVIEW },
+   { &padbview_mask, MASKSIZE, ASSET_PADBVIEW_MASK },
+   { &padcview_image, IMAGESIZE, ASSET_PADCVIEW },
+   { &padcview_mask, MASKSIZE, ASSET_PADCVIEW_MASK }
+};
+
+#define IMAGES          (sizeof(images) / sizeof(struct Image))
+
+static char *cache_name = NULL;
+
+/* the images were decompressed, not read from the cache */
+static BOOL decoded = FALSE;
+
+#ifdef __linux__
+static pthread_t decoder_threads[DECODERS];
+static int decoders = 0;         /* running */
+static pthread_mutex_t job_lock = PTHREAD_MUTEX_INITIALIZER;
+static int next_job, last_job;
+#endif
 
 
 /*-----------------------------------------------------------------------*/
 
 
+/*
+** cache_images()
+**
+** Have decompress_images() read the images from cache file name, or
+** write them to it.  NULL (as it is to begin with) turns the cache off.
+*/
+void cache_images(char *name)
+{
+   cache_name = name;
+}
+
+
 /*
 ** decompress_images()
 **
-** Decompress all compressed images used in game.  Compression method is
-** RLE encoding.  Allocate CHIP memory for decompressed images.
+** Decompress all compressed images used in game, as start_images() and
+** finish_images() do together.
+*/
+void decompress_images()
+{
+   start_images();
+   finish_images();
+}
+
+
+/*
+** start_images()
+**
+** Decompress all compressed images used in game, built in or from the
+** asset pack (see jl_pack.c).  Compression method is RLE encoding.
+** Allocate CHIP memory for decompressed images.  On the Linux host they
+** are decompressed on threads while this returns at once, so the caller
+** can get on with something else; they are ready once finish_images()
+** returns.
 **
 ** RETURNS:  Nothing if sucessful, exit(RETURN_WARN) if unsuccessful.
 */
-void decompress_images()
+void start_images()
 {
-   title_image_plane_1 = (UWORD *)AllocMem(TITLESIZE, MEMF_CHIP);
+   title_image_plane_1 = (UWORD *)alloc_mem(ACCOUNT_IMAGES, TITLESIZE, MEMF_CHIP);
    if (title_image_plane_1 != NULL)
    {
-      title_image_plane_2 = (UWORD *)AllocMem(TITLESIZE, MEMF_CHIP);
+      title_image_plane_2 = (UWORD *)alloc_mem(ACCOUNT_IMAGES, TITLESIZE, MEMF_CHIP);
       if (title_image_plane_2 != NULL)
       {
-         farview_image = (UWORD *)AllocMem(IMAGESIZE, MEMF_CHIP);
+         farview_image = (UWORD *)alloc_mem(ACCOUNT_IMAGES, IMAGESIZE, MEMF_CHIP);
          if (farview_image != NULL)
          {
-            farview_mask = (UWORD *)AllocMem(MASKSIZE, MEMF_CHIP);
+            farview_mask = (UWORD *)alloc_mem(ACCOUNT_IMAGES, MASKSIZE, MEMF_CHIP);
             if (farview_mask != NULL)
             {
-               padaview_image = (UWORD *)AllocMem(IMAGESIZE, MEMF_CHIP);
+               padaview_image = (UWORD *)alloc_mem(ACCOUNT_IMAGES, IMAGESIZE, MEMF_CHIP);
                if (padaview_image != NULL)
                {
-                  padaview_mask = (UWORD *)AllocMem(MASKSIZE, MEMF_CHIP);
+                  padaview_mask = (UWORD *)alloc_mem(ACCOUNT_IMAGES, MASKSIZE, MEMF_CHIP);
                   if (padaview_mask != NULL)
                   {
-                     padbview_image = (UWORD *)AllocMem(IMAGESIZE, MEMF_CHIP);
+                     padbview_image = (UWORD *)alloc_mem(ACCOUNT_IMAGES, IMAGESIZE, MEMF_CHIP);
                      if (padbview_image != NULL)
                      {
-                        padbview_mask = (UWORD *)AllocMem(MASKSIZE, MEMF_CHIP);
+                        padbview_mask = (UWORD *)alloc_mem(ACCOUNT_IMAGES, MASKSIZE, MEMF_CHIP);
                         if (padbview_mask != NULL)
                         {
-                           padcview_image = (UWORD *)AllocMem(IMAGESIZE, MEMF_CHIP);
+                           padcview_image = (UWORD *)alloc_mem(ACCOUNT_IMAGES, IMAGESIZE, MEMF_CHIP);
                            if (padcview_image != NULL)
                            {
-                              padcview_mask = (UWORD *)AllocMem(MASKSIZE, MEMF_CHIP);
+                              padcview_mask = (UWORD *)alloc_mem(ACCOUNT_IMAGES, MASKSIZE, MEMF_CHIP);
                               if (padcview_mask != NULL)
                               {
-                                 decompress(title_image_plane_1_comp,
-                                             (UBYTE *)title_image_plane_1);
-                                 decompress(title_image_plane_2_comp,
-                                             (UBYTE *)title_image_plane_2);
-                                 decompress(farview_image_comp,
-                                             (UBYTE *)farview_image);
-                                 decompress(farview_mask_comp,
-                                             (UBYTE *)farview_mask);
-                                 decompress(padaview_image_comp,
-                                             (UBYTE *)padaview_image);
-                                 decompress(padaview_mask_comp,
-                                             (UBYTE *)padaview_mask);
-                                 decompress(padbview_image_comp,
-                                             (UBYTE *)padbview_image);
-                                 decompress(padbview_mask_comp,
-                                             (UBYTE *)padbview_mask);
-                                 decompress(padcview_image_comp,
-                                             (UBYTE *)padcview_image);
-                                 decompress(padcview_mask_comp,
-                                             (UBYTE *)padcview_mask);
+                                 /* decoded (or only preshifted, if they
+                                 ** are read from the cache) on threads
+                                 ** of their own on the Linux host
+                                 */
+                                 decoded = !read_cache();
+                                 start_decoders(decoded ? IMAGES : 0);
                                  return;
                               }
-                              FreeMem(padcview_image, IMAGESIZE);
+                              free_mem(ACCOUNT_IMAGES, padcview_image, IMAGESIZE);
                            }
-                           FreeMem(padbview_mask, MASKSIZE);
+                           free_mem(ACCOUNT_IMAGES, padbview_mask, MASKSIZE);
                         }
-                        FreeMem(padbview_image, IMAGESIZE);
+                        free_mem(ACCOUNT_IMAGES, padbview_image, IMAGESIZE);
                      }
-                     FreeMem(padaview_mask, MASKSIZE);
+                     free_mem(ACCOUNT_IMAGES, padaview_mask, MASKSIZE);
                   }
-                  FreeMem(padaview_image, IMAGESIZE);
+                  free_mem(ACCOUNT_IMAGES, padaview_image, IMAGESIZE);
                }
-               FreeMem(farview_mask, MASKSIZE);
+               free_mem(ACCOUNT_IMAGES, farview_mask, MASKSIZE);
             }
-            FreeMem(farview_image, IMAGESIZE);
+            free_mem(ACCOUNT_IMAGES, farview_image, IMAGESIZE);
          }
-         FreeMem(title_image_plane_2, TITLESIZE);
+         free_mem(ACCOUNT_IMAGES, title_image_plane_2, TITLESIZE);
       }
-      FreeMem(title_image_plane_1, TITLESIZE);
+      free_mem(ACCOUNT_IMAGES, title_image_plane_1, TITLESIZE);
    }
    
    printf("Could not allocate enough CHIP ram for images!\n");
@@ -141,6 +231,25 @@ void decompress_images()
 }
 
 
+/*
+** finish_images()
+**
+** Wait for the images started by start_images() to be decompressed, and
+** write them to the cache if they were not read from it.
+*/
+void finish_images()
+{
+#ifdef __linux__
+   join_decoders();
+#endif
+   if (decoded)
+   {
+      write_cache();
+      decoded = FALSE;
+   }
+}
+
+
 /*
 ** free_images()
 **
@@ -148,16 +257,24 @@ void decompress_images()
 */
 void free_images()
 {
-   FreeMem(title_image_plane_1, TITLESIZE);
-   FreeMem(title_image_plane_2, TITLESIZE);
-   FreeMem(farview_image, IMAGESIZE);
-   FreeMem(farview_mask, MASKSIZE);
-   FreeMem(padaview_image, IMAGESIZE);
-   FreeMem(padaview_mask, MASKSIZE);
-   FreeMem(padbview_image, IMAGESIZE);
-   FreeMem(padbview_mask, MASKSIZE);
-   FreeMem(padcview_image, IMAGESIZE);
-   FreeMem(padcview_mask, MASKSIZE);
+#ifdef __linux__
+   join_decoders();
+#endif
+   decoded = FALSE;
+   
+   free_mem(ACCOUNT_IMAGES, title_image_plane_1, TITLESIZE);
+   free_mem(ACCOUNT_IMAGES, title_image_plane_2, TITLESIZE);
+   free_mem(ACCOUNT_IMAGES, farview_image, IMAGESIZE);
+   free_mem(ACCOUNT_IMAGES, farview_mask, MASKSIZE);
+   free_mem(ACCOUNT_IMAGES, padaview_image, IMAGESIZE);
+   free_mem(ACCOUNT_IMAGES, padaview_mask, MASKSIZE);
+   free_mem(ACCOUNT_IMAGES, padbview_image, IMAGESIZE);
+   free_mem(ACCOUNT_IMAGES, padbview_mask, MASKSIZE);
+   free_mem(ACCOUNT_IMAGES, padcview_image, IMAGESIZE);
+   free_mem(ACCOUNT_IMAGES, padcview_mask, MASKSIZE);
+#ifdef __linux__
+   host_free_shifted();
+#endif
 }
 
 
@@ -170,6 +287,10 @@ void decompress(UBYTE *source, UBYTE *dest)
 {
    UBYTE code, x, a;
    
+#ifdef __linux__
+   host_begin_count(HOST_VIEWS - 1);
+#endif
+   
    FOREVER
    {
       code = *source;
@@ -202,5 +323,292 @@ void decompress(UBYTE *source, UBYTE *dest)
          }
       }
    }
+   
+#ifdef __linux__
+   host_end_count(HOST_PART_DECOMPRESS);
+#endif
+}
+
+
+/*
+** start_decoders()
+**
+** Run the jobs of decode_job() from 0 to last: on up to DECODERS threads,
+** one a core, on a Linux host with more than one core, or here and now.
+** On one core threads only add to the time.  The host counters only count
+** the thread that started them, so while they are on it is here and now
+** too.
+*/
+static void start_decoders(int last)
+{
+   int job;
+#ifdef __linux__
+   cpu_set_t cores;
+   int n;
+   
+   next_job = 0;
+   last_job = last;
+   decoders = 0;
+   /* the cores this may run on, without reading /sys as sysconf() does */
+   n = (sched_getaffinity(0, sizeof(cores), &cores) == 0) ?
+      CPU_COUNT(&cores) : 1;
+   if ((n > 1) && !host_counting())
+   {
+      n = (n > DECODERS) ? DECODERS : n;
+      n = (n > last + 1) ? last + 1 : n;
+      while ((decoders < n) &&
+         (0 == pthread_create(&decoder_threads[decoders], NULL, decoder, NULL)))
+      {
+         decoders++;
+      }
+   }
+   if (decoders > 0)
+   {
+      return;
+   }
+#endif
+   
+   for (job=0; job <= last; job++)
+   {
+      decode_job(job);
+   }
+}
+
+
+/*
+** decode_job()
+**
+** Do one of the jobs of start_images(): job 0 preshifts the sprites on
+** the Linux host (it is the longest, so it is taken first), and job n
+** decompresses images[n-1].
+*/
+static void decode_job(int job)
+{
+   UWORD *image;
+   
+   if (job == 0)
+   {
+#ifdef __linux__
+      /* without these Bobs are only slower */
+      host_preshift_sprites();
+#endif
+      return;
+   }
+   
+   image = *images[job-1].image;
+   decompress(assets[images[job-1].asset].data, (UBYTE *)image);
+#ifdef __linux__
+   /* decompressed words are big-endian */
+   host_swap_words(image, images[job-1].size);
+#endif
+}
+
+
+#ifdef __linux__
+/*
+** decoder()
+**
+** Thread started by start_decoders(), which takes the next job until
+** there are none left.
+**
+** RETURNS:  NULL.
+*/
+static void *decoder(void *unused)
+{
+   int job;
+   
+   FOREVER
+   {
+      pthread_mutex_lock(&job_lock);
+      job = next_job++;
+      pthread_mutex_unlock(&job_lock);
+      
+      if (job > last_job)
+      {
+         return NULL;
+      }
+      decode_job(job);
+   }
 }
 
+
+/*
+** join_decoders()
+**
+** Wait for the threads started by start_decoders(), if any, to finish.
+*/
+static void join_decoders()
+{
+   while (decoders > 0)
+   {
+      decoders--;
+      pthread_join(decoder_threads[decoders], NULL);
+   }
+}
+#endif
+
+
+/*
+** read_cache()
+**
+** Read every image from the cache file, if there is one that was made
+** from the compressed images there are now and is whole.
+**
+** RETURNS:  TRUE if the images were read, FALSE if they must be
+**           decompressed.
+*/
+static BOOL read_cache()
+{
+   struct CacheHeader header;
+   FILE *file;
+   ULONG sum, size;
+   int n;
+   BOOL ok;
+   
+   if ((cache_name == NULL) || (NULL == (file = fopen(cache_name, "rb"))))
+   {
+      return FALSE;
+   }
+   
+   size = 0;
+   for (n=0; n < IMAGES; n++)
+   {
+      size += images[n].size;
+   }
+   
+   ok = (fread(&header, sizeof(header), 1, file) == 1) &&
+      (header.magic == CACHE_MAGIC) && (header.version == CACHE_VERSION) &&
+      (header.order == CACHE_ORDER) && (header.size == size) &&
+      (header.key == cache_key());
+   
+   sum = HASH_SEED;
+   for (n=0; ok && (n < IMAGES); n++)
+   {
+      ok = (fread(*images[n].image, images[n].size, 1, file) == 1);
+      if (ok)
+      {
+         sum = hash_words(sum, *images[n].image, images[n].size);
+      }
+   }
+   
+   /* nothing may follow the images */
+   if (ok && ((getc(file) != EOF) || (sum != header.sum)))
+   {
+      ok = FALSE;
+   }
+   fclose(file);
+   
+   return ok;
+}
+
+
+/*
+** write_cache()
+**
+** Write every image to the cache file, if there is to be one.  A cache
+** that could not be written whole is removed.
+*/
+static void write_cache()
+{
+   struct CacheHeader header;
+   FILE *file;
+   int n;
+   BOOL ok;
+   
+   if ((cache_name == NULL) || (NULL == (file = fopen(cache_name, "wb"))))
+   {
+      return;
+   }
+   
+   header.magic = CACHE_MAGIC;
+   header.version = CACHE_VERSION;
+   header.order = CACHE_ORDER;
+   header.key = cache_key();
+   header.sum = HASH_SEED;
+   header.size = 0;
+   for (n=0; n < IMAGES; n++)
+   {
+      header.sum = hash_words(header.sum, *images[n].image, images[n].size);
+      header.size += images[n].size;
+   }
+   
+   ok = (fwrite(&header, sizeof(header), 1, file) == 1);
+   for (n=0; ok && (n < IMAGES); n++)
+   {
+      ok = (fwrite(*images[n].image, images[n].size, 1, file) == 1);
+   }
+   if (fclose(file) != 0)
+   {
+      ok = FALSE;
+   }
+   
+   if (!ok)
+   {
+      remove(cache_name);
+   }
+}
+
+
+/*
+** cache_key()
+**
+** RETURNS:  Hash of the compressed images, and the sizes they decompress
+**           to, so a cache made from any others is not used.
+*/
+static ULONG cache_key()
+{
+   ULONG key;
+   int n;
+   
+   key = HASH_SEED;
+   for (n=0; n < IMAGES; n++)
+   {
+      key = hash_bytes(key, (UBYTE *)&images[n].size, sizeof(ULONG));
+      key = hash_bytes(key, assets[images[n].asset].data,
+               assets[images[n].asset].size);
+   }
+   
+   return key;
+}
+
+
+/*
+** hash_bytes()
+**
+** Carry hash (HASH_SEED to begin with) on over size bytes, by 32 bit
+** FNV-1a.
+**
+** RETURNS:  The new hash.
+*/
+static ULONG hash_bytes(ULONG hash, UBYTE *bytes, ULONG size)
+{
+   ULONG n;
+   
+   for (n=0; n < size; n++)
+   {
+      hash = (hash ^ bytes[n]) * 16777619UL;
+   }
+   
+   return hash;
+}
+
+
+/*
+** hash_words()
+**
+** As hash_bytes(), a word at a time, which is twice as quick, over the
+** size bytes at words.
+**
+** RETURNS:  The new hash.
+*/
+static ULONG hash_words(ULONG hash, UWORD *words, ULONG size)
+{
+   ULONG n;
+   
+   for (n=0; n < size / 2; n++)
+   {
+      hash = (hash ^ words[n]) * 16777619UL;
+   }
+   
+   return hash;
+}
@@ -0,0 +1,363 @@
+/*
+** jl_pack.c - the compressed images and the sounds, built in or from an
+**             asset pack
+**
+** (c)1993 Paul Grebenc
+**
+** Everything in jl_images.c that is decompressed (see jl_memory.c) and
+** every sample in jl_sounds.c is an Asset in assets[], which holds where
+** it is and how big.  They point at the arrays built in until
+** load_pack() reads a pack written by jupiterpack: then each asset the
+** pack holds points at its copy there, and the rest stay as they were.
+** On the Linux host the pack is mapped read-only and used where it lies;
+** on the Amiga it is read into one block of CHIP memory, which the
+** samples must be in.  Either way nothing is copied asset by asset.
+**
+** A pack is checked before any asset is taken from it: the header, that
+** every entry lies inside the file and has a name no other entry has,
+** and that every compressed image decompresses to exactly the size it
+** must.  If anything is wrong none of it is used.
+*/
+
+
+/** INCLUDES & DEFINES **/
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "jupiterdefs.h"
+
+
+/** PROTOTYPES **/
+
+int load_pack(char *name);
+void free_pack(void);
+
+static BOOL check_pack(UBYTE *data, ULONG size);
+static struct Asset *find_asset(char *name);
+static BOOL check_compressed(UBYTE *data, ULONG size, ULONG unpacked);
+
+/* jl_account.c */
+extern APTR alloc_mem(int owner, ULONG size, ULONG flags);
+extern void free_mem(int owner, APTR memory, ULONG size);
+
+
+/** GLOBAL VARIABLES **/
+
+extern UBYTE title_image_plane_1_comp[3378];
+extern UBYTE title_image_plane_2_comp[4416];
+extern UBYTE farview_image_comp[2924];
+extern UBYTE farview_mask_comp[2560];
+extern UBYTE padaview_image_comp[2107];
+extern UBYTE padaview_mask_comp[1887];
+extern UBYTE padbview_image_comp[962];
+extern UBYTE padbview_mask_comp[739];
+extern UBYTE padcview_image_comp[2264];
+extern UBYTE padcview_mask_comp[1113];
+
+extern UWORD chip start_tune_a[11919];
+extern UWORD chip start_tune_b[344];
+extern UBYTE chip tick_sound[760];
+extern UBYTE chip crash_sound[9716];
+extern UBYTE chip main_thruster_sound[3028];
+extern UBYTE chip side_thruster_sound[2958];
+
+/* in the order of the ASSET_* numbers */
+struct Asset assets[ASSETS] = {
+   { "title_image_plane_1", title_image_plane_1_comp,
+      sizeof(title_image_plane_1_comp), TITLESIZE, FALSE },
+   { "title_image_plane_2", title_image_plane_2_comp,
+      sizeof(title_image_plane_2_comp), TITLESIZE, FALSE },
+   { "farview_image", farview_image_comp,
+      sizeof(farview_image_comp), IMAGESIZE, FALSE },
+   { "farview_mask", farview_mask_comp,
+      sizeof(farview_mask_comp), MASKSIZE, FALSE },
+   { "padaview_image", padaview_image_comp,
+      sizeof(padaview_image_comp), IMAGESIZE, FALSE },
+   { "padaview_mask", padaview_mask_comp,
+      sizeof(padaview_mask_comp), MASKSIZE, FALSE },
+   { "padbview_image", padbview_image_comp,
+      sizeof(padbview_image_comp), IMAGESIZE, FALSE },
+   { "padbview_mask", padbview_mask_comp,
+      sizeof(padbview_mask_comp), MASKSIZE, FALSE },
+   { "padcview_image", padcview_image_comp,
+      sizeof(padcview_image_comp), IMAGESIZE, FALSE },
+   { "padcview_mask", padcview_mask_comp,
+      sizeof(padcview_mask_comp), MASKSIZE, FALSE },
+   { "start_tune_a", (UBYTE *)start_tune_a, sizeof(start_tune_a), 0, TRUE },
+   { "start_tune_b", (UBYTE *)start_tune_b, sizeof(start_tune_b), 0, TRUE },
+   { "tick_sound", tick_sound, sizeof(tick_sound), 0, FALSE },
+   { "crash_sound", crash_sound, sizeof(crash_sound), 0, FALSE },
+   { "main_thruster_sound", main_thruster_sound,
+      sizeof(main_thruster_sound), 0, FALSE },
+   { "side_thruster_sound", side_thruster_sound,
+      sizeof(side_thruster_sound), 0, FALSE }
+};
+
+/* the assets as built in, while a pack is loaded */
+static struct Asset built_in[ASSETS];
+
+static UBYTE *pack = NULL;
+static ULONG pack_size;
+
+
+/*-----------------------------------------------------------------------*/
+
+
+/*
+** load_pack()
+**
+** Read the asset pack in file name and point each asset it holds at its
+** copy there.  Use free_pack() to go back to the assets built in.
+**
+** RETURNS:  Number of assets taken from the pack, 0 if there is no such
+**           file, -1 if it cannot be read or is not a good pack (and
+**           nothing is taken).
+*/
+int load_pack(char *name)
+{
+   struct PackHeader *header;
+   struct PackEntry *entry;
+   struct Asset *asset;
+   UBYTE *data;
+   ULONG size, n;
+   int count;
+#ifdef __linux__
+   struct stat info;
+   APTR map;
+   int file;
+#else
+   FILE *file;
+#endif
+
+   if (pack != NULL)
+   {
+      free_pack();
+   }
+
+#ifdef __linux__
+   if (-1 == (file = open(name, O_RDONLY)))
+   {
+      return 0;
+   }
+   if ((fstat(file, &info) == -1) || (info.st_size < sizeof(struct PackHeader)))
+   {
+      close(file);
+      return -1;
+   }
+   size = info.st_size;
+   map = mmap(NULL, size, PROT_READ, MAP_SHARED, file, 0);
+   close(file);
+   if (map == MAP_FAILED)
+   {
+      return -1;
+   }
+   data = (UBYTE *)map;
+#else
+   if (NULL == (file = fopen(name, "rb")))
+   {
+      return 0;
+   }
+   fseek(file, 0, SEEK_END);
+   size = ftell(file);
+   fseek(file, 0, SEEK_SET);
+   if ((size < sizeof(struct PackHeader)) ||
+      (NULL == (data = (UBYTE *)alloc_mem(ACCOUNT_PACK, size, MEMF_CHIP))))
+   {
+      fclose(file);
+      return -1;
+   }
+   if (fread(data, 1, size, file) != size)
+   {
+      fclose(file);
+      free_mem(ACCOUNT_PACK, data, size);
+      return -1;
+   }
+   fclose(file);
+#endif
+
+   if (!check_pack(data, size))
+   {
+#ifdef __linux__
+      munmap(data, size);
+#else
+      free_mem(ACCOUNT_PACK, data, size);
+#endif
+      return -1;
+   }
+   pack = data;
+   pack_size = size;
+
+   memcpy(built_in, assets, sizeof(assets));
+   header = (struct PackHeader *)pack;
+   entry = (struct PackEntry *)(pack + sizeof(struct PackHeader));
+   count = 0;
+   for (n=0; n < header->count; n++, entry++)
+   {
+      /* an asset this game does not know of is no use to it */
+      if (asset = find_asset(entry->name))
+      {
+         asset->data = pack + entry->offset;
+         asset->size = entry->size;
+         count++;
+      }
+   }
+
+   return count;
+}
+
+
+/*
+** free_pack()
+**
+** Point every asset back at the one built in and let go of the pack
+** loaded by load_pack(), if there is one.
+*/
+void free_pack()
+{
+   if (pack == NULL)
+   {
+      return;
+   }
+
+   memcpy(assets, built_in, sizeof(assets));
+#ifdef __linux__
+   munmap(pack, pack_size);
+#else
+   free_mem(ACCOUNT_PACK, pack, pack_size);
+#endif
+   pack = NULL;
+}
+
+
+/*
+** check_pack()
+**
+** RETURNS:  TRUE if the size bytes at data are a pack for this machine
+**           whose every entry can be used, FALSE if not.
+*/
+static BOOL check_pack(UBYTE *data, ULONG size)
+{
+   struct PackHeader *header;
+   struct PackEntry *entry, *earlier;
+   struct Asset *asset;
+   ULONG n;
+
+   header = (struct PackHeader *)data;
+   if ((header->magic != PACK_MAGIC) || (header->version != PACK_VERSION) ||
+      (header->order != PACK_ORDER) || (header->size != size) ||
+      (header->count > (size - sizeof(struct PackHeader)) /
+         sizeof(struct PackEntry)))
+   {
+      return FALSE;
+   }
+
+   entry = (struct PackEntry *)(data + sizeof(struct PackHeader));
+   for (n=0; n < header->count; n++, entry++)
+   {
+      if ((entry->name[PACK_NAME - 1] != '\0') ||
+         (entry->offset % PACK_ALIGN != 0) || (entry->offset > size) ||
+         (entry->size > size - entry->offset))
+      {
+         return FALSE;
+      }
+
+      /* else which of the two is used would depend on the order */
+      for (earlier = (struct PackEntry *)(data + sizeof(struct PackHeader));
+         earlier < entry; earlier++)
+      {
+         if (!strcmp(earlier->name, entry->name))
+         {
+            return FALSE;
+         }
+      }
+
+      if (asset = find_asset(entry->name))
+      {
+         if (asset->unpacked > 0)
+         {
+            if (!check_compressed(data + entry->offset, entry->size,
+                  asset->unpacked))
+            {
+               return FALSE;
+            }
+         }
+         else if ((entry->size == 0) || (asset->words && (entry->size & 1)))
+         {
+            return FALSE;
+         }
+      }
+   }
+
+   return TRUE;
+}
+
+
+/*
+** find_asset()
+**
+** RETURNS:  The asset called name, NULL if there is none.
+*/
+static struct Asset *find_asset(char *name)
+{
+   int n;
+
+   for (n=0; n < ASSETS; n++)
+   {
+      if (!strcmp(assets[n].name, name))
+      {
+         return &assets[n];
+      }
+   }
+
+   return NULL;
+}
+
+
+/*
+** check_compressed()
+**
+** Walk the codes of the size bytes at data as decompress() in jl_memory.c
+** would, without writing anything.
+**
+** RETURNS:  TRUE if they end inside data and decompress to exactly
+**           unpacked bytes, FALSE if not.
+*/
+static BOOL check_compressed(UBYTE *data, ULONG size, ULONG unpacked)
+{
+   ULONG in, out;
+   UBYTE code;
+
+   in = out = 0;
+   while (in < size)
+   {
+      code = data[in++];
+
+      if (code == 0)
+      {
+         return (out == unpacked);
+      }
+
+      if (code & 0x80)
+      {
+         in++;
+         out += code & 0x7f;
+      }
+      else
+      {
+         in += code;
+         out += code;
+      }
+
+      if ((in > size) || (out > unpacked))
+      {
+         return FALSE;
+      }
+   }
+
+   return FALSE;
+}
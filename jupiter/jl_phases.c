@@ -0,0 +1,293 @@
+/*
+** jl_phases.c - where the time of each frame goes
+**
+** (c)1993 Paul Grebenc
+**
+** So that a slow machine (or a fast card that is slow at something) can
+** be looked into without a debugger, the parts of each frame are timed by
+** the E clock as the game runs: reading the window's messages, moving the
+** probe, the velocity scale, collision checking, placing the flames,
+** drawing and waiting for the next frame.  The latest PHASE_RING times of
+** each are kept in a ring, from which the least, mean and 99th percentile
+** are worked out when asked for, so timing a part costs two readings of
+** the clock and a store.
+**
+** With the overlay on the times are shown at the top of the window once
+** every PHASE_SHOW frames, and they are all printed when the game closes.
+**
+** On Linux each part is also counted by the CPU's performance counters,
+** in each view, if they have been started (see jl_hostcount.c).
+*/
+
+
+/** INCLUDES & DEFINES **/
+
+#include "jupiterdefs.h"
+
+/* the biggest 1 in 100 of a full ring, for the 99th percentile */
+#define TOP             (PHASE_RING / 100)
+
+
+/** PROTOTYPES **/
+
+int setup_phases(struct GameInfo *gameinfo, BOOL overlay);
+void cleanup_phases(struct GameInfo *gameinfo);
+void begin_phase(struct GameInfo *gameinfo, int phase);
+void end_phase(struct GameInfo *gameinfo, int phase);
+void show_phases(struct GameInfo *gameinfo);
+
+static void phase_times(struct PhaseTimes *phases, int phase, ULONG *least,
+   ULONG *mean, ULONG *p99);
+static ULONG micros(struct PhaseTimes *phases, ULONG ticks);
+
+
+/** GLOBAL VARIABLES **/
+
+/* jl_clock.c */
+extern struct timerequest *open_eclock(void);
+extern void close_eclock(struct timerequest *timerio);
+
+/* jl_trace.c */
+extern void trace_begin(struct GameInfo *gameinfo, char *name);
+extern void trace_end(struct GameInfo *gameinfo, char *name);
+
+static char *phase_names[PHASES] = {
+   "input", "move", "scale", "collide", "flames", "draw", "wait"
+};
+
+/* for the overlay */
+static char *phase_tags[PHASES] = {
+   "in", "mv", "sc", "co", "fl", "dr", "wt"
+};
+
+
+/*-----------------------------------------------------------------------*/
+
+
+/*
+** setup_phases()
+**
+** Start timing the parts of each frame of a game, showing the times in
+** its window if overlay is TRUE.  Opens timer.device for the E clock.
+**
+** RETURNS:  TRUE if successful, FALSE if unsuccessful.
+*/
+int setup_phases(struct GameInfo *gameinfo, BOOL overlay)
+{
+   struct PhaseTimes *phases;
+   int phase;
+
+   if (phases = (struct PhaseTimes *)AllocMem(sizeof(struct PhaseTimes),
+         MEMF_PUBLIC | MEMF_CLEAR))
+   {
+      if (phases->TimerIO = open_eclock())
+      {
+         phases->rate = ReadEClock(&phases->start);
+         for (phase=0; phase < PHASES; phase++)
+         {
+            phases->least[phase] = 0xffffffff;
+         }
+         phases->overlay = overlay;
+
+         gameinfo->phases = phases;
+         return TRUE;
+      }
+      FreeMem(phases, sizeof(struct PhaseTimes));
+   }
+   else
+   {
+      printf("Could not allocate frame timers\n");
+   }
+   return FALSE;
+}
+
+
+/*
+** cleanup_phases()
+**
+** Print how long each part of a frame took, then stop timing them and
+** close timer.device.
+*/
+void cleanup_phases(struct GameInfo *gameinfo)
+{
+   struct PhaseTimes *phases;
+   ULONG least, mean, p99;
+   int phase;
+
+   phases = gameinfo->phases;
+   gameinfo->phases = NULL;
+
+   printf("frame part   times   least    mean     p99  (microseconds)\n");
+   for (phase=0; phase < PHASES; phase++)
+   {
+      phase_times(phases, phase, &least, &mean, &p99);
+      printf("%-10s %7lu %7lu %7lu %7lu\n", phase_names[phase],
+         (unsigned long)phases->count[phase], (unsigned long)least,
+         (unsigned long)mean, (unsigned long)p99);
+   }
+
+   close_eclock(phases->TimerIO);
+   FreeMem(phases, sizeof(struct PhaseTimes));
+}
+
+
+/*
+** begin_phase()
+**
+** Start timing phase, a part of a frame, if the game's frames are being
+** timed, and mark its start in the game's trace.
+*/
+void begin_phase(struct GameInfo *gameinfo, int phase)
+{
+   trace_begin(gameinfo, phase_names[phase]);
+
+#ifdef __linux__
+   host_begin_count(((gameinfo->view >= GO_FAR) && (gameinfo->view <= GO_PAD_C)) ?
+      gameinfo->view - GO_FAR : HOST_VIEWS - 1);
+#endif
+
+   if (gameinfo->phases != NULL)
+   {
+      ReadEClock(&gameinfo->phases->start);
+   }
+}
+
+
+/*
+** end_phase()
+**
+** Keep how long phase (PHASE_INPUT and so on) took since begin_phase(),
+** and mark its end in the game's trace.
+*/
+void end_phase(struct GameInfo *gameinfo, int phase)
+{
+   struct PhaseTimes *phases;
+   struct EClockVal now;
+   ULONG ticks;
+
+#ifdef __linux__
+   host_end_count(phase);
+#endif
+   trace_end(gameinfo, phase_names[phase]);
+
+   if (NULL == (phases = gameinfo->phases))
+   {
+      return;
+   }
+
+   ReadEClock(&now);
+   ticks = now.ev_lo - phases->start.ev_lo;
+
+   phases->ring[phase][phases->count[phase] % PHASE_RING] = ticks;
+   phases->count[phase]++;
+   if (ticks < phases->least[phase])
+   {
+      phases->least[phase] = ticks;
+   }
+}
+
+
+/*
+** show_phases()
+**
+** Once every PHASE_SHOW frames, if the overlay is on, print the mean and
+** 99th percentile time of each part of a frame at the top of the window.
+*/
+void show_phases(struct GameInfo *gameinfo)
+{
+   struct PhaseTimes *phases;
+   struct RastPort *rp;
+   char line[96];
+   ULONG least, mean, p99;
+   int phase, row, length;
+
+   phases = gameinfo->phases;
+   if ((phases == NULL) || !phases->overlay ||
+      (++phases->frames < PHASE_SHOW))
+   {
+      return;
+   }
+   phases->frames = 0;
+
+   rp = gameinfo->window->RPort;
+   SetDrMd(rp, JAM2);
+   SetAPen(rp, WHITE);
+   SetBPen(rp, BLACK);
+
+   /* three parts to a line, mean/p99 of each */
+   for (phase=0, row=0; phase < PHASES; row++)
+   {
+      length = 0;
+      for (; (phase < PHASES) && (length < 30); phase++)
+      {
+         phase_times(phases, phase, &least, &mean, &p99);
+         length += sprintf(line + length, "%s%4lu/%-4lu", phase_tags[phase],
+            (unsigned long)mean, (unsigned long)p99);
+      }
+      Move(rp, 6, gameinfo->title_height + 8 + row*8);
+      Text(rp, line, length);
+   }
+}
+
+
+/*
+** phase_times()
+**
+** Work out the least time phase has ever taken, and the mean and 99th
+** percentile of the times in its ring, in microseconds.
+*/
+static void phase_times(struct PhaseTimes *phases, int phase, ULONG *least,
+   ULONG *mean, ULONG *p99)
+{
+   ULONG top[TOP + 1];
+   ULONG total, ticks;
+   LONG times, n;
+   int kept, k;
+
+   times = (phases->count[phase] < PHASE_RING) ? phases->count[phase] : PHASE_RING;
+   if (times == 0)
+   {
+      *least = *mean = *p99 = 0;
+      return;
+   }
+
+   /* the biggest times / 100 + 1, biggest first; the smallest of them is
+   ** the time 99 in 100 took no longer than
+   */
+   total = 0;
+   kept = 0;
+   for (n=0; n < times; n++)
+   {
+      ticks = phases->ring[phase][n];
+      total += ticks;
+
+      if ((kept == times / 100 + 1) && (ticks <= top[kept-1]))
+      {
+         continue;
+      }
+      if (kept < times / 100 + 1)
+      {
+         kept++;
+      }
+      for (k=kept-1; (k > 0) && (top[k-1] < ticks); k--)
+      {
+         top[k] = top[k-1];
+      }
+      top[k] = ticks;
+   }
+
+   *least = micros(phases, phases->least[phase]);
+   *mean = micros(phases, total / times);
+   *p99 = micros(phases, top[kept-1]);
+}
+
+
+/*
+** micros()
+**
+** RETURNS:  E clock ticks in microseconds.
+*/
+static ULONG micros(struct PhaseTimes *phases, ULONG ticks)
+{
+   return ticks * 1000 / (phases->rate / 1000);
+}
@@ -0,0 +1,558 @@
+/*
+** jl_physics.c - how the probe flies
+**
+** (c)1993 Paul Grebenc
+**
+** The rules a probe is flown by a frame at a time, apart from drawing it.
+** fire_thrusters() fires the thrusters being held and fly_probe() applies
+** gravity and moves the probe, working out where it is drawn and whether
+** it has left the view; the game calls them from read_controls() and
+** move_probe().  probe_hits() does with the collision masks of a view
+** what DoCollision() and probe_collision() do with its Bobs, and
+** landing_score() scores a landing as do_landed() does, so that with
+** step_probe() a probe can be flown without a window at all (see
+** jupiterpolicy.c).  mark_view() and mark_probe() draw the same masks
+** into a small occupancy image, for jl_env.c.
+*/
+
+
+/** INCLUDES & DEFINES **/
+
+#include "jupiterdefs.h"
+
+/* the image of each view, as placed by do_far_view() and the like */
+#define VIEW_X          (3)
+#define VIEW_Y          (-10)
+#define VIEW_WORDS      (17)
+#define VIEW_HEIGHT     (179)
+#define VIEW_WIDTH      (VIEW_WORDS*16)
+
+#define PAD_HEIGHT      (8)
+
+/* where the land and pad of a view are, see do_pad_a() and the like */
+struct ViewMasks {
+   UWORD **land;
+   UWORD *pad;          /* NULL in the far view */
+   int pad_x;
+   int pad_y;
+   int pad_words;
+   int bonus;
+};
+
+
+/** PROTOTYPES **/
+
+void fire_thrusters(struct PhysicsInfo *physics, struct ProbeInfo *probeinfo);
+int fly_probe(struct PhysicsInfo *physics, struct ProbeInfo *probeinfo,
+   int view, int top, WORD *x, WORD *y);
+void place_probe(struct ProbeInfo *probeinfo, int view, int top, WORD *x,
+   WORD *y);
+int probe_hits(int view, int top, int x, int y);
+int landing_score(int view, int x, float y_vel);
+int step_probe(struct PhysicsInfo *physics, struct ProbeInfo *probeinfo,
+   int view, int top, int *score);
+
+void mark_view(int view, UBYTE *image, int width, int height);
+void mark_probe(int view, int top, int x, int y, UBYTE *image, int width,
+   int height);
+
+static int masks_meet(UWORD *mask_a, int words_a, int height_a, int x_a,
+   int y_a, UWORD *mask_b, int words_b, int height_b, int x_b, int y_b);
+static void mark_mask(UWORD *mask, int words, int rows, int x, int y,
+   UBYTE value, UBYTE *image, int width, int height);
+static int any_bits(UWORD *row, int from, int to);
+
+
+/** GLOBAL VARIABLES **/
+
+/* jl_images.c */
+extern UWORD chip smallprobe_image[1*2*21];
+extern UWORD chip largeprobe_image[1*42*3];
+extern UWORD chip pada_mask[1*8*6];
+extern UWORD chip padb_mask[1*8*6];
+extern UWORD chip padc_mask[1*8*5];
+
+/* jl_memory.c */
+extern UWORD *farview_mask;
+extern UWORD *padaview_mask;
+extern UWORD *padbview_mask;
+extern UWORD *padcview_mask;
+
+/* of GO_FAR to GO_PAD_C */
+static struct ViewMasks view_masks[4] = {
+   { &farview_mask,  NULL,       0,  0,   0, 0  },
+   { &padaview_mask, pada_mask,  91, 117, 6, 5  },
+   { &padbview_mask, padb_mask,  97, 74,  6, 2  },
+   { &padcview_mask, padc_mask,  93, 133, 5, 10 }
+};
+
+
+/*-----------------------------------------------------------------------*/
+
+
+/*
+** fire_thrusters()
+**
+** Fire the thrusters held in probeinfo->user_input (CURSOR_* bits) for
+** one frame, for as long as there is fuel.
+*/
+void fire_thrusters(struct PhysicsInfo *physics, struct ProbeInfo *probeinfo)
+{
+   if ((probeinfo->user_input & CURSOR_UP) && (probeinfo->fuel >= 0))
+   {
+      if (probeinfo->y_vel > -1.925)
+      {
+         probeinfo->y_vel-=physics->thrust;
+      }
+      probeinfo->fuel-=physics->burn;
+   }
+   if ((probeinfo->user_input & CURSOR_RIGHT) && (probeinfo->fuel >= 0))
+   {
+      probeinfo->x_vel-=physics->side_thrust;
+      probeinfo->fuel-=physics->side_burn;
+   }
+   if ((probeinfo->user_input & CURSOR_LEFT) && (probeinfo->fuel >= 0))
+   {
+      probeinfo->x_vel+=physics->side_thrust;
+      probeinfo->fuel-=physics->side_burn;
+   }
+}
+
+
+/*
+** fly_probe()
+**
+** Apply gravity and move the probe for one frame of view, and work out
+** where its Bob goes (*x, *y) in a window whose top line is at top.
+**
+** RETURNS:  GO_FAR from a pad view, or GO_PAD_A, GO_PAD_B or GO_PAD_C
+**           from the far view, if the probe has left the view
+**           OK otherwise
+*/
+int fly_probe(struct PhysicsInfo *physics, struct ProbeInfo *probeinfo,
+   int view, int top, WORD *x, WORD *y)
+{
+   int result;
+
+   result = OK;
+
+   /* gravity is always active */
+   if (probeinfo->y_vel < 1.975)
+   {
+      probeinfo->y_vel += physics->gravity;
+   }
+
+   /* work out new positions for probe */
+   probeinfo->x_pos += probeinfo->x_vel;
+   probeinfo->y_pos += probeinfo->y_vel;
+   /* */
+
+   /* check if we've left this view */
+   switch (view)
+   {
+      case GO_FAR:
+            if (probeinfo->y_pos >= 90)
+            {
+               if (probeinfo->x_pos < 101)
+               {
+                  result = GO_PAD_A;
+               }
+               if (probeinfo->x_pos > 180)
+               {
+                  result = GO_PAD_C;
+               }
+            }
+            if ((probeinfo->y_pos >= 10)
+               && (probeinfo->x_pos >= 100)
+               && (probeinfo->x_pos <= 180))
+            {
+               result = GO_PAD_B;
+            }
+            break;
+      case GO_PAD_A:
+            if (probeinfo->y_pos < 90)
+            {
+               result = GO_FAR;
+            }
+            break;
+      case GO_PAD_B:
+            if ((probeinfo->y_pos < 10) || (probeinfo->x_pos < 100)
+               || (probeinfo->x_pos > 180))
+            {
+               result = GO_FAR;
+            }
+            break;
+      case GO_PAD_C:
+            if (probeinfo->y_pos < 90)
+            {
+               result = GO_FAR;
+            }
+            break;
+   }
+   /* */
+
+   place_probe(probeinfo, view, top, x, y);
+
+   return result;
+}
+
+
+/*
+** place_probe()
+**
+** Work out where the probe's Bob goes (*x, *y) in view, in a window whose
+** top line is at top.
+*/
+void place_probe(struct ProbeInfo *probeinfo, int view, int top, WORD *x,
+   WORD *y)
+{
+   switch (view)
+   {
+      case GO_FAR:
+            *x = (SHORT)probeinfo->x_pos+3;
+            *y = (SHORT)probeinfo->y_pos+top;
+            break;
+      case GO_PAD_A:
+            *x = (SHORT)(((probeinfo->x_pos - 10) * 2) + 3);
+            *y = (SHORT)(((probeinfo->y_pos - 90) * 2) + top);
+            break;
+      case GO_PAD_B:
+            *x = (SHORT)(((probeinfo->x_pos - 85) * 2) + 3);
+            *y = (SHORT)(((probeinfo->y_pos - 10) * 2) + top);
+            break;
+      case GO_PAD_C:
+            *x = (SHORT)(((probeinfo->x_pos - 140) * 2) + 3);
+            *y = (SHORT)(((probeinfo->y_pos - 90) * 2) + top);
+            break;
+   }
+}
+
+
+/*
+** probe_hits()
+**
+** Check the probe's Bob at x, y against the land and pad of view, in a
+** window whose top line is at top.  The land is checked first, since
+** probe_collision() never lets a landing undo a crash.  The view's
+** images must be decompressed.
+**
+** RETURNS:  CRASHED if the probe touches the land
+**           LANDED if it touches only the pad
+**           OK otherwise
+*/
+int probe_hits(int view, int top, int x, int y)
+{
+   struct ViewMasks *masks;
+   UWORD *probe;
+   int words, height;
+
+   masks = &view_masks[view - GO_FAR];
+
+   if (view == GO_FAR)
+   {
+      probe = smallprobe_image;
+      words = 2;
+      height = 21;
+   }
+   else
+   {
+      probe = largeprobe_image;
+      words = 3;
+      height = 42;
+   }
+
+   if (masks_meet(probe, words, height, x, y, *masks->land, VIEW_WORDS,
+         VIEW_HEIGHT, VIEW_X, top + VIEW_Y))
+   {
+      return CRASHED;
+   }
+   if ((masks->pad != NULL) && masks_meet(probe, words, height, x, y,
+         masks->pad, masks->pad_words, PAD_HEIGHT, masks->pad_x,
+         top + masks->pad_y))
+   {
+      return LANDED;
+   }
+
+   return OK;
+}
+
+
+/*
+** landing_score()
+**
+** Score a touchdown on the pad of view with the probe's Bob at x, as
+** do_landed() does.
+**
+** RETURNS:  Points times the pad's bonus, or -1 if the landing is a
+**           crash (too hard, or a leg off pad b).
+*/
+int landing_score(int view, int x, float y_vel)
+{
+   if ((view == GO_PAD_B) && ((x < 97) || (x > 132)))
+   {
+      return -1;
+   }
+   if (y_vel >= 0.35)
+   {
+      return -1;
+   }
+
+   return (int)((0.35-y_vel)*1575.0) * view_masks[view - GO_FAR].bonus;
+}
+
+
+/*
+** step_probe()
+**
+** Fly the probe one frame of view, as step_game() plays it from MOVE to
+** the end of SKY_CHECK, with the thrusters in probeinfo->user_input.
+**
+** RETURNS:  LANDED with *score set, if the probe has landed
+**           CRASHED, also for a landing too hard to score
+**           OUT_OF_SKY
+**           GO_FAR, GO_PAD_A, GO_PAD_B or GO_PAD_C if it left the view
+**           OK otherwise
+*/
+int step_probe(struct PhysicsInfo *physics, struct ProbeInfo *probeinfo,
+   int view, int top, int *score)
+{
+   int result;
+   WORD x, y;
+
+   fire_thrusters(physics, probeinfo);
+   result = fly_probe(physics, probeinfo, view, top, &x, &y);
+
+   switch (probe_hits(view, top, x, y))
+   {
+      case CRASHED:
+            return CRASHED;
+            break;
+      case LANDED:
+            *score = landing_score(view, x, probeinfo->y_vel);
+            return (*score < 0) ? CRASHED : LANDED;
+            break;
+   }
+
+   if ((result == OK) && (view == GO_FAR) && (probeinfo->y_pos <= -21))
+   {
+      return OUT_OF_SKY;
+   }
+
+   return result;
+}
+
+
+/*
+** masks_meet()
+**
+** Compare two one-plane collision masks at their positions, fetching the
+** words of b shifted into line with each word of a.
+**
+** RETURNS:  TRUE if any set bits coincide, FALSE otherwise.
+*/
+static int masks_meet(UWORD *mask_a, int words_a, int height_a, int x_a,
+   int y_a, UWORD *mask_b, int words_b, int height_b, int x_b, int y_b)
+{
+   int top, bottom;
+   int row, k;
+   int offset, index, shift;
+   UWORD *row_a;
+   UWORD *row_b;
+   ULONG pair;
+
+   top = (y_a > y_b) ? y_a : y_b;
+   bottom = (y_a + height_a < y_b + height_b) ? y_a + height_a : y_b + height_b;
+
+   for (row=top; row < bottom; row++)
+   {
+      row_a = mask_a + (row - y_a) * words_a;
+      row_b = mask_b + (row - y_b) * words_b;
+
+      for (k=0; k < words_a; k++)
+      {
+         if (row_a[k] == 0)
+         {
+            continue;
+         }
+
+         /* bit offset into b's row of the first pixel of this word of a */
+         offset = x_a + k*16 - x_b;
+         index = offset >> 4;
+         shift = offset & 15;
+
+         if ((index < -1) || (index >= words_b))
+         {
+            continue;
+         }
+
+         pair = 0;
+         if (index >= 0)
+         {
+            pair = (ULONG)row_b[index] << 16;
+         }
+         if (index+1 < words_b)
+         {
+            pair |= row_b[index+1];
+         }
+
+         if (row_a[k] & (UWORD)((pair << shift) >> 16))
+         {
+            return TRUE;
+         }
+      }
+   }
+
+   return FALSE;
+}
+
+
+/*
+** mark_view()
+**
+** Draw the land and pad of view into an occupancy image width by height
+** cells, scaled from the image of the view (272 by 179 pixels): ENV_LAND
+** or ENV_PAD in each cell where they cover any pixel, ENV_EMPTY elsewhere.
+** The view's images must be decompressed.
+*/
+void mark_view(int view, UBYTE *image, int width, int height)
+{
+   struct ViewMasks *masks;
+
+   masks = &view_masks[view - GO_FAR];
+
+   memset(image, ENV_EMPTY, width * height);
+
+   mark_mask(*masks->land, VIEW_WORDS, VIEW_HEIGHT, 0, 0, ENV_LAND, image,
+      width, height);
+   if (masks->pad != NULL)
+   {
+      mark_mask(masks->pad, masks->pad_words, PAD_HEIGHT, masks->pad_x - VIEW_X,
+         masks->pad_y - VIEW_Y, ENV_PAD, image, width, height);
+   }
+}
+
+
+/*
+** mark_probe()
+**
+** Draw the probe, its Bob at x, y in a window whose top line is at top,
+** into an occupancy image of view drawn by mark_view(), as ENV_PROBE.
+*/
+void mark_probe(int view, int top, int x, int y, UBYTE *image, int width,
+   int height)
+{
+   if (view == GO_FAR)
+   {
+      mark_mask(smallprobe_image, 2, 21, x - VIEW_X, y - (top + VIEW_Y),
+         ENV_PROBE, image, width, height);
+   }
+   else
+   {
+      mark_mask(largeprobe_image, 3, 42, x - VIEW_X, y - (top + VIEW_Y),
+         ENV_PROBE, image, width, height);
+   }
+}
+
+
+/*
+** mark_mask()
+**
+** Set to value each cell of an occupancy image of a view where a one-plane
+** mask, words wide and rows high at x, y in the view's image, has a pixel
+** set.  The rows of the mask falling in a row of cells are ORed together
+** first, so that each cell is then only a test of a few bits of one row.
+*/
+static void mark_mask(UWORD *mask, int words, int rows, int x, int y,
+   UBYTE value, UBYTE *image, int width, int height)
+{
+   UWORD band[VIEW_WORDS];
+   int row, col, k;
+   int top, bottom, left, right;
+   UWORD *line;
+
+   for (row=0; row < height; row++)
+   {
+      /* rows of the mask in this row of cells */
+      top = row * VIEW_HEIGHT / height;
+      bottom = (row + 1) * VIEW_HEIGHT / height;
+      if (bottom == top)
+      {
+         bottom++;
+      }
+      top = ((top > y) ? top : y) - y;
+      bottom = ((bottom < y + rows) ? bottom : y + rows) - y;
+      if (top >= bottom)
+      {
+         continue;
+      }
+
+      for (k=0; k < words; k++)
+      {
+         band[k] = 0;
+      }
+      for (line=mask + top*words; line < mask + bottom*words; line+=words)
+      {
+         for (k=0; k < words; k++)
+         {
+            band[k] |= line[k];
+         }
+      }
+
+      for (col=0; col < width; col++)
+      {
+         /* pixels of the mask in this cell */
+         left = col * VIEW_WIDTH / width;
+         right = (col + 1) * VIEW_WIDTH / width;
+         if (right == left)
+         {
+            right++;
+         }
+         left = ((left > x) ? left : x) - x;
+         right = ((right < x + words*16) ? right : x + words*16) - x;
+         if (left >= right)
+         {
+            continue;
+         }
+
+         if (any_bits(band, left, right))
+         {
+            image[row * width + col] = value;
+         }
+      }
+   }
+}
+
+
+/*
+** any_bits()
+**
+** RETURNS:  TRUE if any of pixels from to to-1 of a mask row are set,
+**           FALSE otherwise.
+*/
+static int any_bits(UWORD *row, int from, int to)
+{
+   int k, first, last;
+   UWORD bits;
+
+   first = from >> 4;
+   last = (to - 1) >> 4;
+
+   for (k=first; k <= last; k++)
+   {
+      bits = row[k];
+      if (k == first)
+      {
+         bits &= 0xffff >> (from & 15);
+      }
+      if (k == last)
+      {
+         bits &= 0xffff << (15 - ((to - 1) & 15));
+      }
+      if (bits)
+      {
+         return TRUE;
+      }
+   }
+
+   return FALSE;
+}
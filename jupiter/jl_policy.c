@@ -0,0 +1,226 @@
+/*
+** jl_policy.c - flying by a policy table, for the Linux host
+**
+** (c)1993 Paul Grebenc
+**
+** A policy table written by jupiterpolicy is mapped into memory as it is
+** on disk and read where it lies, so it costs nothing to load however
+** big it is and is shared by every thread and program flying by it.
+** policy_input() finds the cell the probe is in and returns the
+** thrusters the table holds for it.
+**
+** A table is checked when it is mapped: every view's grid must lie
+** inside the cells the file holds, so that no state of the probe can
+** lead policy_input() outside them.
+*/
+
+
+/** INCLUDES & DEFINES **/
+
+#include <fcntl.h>
+#include <math.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "jupiterdefs.h"
+
+
+/** PROTOTYPES **/
+
+struct Policy *load_policy(char *name);
+void free_policy(struct Policy *policy);
+int policy_input(struct Policy *policy, int view, struct ProbeInfo *probeinfo);
+LONG policy_cell(struct PolicyGrid *grid, struct ProbeInfo *probeinfo);
+
+static BOOL check_policy(struct PolicyHeader *header, LONG size);
+static LONG nearest(struct PolicyGrid *grid, int dim, float value);
+
+
+/*-----------------------------------------------------------------------*/
+
+
+/*
+** load_policy()
+**
+** Map the policy table in file name.  Use free_policy() to unmap it.
+**
+** RETURNS:  Address of the Policy if successful, NULL if the file cannot
+**           be read or is not a policy table.
+*/
+struct Policy *load_policy(char *name)
+{
+   struct Policy *policy;
+   struct PolicyHeader *header;
+   struct stat info;
+   APTR map;
+   int file;
+
+   if (-1 == (file = open(name, O_RDONLY)))
+   {
+      return NULL;
+   }
+   if ((fstat(file, &info) == -1) || (info.st_size < sizeof(struct PolicyHeader)))
+   {
+      close(file);
+      return NULL;
+   }
+   map = mmap(NULL, info.st_size, PROT_READ, MAP_SHARED, file, 0);
+   close(file);
+   if (map == MAP_FAILED)
+   {
+      return NULL;
+   }
+
+   header = (struct PolicyHeader *)map;
+   if (!check_policy(header, info.st_size))
+   {
+      munmap(map, info.st_size);
+      return NULL;
+   }
+
+   if (NULL == (policy = (struct Policy *)AllocMem(sizeof(struct Policy),
+         MEMF_PUBLIC | MEMF_CLEAR)))
+   {
+      munmap(map, info.st_size);
+      return NULL;
+   }
+   policy->header = header;
+   policy->inputs = (UBYTE *)map + sizeof(struct PolicyHeader);
+   policy->map = map;
+   policy->size = info.st_size;
+
+   return policy;
+}
+
+
+/*
+** free_policy()
+**
+** Unmap a policy table mapped by load_policy().
+*/
+void free_policy(struct Policy *policy)
+{
+   munmap(policy->map, policy->size);
+   FreeMem(policy, sizeof(struct Policy));
+}
+
+
+/*
+** policy_input()
+**
+** RETURNS:  CURSOR_* bits of the thrusters to hold in view, by the table.
+*/
+int policy_input(struct Policy *policy, int view, struct ProbeInfo *probeinfo)
+{
+   LONG cell;
+
+   cell = policy_cell(&policy->header->grids[view - GO_FAR], probeinfo);
+
+   return (policy->inputs[cell >> 1] >> ((cell & 1) * 4)) & 0x0f;
+}
+
+
+/*
+** policy_cell()
+**
+** Find the cell of grid nearest the state of the probe.  A state off the
+** grid is taken to be in the cell at its edge.
+**
+** RETURNS:  Index of the cell in the table.
+*/
+LONG policy_cell(struct PolicyGrid *grid, struct ProbeInfo *probeinfo)
+{
+   LONG cell, fuel;
+
+   if (probeinfo->fuel < 0)
+   {
+      fuel = 0;
+   }
+   else
+   {
+      fuel = 1 + (LONG)(probeinfo->fuel / grid->step[POLICY_FUEL]);
+      if (fuel >= grid->cells[POLICY_FUEL])
+      {
+         fuel = grid->cells[POLICY_FUEL] - 1;
+      }
+   }
+
+   cell = fuel;
+   cell = cell * grid->cells[1] + nearest(grid, 1, probeinfo->y_pos);
+   cell = cell * grid->cells[0] + nearest(grid, 0, probeinfo->x_pos);
+   cell = cell * grid->cells[3] + nearest(grid, 3, probeinfo->y_vel);
+   cell = cell * grid->cells[2] + nearest(grid, 2, probeinfo->x_vel);
+
+   return grid->first + cell;
+}
+
+
+/*
+** check_policy()
+**
+** RETURNS:  TRUE if the size bytes at header are a policy table whose
+**           every grid lies inside its cells, FALSE if not.
+*/
+static BOOL check_policy(struct PolicyHeader *header, LONG size)
+{
+   struct PolicyGrid *grid;
+   LONG count;
+   int v, d;
+
+   if ((header->magic != POLICY_MAGIC) || (header->frames < 1) ||
+      (header->cells < 0) ||
+      (header->cells / 2 + header->cells % 2 >
+         size - (LONG)sizeof(struct PolicyHeader)))
+   {
+      return FALSE;
+   }
+
+   for (v=0; v < POLICY_VIEWS; v++)
+   {
+      grid = &header->grids[v];
+      count = 1;
+      for (d=0; d < POLICY_DIMS; d++)
+      {
+         if ((grid->cells[d] < 1) ||
+            (count > header->cells / grid->cells[d]) ||
+            !isfinite(grid->low[d]) || !isfinite(grid->step[d]) ||
+            (grid->step[d] <= 0))
+         {
+            return FALSE;
+         }
+         count *= grid->cells[d];
+      }
+
+      if ((grid->first < 0) || (grid->first > header->cells - count))
+      {
+         return FALSE;
+      }
+   }
+
+   return TRUE;
+}
+
+
+/*
+** nearest()
+**
+** RETURNS:  Index along dim of the cell whose middle is nearest value.
+*/
+static LONG nearest(struct PolicyGrid *grid, int dim, float value)
+{
+   float place;
+
+   place = (value - grid->low[dim]) / grid->step[dim] + 0.5;
+
+   if (place < 0)
+   {
+      return 0;
+   }
+   if (place >= grid->cells[dim])
+   {
+      return grid->cells[dim] - 1;
+   }
+
+   return (LONG)place;
+}
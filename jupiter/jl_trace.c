@@ -0,0 +1,285 @@
+/*
+** jl_trace.c - a timeline of what a game does
+**
+** (c)1993 Paul Grebenc
+**
+** For finding out where a stutter comes from.  While a game runs it
+** records the parts of each frame (see jl_phases.c), the setting up of
+** its Bobs, the states step_game() goes through and the sounds it starts
+** and stops, each as an event stamped with the E clock, into a ring of the
+** latest TRACE_EVENTS of them.  Each game has a ring of its own written
+** only by the task (or thread) playing it, so recording needs no locking
+** and never waits.  write_trace() writes the rings of any number of games
+** out as a trace of Chrome's trace event format, a thread to a game, to be
+** looked at with chrome://tracing or the like.
+**
+** Names of events are kept as they are passed, so must be strings that
+** last, such as literals.
+*/
+
+
+/** INCLUDES & DEFINES **/
+
+#include "jupiterdefs.h"
+
+
+/** PROTOTYPES **/
+
+int setup_trace(struct GameInfo *gameinfo);
+void cleanup_trace(struct GameInfo *gameinfo);
+void trace_begin(struct GameInfo *gameinfo, char *name);
+void trace_end(struct GameInfo *gameinfo, char *name);
+void trace_mark(struct GameInfo *gameinfo, char *name);
+void trace_state(struct GameInfo *gameinfo, int state);
+int write_trace(char *name, struct GameInfo **games, int count);
+
+static void record(struct Trace *trace, char *name, char kind);
+static double micros(struct Trace *trace, struct EClockVal *time);
+
+/* jl_clock.c */
+extern struct timerequest *open_eclock(void);
+extern void close_eclock(struct timerequest *timerio);
+
+
+/** GLOBAL VARIABLES **/
+
+/* of the states that are also return codes, QUIT to GAME_OVER */
+static char *state_names[MUSIC] = {
+   "QUIT", "FAIL", "PLAY", "INTRO", "HELP", "OK", "GO_FAR", "GO_PAD_A",
+   "GO_PAD_B", "GO_PAD_C", "LANDED", "CRASHED", "OUT_OF_SKY", "SETUP",
+   "GAME_OVER"
+};
+
+
+/*-----------------------------------------------------------------------*/
+
+
+/*
+** setup_trace()
+**
+** Start recording what a game does.  Opens timer.device for the E clock.
+**
+** RETURNS:  TRUE if successful, FALSE if unsuccessful.
+*/
+int setup_trace(struct GameInfo *gameinfo)
+{
+   struct Trace *trace;
+   struct EClockVal now;
+
+   if (trace = (struct Trace *)AllocMem(sizeof(struct Trace),
+         MEMF_PUBLIC | MEMF_CLEAR))
+   {
+      if (trace->TimerIO = open_eclock())
+      {
+         trace->rate = ReadEClock(&now);
+         trace->state = -1;
+
+         gameinfo->trace = trace;
+         return TRUE;
+      }
+      FreeMem(trace, sizeof(struct Trace));
+   }
+   else
+   {
+      printf("Could not allocate trace\n");
+   }
+   return FALSE;
+}
+
+
+/*
+** cleanup_trace()
+**
+** Stop recording what a game does and close timer.device.  What was
+** recorded is lost, so write it out first.
+*/
+void cleanup_trace(struct GameInfo *gameinfo)
+{
+   struct Trace *trace;
+
+   trace = gameinfo->trace;
+   gameinfo->trace = NULL;
+
+   close_eclock(trace->TimerIO);
+   FreeMem(trace, sizeof(struct Trace));
+}
+
+
+/*
+** trace_begin()
+**
+** Record the start of something the game does, if it is being traced.
+*/
+void trace_begin(struct GameInfo *gameinfo, char *name)
+{
+   if (gameinfo->trace != NULL)
+   {
+      record(gameinfo->trace, name, TRACE_BEGIN);
+   }
+}
+
+
+/*
+** trace_end()
+**
+** Record the end of what was begun by trace_begin() with the same name.
+*/
+void trace_end(struct GameInfo *gameinfo, char *name)
+{
+   if (gameinfo->trace != NULL)
+   {
+      record(gameinfo->trace, name, TRACE_END);
+   }
+}
+
+
+/*
+** trace_mark()
+**
+** Record something that happens at a moment, such as a sound starting.
+*/
+void trace_mark(struct GameInfo *gameinfo, char *name)
+{
+   if (gameinfo->trace != NULL)
+   {
+      record(gameinfo->trace, name, TRACE_MARK);
+   }
+}
+
+
+/*
+** trace_state()
+**
+** Record step_game() going into state, if it was in another and state is
+** one of those that are also return codes (SETUP, the views, how a flight
+** ended, GAME_OVER).  Called with the state of every step.
+*/
+void trace_state(struct GameInfo *gameinfo, int state)
+{
+   struct Trace *trace;
+
+   if ((NULL == (trace = gameinfo->trace)) || (state == trace->state))
+   {
+      return;
+   }
+   trace->state = state;
+
+   if ((state >= 0) && (state < MUSIC))
+   {
+      record(trace, state_names[state], TRACE_MARK);
+   }
+}
+
+
+/*
+** write_trace()
+**
+** Write what count games have recorded to file name as a trace event
+** JSON file, each game as a thread of its own (1 to count).  Games that
+** are not being traced are left out.  An event ending something begun
+** before the oldest event kept is left out too.
+**
+** RETURNS:  TRUE if successful, FALSE if the file could not be written.
+*/
+int write_trace(char *name, struct GameInfo **games, int count)
+{
+   FILE *file;
+   struct Trace *trace;
+   struct TraceEvent *event;
+   double start, time;
+   ULONG n, first;
+   int game, depth;
+   char *comma;
+
+   if (NULL == (file = fopen(name, "w")))
+   {
+      return FALSE;
+   }
+
+   /* times are from the first event kept of any game */
+   start = -1.0;
+   for (game=0; game < count; game++)
+   {
+      if (NULL != (trace = games[game]->trace) && (trace->count > 0))
+      {
+         first = (trace->count > TRACE_EVENTS) ? trace->count - TRACE_EVENTS : 0;
+         time = micros(trace, &trace->events[first % TRACE_EVENTS].time);
+         if ((start < 0) || (time < start))
+         {
+            start = time;
+         }
+      }
+   }
+
+   fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+   comma = "\n";
+   for (game=0; game < count; game++)
+   {
+      if (NULL == (trace = games[game]->trace))
+      {
+         continue;
+      }
+
+      fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+         "\"tid\":%d,\"args\":{\"name\":\"game %d\"}}", comma, game + 1,
+         game + 1);
+      comma = ",\n";
+
+      first = (trace->count > TRACE_EVENTS) ? trace->count - TRACE_EVENTS : 0;
+      depth = 0;
+      for (n=first; n < trace->count; n++)
+      {
+         event = &trace->events[n % TRACE_EVENTS];
+
+         if (event->kind == TRACE_BEGIN)
+         {
+            depth++;
+         }
+         else if (event->kind == TRACE_END)
+         {
+            if (depth == 0)
+            {
+               continue;
+            }
+            depth--;
+         }
+
+         fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,"
+            "\"pid\":1,\"tid\":%d%s}", comma, event->name, event->kind,
+            micros(trace, &event->time) - start, game + 1,
+            (event->kind == TRACE_MARK) ? ",\"s\":\"t\"" : "");
+      }
+   }
+   fprintf(file, "\n]}\n");
+
+   return (fclose(file) == 0);
+}
+
+
+/*
+** record()
+**
+** Stamp an event with the E clock and keep it in place of the oldest.
+*/
+static void record(struct Trace *trace, char *name, char kind)
+{
+   struct TraceEvent *event;
+
+   event = &trace->events[trace->count % TRACE_EVENTS];
+   ReadEClock(&event->time);
+   event->name = name;
+   event->kind = kind;
+
+   trace->count++;
+}
+
+
+/*
+** micros()
+**
+** RETURNS:  An E clock time in microseconds.
+*/
+static double micros(struct Trace *trace, struct EClockVal *time)
+{
+   return (time->ev_hi * 4294967296.0 + time->ev_lo) * 1000000.0 / trace->rate;
+}
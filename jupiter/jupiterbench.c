@@ -0,0 +1,539 @@
+/*
+** jupiterbench.c - timings of the host drawing primitives
+**
+** (c)1993 Paul Grebenc
+**
+** Runs each of the RastPort calls the game draws with against a game
+** sized window on the Linux host and reports the time per call and the
+** pixels filled per second, along with the conversion of the game area
+** to pens and to RGBA.  Each primitive is repeated for at least
+** BENCH_TIME seconds.
+**
+** The sprites are then drawn as OVERLAY Bobs at every x, with and without
+** their pre-shifted copies (jl_hostshift.c), giving the memory each cache
+** entry takes against the time it saves, and whether the game caches it.
+** Those it does not are cached here only to time them.
+**
+** Last, a frame of a probe moving over a terrain sized backdrop is drawn
+** and converted to RGBA, first redrawing and converting everything and
+** then only what the damage tracking (jl_hostdamage.c) says changed.
+**
+** Build (Linux):
+**    cc -std=gnu99 -O2 -o jupiterbench jupiterbench.c jl_host*.c jl_c2p.c \
+**       jl_images.c
+*/
+
+
+/** INCLUDES & DEFINES **/
+
+#include "jupiterdefs.h"
+
+#define BENCH_TIME      (0.25)
+
+#define TITLE_HEIGHT    (11)
+
+struct Bench {
+   char *name;
+   void (*function)(struct RastPort *rp, LONG n);
+   LONG pixels;      /* pixels touched per call */
+};
+
+struct Sprite {
+   char  *name;
+   UWORD *image;
+   SHORT  words;
+   SHORT  height;
+};
+
+
+/** PROTOTYPES **/
+
+static void bench_setrast(struct RastPort *rp, LONG n);
+static void bench_rectfill_fuel(struct RastPort *rp, LONG n);
+static void bench_rectfill_small(struct RastPort *rp, LONG n);
+static void bench_rectfill_complement(struct RastPort *rp, LONG n);
+static void bench_draw_horizontal(struct RastPort *rp, LONG n);
+static void bench_draw_diagonal(struct RastPort *rp, LONG n);
+static void bench_text_jam1(struct RastPort *rp, LONG n);
+static void bench_text_jam2(struct RastPort *rp, LONG n);
+static void bench_bltpattern(struct RastPort *rp, LONG n);
+static void bench_readpixel(struct RastPort *rp, LONG n);
+static void bench_bltbitmaprastport(struct RastPort *rp, LONG n);
+static void bench_printitext(struct RastPort *rp, LONG n);
+static void bench_planar_to_chunky(struct RastPort *rp, LONG n);
+static void bench_planar_to_rgba(struct RastPort *rp, LONG n);
+
+static void bench_sprite(struct RastPort *rp, LONG n);
+static void bench_sprites(struct RastPort *rp);
+static void bench_frame(struct RastPort *rp, LONG n);
+static void bench_damage(struct RastPort *rp);
+
+static double run_bench(struct RastPort *rp, struct Bench *bench, LONG *calls);
+
+/* jl_images.c */
+extern UWORD chip mps_image[1*10*2];
+extern UWORD chip smallprobe_image[1*21*2];
+extern UWORD chip largeprobe_image[1*42*3];
+extern UWORD chip farcrash_image[7][1*21*2];
+extern UWORD chip closecrash_image[7][1*42*3];
+extern UWORD chip farflame_down_image[2][1*5*1];
+extern UWORD chip farflame_left_image[1*3*1];
+extern UWORD chip closeflame_down_image[2][1*10*2];
+extern UWORD chip closeflame_left_image[1*6*1];
+
+
+/** GLOBAL VARIABLES **/
+
+static struct Bench benches[] = {
+   { "SetRast",                 bench_setrast,             320*200 },
+   { "RectFill 220x8",          bench_rectfill_fuel,       220*8 },
+   { "RectFill 15x1",           bench_rectfill_small,      15*1 },
+   { "RectFill COMPLEMENT",     bench_rectfill_complement, 137*25 },
+   { "Draw horizontal",         bench_draw_horizontal,     15 },
+   { "Draw diagonal",           bench_draw_diagonal,       101 },
+   { "Text JAM1 12 chars",      bench_text_jam1,           12*8*8 },
+   { "Text JAM2 12 chars",      bench_text_jam2,           12*8*8 },
+   { "BltPattern 32x10",        bench_bltpattern,          32*10 },
+   { "ReadPixel",               bench_readpixel,           1 },
+   { "BltBitMapRastPort 0xc0",  bench_bltbitmaprastport,   313*187 },
+   { "PrintIText bold",         bench_printitext,          18*9*8 },
+   { "planar_to_chunky",        bench_planar_to_chunky,    320*189 },
+   { "planar_to_rgba",          bench_planar_to_rgba,      320*189 },
+};
+
+static struct Sprite sprites[] = {
+   { "smallprobe",       smallprobe_image,         2, 21 },
+   { "largeprobe",       largeprobe_image,         3, 42 },
+   { "farcrash",         farcrash_image[0],        2, 21 },
+   { "closecrash",       closecrash_image[0],      3, 42 },
+   { "farflame_down",    farflame_down_image[0],   1, 5 },
+   { "farflame_left",    farflame_left_image,      1, 3 },
+   { "closeflame_down",  closeflame_down_image[0], 2, 10 },
+   { "closeflame_left",  closeflame_left_image,    1, 6 },
+};
+
+/* the Bob moved about by bench_sprite() */
+static struct Bob sprite_bob;
+
+static struct BitMap source_bitmap;
+
+/* the scene of bench_damage(), a backdrop as big as the terrain and a probe */
+static UWORD backdrop_image[2*17*179];
+static UWORD backdrop_mask[17*179];
+static UWORD probe_save[2*2*21];
+static struct Bob backdrop_bob, probe_bob;
+
+/* set when bench_frame() draws and converts only the damage */
+static int damage_only;
+
+/* frame conversion output, the game area of the window */
+static UBYTE chunky[320*189];
+static ULONG rgba[320*189];
+static ULONG palette[4];
+
+static LONG sink;
+
+
+/*-----------------------------------------------------------------------*/
+
+
+main()
+{
+   struct Window *window;
+   LONG calls;
+   double elapsed;
+   int n, plane;
+
+   window = OpenWindowTags(NULL,
+               WA_Width,   WINDOW_WIDTH,
+               WA_Height,  WINDOW_HEIGHT + TITLE_HEIGHT,
+               TAG_END);
+
+   if (window == NULL)
+   {
+      printf("Could not open window\n");
+      exit(RETURN_FAIL);
+   }
+
+   /* a title sized source for BltBitMapRastPort() */
+   InitBitMap(&source_bitmap, 2, 313, 187);
+   for (plane=0; plane < 2; plane++)
+   {
+      if (NULL == (source_bitmap.Planes[plane] =
+            AllocMem(source_bitmap.BytesPerRow*source_bitmap.Rows, MEMF_CHIP)))
+      {
+         printf("Could not allocate memory for source bitmap\n");
+         exit(RETURN_FAIL);
+      }
+      memset(source_bitmap.Planes[plane], plane ? 0x33 : 0x55,
+         source_bitmap.BytesPerRow*source_bitmap.Rows);
+   }
+   /* */
+
+   rgb4_to_rgba(host_colors, 4, palette);
+
+   printf("%-24s %12s %12s %12s\n", "primitive", "calls", "ns/call", "Mpixel/s");
+
+   for (n=0; n < sizeof(benches)/sizeof(benches[0]); n++)
+   {
+      elapsed = run_bench(window->RPort, &benches[n], &calls);
+
+      printf("%-24s %12d %12.1f %12.1f\n", benches[n].name, (int)calls,
+         elapsed * 1e9 / calls,
+         (double)benches[n].pixels * calls / elapsed / 1e6);
+   }
+
+   bench_sprites(window->RPort);
+   bench_damage(window->RPort);
+
+   for (plane=0; plane < 2; plane++)
+   {
+      FreeMem(source_bitmap.Planes[plane],
+         source_bitmap.BytesPerRow*source_bitmap.Rows);
+   }
+
+   CloseWindow(window);
+
+   exit(RETURN_OK);
+}
+
+
+/*
+** run_bench()
+**
+** Call a primitive in batches that double in size until BENCH_TIME has
+** gone by.
+**
+** RETURNS:  Seconds taken, with the number of calls made in calls.
+*/
+static double run_bench(struct RastPort *rp, struct Bench *bench, LONG *calls)
+{
+   double start, elapsed;
+   LONG batch, n;
+
+   SetRast(rp, BLACK);
+   SetDrMd(rp, JAM1);
+   SetAPen(rp, WHITE);
+   SetBPen(rp, GREY);
+
+   *calls = 0;
+   batch = 1;
+   start = host_seconds();
+
+   do
+   {
+      for (n=0; n < batch; n++)
+      {
+         bench->function(rp, *calls + n);
+      }
+      *calls += batch;
+      batch *= 2;
+
+      elapsed = host_seconds() - start;
+   } while (elapsed < BENCH_TIME);
+
+   return elapsed;
+}
+
+
+/*
+** bench_sprites()
+**
+** Time DrawGList() of a lone OVERLAY Bob for each sprite, shifting its
+** image as it is drawn and then from the pre-shifted copies.
+*/
+static void bench_sprites(struct RastPort *rp)
+{
+   struct GelsInfo gInfo;
+   struct VSprite head, tail, vs;
+   UWORD collmask[3*42];
+   UWORD border[3];
+   double shifted, preshifted;
+   LONG calls, game_bytes;
+   BOOL in_game;
+   int n;
+
+   struct Bench draw = { NULL, bench_sprite, 0 };
+
+   if (FALSE == host_preshift_sprites())
+   {
+      printf("Could not allocate memory for shifted sprites\n");
+      return;
+   }
+   game_bytes = host_shifted_bytes(NULL);
+
+   memset(&gInfo, 0, sizeof(gInfo));
+   InitGels(&head, &tail, &gInfo);
+   rp->GelsInfo = &gInfo;
+
+   printf("\n%-24s %12s %12s %12s %12s %8s\n", "sprite", "bytes",
+      "ns shifted", "ns cached", "speedup", "in game");
+
+   for (n=0; n < sizeof(sprites)/sizeof(sprites[0]); n++)
+   {
+      /* timed cached even if the game does not cache it */
+      in_game = (host_shifted_bytes(sprites[n].image) > 0);
+      if (NULL == host_preshift_image(sprites[n].image, sprites[n].words,
+            sprites[n].height, 1))
+      {
+         printf("Could not allocate memory for shifted sprites\n");
+         break;
+      }
+
+      memset(&vs, 0, sizeof(vs));
+      memset(&sprite_bob, 0, sizeof(sprite_bob));
+
+      vs.Flags = OVERLAY;
+      vs.Width = sprites[n].words;
+      vs.Height = sprites[n].height;
+      vs.Depth = 1;
+      vs.ImageData = (WORD *)sprites[n].image;
+      vs.CollMask = (WORD *)collmask;
+      vs.BorderLine = (WORD *)border;
+      vs.PlanePick = 0x02;
+      InitMasks(&vs);
+
+      vs.VSBob = &sprite_bob;
+      sprite_bob.BobVSprite = &vs;
+      sprite_bob.ImageShadow = (WORD *)collmask;
+
+      AddBob(&sprite_bob, rp);
+
+      host_use_shifted = FALSE;
+      shifted = run_bench(rp, &draw, &calls) / calls;
+
+      host_use_shifted = TRUE;
+      preshifted = run_bench(rp, &draw, &calls) / calls;
+
+      RemBob(&sprite_bob);
+      DrawGList(rp, NULL);
+
+      printf("%-24s %12d %12.1f %12.1f %11.2fx %8s\n", sprites[n].name,
+         (int)host_shifted_bytes(sprites[n].image),
+         shifted * 1e9, preshifted * 1e9, shifted / preshifted,
+         in_game ? "yes" : "no");
+   }
+
+   printf("%-24s %12d\n", "all cached in game", (int)game_bytes);
+
+   rp->GelsInfo = NULL;
+   host_free_shifted();
+}
+
+
+/*
+** bench_damage()
+**
+** Time a whole frame, DrawGList() and the conversion of the game area to
+** RGBA, with a probe moving over a backdrop Bob, redrawing everything and
+** then only the damage.
+*/
+static void bench_damage(struct RastPort *rp)
+{
+   struct GelsInfo gInfo;
+   struct VSprite head, tail, backdrop, probe;
+   UWORD probe_mask[2*21];
+   UWORD border[17];
+   double full, damaged;
+   LONG calls;
+   int n;
+
+   struct Bench frame = { NULL, bench_frame, 0 };
+
+   for (n=0; n < 2*17*179; n++)
+   {
+      backdrop_image[n] = (n & 1) ? 0x0ff0 : 0x3c3c;
+   }
+
+   memset(&gInfo, 0, sizeof(gInfo));
+   InitGels(&head, &tail, &gInfo);
+   rp->GelsInfo = &gInfo;
+
+   memset(&backdrop, 0, sizeof(backdrop));
+   memset(&backdrop_bob, 0, sizeof(backdrop_bob));
+   backdrop.X = 3;
+   backdrop.Y = TITLE_HEIGHT + 1;
+   backdrop.Width = 17;
+   backdrop.Height = 179;
+   backdrop.Depth = 2;
+   backdrop.ImageData = (WORD *)backdrop_image;
+   backdrop.CollMask = (WORD *)backdrop_mask;
+   backdrop.BorderLine = (WORD *)border;
+   backdrop.PlanePick = 0x03;
+   InitMasks(&backdrop);
+   backdrop.VSBob = &backdrop_bob;
+   backdrop_bob.BobVSprite = &backdrop;
+   backdrop_bob.ImageShadow = (WORD *)backdrop_mask;
+   AddBob(&backdrop_bob, rp);
+
+   memset(&probe, 0, sizeof(probe));
+   memset(&probe_bob, 0, sizeof(probe_bob));
+   probe.Flags = SAVEBACK | OVERLAY;
+   probe.Width = 2;
+   probe.Height = 21;
+   probe.Depth = 1;
+   probe.ImageData = (WORD *)smallprobe_image;
+   probe.CollMask = (WORD *)probe_mask;
+   probe.BorderLine = (WORD *)border;
+   probe.PlanePick = 0x02;
+   InitMasks(&probe);
+   probe.VSBob = &probe_bob;
+   probe_bob.BobVSprite = &probe;
+   probe_bob.ImageShadow = (WORD *)probe_mask;
+   probe_bob.SaveBuffer = (WORD *)probe_save;
+   AddBob(&probe_bob, rp);
+
+   printf("\n%-24s %12s %12s %12s\n", "frame", "ns full", "ns damage",
+      "speedup");
+
+   host_skip_static = FALSE;
+   damage_only = FALSE;
+   full = run_bench(rp, &frame, &calls) / calls;
+
+   host_skip_static = TRUE;
+   damage_only = TRUE;
+   damaged = run_bench(rp, &frame, &calls) / calls;
+
+   printf("%-24s %12.1f %12.1f %11.2fx\n", "probe over backdrop",
+      full * 1e9, damaged * 1e9, full / damaged);
+
+   RemBob(&probe_bob);
+   RemBob(&backdrop_bob);
+   DrawGList(rp, NULL);
+
+   rp->GelsInfo = NULL;
+}
+
+
+/*
+** The primitives, as the game calls them.  n is the call number, used to
+** vary the pen or position where the game would.
+*/
+
+static void bench_setrast(struct RastPort *rp, LONG n)
+{
+   SetRast(rp, n & 3);
+}
+
+static void bench_rectfill_fuel(struct RastPort *rp, LONG n)
+{
+   SetAPen(rp, (n & 1) ? BLUE : BLACK);
+   RectFill(rp, 60, 178+TITLE_HEIGHT, 279, 185+TITLE_HEIGHT);
+}
+
+static void bench_rectfill_small(struct RastPort *rp, LONG n)
+{
+   RectFill(rp, 295, 9+TITLE_HEIGHT + (n & 127), 309, 9+TITLE_HEIGHT + (n & 127));
+}
+
+static void bench_rectfill_complement(struct RastPort *rp, LONG n)
+{
+   SetDrMd(rp, COMPLEMENT);
+   RectFill(rp, 66, 5+TITLE_HEIGHT, 202, 29+TITLE_HEIGHT);
+   SetDrMd(rp, JAM1);
+}
+
+static void bench_draw_horizontal(struct RastPort *rp, LONG n)
+{
+   Move(rp, 295, 9+TITLE_HEIGHT + (n & 127));
+   Draw(rp, 309, 9+TITLE_HEIGHT + (n & 127));
+}
+
+static void bench_draw_diagonal(struct RastPort *rp, LONG n)
+{
+   Move(rp, 10 + (n & 63), 20);
+   Draw(rp, 110 + (n & 63), 120);
+}
+
+static void bench_text_jam1(struct RastPort *rp, LONG n)
+{
+   Move(rp, 10, 176+TITLE_HEIGHT);
+   Text(rp, "SCORE: 00000", 12);
+}
+
+static void bench_text_jam2(struct RastPort *rp, LONG n)
+{
+   SetDrMd(rp, JAM2);
+   Move(rp, 11 + (n & 7), 176+TITLE_HEIGHT);
+   Text(rp, "SCORE: 00000", 12);
+   SetDrMd(rp, JAM1);
+}
+
+static void bench_bltpattern(struct RastPort *rp, LONG n)
+{
+   BltPattern(rp, (PLANEPTR)mps_image, 275, 4+TITLE_HEIGHT,
+      275+31, 4+TITLE_HEIGHT+9, 4);
+}
+
+static void bench_readpixel(struct RastPort *rp, LONG n)
+{
+   sink += ReadPixel(rp, 295, 9+TITLE_HEIGHT + (n & 127));
+}
+
+static void bench_bltbitmaprastport(struct RastPort *rp, LONG n)
+{
+   BltBitMapRastPort(&source_bitmap, 0, 0, rp, 3, TITLE_HEIGHT, 313, 187, 0xc0);
+}
+
+static void bench_printitext(struct RastPort *rp, LONG n)
+{
+   struct TextAttr bold = { "topaz.font", 8, FSF_BOLD, FPF_ROMFONT };
+   struct IntuiText itext = { WHITE, GREY, JAM1, 86, 8, NULL,
+      (UBYTE *)"JUPITER LANDER 0.9", NULL };
+
+   itext.ITextFont = &bold;
+
+   PrintIText(rp, &itext, 0, TITLE_HEIGHT+4);
+}
+
+static void bench_planar_to_chunky(struct RastPort *rp, LONG n)
+{
+   struct BitMap game_area;
+
+   game_area = *rp->BitMap;
+   game_area.Rows = WINDOW_HEIGHT;
+
+   planar_to_chunky(&game_area, chunky, 320);
+}
+
+static void bench_planar_to_rgba(struct RastPort *rp, LONG n)
+{
+   struct BitMap game_area;
+
+   game_area = *rp->BitMap;
+   game_area.Rows = WINDOW_HEIGHT;
+
+   planar_to_rgba(&game_area, rgba, palette, 4);
+}
+
+static void bench_sprite(struct RastPort *rp, LONG n)
+{
+   sprite_bob.BobVSprite->X = 16 + (n % 241);
+   sprite_bob.BobVSprite->Y = 40;
+
+   DrawGList(rp, NULL);
+}
+
+static void bench_frame(struct RastPort *rp, LONG n)
+{
+   struct BitMap game_area;
+   struct DamageList damage;
+
+   probe_bob.BobVSprite->X = 16 + (n % 241);
+   probe_bob.BobVSprite->Y = 40 + (n % 97);
+
+   DrawGList(rp, NULL);
+
+   game_area = *rp->BitMap;
+   game_area.Rows = WINDOW_HEIGHT;
+
+   host_take_damage(rp, &damage);
+   if (damage_only)
+   {
+      planar_to_rgba_damage(&game_area, rgba, palette, 4, &damage);
+   }
+   else
+   {
+      planar_to_rgba(&game_area, rgba, palette, 4);
+   }
+}
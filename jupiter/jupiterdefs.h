@@ -7,6 +7,9 @@
 
 #define INTUI_V36_NAMES_ONLY
 
+/* each VSprite points back at the GameInfo of the game it belongs to */
+#define VUserStuff APTR
+
 
 /** INCLUDES **/
 
@@ -14,8 +17,12 @@
 #include <stdlib.h>
 #include <strings.h>
 
+#ifdef __linux__
+#include "jl_host.h"
+#else
 #include <devices/audio.h>
 #include <devices/keyboard.h>
+#include <devices/timer.h>
 #include <dos/dos.h>
 #include <exec/memory.h>
 #include <exec/types.h>
@@ -37,6 +44,8 @@
 #include <clib/graphics_protos.h>
 #include <clib/intuition_protos.h>
 #include <clib/layers_protos.h>
+#include <clib/timer_protos.h>
+#endif
 
 
 /** DEFINES **/
@@ -64,6 +73,31 @@
 #define SETUP        (13)
 #define GAME_OVER    (14)
 
+/* further steps of a game in progress, see step_game() */
+#define MUSIC        (15)
+#define MOVE         (16)
+#define PAUSED       (17)
+#define FLY          (18)
+#define COLLIDE      (19)
+#define SKY_CHECK    (20)
+#define END_FRAMES   (21)
+#define TALLY        (22)
+#define CRASH_FRAME  (23)
+#define CRASH_SOUND  (24)
+#define LEAVE_VIEW   (25)
+
+/* what step_game() waits for before it is called again */
+#define WAIT_NONE    (0)
+#define WAIT_TOF     (1)
+#define WAIT_DELAY   (2)
+#define WAIT_PORT    (3)
+#define WAIT_END     (4)
+
+/* clocks a game can be played to, see jl_clock.c */
+#define CLOCK_REAL      (0)
+#define CLOCK_SCALED    (1)
+#define CLOCK_INSTANT   (2)
+
 /* colors */
 #define GREY   (0)
 #define BLACK  (1)
@@ -116,3 +150,394 @@ struct ProbeInfo {
    float fuel;
    int user_input;
 };
+
+
+/* where each flight starts and the constants it is flown by, see
+** do_game_setup() and jl_physics.c
+*/
+struct PhysicsInfo {
+   double x_pos;        /* of the probe at the start of a flight */
+   double y_pos;
+   double x_vel;
+   double gravity;      /* added to y_vel every frame */
+   double thrust;       /* taken from y_vel a frame by the main thruster */
+   double side_thrust;  /* added to x_vel a frame by a side thruster */
+   double burn;         /* fuel used a frame by the main thruster */
+   double side_burn;    /* fuel used a frame by a side thruster */
+};
+
+
+/* how a flight, from do_game_setup() to the end of the view it finished
+** in, came out
+*/
+struct FlightInfo {
+   int result;          /* LANDED, CRASHED or OUT_OF_SKY, OK while flying */
+   int view;            /* GO_FAR, GO_PAD_A, GO_PAD_B or GO_PAD_C */
+   float y_vel;         /* when it touched down */
+   float fuel;          /* at the start */
+   float fuel_left;     /* at the end */
+   LONG frames;         /* flown */
+   int points;          /* added to the score for landing */
+   int x;               /* of the middle of the probe's feet when it */
+   int y;               /* ended, in the image of its view */
+   int pad_offset;      /* pixels right of the middle of the pad landed on */
+};
+
+
+/* counts of where flights ended, see jl_heatmap.c */
+#define HEAT_VIEWS      (4)      /* GO_FAR to GO_PAD_C */
+#define HEAT_CELL       (2)      /* pixels to a side of a cell */
+#define HEAT_COLS       (17*16/HEAT_CELL)
+#define HEAT_ROWS       ((179+HEAT_CELL-1)/HEAT_CELL)
+#define HEAT_OFFSETS    (97)     /* landing offsets -48 to 48 */
+
+struct HeatMap {
+   ULONG crashes[HEAT_VIEWS][HEAT_ROWS][HEAT_COLS];
+   ULONG landings[HEAT_VIEWS][HEAT_ROWS][HEAT_COLS];
+   ULONG exits[HEAT_COLS];                /* out of the sky */
+   ULONG offsets[HEAT_VIEWS-1][HEAT_OFFSETS];   /* on pads A, B and C */
+   ULONG flights;
+};
+
+
+/* a policy table, see jupiterpolicy.c and jl_policy.c: for each view a
+** grid of cells over the state of the probe, and for each cell the
+** CURSOR_* bits to hold, two cells to a byte (the first in the low half)
+** after the header
+*/
+#define POLICY_MAGIC    (0x4a4c5031)   /* "JLP1" */
+#define POLICY_VIEWS    (4)            /* GO_FAR to GO_PAD_C */
+#define POLICY_DIMS     (5)            /* x_pos, y_pos, x_vel, y_vel, fuel */
+#define POLICY_FUEL     (4)
+
+struct PolicyGrid {
+   float low[POLICY_DIMS];    /* middle of the first cell of each */
+   float step[POLICY_DIMS];   /* from the middle of one to the next */
+   LONG cells[POLICY_DIMS];
+   LONG first;                /* in the table, of the view */
+};
+
+/* fuel cell 0 is for a probe out of fuel (below 0), and the rest share
+** out 0 to 219 in bands of step, low being 0; x_vel changes fastest from
+** cell to cell, then y_vel, x_pos, y_pos and fuel
+*/
+struct PolicyHeader {
+   ULONG magic;
+   LONG frames;         /* an input was solved for being held for */
+   LONG cells;          /* of all the views */
+   float expected;      /* score, from where a flight starts */
+   struct PolicyGrid grids[POLICY_VIEWS];
+};
+
+struct Policy {
+   struct PolicyHeader *header;
+   UBYTE *inputs;
+   APTR map;
+   LONG size;           /* of the file mapped at map */
+};
+
+
+/* games played side by side as a learning environment, see jl_env.c: for
+** each game ENV_OBSERVATION floats (x_pos, y_pos, x_vel, y_vel, fuel,
+** view from 0 for GO_FAR, and x and y from the probe to the nearest pad)
+*/
+#define ENV_OBSERVATION (8)
+#define ENV_CRASH_FUEL  (30)     /* taken for a crash, see do_crash_sound() */
+
+/* cells of the occupancy images drawn by render_env() */
+#define ENV_EMPTY       (0)
+#define ENV_LAND        (1)
+#define ENV_PAD         (2)
+#define ENV_PROBE       (3)
+
+struct EnvGame {
+   struct ProbeInfo probeinfo;
+   int view;            /* GO_FAR, GO_PAD_A, GO_PAD_B or GO_PAD_C */
+   ULONG seed;          /* of where its flights start */
+};
+
+struct Environment {
+   struct PhysicsInfo physics;   /* all the games are flown by */
+   LONG games;
+   struct EnvGame *game;
+
+   /* the caller's, written in place by reset_env() and step_env() */
+   float *observations; /* games * ENV_OBSERVATION */
+   float *rewards;      /* games */
+   UBYTE *dones;        /* games */
+};
+
+
+/* the search jl_autopilot.c makes each frame */
+#define AUTO_BEAM       (32)     /* states kept at each depth */
+#define AUTO_ACTIONS    (6)      /* ways of holding the thrusters */
+#define AUTO_HOLD       (4)      /* frames each is held for */
+#define AUTO_DEPTH      (40)     /* most depths searched */
+#define AUTO_HASH       (512)    /* slots to find duplicates in, 2^n */
+#define AUTO_BUDGET     (1000)   /* microseconds a frame, by default */
+
+struct AutoNode {
+   struct ProbeInfo probeinfo;
+   int view;
+   int first;           /* action the path to it began with */
+   float cost;          /* of the path to it */
+};
+
+struct AutoPilot {
+   struct timerequest *TimerIO;
+   ULONG budget;        /* E clock ticks a search may take */
+   
+   int flight;          /* of the game, being flown */
+   int pad;             /* being made for, 0 to 2 */
+   
+   struct AutoNode beam[AUTO_BEAM];
+   struct AutoNode next[AUTO_BEAM*AUTO_ACTIONS];
+   int order[AUTO_BEAM*AUTO_ACTIONS];
+   ULONG hash_key[AUTO_HASH];
+   ULONG hash_stamp[AUTO_HASH];
+   int hash_node[AUTO_HASH];
+   ULONG stamp;         /* of the slots filled at this depth */
+   
+   /* for soak tests */
+   LONG searches;
+   LONG depths;         /* searched, in all */
+   LONG landings;       /* searches that found a way down */
+   ULONG longest;       /* search, in E clock ticks */
+};
+
+
+/* parts of a frame timed by jl_phases.c */
+#define PHASE_INPUT     (0)      /* process_input() */
+#define PHASE_MOVE      (1)      /* gravity and position, fly_probe() */
+#define PHASE_SCALE     (2)      /* update_velocity_scale() */
+#define PHASE_COLLIDE   (3)      /* SortGList() and DoCollision() */
+#define PHASE_FLAMES    (4)      /* put_flames() */
+#define PHASE_DRAW      (5)      /* DrawGList() */
+#define PHASE_WAIT      (6)      /* WaitTOF() */
+#define PHASES          (7)
+#define PHASE_RING      (500)    /* latest times kept of each */
+#define PHASE_SHOW      (50)     /* frames between updates of the overlay */
+
+struct PhaseTimes {
+   struct timerequest *TimerIO;
+   ULONG rate;          /* E clock ticks a second */
+   struct EClockVal start;    /* of the part being timed */
+   
+   ULONG ring[PHASES][PHASE_RING];  /* E clock ticks each took */
+   ULONG count[PHASES]; /* timed, in all */
+   ULONG least[PHASES]; /* ever taken */
+   
+   BOOL overlay;        /* show the times in the window as the game runs */
+   LONG frames;         /* since the overlay was last updated */
+};
+
+
+/* what a game did and when, as recorded by jl_trace.c */
+#define TRACE_EVENTS    (8192)   /* latest kept */
+#define TRACE_BEGIN     ('B')
+#define TRACE_END       ('E')
+#define TRACE_MARK      ('i')
+
+struct TraceEvent {
+   struct EClockVal time;
+   char *name;          /* a string that lasts as long as the program */
+   char kind;           /* TRACE_BEGIN, TRACE_END or TRACE_MARK */
+};
+
+struct Trace {
+   struct timerequest *TimerIO;
+   ULONG rate;          /* E clock ticks a second */
+   ULONG count;         /* events recorded, in all */
+   int state;           /* the state step_game() was last in */
+   struct TraceEvent events[TRACE_EVENTS];
+};
+
+
+/* sizes of the images decompressed by jl_memory.c, in bytes */
+#define IMAGESIZE (2*17*181)*2
+#define MASKSIZE (1*17*181)*2
+#define TITLESIZE (1*20*187)*2
+
+
+/* where jupitermain.c has jl_memory.c keep the images decompressed */
+#define CACHE_FILE "jupiter.cache"
+
+
+/* the compressed images and the sounds, which may be read from an asset
+** pack (see jl_pack.c and jupiterpack.c) in place of those built in
+*/
+#define ASSET_TITLE_1      (0)
+#define ASSET_TITLE_2      (1)
+#define ASSET_FARVIEW      (2)
+#define ASSET_FARVIEW_MASK (3)
+#define ASSET_PADAVIEW     (4)
+#define ASSET_PADAVIEW_MASK (5)
+#define ASSET_PADBVIEW     (6)
+#define ASSET_PADBVIEW_MASK (7)
+#define ASSET_PADCVIEW     (8)
+#define ASSET_PADCVIEW_MASK (9)
+#define ASSET_START_TUNE_A (10)
+#define ASSET_START_TUNE_B (11)
+#define ASSET_TICK         (12)
+#define ASSET_CRASH        (13)
+#define ASSET_MAIN_THRUSTER (14)
+#define ASSET_SIDE_THRUSTER (15)
+#define ASSETS             (16)
+
+struct Asset {
+   char *name;
+   UBYTE *data;         /* built in, or in the pack */
+   ULONG size;          /* in bytes */
+   ULONG unpacked;      /* size it decompresses to, 0 if not compressed */
+   BOOL words;          /* made of UWORDs, in the byte order of the CPU */
+};
+
+/* an asset pack: a PackHeader, count PackEntry's, then the data of each
+** at offset from the start of the file, on a PACK_ALIGN byte boundary,
+** all in the byte order of the machine it is for
+*/
+#define PACK_FILE       "jupiter.pak"
+#define PACK_MAGIC      (0x4a4c504b)   /* "JLPK" */
+#define PACK_VERSION    (1)
+#define PACK_ORDER      (0x0102)       /* reads as 0x0201 if swapped */
+#define PACK_ALIGN      (16)
+#define PACK_NAME       (24)
+
+struct PackHeader {
+   ULONG magic;
+   UWORD version;
+   UWORD order;         /* PACK_ORDER */
+   ULONG count;         /* of entries */
+   ULONG size;          /* of the whole file */
+};
+
+struct PackEntry {
+   char name[PACK_NAME];   /* of the Asset, ended by a 0 */
+   ULONG offset;
+   ULONG size;
+};
+
+
+/* what the Workbench screen is like, see read_screen_info() */
+struct ScreenInfo {
+   int depth;           /* in bitplanes */
+   int title_height;    /* of a window's title bar, in pixels */
+};
+
+
+/* Bobs kept for reuse by a game, see reserve_gels() in jl_gels.c */
+#define SPARE_BOBS      (32)
+
+
+/* who memory is allocated for, see alloc_mem() in jl_account.c */
+#define ACCOUNT_IMAGES     (0)   /* jl_memory.c */
+#define ACCOUNT_GELS       (1)   /* jl_gels.c */
+#define ACCOUNT_KEYBOARD   (2)   /* jl_keyboard.c */
+#define ACCOUNT_AUDIO      (3)   /* jl_audio.c */
+#define ACCOUNT_GAME       (4)   /* the GameInfo, jupitergame.c */
+#define ACCOUNT_PACK       (5)   /* an asset pack read by jl_pack.c */
+#define ACCOUNT_OWNERS     (6)
+
+
+/* which thruster flames are showing, see put_small_flames() */
+struct FlameInfo {
+   int left;
+   int right;
+   int down;
+   int x;      /* which of the two main thruster flames */
+};
+
+
+/* everything one copy of the game changes as it runs, so that several
+** can run in one program
+*/
+struct GameInfo {
+   struct Window *window;
+   int title_height;
+   
+   int collision_code;  /* to be set by collision handling functions */
+   
+   LONG score;
+   LONG hiscore;
+   
+   /* jl_gamestuff.c */
+   int old_scale_pos;
+   LONG old_color;
+   int old_fuel;
+   
+   /* jupitergame.c, the game in progress as run by step_game() */
+   int state;           /* the step to take next */
+   int view;            /* GO_FAR, GO_PAD_A, GO_PAD_B or GO_PAD_C */
+   int result;          /* how play in the view ended */
+   int bonus;           /* of the pad in view */
+   int pad_top;         /* y of the top of the pad in view */
+   int count;           /* frames of the crash shown, points tallied */
+   int total;           /* points to be tallied */
+   LONG delay;          /* ticks to wait for WAIT_DELAY */
+   struct MsgPort *port;   /* port to wait at for WAIT_PORT */
+   
+   struct ProbeInfo probeinfo;
+   struct PhysicsInfo physics;
+   
+   struct FlightInfo flight;  /* the one being flown, or last flown */
+   int flights;         /* started this game */
+   int max_flights;     /* game over after this many, 0 for no limit */
+   
+   struct Bob *probebob;
+   struct Bob *landbob;
+   struct Bob *padbob;  /* NULL in the far view */
+   struct Bob *leftflamebob;
+   struct Bob *rightflamebob;
+   struct Bob *downflamebob[2];
+   struct Bob *crashbob[7];
+   
+   struct FlameInfo small_flames;
+   struct FlameInfo big_flames;
+   
+   /* jl_clock.c */
+   int clock_type;      /* CLOCK_REAL, CLOCK_SCALED or CLOCK_INSTANT */
+   int clock_speed;     /* times faster than real, for CLOCK_SCALED */
+   int clock_frames;    /* frames gone by since one was waited for */
+   LONG clock_owed;     /* ticks of delay not yet waited out */
+   LONG clock_ticks;    /* game time gone by, in ticks */
+   
+   /* jl_gels.c, what free_bob() and cleanup_gels() keep for reuse while
+   ** reserve_gels is TRUE
+   */
+   BOOL reserve_gels;
+   struct GelsInfo *spare_gels;
+   struct Bob *spare_bobs[SPARE_BOBS];
+   int spares;
+   
+   /* jl_keyboard.c */
+   struct IOStdReq *KeyIO;
+   struct MsgPort *KeyMP;
+   UBYTE *keyMatrix;
+   
+   /* jl_autopilot.c, flies in place of the keyboard if not NULL */
+   struct AutoPilot *autopilot;
+   
+   /* jl_phases.c, times the parts of each frame if not NULL */
+   struct PhaseTimes *phases;
+   
+   /* jl_trace.c, records what the game does if not NULL */
+   struct Trace *trace;
+   
+   /* jl_audio.c */
+   struct IOAudio *AudioIO1;  /* left */
+   struct IOAudio *AudioIO2;  /* right */
+   struct IOAudio *AudioIO3;  /* start/stop */
+   struct IOAudio *AudioIO4;  /* left */
+   struct IOAudio *AudioIO5;  /* right */
+   
+   struct MsgPort *AudioMP1;
+   struct MsgPort *AudioMP2;
+   struct MsgPort *AudioMP3;
+   struct MsgPort *AudioMP4;
+   struct MsgPort *AudioMP5;
+   
+   int audio_flag;
+   int note;            /* part of the starting tune being played */
+   int note_step;
+   int sound_step;      /* channels heard from by wait_sound() */
+};
@@ -2,6 +2,14 @@
 ** jupitergame.c - code for the game part of Jupiter Lander
 **
 ** (c)1993 Paul Grebenc
+**
+** A game is played a step at a time by step_game(), which never waits
+** itself but returns what the game is waiting for (the next frame, a
+** delay or a message) before it can go on.  game() does the waiting for
+** a single game; a program playing many games in one task can step each
+** of them in turn instead.  Where a game has got to is kept in its
+** GameInfo (state, and the Bobs of the view being played), along with
+** the clock it is played to (see jl_clock.c).
 */
 
 
@@ -9,92 +17,160 @@
 
 #include "jupiterdefs.h"
 
+/* sizes of Bob a game can have out at once, and how many of each */
+struct BobSize {
+   WORD width;          /* in words */
+   WORD height;         /* in lines */
+   int count;
+};
+
 
 /** PROTOTYPES **/
 
-int game(void);
+struct GameInfo *alloc_gameinfo(void);
+void free_gameinfo(struct GameInfo *gameinfo);
+
+int game(struct GameInfo *gameinfo);
+int start_game(struct GameInfo *gameinfo);
+int step_game(struct GameInfo *gameinfo);
+void end_game(struct GameInfo *gameinfo);
 
 void probe_collision(struct VSprite *vsprite_a, struct VSprite *vsprite_b);
 
-int do_far_view(struct ProbeInfo *probeinfo);
-int do_pad_a(struct ProbeInfo *probeinfo);
-int do_pad_b(struct ProbeInfo *probeinfo);
-int do_pad_c(struct ProbeInfo *probeinfo);
-int do_landed(struct ProbeInfo *probeinfo, int bonus);
-int do_out_of_sky(void);
-int do_game_over(struct ProbeInfo *probeinfo);
-int do_game_setup(struct ProbeInfo *probeinfo);
-
-int process_far_view_events(struct ProbeInfo *probeinfo,
-   struct Bob *probebob, struct Bob *landbob);
-int process_pad_a_events(struct ProbeInfo *probeinfo,
-   struct Bob *probebob, struct Bob *landbob, struct Bob *padbob);
-int process_pad_b_events(struct ProbeInfo *probeinfo,
-   struct Bob *probebob, struct Bob *landbob, struct Bob *padbob);
-int process_pad_c_events(struct ProbeInfo *probeinfo,
-   struct Bob *probebob, struct Bob *landbob, struct Bob *padbob);
-
-void put_small_flames(struct ProbeInfo *probeinfo, struct Bob *probebob,
-   struct Bob *leftflamebob, struct Bob *rightflamebob,
+int reserve_bobs(struct GameInfo *gameinfo);
+
+int do_game_setup(struct GameInfo *gameinfo);
+int do_far_view(struct GameInfo *gameinfo);
+int do_pad_a(struct GameInfo *gameinfo);
+int do_pad_b(struct GameInfo *gameinfo);
+int do_pad_c(struct GameInfo *gameinfo);
+int end_view(struct GameInfo *gameinfo);
+
+int create_small_flames(struct GameInfo *gameinfo);
+int create_big_flames(struct GameInfo *gameinfo);
+void free_flames(struct GameInfo *gameinfo);
+
+int do_move(struct GameInfo *gameinfo);
+int do_paused(struct GameInfo *gameinfo);
+int do_fly(struct GameInfo *gameinfo);
+int do_collision(struct GameInfo *gameinfo);
+int do_sky_check(struct GameInfo *gameinfo);
+int end_frames(struct GameInfo *gameinfo);
+
+int move_probe(struct GameInfo *gameinfo, struct ProbeInfo *probeinfo);
+
+void put_flames(struct GameInfo *gameinfo);
+void put_small_flames(struct GameInfo *gameinfo, struct ProbeInfo *probeinfo,
+   struct Bob *probebob, struct Bob *leftflamebob, struct Bob *rightflamebob,
    struct Bob *downflamebob[2]);
-void put_big_flames(struct ProbeInfo *probeinfo, struct Bob *probebob,
-   struct Bob *leftflamebob, struct Bob *rightflamebob,
+void put_big_flames(struct GameInfo *gameinfo, struct ProbeInfo *probeinfo,
+   struct Bob *probebob, struct Bob *leftflamebob, struct Bob *rightflamebob,
    struct Bob *downflamebob[2]);
 
-int process_input(struct ProbeInfo *probeinfo);
+int process_input(struct GameInfo *gameinfo, struct ProbeInfo *probeinfo);
+void new_prefs(struct GameInfo *gameinfo);
+void read_controls(struct GameInfo *gameinfo, struct ProbeInfo *probeinfo);
+void note_position(struct GameInfo *gameinfo);
 
-int do_far_view_crash(struct Bob *probebob, struct Bob *landbob,
-   struct ProbeInfo *probeinfo);
-int do_close_view_crash(struct Bob *probebob, struct Bob *landbob,
-   struct Bob *padbob, struct ProbeInfo *probeinfo);
+int do_landed(struct GameInfo *gameinfo);
+int do_tally(struct GameInfo *gameinfo);
+int do_out_of_sky(struct GameInfo *gameinfo);
+int do_game_over(struct GameInfo *gameinfo);
+
+int do_far_view_crash(struct GameInfo *gameinfo);
+int do_close_view_crash(struct GameInfo *gameinfo);
+int do_crash_frame(struct GameInfo *gameinfo);
+int do_crash_sound(struct GameInfo *gameinfo);
 
 /* jupitermain.c */
-extern void unclip_window(void);
+extern void unclip_window(struct GameInfo *gameinfo);
 extern int get_workbench_depth(void);
+extern void read_screen_info(void);
 
 /* jl_gels.c */
-extern int setup_gels(void);
-extern void cleanup_gels(void);
-extern struct Bob *create_bob(NEWBOB *nBob);
+extern int setup_gels(struct GameInfo *gameinfo);
+extern void cleanup_gels(struct GameInfo *gameinfo);
+extern struct Bob *create_bob(struct GameInfo *gameinfo, NEWBOB *nBob);
 extern void free_bob(struct Bob *bob);
-extern void redraw_bobs(void);
+extern void redraw_bobs(struct GameInfo *gameinfo);
+extern int reserve_gels(struct GameInfo *gameinfo, WORD width, WORD height,
+   int count);
+extern void release_gels(struct GameInfo *gameinfo);
+extern void renew_gels(struct GameInfo *gameinfo);
 
 /* jl_draw.c */
-extern int draw_game(LONG hiscore);
+extern int draw_game(struct GameInfo *gameinfo);
 
 /* jl_gamestuff.c */
-extern void update_velocity_scale(struct ProbeInfo *probeinfo);
-extern void update_fuel_bar(struct ProbeInfo *probeinfo);
-extern void update_score(LONG *score, LONG *hiscore);
+extern void update_velocity_scale(struct GameInfo *gameinfo,
+   struct ProbeInfo *probeinfo);
+extern void update_fuel_bar(struct GameInfo *gameinfo,
+   struct ProbeInfo *probeinfo);
+extern void update_score(struct GameInfo *gameinfo);
 
 /* jl_keyboard.c */
-extern int setup_keyboard(void);
-extern void cleanup_keyboard(void);
-extern int read_keyboard(void);
+extern int setup_keyboard(struct GameInfo *gameinfo);
+extern void cleanup_keyboard(struct GameInfo *gameinfo);
+extern int read_keyboard(struct GameInfo *gameinfo);
+
+/* jl_autopilot.c */
+extern int fly_autopilot(struct GameInfo *gameinfo);
 
 /* jl_audio.c */
-extern int setup_audio(void);
-extern void cleanup_audio(void);
-extern void play_start_music(void);
-extern void play_crash_sound(void);
-extern void end_crash_sound(void);
-extern void play_pop_sound(void);
-extern void end_pop_sound(void);
-extern void begin_main_thruster_sound(void);
-extern void end_main_thruster_sound(void);
-extern void begin_left_thruster_sound(void);
-extern void end_left_thruster_sound(void);
-extern void begin_right_thruster_sound(void);
-extern void end_right_thruster_sound(void);
+extern int setup_audio(struct GameInfo *gameinfo);
+extern void cleanup_audio(struct GameInfo *gameinfo);
+extern int play_start_music(struct GameInfo *gameinfo);
+extern void play_crash_sound(struct GameInfo *gameinfo);
+extern int end_crash_sound(struct GameInfo *gameinfo);
+extern void play_pop_sound(struct GameInfo *gameinfo);
+extern void end_pop_sound(struct GameInfo *gameinfo);
+extern void begin_main_thruster_sound(struct GameInfo *gameinfo);
+extern void end_main_thruster_sound(struct GameInfo *gameinfo);
+extern void begin_left_thruster_sound(struct GameInfo *gameinfo);
+extern void end_left_thruster_sound(struct GameInfo *gameinfo);
+extern void begin_right_thruster_sound(struct GameInfo *gameinfo);
+extern void end_right_thruster_sound(struct GameInfo *gameinfo);
+
+/* jl_clock.c */
+extern void set_clock(struct GameInfo *gameinfo, int type, int speed);
+extern void wait_clock(struct GameInfo *gameinfo, int wait);
+
+/* jl_phases.c */
+extern void begin_phase(struct GameInfo *gameinfo, int phase);
+extern void end_phase(struct GameInfo *gameinfo, int phase);
+extern void show_phases(struct GameInfo *gameinfo);
+
+/* jl_account.c */
+extern APTR alloc_mem(int owner, ULONG size, ULONG flags);
+extern void free_mem(int owner, APTR memory, ULONG size);
+extern BOOL arm_guard(BOOL arm);
+
+/* jl_trace.c */
+extern void trace_state(struct GameInfo *gameinfo, int state);
+
+/* jl_physics.c */
+extern void fire_thrusters(struct PhysicsInfo *physics,
+   struct ProbeInfo *probeinfo);
+extern int fly_probe(struct PhysicsInfo *physics, struct ProbeInfo *probeinfo,
+   int view, int top, WORD *x, WORD *y);
 
 
 /** GLOBAL VARIABLES **/
 
-int collision_code;  /* to be set by collision handling functions */
-
-LONG score;
-static LONG hiscore = 0L;
-
+/* every Bob of every view, see reserve_bobs() */
+static struct BobSize bob_sizes[] = {
+   {  2,  21, 8 },      /* small probe, far view crash */
+   {  3,  42, 8 },      /* large probe, close view crash */
+   { 17, 179, 1 },      /* land of each view */
+   {  6,   8, 1 },      /* pad A or B */
+   {  5,   8, 1 },      /* pad C */
+   {  1,   3, 2 },      /* far view side flames */
+   {  1,   5, 2 },      /* far view main flames */
+   {  1,   6, 2 },      /* close view side flames */
+   {  2,  10, 2 }       /* close view main flames */
+};
+
+#define BOB_SIZES       (sizeof(bob_sizes) / sizeof(struct BobSize))
 
 /* jupitermain.c */
 extern struct Library *IntuitionBase;
@@ -102,10 +178,6 @@ extern struct Library *GfxBase;
 extern struct Library *LayersBase;
 extern struct Library *DOSBase;
 
-extern struct Window *window;
-
-extern int title_height;
-
 /* jl_images.c */
 extern UWORD chip smallprobe_image[1*2*21];
 extern UWORD chip largeprobe_image[1*42*3];
@@ -142,91 +214,306 @@ extern UWORD chip padc_mask[1*8*5];
 /*-----------------------------------------------------------------------*/
 
 
+/*
+** alloc_gameinfo()
+**
+** Allocate the state for one copy of the game, as it is before the first
+** game is played.  The caller opens the window and fills in window and
+** title_height.  Use free_gameinfo() to free it.
+**
+** RETURNS:  Address of the GameInfo if successful, NULL if unsuccessful.
+*/
+struct GameInfo *alloc_gameinfo()
+{
+   struct GameInfo *gameinfo;
+   
+   if (NULL != (gameinfo = (struct GameInfo *)alloc_mem(ACCOUNT_GAME,
+         sizeof(struct GameInfo), MEMF_PUBLIC | MEMF_CLEAR)))
+   {
+      gameinfo->hiscore = 0L;
+      gameinfo->old_scale_pos = 0;
+      gameinfo->old_color = BLUE;
+      gameinfo->old_fuel = 219;
+      gameinfo->audio_flag = FALSE;
+      set_clock(gameinfo, CLOCK_REAL, 1);
+      
+      gameinfo->physics.x_pos = 20;
+      gameinfo->physics.y_pos = 8;
+      gameinfo->physics.x_vel = 0.25;
+      gameinfo->physics.gravity = 0.025;
+      gameinfo->physics.thrust = 0.075;
+      gameinfo->physics.side_thrust = 0.025;
+      gameinfo->physics.burn = 0.5;
+      gameinfo->physics.side_burn = 0.25;
+   }
+   
+   return gameinfo;
+}
+
+
+/*
+** free_gameinfo()
+**
+** Free the GameInfo allocated by alloc_gameinfo().
+*/
+void free_gameinfo(struct GameInfo *gameinfo)
+{
+   free_mem(ACCOUNT_GAME, gameinfo, sizeof(struct GameInfo));
+}
+
+
 /*
 ** game()
 **
 ** This is going to be the main function that handles the game play.
+** The game itself is played by step_game(), and the waiting it asks for
+** between steps is done here, to the game's clock.
 **
 ** RETURNS:  INTRO or QUIT depending on how it exits.
 */
-int game()
+int game(struct GameInfo *gameinfo)
 {
-   int result;
-   struct ProbeInfo probeinfo;
+   int wait;
    
+   if (start_game(gameinfo) == FALSE)
+   {
+      return QUIT;
+   }
+
+   /* run game */
+   FOREVER
+   {
+      wait = step_game(gameinfo);
+      if (wait == WAIT_END)
+      {
+         end_game(gameinfo);
+         return gameinfo->state;
+      }
+      wait_clock(gameinfo, wait);
+   }
+   /* */
+}
+
+
+/*
+** start_game()
+**
+** Draw the game screen and open the devices for a new game.  The game is
+** then played by calling step_game() until it returns WAIT_END, and
+** finished with end_game().
+**
+** RETURNS:  TRUE if successful, FALSE if unsuccessful.
+*/
+int start_game(struct GameInfo *gameinfo)
+{
+   int result;
+
    /* draw everything that remains static throughout the game.
    ** Then draw everything else as it is at the beginning of a game.
    */
-   result = draw_game(hiscore);
-   
+   result = draw_game(gameinfo);
+
    if (result == FALSE)
    {
       printf("Could not draw game screen.\n");
-      return QUIT;
+      return FALSE;
    }
    /* */
 
    /* open keyboard.device for reading key matrix */
-   result = setup_keyboard();
-   
+   result = setup_keyboard(gameinfo);
+
    if (result == FALSE)
    {
       printf("Error returned from setup_keyboard()\n");
-      return QUIT;
+      return FALSE;
    }
    /* */
-   
-   /* open audio.device if possible */
-   result = setup_audio(); /* result doesn't matter, game play w/o sound */
-   
+
+   /* open audio.device if possible, sound is only played in real time */
+   if (gameinfo->clock_type == CLOCK_REAL)
+   {
+      result = setup_audio(gameinfo); /* result doesn't matter, game play w/o sound */
+   }
+   else
+   {
+      gameinfo->audio_flag = FALSE;
+   }
+   gameinfo->clock_ticks = 0L;
+
+   /* make every Bob the game will need now, so that nothing is allocated
+   ** from here to end_game(), whatever happens in play
+   */
+   if (reserve_bobs(gameinfo) == FALSE)
+   {
+      printf("Could not reserve Bobs\n");
+      release_gels(gameinfo);
+      cleanup_keyboard(gameinfo);
+      cleanup_audio(gameinfo);
+      return FALSE;
+   }
+   arm_guard(TRUE);
+   /* */
+
    /* prepare for start of game */
-   score = 0L;
-   probeinfo.fuel = 219.0;
-   result = SETUP;
+   gameinfo->score = 0L;
+   gameinfo->probeinfo.fuel = 219.0;
+   gameinfo->flights = 0;
+   gameinfo->state = SETUP;
    /* */
-   
-   /* run game */
-   FOREVER
+
+   return TRUE;
+}
+
+
+/*
+** step_game()
+**
+** Play the game up to the next point at which it has to wait.  Each step
+** sets gameinfo->state to the one to take next and returns what to wait
+** for first, or WAIT_NONE to go straight on to it.
+**
+** RETURNS:  WAIT_TOF for the next frame,
+**           WAIT_DELAY for gameinfo->delay ticks,
+**           WAIT_PORT for a message at gameinfo->port,
+**           WAIT_END once the game is over, with gameinfo->state set to
+**           INTRO or QUIT.
+*/
+int step_game(struct GameInfo *gameinfo)
+{
+   int wait;
+
+   do
    {
-      switch (result)
+      trace_state(gameinfo, gameinfo->state);
+
+      switch (gameinfo->state)
       {
+         case SETUP:
+               wait = do_game_setup(gameinfo);
+               break;
          case GO_FAR:
-               result = do_far_view(&probeinfo);
+               wait = do_far_view(gameinfo);
                break;
          case GO_PAD_A:
-               result = do_pad_a(&probeinfo);
+               wait = do_pad_a(gameinfo);
                break;
          case GO_PAD_B:
-               result = do_pad_b(&probeinfo);
+               wait = do_pad_b(gameinfo);
                break;
          case GO_PAD_C:
-               result = do_pad_c(&probeinfo);
+               wait = do_pad_c(gameinfo);
                break;
-         case GAME_OVER:
-               do_game_over(&probeinfo);
-               cleanup_keyboard();
-               cleanup_audio();
-               return INTRO;
+         case MUSIC:
+               wait = play_start_music(gameinfo);
+               if (wait == WAIT_NONE)
+               {
+                  gameinfo->state = MOVE;
+               }
+               break;
+         case MOVE:
+               wait = do_move(gameinfo);
+               break;
+         case PAUSED:
+               wait = do_paused(gameinfo);
+               break;
+         case FLY:
+               wait = do_fly(gameinfo);
+               break;
+         case COLLIDE:
+               wait = do_collision(gameinfo);
+               break;
+         case SKY_CHECK:
+               wait = do_sky_check(gameinfo);
+               break;
+         case END_FRAMES:
+               wait = end_frames(gameinfo);
+               break;
+         case LANDED:
+               wait = do_landed(gameinfo);
+               break;
+         case TALLY:
+               wait = do_tally(gameinfo);
+               break;
+         case CRASHED:
+               if (gameinfo->view == GO_FAR)
+               {
+                  wait = do_far_view_crash(gameinfo);
+               }
+               else
+               {
+                  wait = do_close_view_crash(gameinfo);
+               }
+               break;
+         case CRASH_FRAME:
+               wait = do_crash_frame(gameinfo);
+               break;
+         case CRASH_SOUND:
+               wait = do_crash_sound(gameinfo);
+               break;
+         case OUT_OF_SKY:
+               wait = do_out_of_sky(gameinfo);
                break;
-         case QUIT:
-               /* cleanup first? */
-               cleanup_keyboard();
-               cleanup_audio();
-               return QUIT;
+         case LEAVE_VIEW:
+               wait = end_view(gameinfo);
+               break;
+         case GAME_OVER:
+               wait = do_game_over(gameinfo);
                break;
          case FAIL:
-               /* cleanup first? */
-               cleanup_keyboard();
-               cleanup_audio();
                printf("Program failure!\n");
-               return QUIT;
+               gameinfo->state = QUIT;
+               wait = WAIT_END;
                break;
-         case SETUP:
-               result=do_game_setup(&probeinfo);
+         default:    /* INTRO or QUIT */
+               wait = WAIT_END;
                break;
       }
    }
-   /* */
+   while (wait == WAIT_NONE);
+
+   return wait;
+}
+
+
+/*
+** end_game()
+**
+** Close the devices opened by start_game() and free the Bobs it
+** reserved, once step_game() has returned WAIT_END.
+*/
+void end_game(struct GameInfo *gameinfo)
+{
+   arm_guard(FALSE);
+   release_gels(gameinfo);
+   
+   cleanup_keyboard(gameinfo);
+   cleanup_audio(gameinfo);
+}
+
+
+/*
+** reserve_bobs()
+**
+** Reserve the GELS and every Bob in bob_sizes[] for the game, to be taken
+** by the views as they are set up and given back as they end.
+**
+** RETURNS:  TRUE if successful, FALSE if unsuccessful.
+*/
+int reserve_bobs(struct GameInfo *gameinfo)
+{
+   int n;
+   
+   for (n=0; n < BOB_SIZES; n++)
+   {
+      if (reserve_gels(gameinfo, bob_sizes[n].width, bob_sizes[n].height,
+            bob_sizes[n].count) == FALSE)
+      {
+         return FALSE;
+      }
+   }
+   
+   return TRUE;
 }
 
 
@@ -238,15 +525,20 @@ int game()
 */
 void probe_collision(struct VSprite *vsprite_a, struct VSprite *vsprite_b)
 {
+   struct GameInfo *gameinfo;
+   
+   /* both Bobs were made by create_bob() for the same game */
+   gameinfo = (struct GameInfo *)vsprite_a->VUserExt;
+   
    if ( ((vsprite_a->MeMask == PADMASK) || (vsprite_b->MeMask == PADMASK))
-         && (collision_code != CRASHED))
+         && (gameinfo->collision_code != CRASHED))
    {
-      collision_code = LANDED;
+      gameinfo->collision_code = LANDED;
    }
    
    if ((vsprite_a->MeMask == LANDMASK) || (vsprite_b->MeMask == LANDMASK))
    {
-      collision_code = CRASHED;
+      gameinfo->collision_code = CRASHED;
    }
 }
 
@@ -256,62 +548,78 @@ void probe_collision(struct VSprite *vsprite_a, struct VSprite *vsprite_b)
 **
 ** Setup for game.  Called when game first started and after
 ** probe crash, probe out of sky, or probe landed.
+** Goes on to GO_FAR if any fuel remains, GAME_OVER if the probe is
+** out of fuel.
 **
-** RETURNS:  GO_FAR, if any fuel remains.
-**           GAME_OVER, if probe is out of fuel.
+** RETURNS:  WAIT_NONE
 */
-int do_game_setup(struct ProbeInfo *probeinfo)
+int do_game_setup(struct GameInfo *gameinfo)
 {
+   struct ProbeInfo *probeinfo;
+
+   probeinfo = &gameinfo->probeinfo;
+
    /* initialize collision code */
-   collision_code = NULL;
+   gameinfo->collision_code = NULL;
 
    /* check if game is over */
-   if (probeinfo->fuel <= 0.0)
+   if ((probeinfo->fuel <= 0.0) ||
+      ((gameinfo->max_flights > 0) && (gameinfo->flights >= gameinfo->max_flights)))
    {
-      return GAME_OVER;
+      gameinfo->state = GAME_OVER;
+      return WAIT_NONE;
    }
    /* */
 
    /* initial probeinfo values */
-   probeinfo->x_pos = 20;
-   probeinfo->y_pos = 8;
-   probeinfo->x_vel = 0.25;
+   probeinfo->x_pos = gameinfo->physics.x_pos;
+   probeinfo->y_pos = gameinfo->physics.y_pos;
+   probeinfo->x_vel = gameinfo->physics.x_vel;
    probeinfo->y_vel = 0.0;
    /* */
-   
-   return GO_FAR;
+
+   /* start a record of the flight */
+   gameinfo->flights++;
+   gameinfo->flight.result = OK;
+   gameinfo->flight.view = GO_FAR;
+   gameinfo->flight.y_vel = 0.0;
+   gameinfo->flight.fuel = probeinfo->fuel;
+   gameinfo->flight.fuel_left = probeinfo->fuel;
+   gameinfo->flight.frames = 0L;
+   gameinfo->flight.points = 0;
+   /* */
+
+   gameinfo->state = GO_FAR;
+   return WAIT_NONE;
 }
 
 
 /*
 ** do_far_view()
 **
-** Run the far view of the game.
+** Set up the far view of the game.  Play goes on a frame at a time from
+** MOVE, after the starting song at the beginning of each game.
 **
-** RETURNS:  GO_PAD_A
-**           GO_PAD_B
-**           GO_PAD_C if the probe comes within specified range of them
-**           SETUP if the probe crashed or left the window
-**           QUIT if the user decides to quit game
-**           FAIL if an error occurs
+** RETURNS:  WAIT_TOF, or WAIT_NONE with state FAIL if an error occurs.
 */
-int do_far_view(struct ProbeInfo *probeinfo)
+int do_far_view(struct GameInfo *gameinfo)
 {
    int result;
-   struct Bob *probebob;
-   struct Bob *landbob;
+   struct ProbeInfo *probeinfo;
    NEWBOB smallprobeNewBob;
    NEWBOB farviewNewBob;
-   
+
    VOID (*routine)();
-   
+
+   probeinfo = &gameinfo->probeinfo;
+
    smallprobeNewBob.nb_Image = smallprobe_image;
    smallprobeNewBob.nb_WordWidth = 2;
    smallprobeNewBob.nb_ImageDepth = 1;
    smallprobeNewBob.nb_LineHeight = 21;
    smallprobeNewBob.nb_BFlags = SAVEBACK | OVERLAY;
    smallprobeNewBob.nb_X = probeinfo->x_pos+3;
-   smallprobeNewBob.nb_Y = probeinfo->y_pos+title_height;
+   smallprobeNewBob.nb_Y = probeinfo->y_pos+gameinfo->title_height;
    smallprobeNewBob.nb_HitMask = LANDMASK;
    smallprobeNewBob.nb_MeMask = PROBEMASK;
    smallprobeNewBob.nb_PlanePick = 0x02;
@@ -323,310 +631,105 @@ int do_far_view(struct ProbeInfo *probeinfo)
    farviewNewBob.nb_LineHeight = 179;
    farviewNewBob.nb_BFlags = NULL;
    farviewNewBob.nb_X = 3;
-   farviewNewBob.nb_Y = 0+title_height-10;
+   farviewNewBob.nb_Y = 0+gameinfo->title_height-10;
    farviewNewBob.nb_HitMask = PROBEMASK;
    farviewNewBob.nb_MeMask = LANDMASK;
    farviewNewBob.nb_PlanePick = 0x03;
    farviewNewBob.nb_CollMask = (UWORD *)farview_mask;
    
-   
    /* setup GELS system for Bobs */
-   result = setup_gels();
-   
+   result = setup_gels(gameinfo);
+
    if (result != FALSE)
    {
-      probebob = create_bob(&smallprobeNewBob);
-      
-      if (probebob != NULL)
+      gameinfo->probebob = create_bob(gameinfo, &smallprobeNewBob);
+
+      if (gameinfo->probebob != NULL)
       {
-         landbob = create_bob(&farviewNewBob);
-         
-         if (landbob != NULL)
+         gameinfo->landbob = create_bob(gameinfo, &farviewNewBob);
+
+         if (gameinfo->landbob != NULL)
          {
-            AddBob(landbob, window->RPort);
-            AddBob(probebob, window->RPort);
-            
-            routine = probe_collision;
-            SetCollision(LANDHIT, routine, window->RPort->GelsInfo);
-            SetCollision(PROBEHIT, routine, window->RPort->GelsInfo);
-            
-            redraw_bobs();
-            
-            /* play starting song, only at the beginning of each game */
-            if ((score == 0L) && (probeinfo->fuel == 219.0))
-            {
-               play_start_music();
-            }
-            /* */
-            
-            /* handle input events for this view of the game */
-            result = process_far_view_events(probeinfo, probebob, landbob);
-            
-            if (result == CRASHED)
-            {
-               result = do_far_view_crash(probebob, landbob, probeinfo);
-            }
-            
-            if (result == OUT_OF_SKY)
+            if (create_small_flames(gameinfo) != FALSE)
             {
-               result = do_out_of_sky();
-            }
-            /* */
-            
-            RemBob(probebob);
-            RemBob(landbob);
-            
-            free_bob(landbob);
-            free_bob(probebob);
-            
-            cleanup_gels();
-            
-            return result;
-         }
-         else
-         {
-            printf("Could not create farview landbob\n");
-         }
-         free_bob(probebob);
-      }
-      else
-      {
-         printf("Could not create smallprobe probebob\n");
-      }
-      cleanup_gels();
-   }
-   else
-   {
-      printf("Could not set up gels system\n");
-   }
-   
-   return FAIL;
-}
+               gameinfo->view = GO_FAR;
+               gameinfo->padbob = NULL;
 
+               AddBob(gameinfo->landbob, gameinfo->window->RPort);
+               AddBob(gameinfo->probebob, gameinfo->window->RPort);
 
-/*
-** process_far_view_events()
-**
-** Read the keyboard & closegadget and handle movement on the screen.
-**
-** RETURNS:  GO_PAD_A
-**           GO_PAD_B
-**           GO_PAD_C if the probe comes within specified range of them
-**           CRASHED if probe & land bobs collide
-**           OUT_OF_SKY if probe leave the screen (collides with boundary)
-**           QUIT if the user selects closewindow gadget
-**           FAIL if function cannot allocate necessary bobs
-*/
-int process_far_view_events(struct ProbeInfo *probeinfo,
-   struct Bob *probebob, struct Bob *landbob)
-{
-   int result;
-   struct Bob *leftflamebob;
-   struct Bob *rightflamebob;
-   struct Bob *downflamebob[2];
-   NEWBOB flameNewBob;
-   
-   flameNewBob.nb_WordWidth = 1;
-   flameNewBob.nb_ImageDepth = 1;
-   flameNewBob.nb_BFlags = SAVEBACK | OVERLAY;
-   flameNewBob.nb_X = 0;
-   flameNewBob.nb_Y = 0;
-   flameNewBob.nb_HitMask = NULL;
-   flameNewBob.nb_MeMask = NULL;
-   flameNewBob.nb_PlanePick = 0x02;
-   flameNewBob.nb_CollMask = NULL;
-   
-   flameNewBob.nb_Image = farflame_left_image;
-   flameNewBob.nb_LineHeight = 3;
-   leftflamebob = create_bob(&flameNewBob);
-   
-   if (leftflamebob != NULL)
-   {
-      flameNewBob.nb_Image = farflame_right_image;
-      rightflamebob = create_bob(&flameNewBob);
-      
-      if (rightflamebob != NULL)
-      {
-         flameNewBob.nb_Image = farflame_down_image[0];
-         flameNewBob.nb_LineHeight = 5;
-         
-         downflamebob[0] = create_bob(&flameNewBob);
-         
-         if (downflamebob[0] != NULL)
-         {
-            flameNewBob.nb_Image = farflame_down_image[1];
-            
-            downflamebob[1] = create_bob(&flameNewBob);
-            
-            if (downflamebob[1] != NULL)
-            {
-               FOREVER
+               routine = probe_collision;
+               SetCollision(LANDHIT, routine, gameinfo->window->RPort->GelsInfo);
+               SetCollision(PROBEHIT, routine, gameinfo->window->RPort->GelsInfo);
+
+               redraw_bobs(gameinfo);
+
+               /* play starting song, only at the beginning of each game */
+               if ((gameinfo->score == 0L) && (probeinfo->fuel == 219.0))
                {
-                  /* read the idcmp port of window (affects probeinfo values) */
-                  result = process_input(probeinfo);
-                  
-                  if (result != QUIT)
-                  {
-                     /* gravity is always active */
-                     if (probeinfo->y_vel < 1.975)
-                     {
-                        probeinfo->y_vel+=0.025;
-                     }
-               
-                     /* update the velocity scale */
-                     update_velocity_scale(probeinfo);
-                     
-                     /* work out new postions for probe */
-                     probeinfo->x_pos+=probeinfo->x_vel;
-                     probeinfo->y_pos+=probeinfo->y_vel;
-                     /* */
-               
-                     /* check if we've left this view */
-                     if (probeinfo->y_pos >= 90)
-                     {
-                        if (probeinfo->x_pos < 101)
-                        {
-                           result = GO_PAD_A;
-                        }
-                        if (probeinfo->x_pos > 180)
-                        {
-                           result = GO_PAD_C;
-                        }
-                     }
-                     if ((probeinfo->y_pos >= 10)
-                        && (probeinfo->x_pos >= 100)
-                        && (probeinfo->x_pos <= 180))
-                     {
-                        result = GO_PAD_B;
-                     }
-                     /* */
-                     
-                     /* move probe */
-                     probebob->BobVSprite->X = (SHORT)probeinfo->x_pos+3;
-                     probebob->BobVSprite->Y = (SHORT)probeinfo->y_pos+title_height;
-                     /* */
-                     
-                     WaitTOF();
-                     
-                     SortGList(window->RPort);
-                     DoCollision(window->RPort);
-                     
-                     if (collision_code == CRASHED)
-                     {
-                        result = CRASHED;
-                     }
-                  }
-                  
-                  if (result != OK)
-                  {
-                     /* remove flame bobs */
-                     probeinfo->user_input = NULL;
-                     
-                     put_small_flames(probeinfo, probebob, leftflamebob,
-                        rightflamebob, downflamebob);
-                     /* */
-                     
-                     /* must redraw gels before freeing bobs */
-                     redraw_bobs();
-                     
-                     /* free them now */
-                     free_bob(leftflamebob);
-                     free_bob(rightflamebob);
-                     free_bob(downflamebob[0]);
-                     free_bob(downflamebob[1]);
-                     /* */
-                     
-                     return result;
-                  }
-                  
-                  /* add flame bobs to gels list */
-                  put_small_flames(probeinfo, probebob, leftflamebob,
-                     rightflamebob, downflamebob);
-                  
-                  /* move probe (remove other bobs while redrawing for speed) */
-                  RemBob(landbob);
-                  DrawGList(window->RPort, ViewPortAddress(window));
-                  AddBob(landbob, window->RPort);
-                  WaitTOF();
-                  /* */
-                  
-                  /* this check is done after probe is already redrawn */
-                  if (probeinfo->y_pos <= -21)
-                  {
-                     /* remove flame bobs */
-                     probeinfo->user_input = NULL;
-                     
-                     put_small_flames(probeinfo, probebob, leftflamebob,
-                        rightflamebob, downflamebob);
-                     /* */
-                     
-                     /* free them now */
-                     free_bob(leftflamebob);
-                     free_bob(rightflamebob);
-                     free_bob(downflamebob[0]);
-                     free_bob(downflamebob[1]);
-                     /* */
-                     
-                     return OUT_OF_SKY;
-                  }
+                  gameinfo->note = 0;
+                  gameinfo->note_step = 0;
+                  gameinfo->state = MUSIC;
                }
+               else
+               {
+                  gameinfo->state = MOVE;
+               }
+               /* */
+
+               return WAIT_TOF;
             }
-            else
-            {
-               printf("Could not create farview downflamebob[1] bob\n");
-            }
-            free_bob(downflamebob[0]);
+            free_bob(gameinfo->landbob);
          }
          else
          {
-            printf("Could not create farview downflamebob[0] bob\n");
+            printf("Could not create farview landbob\n");
          }
-         free_bob(rightflamebob);
+         free_bob(gameinfo->probebob);
       }
       else
       {
-         printf("Could not create farview rightflamebob bob\n");
+         printf("Could not create smallprobe probebob\n");
       }
-      free_bob(leftflamebob);
+      cleanup_gels(gameinfo);
    }
    else
    {
-      printf("Could not create farview leftflamebob bob\n");
+      printf("Could not set up gels system\n");
    }
-   
-   return FAIL;
+
+   gameinfo->state = FAIL;
+   return WAIT_NONE;
 }
 
 
 /*
 ** do_pad_a()
 **
-** Run the pad a view of the game.
+** Set up the pad a view of the game.  Play goes on a frame at a time
+** from MOVE.
 **
-** RETURNS:  GO_FAR if the probe leaves this view
-**           SETUP if the probe crashed
-**           QUIT if the user decides to quit game
-**           FAIL if an error occurs
+** RETURNS:  WAIT_TOF, or WAIT_NONE with state FAIL if an error occurs.
 */
-int do_pad_a(struct ProbeInfo *probeinfo)
+int do_pad_a(struct GameInfo *gameinfo)
 {
    int result;
-   struct Bob *probebob;
-   struct Bob *landbob;
-   struct Bob *padbob;
+   struct ProbeInfo *probeinfo;
    NEWBOB largeprobeNewBob;
    NEWBOB padaviewNewBob;
    NEWBOB padaNewBob;
-   
+
    VOID (*routine)();
-   
+
+   probeinfo = &gameinfo->probeinfo;
+
    largeprobeNewBob.nb_Image = largeprobe_image;
    largeprobeNewBob.nb_WordWidth = 3;
    largeprobeNewBob.nb_ImageDepth = 1;
    largeprobeNewBob.nb_LineHeight = 42;
    largeprobeNewBob.nb_BFlags = SAVEBACK | OVERLAY;
    largeprobeNewBob.nb_X = ((probeinfo->x_pos - 10) * 2) + 3;
-   largeprobeNewBob.nb_Y = ((probeinfo->y_pos - 90) * 2) + title_height;
+   largeprobeNewBob.nb_Y = ((probeinfo->y_pos - 90) * 2) + gameinfo->title_height;
    largeprobeNewBob.nb_HitMask = LANDMASK | PADMASK;
    largeprobeNewBob.nb_MeMask = PROBEMASK;
    largeprobeNewBob.nb_PlanePick = 0x02;
@@ -638,7 +741,7 @@ int do_pad_a(struct ProbeInfo *probeinfo)
    padaviewNewBob.nb_LineHeight = 179;
    padaviewNewBob.nb_BFlags = NULL;
    padaviewNewBob.nb_X = 3;
-   padaviewNewBob.nb_Y = 0+title_height-10;
+   padaviewNewBob.nb_Y = 0+gameinfo->title_height-10;
    padaviewNewBob.nb_HitMask = PROBEMASK;
    padaviewNewBob.nb_MeMask = LANDMASK;
    padaviewNewBob.nb_PlanePick = 0x03;
@@ -650,444 +753,369 @@ int do_pad_a(struct ProbeInfo *probeinfo)
    padaNewBob.nb_LineHeight = 8;
    padaNewBob.nb_BFlags = OVERLAY;
    padaNewBob.nb_X = 91;
-   padaNewBob.nb_Y = 117+title_height;
+   padaNewBob.nb_Y = 117+gameinfo->title_height;
    padaNewBob.nb_HitMask = PROBEMASK;
    padaNewBob.nb_MeMask = PADMASK;
    padaNewBob.nb_PlanePick = 0x03;
    padaNewBob.nb_CollMask = pada_mask;
    
    /* setup GELS system for Bobs */
-   result = setup_gels();
-   
+   result = setup_gels(gameinfo);
+
    if (result != FALSE)
    {
-      probebob = create_bob(&largeprobeNewBob);
-      
-      if (probebob != NULL)
+      gameinfo->probebob = create_bob(gameinfo, &largeprobeNewBob);
+
+      if (gameinfo->probebob != NULL)
       {
-         landbob = create_bob(&padaviewNewBob);
-         
-         if (landbob != NULL)
+         gameinfo->landbob = create_bob(gameinfo, &padaviewNewBob);
+
+         if (gameinfo->landbob != NULL)
          {
-            padbob = create_bob(&padaNewBob);
-            
-            if (padbob != NULL)
+            gameinfo->padbob = create_bob(gameinfo, &padaNewBob);
+
+            if (gameinfo->padbob != NULL)
             {
-               AddBob(landbob, window->RPort);
-               AddBob(padbob, window->RPort);
-               AddBob(probebob, window->RPort);
-               
-               routine = probe_collision;
-               SetCollision(LANDHIT, routine, window->RPort->GelsInfo);
-               SetCollision(PADHIT, routine, window->RPort->GelsInfo);
-               SetCollision(PROBEHIT, routine, window->RPort->GelsInfo);
-               
-               redraw_bobs();
-               
-               /* handle input events for this part of the game */
-               result = process_pad_a_events(probeinfo, probebob, landbob,
-                           padbob);
-               
-               /* the check for LANDED comes first because if you landed
-               ** too hard it will return CRASHED.
-               */
-               if (result == LANDED)
-               {
-                  result = do_landed(probeinfo, 5);
-               }
-               if (result == CRASHED)
+               if (create_big_flames(gameinfo) != FALSE)
                {
-                  result = do_close_view_crash(probebob, landbob, padbob,
-                     probeinfo);
+                  gameinfo->view = GO_PAD_A;
+                  gameinfo->bonus = 5;
+                  gameinfo->pad_top = 118;
+
+                  AddBob(gameinfo->landbob, gameinfo->window->RPort);
+                  AddBob(gameinfo->padbob, gameinfo->window->RPort);
+                  AddBob(gameinfo->probebob, gameinfo->window->RPort);
+
+                  routine = probe_collision;
+                  SetCollision(LANDHIT, routine, gameinfo->window->RPort->GelsInfo);
+                  SetCollision(PADHIT, routine, gameinfo->window->RPort->GelsInfo);
+                  SetCollision(PROBEHIT, routine, gameinfo->window->RPort->GelsInfo);
+
+                  redraw_bobs(gameinfo);
+
+                  gameinfo->state = MOVE;
+                  return WAIT_TOF;
                }
-               /* */
-               
-               RemBob(probebob);
-               RemBob(landbob);
-               RemBob(padbob);
-               
-               free_bob(probebob);
-               free_bob(landbob);
-               free_bob(padbob);
-               
-               cleanup_gels();
-               
-               return result;
+               free_bob(gameinfo->padbob);
             }
             else
             {
                printf("Could not create pada padbob\n");
             }
-            free_bob(landbob);
+            free_bob(gameinfo->landbob);
          }
          else
          {
             printf("Could not create padaview landbob\n");
          }
-         free_bob(probebob);
+         free_bob(gameinfo->probebob);
       }
       else
       {
          printf("Could not create largeprobe probebob\n");
       }
-      cleanup_gels();
+      cleanup_gels(gameinfo);
    }
    else
    {
       printf("Could not set up gels system\n");
    }
-   
-   return FAIL;
+
+   gameinfo->state = FAIL;
+   return WAIT_NONE;
 }
 
 
 /*
-** process_pad_a_events()
+** do_pad_b()
 **
-** Read the keyboard & closegadget and handle movement on the screen.
+** Set up the pad b view of the game.  Play goes on a frame at a time
+** from MOVE.
 **
-** RETURNS:  GO_FAR if the probe leaves the screen
-**           CRASHED if probe & land collide or if probe lands too hard
-**           LANDED if the probe lands on the pad
-**           QUIT if the user selects closewindow gadget
-**           FAIL if function cannot allocate necessary bobs
+** RETURNS:  WAIT_TOF, or WAIT_NONE with state FAIL if an error occurs.
 */
-int process_pad_a_events(struct ProbeInfo *probeinfo, struct Bob *probebob,
-                           struct Bob *landbob, struct Bob *padbob)
+int do_pad_b(struct GameInfo *gameinfo)
 {
    int result;
-   struct Bob *leftflamebob;
-   struct Bob *rightflamebob;
-   struct Bob *downflamebob[2];
-   NEWBOB flameNewBob;
+   struct ProbeInfo *probeinfo;
+   NEWBOB largeprobeNewBob;
+   NEWBOB padbviewNewBob;
+   NEWBOB padbNewBob;
+
+   VOID (*routine)();
+
+   probeinfo = &gameinfo->probeinfo;
+
+   largeprobeNewBob.nb_Image = largeprobe_image;
+   largeprobeNewBob.nb_WordWidth = 3;
+   largeprobeNewBob.nb_ImageDepth = 1;
+   largeprobeNewBob.nb_LineHeight = 42;
+   largeprobeNewBob.nb_BFlags = SAVEBACK | OVERLAY;
+   largeprobeNewBob.nb_X = ((probeinfo->x_pos - 85) * 2) + 3;
+   largeprobeNewBob.nb_Y = ((probeinfo->y_pos - 10) * 2) + gameinfo->title_height;
+   largeprobeNewBob.nb_HitMask = LANDMASK | PADMASK;
+   largeprobeNewBob.nb_MeMask = PROBEMASK;
+   largeprobeNewBob.nb_PlanePick = 0x02;
+   largeprobeNewBob.nb_CollMask = NULL;
    
-   flameNewBob.nb_ImageDepth = 1;
-   flameNewBob.nb_BFlags = SAVEBACK | OVERLAY;
-   flameNewBob.nb_X = 0;
-   flameNewBob.nb_Y = 0;
-   flameNewBob.nb_HitMask = NULL;
-   flameNewBob.nb_MeMask = NULL;
-   flameNewBob.nb_PlanePick = 0x02;
-   flameNewBob.nb_CollMask = NULL;
+   padbviewNewBob.nb_Image = (UWORD *)padbview_image;
+   padbviewNewBob.nb_WordWidth = 17;
+   padbviewNewBob.nb_ImageDepth = 2;
+   padbviewNewBob.nb_LineHeight = 179;
+   padbviewNewBob.nb_BFlags = NULL;
+   padbviewNewBob.nb_X = 3;
+   padbviewNewBob.nb_Y = 0+gameinfo->title_height-10;
+   padbviewNewBob.nb_HitMask = PROBEMASK;
+   padbviewNewBob.nb_MeMask = LANDMASK;
+   padbviewNewBob.nb_PlanePick = 0x03;
+   padbviewNewBob.nb_CollMask = (UWORD *)padbview_mask;
    
-   flameNewBob.nb_Image = closeflame_left_image;
-   flameNewBob.nb_WordWidth = 1;
-   flameNewBob.nb_LineHeight = 6;
-   leftflamebob = create_bob(&flameNewBob);
+   padbNewBob.nb_Image = padb_image;
+   padbNewBob.nb_WordWidth = 6;
+   padbNewBob.nb_ImageDepth = 1;
+   padbNewBob.nb_LineHeight = 8;
+   padbNewBob.nb_BFlags = OVERLAY;
+   padbNewBob.nb_X = 97;
+   padbNewBob.nb_Y = 74+gameinfo->title_height;
+   padbNewBob.nb_HitMask = PROBEMASK;
+   padbNewBob.nb_MeMask = PADMASK;
+   padbNewBob.nb_PlanePick = 0x03;
+   padbNewBob.nb_CollMask = padb_mask;
    
-   if (leftflamebob != NULL)
+   /* setup GELS system for Bobs */
+   result = setup_gels(gameinfo);
+
+   if (result != FALSE)
    {
-      flameNewBob.nb_Image = closeflame_right_image;
-      rightflamebob = create_bob(&flameNewBob);
-      
-      if (rightflamebob != NULL)
+      gameinfo->probebob = create_bob(gameinfo, &largeprobeNewBob);
+
+      if (gameinfo->probebob != NULL)
       {
-         flameNewBob.nb_Image = closeflame_down_image[0];
-         flameNewBob.nb_WordWidth = 2;
-         flameNewBob.nb_LineHeight = 10;
-         downflamebob[0] = create_bob(&flameNewBob);
-         
-         if (downflamebob[0] != NULL)
+         gameinfo->landbob = create_bob(gameinfo, &padbviewNewBob);
+
+         if (gameinfo->landbob != NULL)
          {
-            flameNewBob.nb_Image = closeflame_down_image[1];
-            downflamebob[1] = create_bob(&flameNewBob);
-            
-            if (downflamebob[1] != NULL)
+            gameinfo->padbob = create_bob(gameinfo, &padbNewBob);
+
+            if (gameinfo->padbob != NULL)
             {
-               FOREVER
+               if (create_big_flames(gameinfo) != FALSE)
                {
-                  /* read the idcmp port of window (affects probeinfo values) */
-                  result = process_input(probeinfo);
-                  
-                  if (result != QUIT)
-                  {
-                     /* gravity is always active */
-                     if (probeinfo->y_vel < 1.975)
-                     {
-                        probeinfo->y_vel += 0.025;
-                     }
-                     
-                     /* update the velocity scale */
-                     update_velocity_scale(probeinfo);
-                     
-                     /* work out new positions for probe */
-                     probeinfo->x_pos += probeinfo->x_vel;
-                     probeinfo->y_pos += probeinfo->y_vel;
-                     /* */
-                     
-                     /* check if we've left this view before redrawing probe */
-                     if (probeinfo->y_pos < 90)
-                     {
-                        result = GO_FAR;
-                     }
-                     /* */
-                     
-                     /* move probe */
-                     probebob->BobVSprite->X = (SHORT)(((probeinfo->x_pos - 10) * 2) + 3);
-                     probebob->BobVSprite->Y = (SHORT)(((probeinfo->y_pos - 90) * 2) + title_height);
-                     /* */
-                     
-                     WaitTOF();
-                     
-                     /* check for collisions (sets collision_code) */
-                     SortGList(window->RPort);
-                     DoCollision(window->RPort);
-                     /* */
-                     
-                     if (collision_code == CRASHED)
-                     {
-                        result = CRASHED;
-                     }
-                     if (collision_code == LANDED)
-                     {
-                        /* make sure that probe is not below surface of pad */
-                        probebob->BobVSprite->Y = (118+title_height-42);
-                        RemBob(landbob);
-                        RemBob(padbob);
-                        DrawGList(window->RPort, ViewPortAddress(window));
-                        AddBob(landbob, window->RPort);
-                        AddBob(padbob, window->RPort);
-                        /* */
-                        
-                        result = LANDED;
-                     }
-                  }
-                  
-                  if (result != OK)
-                  {
-                     /* remove flame bobs */
-                     probeinfo->user_input = NULL;
-                     
-                     put_big_flames(probeinfo, probebob, leftflamebob,
-                        rightflamebob, downflamebob);
-                     /* */
-                     
-                     /* must redraw gels before freeing bobs */
-                     redraw_bobs();
-                     
-                     /* free them now */
-                     free_bob(leftflamebob);
-                     free_bob(rightflamebob);
-                     free_bob(downflamebob[0]);
-                     free_bob(downflamebob[1]);
-                     /* */
-                     
-                     return result;
-                  }
-                  
-                  /* add flame bobs to gels list */
-                  put_big_flames(probeinfo, probebob, leftflamebob,
-                     rightflamebob, downflamebob);
-                  
-                  /* move probe (remove other bobs while redrawing for speed) */
-                  RemBob(landbob);
-                  RemBob(padbob);
-                  DrawGList(window->RPort, ViewPortAddress(window));
-                  AddBob(landbob, window->RPort);
-                  AddBob(padbob, window->RPort);
-                  WaitTOF();
-                  /* */
+                  gameinfo->view = GO_PAD_B;
+                  gameinfo->bonus = 2;
+                  gameinfo->pad_top = 75;
+
+                  AddBob(gameinfo->landbob, gameinfo->window->RPort);
+                  AddBob(gameinfo->padbob, gameinfo->window->RPort);
+                  AddBob(gameinfo->probebob, gameinfo->window->RPort);
+
+                  routine = probe_collision;
+                  SetCollision(LANDHIT, routine, gameinfo->window->RPort->GelsInfo);
+                  SetCollision(PADHIT, routine, gameinfo->window->RPort->GelsInfo);
+                  SetCollision(PROBEHIT, routine, gameinfo->window->RPort->GelsInfo);
+
+                  redraw_bobs(gameinfo);
+
+                  gameinfo->state = MOVE;
+                  return WAIT_TOF;
                }
+               free_bob(gameinfo->padbob);
             }
             else
             {
-               printf("Could not create closeview downflamebob[1] bob\n");
+               printf("Could not create padb padbob\n");
             }
-            free_bob(downflamebob[0]);
+            free_bob(gameinfo->landbob);
          }
          else
          {
-            printf("Could not create farview downflamebob[0] bob\n");
+            printf("Could not create padbview landbob\n");
          }
-         free_bob(rightflamebob);
+         free_bob(gameinfo->probebob);
       }
       else
       {
-         printf("Could not create farview rightflamebob bob\n");
+         printf("Could not create largeprobe probebob\n");
       }
-      free_bob(leftflamebob);
+      cleanup_gels(gameinfo);
    }
    else
    {
-      printf("Could not create farview leftflamebob bob\n");
+      printf("Could not set up gels system\n");
    }
-   
-   return FAIL;
+
+   gameinfo->state = FAIL;
+   return WAIT_NONE;
 }
 
 
 /*
-** do_pad_b()
+** do_pad_c()
 **
-** Run the pad b view of the game.
+** Set up the pad c view of the game.  Play goes on a frame at a time
+** from MOVE.
 **
-** RETURNS:  GO_FAR if the probe leaves this view
-**           SETUP if the probe crashed
-**           QUIT if the user decides to quit game
-**           FAIL if an error occurs
+** RETURNS:  WAIT_TOF, or WAIT_NONE with state FAIL if an error occurs.
 */
-int do_pad_b(struct ProbeInfo *probeinfo)
+int do_pad_c(struct GameInfo *gameinfo)
 {
    int result;
-   struct Bob *probebob;
-   struct Bob *landbob;
-   struct Bob *padbob;
+   struct ProbeInfo *probeinfo;
    NEWBOB largeprobeNewBob;
-   NEWBOB padbviewNewBob;
-   NEWBOB padbNewBob;
-   
+   NEWBOB padcviewNewBob;
+   NEWBOB padcNewBob;
+
    VOID (*routine)();
-   
+
+   probeinfo = &gameinfo->probeinfo;
+
    largeprobeNewBob.nb_Image = largeprobe_image;
    largeprobeNewBob.nb_WordWidth = 3;
    largeprobeNewBob.nb_ImageDepth = 1;
    largeprobeNewBob.nb_LineHeight = 42;
    largeprobeNewBob.nb_BFlags = SAVEBACK | OVERLAY;
-   largeprobeNewBob.nb_X = ((probeinfo->x_pos - 85) * 2) + 3;
-   largeprobeNewBob.nb_Y = ((probeinfo->y_pos - 10) * 2) + title_height;
+   largeprobeNewBob.nb_X = ((probeinfo->x_pos - 140) * 2) + 3;
+   largeprobeNewBob.nb_Y = ((probeinfo->y_pos - 90) * 2) + gameinfo->title_height;
    largeprobeNewBob.nb_HitMask = LANDMASK | PADMASK;
    largeprobeNewBob.nb_MeMask = PROBEMASK;
    largeprobeNewBob.nb_PlanePick = 0x02;
    largeprobeNewBob.nb_CollMask = NULL;
    
-   padbviewNewBob.nb_Image = (UWORD *)padbview_image;
-   padbviewNewBob.nb_WordWidth = 17;
-   padbviewNewBob.nb_ImageDepth = 2;
-   padbviewNewBob.nb_LineHeight = 179;
-   padbviewNewBob.nb_BFlags = NULL;
-   padbviewNewBob.nb_X = 3;
-   padbviewNewBob.nb_Y = 0+title_height-10;
-   padbviewNewBob.nb_HitMask = PROBEMASK;
-   padbviewNewBob.nb_MeMask = LANDMASK;
-   padbviewNewBob.nb_PlanePick = 0x03;
-   padbviewNewBob.nb_CollMask = (UWORD *)padbview_mask;
+   padcviewNewBob.nb_Image = (UWORD *)padcview_image;
+   padcviewNewBob.nb_WordWidth = 17;
+   padcviewNewBob.nb_ImageDepth = 2;
+   padcviewNewBob.nb_LineHeight = 179;
+   padcviewNewBob.nb_BFlags = NULL;
+   padcviewNewBob.nb_X = 3;
+   padcviewNewBob.nb_Y = 0+gameinfo->title_height-10;
+   padcviewNewBob.nb_HitMask = PROBEMASK;
+   padcviewNewBob.nb_MeMask = LANDMASK;
+   padcviewNewBob.nb_PlanePick = 0x03;
+   padcviewNewBob.nb_CollMask = (UWORD *)padcview_mask;
    
-   padbNewBob.nb_Image = padb_image;
-   padbNewBob.nb_WordWidth = 6;
-   padbNewBob.nb_ImageDepth = 1;
-   padbNewBob.nb_LineHeight = 8;
-   padbNewBob.nb_BFlags = OVERLAY;
-   padbNewBob.nb_X = 97;
-   padbNewBob.nb_Y = 74+title_height;
-   padbNewBob.nb_HitMask = PROBEMASK;
-   padbNewBob.nb_MeMask = PADMASK;
-   padbNewBob.nb_PlanePick = 0x03;
-   padbNewBob.nb_CollMask = padb_mask;
+   padcNewBob.nb_Image = padc_image;
+   padcNewBob.nb_WordWidth = 5;
+   padcNewBob.nb_ImageDepth = 1;
+   padcNewBob.nb_LineHeight = 8;
+   padcNewBob.nb_BFlags = OVERLAY;
+   padcNewBob.nb_X = 93;
+   padcNewBob.nb_Y = 133+gameinfo->title_height;
+   padcNewBob.nb_HitMask = PROBEMASK;
+   padcNewBob.nb_MeMask = PADMASK;
+   padcNewBob.nb_PlanePick = 0x03;
+   padcNewBob.nb_CollMask = padc_mask;
    
    /* setup GELS system for Bobs */
-   result = setup_gels();
-   
+   result = setup_gels(gameinfo);
+
    if (result != FALSE)
    {
-      probebob = create_bob(&largeprobeNewBob);
-      
-      if (probebob != NULL)
+      gameinfo->probebob = create_bob(gameinfo, &largeprobeNewBob);
+
+      if (gameinfo->probebob != NULL)
       {
-         landbob = create_bob(&padbviewNewBob);
-         
-         if (landbob != NULL)
+         gameinfo->landbob = create_bob(gameinfo, &padcviewNewBob);
+
+         if (gameinfo->landbob != NULL)
          {
-            padbob = create_bob(&padbNewBob);
-            
-            if (padbob != NULL)
+            gameinfo->padbob = create_bob(gameinfo, &padcNewBob);
+
+            if (gameinfo->padbob != NULL)
             {
-               AddBob(landbob, window->RPort);
-               AddBob(padbob, window->RPort);
-               AddBob(probebob, window->RPort);
-               
-               routine = probe_collision;
-               SetCollision(LANDHIT, routine, window->RPort->GelsInfo);
-               SetCollision(PADHIT, routine, window->RPort->GelsInfo);
-               SetCollision(PROBEHIT, routine, window->RPort->GelsInfo);
-               
-               redraw_bobs();
-               
-               /* handle input events for this part of the game */
-               result = process_pad_b_events(probeinfo, probebob, landbob,
-                           padbob);
-               
-               /* the check for LANDED comes first because if you landed
-               ** too hard it will return CRASHED.
-               */
-               if (result == LANDED)
-               {
-                  /* check if both legs are completely on the pad */
-                  if ((probebob->BobVSprite->X >= 97) &&
-                     (probebob->BobVSprite->X <= 132))
-                  {
-                     result = do_landed(probeinfo, 2);
-                  }
-                  else
-                  {
-                     result = CRASHED;
-                  }
-               }
-               if (result == CRASHED)
+               if (create_big_flames(gameinfo) != FALSE)
                {
-                  result = do_close_view_crash(probebob, landbob, padbob,
-                     probeinfo);
+                  gameinfo->view = GO_PAD_C;
+                  gameinfo->bonus = 10;
+                  gameinfo->pad_top = 134;
+
+                  AddBob(gameinfo->landbob, gameinfo->window->RPort);
+                  AddBob(gameinfo->padbob, gameinfo->window->RPort);
+                  AddBob(gameinfo->probebob, gameinfo->window->RPort);
+
+                  routine = probe_collision;
+                  SetCollision(LANDHIT, routine, gameinfo->window->RPort->GelsInfo);
+                  SetCollision(PADHIT, routine, gameinfo->window->RPort->GelsInfo);
+                  SetCollision(PROBEHIT, routine, gameinfo->window->RPort->GelsInfo);
+
+                  redraw_bobs(gameinfo);
+
+                  gameinfo->state = MOVE;
+                  return WAIT_TOF;
                }
-               /* */
-               
-               RemBob(probebob);
-               RemBob(landbob);
-               RemBob(padbob);
-               
-               free_bob(probebob);
-               free_bob(landbob);
-               free_bob(padbob);
-               
-               cleanup_gels();
-               
-               return result;
+               free_bob(gameinfo->padbob);
             }
             else
             {
-               printf("Could not create padb padbob\n");
+               printf("Could not create padc padbob\n");
             }
-            free_bob(landbob);
+            free_bob(gameinfo->landbob);
          }
          else
          {
-            printf("Could not create padbview landbob\n");
+            printf("Could not create padcview landbob\n");
          }
-         free_bob(probebob);
+         free_bob(gameinfo->probebob);
       }
       else
       {
          printf("Could not create largeprobe probebob\n");
       }
-      cleanup_gels();
+      cleanup_gels(gameinfo);
    }
    else
    {
       printf("Could not set up gels system\n");
    }
-   
-   return FAIL;
+
+   gameinfo->state = FAIL;
+   return WAIT_NONE;
 }
 
 
 /*
-** process_pad_b_events()
+** end_view()
 **
-** Read the keyboard & closegadget and handle movement on the screen.
+** Remove and free the Bobs of the view that has been played, then go on
+** to the step its play ended with (gameinfo->result).
 **
-** RETURNS:  GO_FAR if the probe leaves the screen
-**           CRASHED if probe & land collide or if probe lands too hard
-**           LANDED if the probe lands on the pad
-**           QUIT if the user selects closewindow gadget
-**           FAIL if function cannot allocate necessary bobs
+** RETURNS:  WAIT_NONE
 */
-int process_pad_b_events(struct ProbeInfo *probeinfo, struct Bob *probebob,
-                           struct Bob *landbob, struct Bob *padbob)
+int end_view(struct GameInfo *gameinfo)
+{
+   RemBob(gameinfo->probebob);
+   RemBob(gameinfo->landbob);
+   if (gameinfo->padbob != NULL)
+   {
+      RemBob(gameinfo->padbob);
+   }
+
+   free_bob(gameinfo->probebob);
+   free_bob(gameinfo->landbob);
+   if (gameinfo->padbob != NULL)
+   {
+      free_bob(gameinfo->padbob);
+   }
+
+   cleanup_gels(gameinfo);
+
+   gameinfo->state = gameinfo->result;
+   return WAIT_NONE;
+}
+
+
+/*
+** create_small_flames()
+**
+** Create the thruster flame Bobs of the far view.  put_small_flames()
+** adds them to the gels list as they are needed.
+**
+** RETURNS:  TRUE if successful, FALSE if unsuccessful.
+*/
+int create_small_flames(struct GameInfo *gameinfo)
 {
-   int result;
-   struct Bob *leftflamebob;
-   struct Bob *rightflamebob;
-   struct Bob *downflamebob[2];
    NEWBOB flameNewBob;
-   
+
+   flameNewBob.nb_WordWidth = 1;
    flameNewBob.nb_ImageDepth = 1;
    flameNewBob.nb_BFlags = SAVEBACK | OVERLAY;
    flameNewBob.nb_X = 0;
@@ -1097,468 +1125,429 @@ int process_pad_b_events(struct ProbeInfo *probeinfo, struct Bob *probebob,
    flameNewBob.nb_PlanePick = 0x02;
    flameNewBob.nb_CollMask = NULL;
    
-   flameNewBob.nb_Image = closeflame_left_image;
-   flameNewBob.nb_WordWidth = 1;
-   flameNewBob.nb_LineHeight = 6;
-   leftflamebob = create_bob(&flameNewBob);
-   
-   if (leftflamebob != NULL)
+   flameNewBob.nb_Image = farflame_left_image;
+   flameNewBob.nb_LineHeight = 3;
+   gameinfo->leftflamebob = create_bob(gameinfo, &flameNewBob);
+
+   if (gameinfo->leftflamebob != NULL)
    {
-      flameNewBob.nb_Image = closeflame_right_image;
-      rightflamebob = create_bob(&flameNewBob);
-      
-      if (rightflamebob != NULL)
+      flameNewBob.nb_Image = farflame_right_image;
+      gameinfo->rightflamebob = create_bob(gameinfo, &flameNewBob);
+
+      if (gameinfo->rightflamebob != NULL)
       {
-         flameNewBob.nb_Image = closeflame_down_image[0];
-         flameNewBob.nb_WordWidth = 2;
-         flameNewBob.nb_LineHeight = 10;
-         downflamebob[0] = create_bob(&flameNewBob);
-         
-         if (downflamebob[0] != NULL)
+         flameNewBob.nb_Image = farflame_down_image[0];
+         flameNewBob.nb_LineHeight = 5;
+
+         gameinfo->downflamebob[0] = create_bob(gameinfo, &flameNewBob);
+
+         if (gameinfo->downflamebob[0] != NULL)
          {
-            flameNewBob.nb_Image = closeflame_down_image[1];
-            downflamebob[1] = create_bob(&flameNewBob);
-            
-            if (downflamebob[1] != NULL)
+            flameNewBob.nb_Image = farflame_down_image[1];
+
+            gameinfo->downflamebob[1] = create_bob(gameinfo, &flameNewBob);
+
+            if (gameinfo->downflamebob[1] != NULL)
             {
-               FOREVER
-               {
-                  /* read the idcmp port of window (affects probeinfo values) */
-                  result = process_input(probeinfo);
-                  
-                  if (result != QUIT)
-                  {
-                     /* gravity is always active */
-                     if (probeinfo->y_vel < 1.975)
-                     {
-                        probeinfo->y_vel += 0.025;
-                     }
-                     
-                     /* update the velocity scale */
-                     update_velocity_scale(probeinfo);
-                     
-                     /* work out new positions for probe */
-                     probeinfo->x_pos += probeinfo->x_vel;
-                     probeinfo->y_pos += probeinfo->y_vel;
-                     /* */
-                     
-                     /* check if we've left this view before redrawing probe */
-                     if ((probeinfo->y_pos < 10) || (probeinfo->x_pos < 100)
-                        || (probeinfo->x_pos > 180))
-                     {
-                        result = GO_FAR;
-                     }
-                     /* */
-                     
-                     /* move probe */
-                     probebob->BobVSprite->X = (SHORT)(((probeinfo->x_pos - 85) * 2) + 3);
-                     probebob->BobVSprite->Y = (SHORT)(((probeinfo->y_pos - 10) * 2) + title_height);
-                     /* */
-                     
-                     WaitTOF();
-
-                     /* check for collisions (sets collision_code) */
-                     SortGList(window->RPort);
-                     DoCollision(window->RPort);
-                     /* */
-                     
-                     if (collision_code == CRASHED)
-                     {
-                        result = CRASHED;
-                     }
-                     if (collision_code == LANDED)
-                     {
-                        /* make sure that probe is not below surface of pad */
-                        probebob->BobVSprite->Y = (75+title_height-42);
-                        RemBob(landbob);
-                        RemBob(padbob);
-                        DrawGList(window->RPort, ViewPortAddress(window));
-                        AddBob(landbob, window->RPort);
-                        AddBob(padbob, window->RPort);
-                        /* */
-                        
-                        result = LANDED;
-                     }
-                  }
-                  
-                  if (result != OK)
-                  {
-                     /* remove flame bobs */
-                     probeinfo->user_input = NULL;
-                     
-                     put_big_flames(probeinfo, probebob, leftflamebob,
-                        rightflamebob, downflamebob);
-                     /* */
-                     
-                     /* must redraw gels before freeing bobs */
-                     redraw_bobs();
-                     
-                     /* free them now */
-                     free_bob(leftflamebob);
-                     free_bob(rightflamebob);
-                     free_bob(downflamebob[0]);
-                     free_bob(downflamebob[1]);
-                     /* */
-                     
-                     return result;
-                  }
-                  
-                  /* add flame bobs to gels list */
-                  put_big_flames(probeinfo, probebob, leftflamebob,
-                     rightflamebob, downflamebob);
-                  
-                  /* move probe (remove other bobs while redrawing for speed) */
-                  RemBob(landbob);
-                  RemBob(padbob);
-                  DrawGList(window->RPort, ViewPortAddress(window));
-                  AddBob(landbob, window->RPort);
-                  AddBob(padbob, window->RPort);
-                  WaitTOF();
-                  /* */
-               }
+               return TRUE;
             }
             else
             {
-               printf("Could not create closeview downflamebob[1] bob\n");
+               printf("Could not create farview downflamebob[1] bob\n");
             }
-            free_bob(downflamebob[0]);
+            free_bob(gameinfo->downflamebob[0]);
          }
          else
          {
             printf("Could not create farview downflamebob[0] bob\n");
          }
-         free_bob(rightflamebob);
+         free_bob(gameinfo->rightflamebob);
       }
       else
       {
          printf("Could not create farview rightflamebob bob\n");
       }
-      free_bob(leftflamebob);
+      free_bob(gameinfo->leftflamebob);
    }
    else
    {
       printf("Could not create farview leftflamebob bob\n");
    }
-   
-   return FAIL;
+
+   return FALSE;
 }
 
 
 /*
-** do_pad_c()
+** create_big_flames()
 **
-** Run the pad c view of the game.
+** Create the thruster flame Bobs of the pad views.  put_big_flames()
+** adds them to the gels list as they are needed.
 **
-** RETURNS:  GO_FAR if the probe leaves this view
-**           SETUP if the probe crashed
-**           QUIT if the user decides to quit game
-**           FAIL if an error occurs
+** RETURNS:  TRUE if successful, FALSE if unsuccessful.
 */
-int do_pad_c(struct ProbeInfo *probeinfo)
+int create_big_flames(struct GameInfo *gameinfo)
 {
-   int result;
-   struct Bob *probebob;
-   struct Bob *landbob;
-   struct Bob *padbob;
-   NEWBOB largeprobeNewBob;
-   NEWBOB padcviewNewBob;
-   NEWBOB padcNewBob;
-   
-   VOID (*routine)();
-   
-   largeprobeNewBob.nb_Image = largeprobe_image;
-   largeprobeNewBob.nb_WordWidth = 3;
-   largeprobeNewBob.nb_ImageDepth = 1;
-   largeprobeNewBob.nb_LineHeight = 42;
-   largeprobeNewBob.nb_BFlags = SAVEBACK | OVERLAY;
-   largeprobeNewBob.nb_X = ((probeinfo->x_pos - 140) * 2) + 3;
-   largeprobeNewBob.nb_Y = ((probeinfo->y_pos - 90) * 2) + title_height;
-   largeprobeNewBob.nb_HitMask = LANDMASK | PADMASK;
-   largeprobeNewBob.nb_MeMask = PROBEMASK;
-   largeprobeNewBob.nb_PlanePick = 0x02;
-   largeprobeNewBob.nb_CollMask = NULL;
-   
-   padcviewNewBob.nb_Image = (UWORD *)padcview_image;
-   padcviewNewBob.nb_WordWidth = 17;
-   padcviewNewBob.nb_ImageDepth = 2;
-   padcviewNewBob.nb_LineHeight = 179;
-   padcviewNewBob.nb_BFlags = NULL;
-   padcviewNewBob.nb_X = 3;
-   padcviewNewBob.nb_Y = 0+title_height-10;
-   padcviewNewBob.nb_HitMask = PROBEMASK;
-   padcviewNewBob.nb_MeMask = LANDMASK;
-   padcviewNewBob.nb_PlanePick = 0x03;
-   padcviewNewBob.nb_CollMask = (UWORD *)padcview_mask;
-   
-   padcNewBob.nb_Image = padc_image;
-   padcNewBob.nb_WordWidth = 5;
-   padcNewBob.nb_ImageDepth = 1;
-   padcNewBob.nb_LineHeight = 8;
-   padcNewBob.nb_BFlags = OVERLAY;
-   padcNewBob.nb_X = 93;
-   padcNewBob.nb_Y = 133+title_height;
-   padcNewBob.nb_HitMask = PROBEMASK;
-   padcNewBob.nb_MeMask = PADMASK;
-   padcNewBob.nb_PlanePick = 0x03;
-   padcNewBob.nb_CollMask = padc_mask;
-   
-   /* setup GELS system for Bobs */
-   result = setup_gels();
+   NEWBOB flameNewBob;
+
+   flameNewBob.nb_ImageDepth = 1;
+   flameNewBob.nb_BFlags = SAVEBACK | OVERLAY;
+   flameNewBob.nb_X = 0;
+   flameNewBob.nb_Y = 0;
+   flameNewBob.nb_HitMask = NULL;
+   flameNewBob.nb_MeMask = NULL;
+   flameNewBob.nb_PlanePick = 0x02;
+   flameNewBob.nb_CollMask = NULL;
    
-   if (result != FALSE)
+   flameNewBob.nb_Image = closeflame_left_image;
+   flameNewBob.nb_WordWidth = 1;
+   flameNewBob.nb_LineHeight = 6;
+   gameinfo->leftflamebob = create_bob(gameinfo, &flameNewBob);
+
+   if (gameinfo->leftflamebob != NULL)
    {
-      probebob = create_bob(&largeprobeNewBob);
-      
-      if (probebob != NULL)
+      flameNewBob.nb_Image = closeflame_right_image;
+      gameinfo->rightflamebob = create_bob(gameinfo, &flameNewBob);
+
+      if (gameinfo->rightflamebob != NULL)
       {
-         landbob = create_bob(&padcviewNewBob);
-         
-         if (landbob != NULL)
+         flameNewBob.nb_Image = closeflame_down_image[0];
+         flameNewBob.nb_WordWidth = 2;
+         flameNewBob.nb_LineHeight = 10;
+         gameinfo->downflamebob[0] = create_bob(gameinfo, &flameNewBob);
+
+         if (gameinfo->downflamebob[0] != NULL)
          {
-            padbob = create_bob(&padcNewBob);
-            
-            if (padbob != NULL)
+            flameNewBob.nb_Image = closeflame_down_image[1];
+            gameinfo->downflamebob[1] = create_bob(gameinfo, &flameNewBob);
+
+            if (gameinfo->downflamebob[1] != NULL)
             {
-               AddBob(landbob, window->RPort);
-               AddBob(padbob, window->RPort);
-               AddBob(probebob, window->RPort);
-               
-               routine = probe_collision;
-               SetCollision(LANDHIT, routine, window->RPort->GelsInfo);
-               SetCollision(PADHIT, routine, window->RPort->GelsInfo);
-               SetCollision(PROBEHIT, routine, window->RPort->GelsInfo);
-               
-               redraw_bobs();
-               
-               /* handle input events for this part of the game */
-               result = process_pad_c_events(probeinfo, probebob, landbob,
-                           padbob);
-               
-               /* the check for LANDED comes first because if you landed
-               ** too hard it will return CRASHED.
-               */
-               if (result == LANDED)
-               {
-                  result = do_landed(probeinfo, 10);
-               }
-               if (result == CRASHED)
-               {
-                  result = do_close_view_crash(probebob, landbob, padbob,
-                     probeinfo);
-               }
-               /* */
-               
-               RemBob(probebob);
-               RemBob(landbob);
-               RemBob(padbob);
-               
-               free_bob(probebob);
-               free_bob(landbob);
-               free_bob(padbob);
-               
-               cleanup_gels();
-               
-               return result;
+               return TRUE;
             }
             else
             {
-               printf("Could not create padc padbob\n");
+               printf("Could not create closeview downflamebob[1] bob\n");
             }
-            free_bob(landbob);
+            free_bob(gameinfo->downflamebob[0]);
          }
          else
          {
-            printf("Could not create padcview landbob\n");
+            printf("Could not create closeview downflamebob[0] bob\n");
          }
-         free_bob(probebob);
+         free_bob(gameinfo->rightflamebob);
       }
       else
       {
-         printf("Could not create largeprobe probebob\n");
+         printf("Could not create closeview rightflamebob bob\n");
       }
-      cleanup_gels();
+      free_bob(gameinfo->leftflamebob);
+   }
+   else
+   {
+      printf("Could not create closeview leftflamebob bob\n");
+   }
+
+   return FALSE;
+}
+
+
+/*
+** free_flames()
+**
+** Free the thruster flame Bobs, which must be off the gels list.
+*/
+void free_flames(struct GameInfo *gameinfo)
+{
+   free_bob(gameinfo->leftflamebob);
+   free_bob(gameinfo->rightflamebob);
+   free_bob(gameinfo->downflamebob[0]);
+   free_bob(gameinfo->downflamebob[1]);
+}
+
+
+/*
+** do_move()
+**
+** Start a frame of play by reading the window & keyboard.  Goes on to
+** FLY, to PAUSED if the window has become inactive, or to END_FRAMES if
+** the user selects the closewindow gadget.
+**
+** RETURNS:  WAIT_PORT if paused, else WAIT_NONE.
+*/
+int do_move(struct GameInfo *gameinfo)
+{
+   int result;
+
+   /* read the idcmp port of window (affects probeinfo values) */
+   begin_phase(gameinfo, PHASE_INPUT);
+   result = process_input(gameinfo, &gameinfo->probeinfo);
+   end_phase(gameinfo, PHASE_INPUT);
+
+   switch (result)
+   {
+      case QUIT:
+            gameinfo->result = QUIT;
+            gameinfo->state = END_FRAMES;
+            break;
+      case PAUSED:
+            gameinfo->port = gameinfo->window->UserPort;
+            gameinfo->state = PAUSED;
+            return WAIT_PORT;
+            break;
+      default:
+            gameinfo->state = FLY;
+            break;
+   }
+
+   return WAIT_NONE;
+}
+
+
+/*
+** do_paused()
+**
+** Keep the game paused until the window becomes active again, then read
+** the keyboard and go on to FLY.
+**
+** RETURNS:  WAIT_PORT while paused, then WAIT_NONE.
+*/
+int do_paused(struct GameInfo *gameinfo)
+{
+   struct IntuiMessage *imsg;
+   ULONG class;
+
+   while (NULL != (imsg = (struct IntuiMessage *)GetMsg(gameinfo->window->UserPort)))
+   {
+      class = imsg->Class;
+      ReplyMsg((struct Message *)imsg);
+
+      if (class == IDCMP_ACTIVEWINDOW)
+      {
+         read_controls(gameinfo, &gameinfo->probeinfo);
+         gameinfo->state = FLY;
+         return WAIT_NONE;
+      }
+      else if (class == IDCMP_NEWPREFS)
+      {
+         new_prefs(gameinfo);
+      }
+   }
+
+   return WAIT_PORT;
+}
+
+
+/*
+** do_fly()
+**
+** Move the probe in the view being played, then go on to COLLIDE.
+**
+** RETURNS:  WAIT_TOF
+*/
+int do_fly(struct GameInfo *gameinfo)
+{
+   gameinfo->flight.frames++;
+
+   gameinfo->result = move_probe(gameinfo, &gameinfo->probeinfo);
+
+   gameinfo->state = COLLIDE;
+   return WAIT_TOF;
+}
+
+
+/*
+** move_probe()
+**
+** Apply gravity and move the probe for one frame of the view being
+** played (see fly_probe() in jl_physics.c).
+**
+** RETURNS:  GO_FAR from a pad view, or GO_PAD_A, GO_PAD_B or GO_PAD_C
+**           from the far view, if the probe comes within range of them
+**           OK otherwise
+*/
+int move_probe(struct GameInfo *gameinfo, struct ProbeInfo *probeinfo)
+{
+   int result;
+   WORD x, y;
+
+   begin_phase(gameinfo, PHASE_MOVE);
+   result = fly_probe(&gameinfo->physics, probeinfo, gameinfo->view,
+      gameinfo->title_height, &x, &y);
+   end_phase(gameinfo, PHASE_MOVE);
+
+   /* update the velocity scale */
+   begin_phase(gameinfo, PHASE_SCALE);
+   update_velocity_scale(gameinfo, probeinfo);
+   end_phase(gameinfo, PHASE_SCALE);
+
+   /* move probe */
+   gameinfo->probebob->BobVSprite->X = x;
+   gameinfo->probebob->BobVSprite->Y = y;
+   /* */
+
+   return result;
+}
+
+
+/*
+** do_collision()
+**
+** Finish the frame: check for collisions, and if play in the view goes
+** on, put up the thruster flames and redraw the probe.  Goes on to the
+** next frame (MOVE, by way of SKY_CHECK in the far view), or END_FRAMES
+** if play in the view is over.
+**
+** RETURNS:  WAIT_TOF after redrawing, else WAIT_NONE.
+*/
+int do_collision(struct GameInfo *gameinfo)
+{
+   /* check for collisions (sets collision_code) */
+   begin_phase(gameinfo, PHASE_COLLIDE);
+   SortGList(gameinfo->window->RPort);
+   DoCollision(gameinfo->window->RPort);
+   end_phase(gameinfo, PHASE_COLLIDE);
+   /* */
+
+   if (gameinfo->collision_code == CRASHED)
+   {
+      gameinfo->result = CRASHED;
+   }
+   if ((gameinfo->collision_code == LANDED) && (gameinfo->padbob != NULL))
+   {
+      /* make sure that probe is not below surface of pad */
+      gameinfo->probebob->BobVSprite->Y = (gameinfo->pad_top+gameinfo->title_height-42);
+      RemBob(gameinfo->landbob);
+      RemBob(gameinfo->padbob);
+      DrawGList(gameinfo->window->RPort, ViewPortAddress(gameinfo->window));
+      AddBob(gameinfo->landbob, gameinfo->window->RPort);
+      AddBob(gameinfo->padbob, gameinfo->window->RPort);
+      /* */
+
+      gameinfo->result = LANDED;
+   }
+
+   if (gameinfo->result != OK)
+   {
+      if ((gameinfo->result == LANDED) || (gameinfo->result == CRASHED))
+      {
+         gameinfo->flight.result = gameinfo->result;
+         gameinfo->flight.view = gameinfo->view;
+         gameinfo->flight.y_vel = gameinfo->probeinfo.y_vel;
+         gameinfo->flight.fuel_left = gameinfo->probeinfo.fuel;
+         note_position(gameinfo);
+      }
+      gameinfo->state = END_FRAMES;
+      return WAIT_NONE;
+   }
+
+   /* add flame bobs to gels list */
+   begin_phase(gameinfo, PHASE_FLAMES);
+   put_flames(gameinfo);
+   end_phase(gameinfo, PHASE_FLAMES);
+
+   /* move probe (remove other bobs while redrawing for speed) */
+   begin_phase(gameinfo, PHASE_DRAW);
+   RemBob(gameinfo->landbob);
+   if (gameinfo->padbob != NULL)
+   {
+      RemBob(gameinfo->padbob);
+   }
+   DrawGList(gameinfo->window->RPort, ViewPortAddress(gameinfo->window));
+   AddBob(gameinfo->landbob, gameinfo->window->RPort);
+   if (gameinfo->padbob != NULL)
+   {
+      AddBob(gameinfo->padbob, gameinfo->window->RPort);
+   }
+   end_phase(gameinfo, PHASE_DRAW);
+   /* */
+
+   show_phases(gameinfo);
+
+   if (gameinfo->view == GO_FAR)
+   {
+      gameinfo->state = SKY_CHECK;
+   }
+   else
+   {
+      gameinfo->state = MOVE;
+   }
+
+   return WAIT_TOF;
+}
+
+
+/*
+** do_sky_check()
+**
+** In the far view, once the probe has been redrawn, check whether it has
+** left the top of the sky.  Goes on to OUT_OF_SKY if it has, else to the
+** next frame.
+**
+** RETURNS:  WAIT_NONE
+*/
+int do_sky_check(struct GameInfo *gameinfo)
+{
+   if (gameinfo->probeinfo.y_pos <= -21)
+   {
+      /* remove flame bobs */
+      gameinfo->probeinfo.user_input = NULL;
+
+      put_flames(gameinfo);
+      /* */
+
+      /* free them now */
+      free_flames(gameinfo);
+
+      gameinfo->flight.result = OUT_OF_SKY;
+      gameinfo->flight.fuel_left = gameinfo->probeinfo.fuel;
+      note_position(gameinfo);
+      gameinfo->state = OUT_OF_SKY;
    }
    else
    {
-      printf("Could not set up gels system\n");
+      gameinfo->state = MOVE;
    }
-   
-   return FAIL;
+
+   return WAIT_NONE;
 }
 
 
 /*
-** process_pad_c_events()
+** end_frames()
 **
-** Read the keyboard & closegadget and handle movement on the screen.
+** Play in the view is over: take down the thruster flames, then go on to
+** LANDED or CRASHED, or leave the view.
 **
-** RETURNS:  GO_FAR if the probe leaves the screen
-**           CRASHED if probe & land collide or if probe lands too hard
-**           LANDED if the probe lands on the pad
-**           QUIT if the user selects closewindow gadget
-**           FAIL if function cannot allocate necessary bobs
+** RETURNS:  WAIT_TOF
 */
-int process_pad_c_events(struct ProbeInfo *probeinfo, struct Bob *probebob,
-                           struct Bob *landbob, struct Bob *padbob)
+int end_frames(struct GameInfo *gameinfo)
 {
-   int result;
-   struct Bob *leftflamebob;
-   struct Bob *rightflamebob;
-   struct Bob *downflamebob[2];
-   NEWBOB flameNewBob;
-   
-   flameNewBob.nb_ImageDepth = 1;
-   flameNewBob.nb_BFlags = SAVEBACK | OVERLAY;
-   flameNewBob.nb_X = 0;
-   flameNewBob.nb_Y = 0;
-   flameNewBob.nb_HitMask = NULL;
-   flameNewBob.nb_MeMask = NULL;
-   flameNewBob.nb_PlanePick = 0x02;
-   flameNewBob.nb_CollMask = NULL;
-   
-   flameNewBob.nb_Image = closeflame_left_image;
-   flameNewBob.nb_WordWidth = 1;
-   flameNewBob.nb_LineHeight = 6;
-   leftflamebob = create_bob(&flameNewBob);
-   
-   if (leftflamebob != NULL)
+   /* remove flame bobs */
+   gameinfo->probeinfo.user_input = NULL;
+
+   put_flames(gameinfo);
+   /* */
+
+   /* must redraw gels before freeing bobs */
+   redraw_bobs(gameinfo);
+
+   /* free them now */
+   free_flames(gameinfo);
+
+   /* the check for LANDED comes first because if you landed
+   ** too hard it will go on to CRASHED.
+   */
+   if ((gameinfo->result == LANDED) || (gameinfo->result == CRASHED))
    {
-      flameNewBob.nb_Image = closeflame_right_image;
-      rightflamebob = create_bob(&flameNewBob);
-      
-      if (rightflamebob != NULL)
-      {
-         flameNewBob.nb_Image = closeflame_down_image[0];
-         flameNewBob.nb_WordWidth = 2;
-         flameNewBob.nb_LineHeight = 10;
-         downflamebob[0] = create_bob(&flameNewBob);
-         
-         if (downflamebob[0] != NULL)
-         {
-            flameNewBob.nb_Image = closeflame_down_image[1];
-            downflamebob[1] = create_bob(&flameNewBob);
-            
-            if (downflamebob[1] != NULL)
-            {
-               FOREVER
-               {
-                  /* read the idcmp port of window (affects probeinfo values) */
-                  result = process_input(probeinfo);
-                  
-                  if (result != QUIT)
-                  {
-                     /* gravity is always active */
-                     if (probeinfo->y_vel < 1.975)
-                     {
-                        probeinfo->y_vel += 0.025;
-                     }
-                     
-                     /* update the velocity scale */
-                     update_velocity_scale(probeinfo);
-                     
-                     /* work out new positions for probe */
-                     probeinfo->x_pos += probeinfo->x_vel;
-                     probeinfo->y_pos += probeinfo->y_vel;
-                     /* */
-                     
-                     /* check if we've left this view before redrawing probe */
-                     if (probeinfo->y_pos < 90)
-                     {
-                        result = GO_FAR;
-                     }
-                     /* */
-                     
-                     /* move probe */
-                     probebob->BobVSprite->X = (SHORT)(((probeinfo->x_pos - 140) * 2) + 3);
-                     probebob->BobVSprite->Y = (SHORT)(((probeinfo->y_pos - 90) * 2) + title_height);
-                     /* */
-                     
-                     WaitTOF();
-                     
-                     /* check for collisions (sets collision_code) */
-                     SortGList(window->RPort);
-                     DoCollision(window->RPort);
-                     /* */
-                     
-                     if (collision_code == CRASHED)
-                     {
-                        result = CRASHED;
-                     }
-                     if (collision_code == LANDED)
-                     {
-                        /* make sure that probe is not below surface of pad */
-                        probebob->BobVSprite->Y = (134+title_height-42);
-                        RemBob(landbob);
-                        RemBob(padbob);
-                        DrawGList(window->RPort, ViewPortAddress(window));
-                        AddBob(landbob, window->RPort);
-                        AddBob(padbob, window->RPort);
-                        /* */
-                        
-                        result = LANDED;
-                     }
-                  }
-                  
-                  if (result != OK)
-                  {
-                     /* remove flame bobs */
-                     probeinfo->user_input = NULL;
-                     
-                     put_big_flames(probeinfo, probebob, leftflamebob,
-                        rightflamebob, downflamebob);
-                     /* */
-                     
-                     /* must redraw gels before freeing bobs */
-                     redraw_bobs();
-                     
-                     /* free them now */
-                     free_bob(leftflamebob);
-                     free_bob(rightflamebob);
-                     free_bob(downflamebob[0]);
-                     free_bob(downflamebob[1]);
-                     /* */
-                     
-                     return result;
-                  }
-                  
-                  /* add flame bobs to gels list */
-                  put_big_flames(probeinfo, probebob, leftflamebob,
-                     rightflamebob, downflamebob);
-                  
-                  /* move probe (remove other bobs while redrawing for speed) */
-                  RemBob(landbob);
-                  RemBob(padbob);
-                  DrawGList(window->RPort, ViewPortAddress(window));
-                  AddBob(landbob, window->RPort);
-                  AddBob(padbob, window->RPort);
-                  WaitTOF();
-                  /* */
-               }
-            }
-            else
-            {
-               printf("Could not create closeview downflamebob[1] bob\n");
-            }
-            free_bob(downflamebob[0]);
-         }
-         else
-         {
-            printf("Could not create farview downflamebob[0] bob\n");
-         }
-         free_bob(rightflamebob);
-      }
-      else
-      {
-         printf("Could not create farview rightflamebob bob\n");
-      }
-      free_bob(leftflamebob);
+      gameinfo->state = gameinfo->result;
    }
    else
    {
-      printf("Could not create farview leftflamebob bob\n");
+      gameinfo->state = LEAVE_VIEW;
    }
-   
-   return FAIL;
+
+   return WAIT_TOF;
 }
 
 
@@ -1566,81 +1555,114 @@ int process_pad_c_events(struct ProbeInfo *probeinfo, struct Bob *probebob,
 ** process_input()
 **
 ** Get a message from the window & handle input.  Change probeinfo values
-** if a key is pressed, pause game if window becomes inactive.
-** Update the fuel bar in the window if thrusters are used.
+** if a key is pressed.  Update the fuel bar in the window if thrusters
+** are used.
 **
-** RETURNS:  QUIT if user selected closewindow gadget, else returns OK.
+** RETURNS:  QUIT if user selected closewindow gadget,
+**           PAUSED if the window has become inactive (the keyboard is not
+**           read), else returns OK.
 */
-int process_input(struct ProbeInfo *probeinfo)
+int process_input(struct GameInfo *gameinfo, struct ProbeInfo *probeinfo)
 {
    struct IntuiMessage *imsg;
    ULONG class;
    USHORT code;
-   
+
    /* check the idcmp port */
-   if (NULL != (imsg = (struct IntuiMessage *)GetMsg(window->UserPort)))
+   if (NULL != (imsg = (struct IntuiMessage *)GetMsg(gameinfo->window->UserPort)))
    {
       class = imsg->Class;
       code = imsg->Code;
       ReplyMsg((struct Message *)imsg);
-      
+
       switch(class)
       {
          case IDCMP_CLOSEWINDOW:
             return QUIT;
             break;
          case IDCMP_INACTIVEWINDOW:
-            FOREVER
-            {
-               Wait (1 << window->UserPort->mp_SigBit);
-               
-               while (NULL != (imsg = (struct IntuiMessage *)GetMsg(window->UserPort)))
-               {
-                  class = imsg->Class;
-                  ReplyMsg((struct Message *)imsg);
-                  
-                  if (class == IDCMP_ACTIVEWINDOW)
-                  {
-                     break;
-                  }
-               }
-               if (class == IDCMP_ACTIVEWINDOW)
-               {
-                  break;
-               }
-            }
+            return PAUSED;
+            break;
+         case IDCMP_NEWPREFS:
+            new_prefs(gameinfo);
             break;
       }
    }
    /* */
-   
+
+   read_controls(gameinfo, probeinfo);
+
+   return OK;
+}
+
+
+/*
+** new_prefs()
+**
+** Read the Workbench screen again after its preferences have changed,
+** and make the Bobs kept for reuse again if its depth has.
+*/
+void new_prefs(struct GameInfo *gameinfo)
+{
+   read_screen_info();
+   renew_gels(gameinfo);
+}
+
+
+/*
+** read_controls()
+**
+** Check the keyboard (or ask the autopilot, if it is flying) and fire
+** the thrusters the user is holding down.
+*/
+void read_controls(struct GameInfo *gameinfo, struct ProbeInfo *probeinfo)
+{
    /* check keyboard */
-   probeinfo->user_input = read_keyboard();
-   
-   if ((probeinfo->user_input & CURSOR_UP) && (probeinfo->fuel >= 0))
-   {
-      if (probeinfo->y_vel > -1.925)
-      {
-         probeinfo->y_vel-=0.075;
-      }
-      probeinfo->fuel-=0.5;
-   }
-   if ((probeinfo->user_input & CURSOR_RIGHT) && (probeinfo->fuel >= 0))
+   if (gameinfo->autopilot != NULL)
    {
-      probeinfo->x_vel-=0.025;
-      probeinfo->fuel-=0.25;
+      probeinfo->user_input = fly_autopilot(gameinfo);
    }
-   if ((probeinfo->user_input & CURSOR_LEFT) && (probeinfo->fuel >= 0))
+   else
    {
-      probeinfo->x_vel+=0.025;
-      probeinfo->fuel-=0.25;
+      probeinfo->user_input = read_keyboard(gameinfo);
    }
+   
+   fire_thrusters(&gameinfo->physics, probeinfo);
    /* */
 
    /* update the fuel bar in the window to reflect any change in fuel */
-   update_fuel_bar(probeinfo);
-   
-   return OK;
+   update_fuel_bar(gameinfo, probeinfo);
+}
+
+
+/*
+** note_position()
+**
+** Keep where the feet of the probe are in the image of the view (which
+** is drawn at x 3, 10 lines above the top of the window) in the record
+** of the flight, and how far they are from the middle of the pad.  The
+** probe is 24 pixels across in the far view and 48 in the pad views.
+*/
+void note_position(struct GameInfo *gameinfo)
+{
+   struct VSprite *probe;
+   int width;
+
+   probe = gameinfo->probebob->BobVSprite;
+   width = (gameinfo->view == GO_FAR) ? 24 : 48;
+
+   gameinfo->flight.x = probe->X - 3 + width/2;
+   gameinfo->flight.y = probe->Y + probe->Height - 1 - gameinfo->title_height + 10;
+
+   if (gameinfo->padbob != NULL)
+   {
+      gameinfo->flight.pad_offset = probe->X + width/2 -
+         (gameinfo->padbob->BobVSprite->X + gameinfo->padbob->BobVSprite->Width*8);
+   }
+   else
+   {
+      gameinfo->flight.pad_offset = 0;
+   }
 }
 
 
@@ -1648,43 +1670,61 @@ int process_input(struct ProbeInfo *probeinfo)
 ** do_landed()
 **
 ** Check whether probe landed within allowed velocity.  If not then print
-** "SORRY, NO BONUS" and return CRASHED.  If landing was successful,
-** calculate increase in score and update score and fuel values (and update
-** screen display of them).
+** "SORRY, NO BONUS" and go on to CRASHED.  If landing was successful,
+** calculate increase in score and go on to TALLY to add it to the score
+** & fuel.
 **
-** RETURNS:  SETUP if landed successfully after adding to score & fuel
-**           CRASHED if landing was too hard
+** RETURNS:  WAIT_DELAY if landing was too hard, else WAIT_NONE.
 */
-int do_landed(struct ProbeInfo *probeinfo, int bonus)
+int do_landed(struct GameInfo *gameinfo)
 {
+   struct ProbeInfo *probeinfo;
+
    int points;    /* depends on how soft landing is */
+   int bonus;     /* of the pad landed on */
    int total;     /* points x bonus */
-   
+
    char output[16];  /* final output string "### x # = ####" */
    char s[7];        /* for conversion from INT->ASCII */
    int n;            /* for conversion from INT->ASCII */
-   
+
    int x;   /* counter */
-   
-   
+
+
+   probeinfo = &gameinfo->probeinfo;
+   bonus = gameinfo->bonus;
+
+   /* on pad b, check if both legs are completely on the pad */
+   if ((gameinfo->view == GO_PAD_B) &&
+      ((gameinfo->probebob->BobVSprite->X < 97) ||
+      (gameinfo->probebob->BobVSprite->X > 132)))
+   {
+      gameinfo->flight.result = CRASHED;
+      gameinfo->state = CRASHED;
+      return WAIT_NONE;
+   }
+   /* */
+
    /* did probe land too hard */
    if (probeinfo->y_vel >= 0.35)
    {
       /* print "SORRY, NO BONUS" */
-      SetDrMd(window->RPort, JAM1);
+      SetDrMd(gameinfo->window->RPort, JAM1);
       
-      SetAPen(window->RPort, BLACK);
-      RectFill(window->RPort, 66, 5+title_height, 202, 29+title_height);
+      SetAPen(gameinfo->window->RPort, BLACK);
+      RectFill(gameinfo->window->RPort, 66, 5+gameinfo->title_height, 202,
+         29+gameinfo->title_height);
       
-      SetAPen(window->RPort, WHITE);
-      Move(window->RPort, 74, 20+title_height);
-      Text(window->RPort, "SORRY, NO BONUS", 15);
+      SetAPen(gameinfo->window->RPort, WHITE);
+      Move(gameinfo->window->RPort, 74, 20+gameinfo->title_height);
+      Text(gameinfo->window->RPort, "SORRY, NO BONUS", 15);
       /* */
       
       /* probe did land on pad so we'll add a little delay for suspense */
-      Delay(100);
-
-      return CRASHED;
+      gameinfo->flight.result = CRASHED;
+      gameinfo->state = CRASHED;
+      gameinfo->delay = 100;
+      return WAIT_DELAY;
    }
    /* probe landed within allowed impact level */
    else
@@ -1692,12 +1732,14 @@ int do_landed(struct ProbeInfo *probeinfo, int bonus)
       /* points = ((0.35 - y_vel) / 0.35) * 4500.0 */
       points = (int)((0.35-probeinfo->y_vel)*1575.0);
       total = points * bonus;
+      gameinfo->flight.points = total;
       /* */
 
       /* print "### x ## = ####"  (points x bonus = total) */
-      SetDrMd(window->RPort, JAM1);
-      SetAPen(window->RPort, BLACK);
-      RectFill(window->RPort, 66, 5+title_height, 202, 29+title_height);
+      SetDrMd(gameinfo->window->RPort, JAM1);
+      SetAPen(gameinfo->window->RPort, BLACK);
+      RectFill(gameinfo->window->RPort, 66, 5+gameinfo->title_height, 202,
+         29+gameinfo->title_height);
       
          /* setup string to be printed */
          n = stci_d(s, points);
@@ -1722,382 +1764,445 @@ int do_landed(struct ProbeInfo *probeinfo, int bonus)
          strcpy(&output[15-n], s);
          /* */
          
-      SetAPen(window->RPort, WHITE);
-      Move(window->RPort, 74, 20+title_height);
-      Text(window->RPort, output, 15);
+      SetAPen(gameinfo->window->RPort, WHITE);
+      Move(gameinfo->window->RPort, 74, 20+gameinfo->title_height);
+      Text(gameinfo->window->RPort, output, 15);
       /* */
       
-      play_pop_sound();
-      /* add to score and fuel and update screen */
-      for (x=10; x <= total; x+=10)
+      play_pop_sound(gameinfo);
+
+      gameinfo->total = total;
+      gameinfo->count = 10;
+      gameinfo->state = TALLY;
+      return WAIT_NONE;
+   }
+}
+
+
+/*
+** do_tally()
+**
+** Add the points for landing to the score ten at a time, a frame apart,
+** with a little fuel for each.  Then go on to the next probe.
+**
+** RETURNS:  WAIT_TOF while adding, then WAIT_DELAY.
+*/
+int do_tally(struct GameInfo *gameinfo)
+{
+   struct ProbeInfo *probeinfo;
+
+   probeinfo = &gameinfo->probeinfo;
+
+   /* add to score and fuel and update screen */
+   if (gameinfo->count <= gameinfo->total)
+   {
+      gameinfo->score+=10;
+      if (probeinfo->fuel < 219)
       {
-         score+=10;
-         if (probeinfo->fuel < 219)
-         {
-            probeinfo->fuel+=0.25;
-         }
-         
-         update_score(&score, &hiscore);
-         update_fuel_bar(probeinfo);
-         
-         WaitTOF();
+         probeinfo->fuel+=0.25;
       }
-      end_pop_sound();
-      score+=(total-(x-10));           /* print final score (in case    */
-      update_score(&score, &hiscore);  /* total is not evenly divisible */
-      update_fuel_bar(probeinfo);      /* by ten                        */
-      /* */
-      
-      Delay(100);
-      
-      return SETUP;
+
+      update_score(gameinfo);
+      update_fuel_bar(gameinfo, probeinfo);
+
+      gameinfo->count+=10;
+      return WAIT_TOF;
    }
+   end_pop_sound(gameinfo);
+   gameinfo->score+=(gameinfo->total-(gameinfo->count-10)); /* print final score (in case */
+   update_score(gameinfo);                /* total is not evenly divisible */
+   update_fuel_bar(gameinfo, probeinfo);  /* by ten                        */
+   /* */
+
+   gameinfo->result = SETUP;
+   gameinfo->state = LEAVE_VIEW;
+   gameinfo->delay = 100;
+   return WAIT_DELAY;
 }
 
 
 /*
 ** do_out_of_sky()
 **
-** Print out OUT OF SKY in the window and delay for a few seconds.
+** Print out OUT OF SKY in the window and delay for a few seconds before
+** play begins again.
 **
-** RETURNS:  SETUP, which begins play again.
+** RETURNS:  WAIT_DELAY
 */
-int do_out_of_sky()
+int do_out_of_sky(struct GameInfo *gameinfo)
 {
    /* print "OUT OF SKY" */
-   SetDrMd(window->RPort, JAM1);
-   SetAPen(window->RPort, BLACK);
-   RectFill(window->RPort, 86, 5+title_height, 182, 29+title_height);
+   SetDrMd(gameinfo->window->RPort, JAM1);
+   SetAPen(gameinfo->window->RPort, BLACK);
+   RectFill(gameinfo->window->RPort, 86, 5+gameinfo->title_height, 182, 29+gameinfo->title_height);
    
-   SetAPen(window->RPort, WHITE);
-   Move(window->RPort, 94, 20+title_height);
-   Text(window->RPort, "OUT OF SKY", 10);
+   SetAPen(gameinfo->window->RPort, WHITE);
+   Move(gameinfo->window->RPort, 94, 20+gameinfo->title_height);
+   Text(gameinfo->window->RPort, "OUT OF SKY", 10);
    /* */
    
-   Delay(150);
-   
-   return SETUP;
+   gameinfo->result = SETUP;
+   gameinfo->state = LEAVE_VIEW;
+   gameinfo->delay = 150;
+   return WAIT_DELAY;
 }
 
 
 /*
 ** do_game_over()
 **
-** Print game over on the screen and delay before returning.
+** Print game over on the screen and delay before going back to the
+** title screen.
 **
-** RETURNS:  QUIT, which takes you back to title screen.
+** RETURNS:  WAIT_DELAY
 */
-int do_game_over(struct ProbeInfo *probeinfo)
+int do_game_over(struct GameInfo *gameinfo)
 {
-   SetDrMd(window->RPort, JAM1);
-   SetAPen(window->RPort, BLACK);
-   RectFill(window->RPort, 66, 30+title_height, 202, 54+title_height);
+   SetDrMd(gameinfo->window->RPort, JAM1);
+   SetAPen(gameinfo->window->RPort, BLACK);
+   RectFill(gameinfo->window->RPort, 66, 30+gameinfo->title_height, 202, 54+gameinfo->title_height);
    
-   SetAPen(window->RPort, WHITE);
-   Move(window->RPort, 98, 45+title_height);
-   Text(window->RPort, "GAME OVER", 9);
+   SetAPen(gameinfo->window->RPort, WHITE);
+   Move(gameinfo->window->RPort, 98, 45+gameinfo->title_height);
+   Text(gameinfo->window->RPort, "GAME OVER", 9);
    
-   Delay(250);
-   
-   return QUIT;
+   gameinfo->state = INTRO;
+   gameinfo->delay = 250;
+   return WAIT_DELAY;
 }
 
 
 /*
 ** do_far_view_crash()
 **
-** Display the destruction of the probe in the window.
-** Decrease the amount of fuel remaining for probe.
+** Start the destruction of the probe in the far view, shown a frame at
+** a time from CRASH_FRAME.
 **
-** RETURNS:  SETUP if successful, FAIL if unsuccessful.
+** RETURNS:  WAIT_NONE, with the view left with result FAIL if
+**           unsuccessful.
 */
-int do_far_view_crash(struct Bob *probebob, struct Bob *landbob,
-   struct ProbeInfo *probeinfo)
+int do_far_view_crash(struct GameInfo *gameinfo)
 {
-   struct Bob *farcrash_bob[7];
    NEWBOB farcrashNewBob;
-   
-   int x;
-   
+
    farcrashNewBob.nb_Image = NULL;
    farcrashNewBob.nb_WordWidth = 2;
    farcrashNewBob.nb_ImageDepth = 1;
    farcrashNewBob.nb_LineHeight = 21;
    farcrashNewBob.nb_BFlags = SAVEBACK | OVERLAY;
-   farcrashNewBob.nb_X = probebob->BobVSprite->X;
-   farcrashNewBob.nb_Y = probebob->BobVSprite->Y;
+   farcrashNewBob.nb_X = gameinfo->probebob->BobVSprite->X;
+   farcrashNewBob.nb_Y = gameinfo->probebob->BobVSprite->Y;
    farcrashNewBob.nb_HitMask = NULL;
    farcrashNewBob.nb_MeMask = NULL;
    farcrashNewBob.nb_PlanePick = 0x02;
    farcrashNewBob.nb_CollMask = NULL;
    
    farcrashNewBob.nb_Image = farcrash_image[0];
-   farcrash_bob[0] = create_bob(&farcrashNewBob);
-   if (farcrash_bob[0] != NULL)
+   gameinfo->crashbob[0] = create_bob(gameinfo, &farcrashNewBob);
+   if (gameinfo->crashbob[0] != NULL)
    {
       farcrashNewBob.nb_Image = farcrash_image[1];
-      farcrash_bob[1] = create_bob(&farcrashNewBob);
-      if (farcrash_bob[1] != NULL)
+      gameinfo->crashbob[1] = create_bob(gameinfo, &farcrashNewBob);
+      if (gameinfo->crashbob[1] != NULL)
       {
          farcrashNewBob.nb_Image = farcrash_image[2];
-         farcrash_bob[2] = create_bob(&farcrashNewBob);
-         if (farcrash_bob[2] != NULL)
+         gameinfo->crashbob[2] = create_bob(gameinfo, &farcrashNewBob);
+         if (gameinfo->crashbob[2] != NULL)
          {
             farcrashNewBob.nb_Image = farcrash_image[3];
-            farcrash_bob[3] = create_bob(&farcrashNewBob);
-            if (farcrash_bob[3] != NULL)
+            gameinfo->crashbob[3] = create_bob(gameinfo, &farcrashNewBob);
+            if (gameinfo->crashbob[3] != NULL)
             {
                farcrashNewBob.nb_Image = farcrash_image[4];
-               farcrash_bob[4] = create_bob(&farcrashNewBob);
-               if (farcrash_bob[4] != NULL)
+               gameinfo->crashbob[4] = create_bob(gameinfo, &farcrashNewBob);
+               if (gameinfo->crashbob[4] != NULL)
                {
                   farcrashNewBob.nb_Image = farcrash_image[5];
-                  farcrash_bob[5] = create_bob(&farcrashNewBob);
-                  if (farcrash_bob[5] != NULL)
+                  gameinfo->crashbob[5] = create_bob(gameinfo, &farcrashNewBob);
+                  if (gameinfo->crashbob[5] != NULL)
                   {
                      farcrashNewBob.nb_Image = farcrash_image[6];
-                     farcrash_bob[6] = create_bob(&farcrashNewBob);
-                     if (farcrash_bob[6] != NULL)
+                     gameinfo->crashbob[6] = create_bob(gameinfo, &farcrashNewBob);
+                     if (gameinfo->crashbob[6] != NULL)
                      {
                         /* start the probe crash sound */
-                        play_crash_sound();
-                        
+                        play_crash_sound(gameinfo);
+
                         /* remove these to speed up bob redrawing */
-                        RemBob(landbob);
-                        RemBob(probebob);
+                        RemBob(gameinfo->landbob);
+                        RemBob(gameinfo->probebob);
                         /* */
-                        
-                        for (x=0; x<7; x++)
-                        {
-                           /* show each frame of the crash in order */
-                           AddBob(farcrash_bob[x], window->RPort);
-                           redraw_bobs();
-                           WaitTOF();
-                           WaitTOF();
-                           WaitTOF();
-                           WaitTOF();
-                           RemBob(farcrash_bob[x]);
-                        }
-                        
-                        /* clear the last bob in crash sequence */
-                        redraw_bobs();
-                        
-                        /* free the farcrash bobs */
-                        for (x=0; x<7; x++)
-                        {
-                           free_bob(farcrash_bob[x]);
-                        }
-                        /* */
-                        
-                        /* add these back before returning */
-                        AddBob(landbob, window->RPort);
-                        AddBob(probebob, window->RPort);
-                        /* */
-                        
-                        /* wait for probe crash sound to finish */
-                        end_crash_sound();
-                        
-                        /* decrease fuel (penalty for crashing) */
-                        probeinfo->fuel-=30;
-                        update_fuel_bar(probeinfo);
-                        /* */
-                        
-                        Delay(100);
-                        
-                        return SETUP;
+
+                        gameinfo->count = 0;
+                        gameinfo->state = CRASH_FRAME;
+                        return WAIT_NONE;
                      }
                      else
                      {
                         printf("Could not create farcrash_bob[6] bob\n");
                      }
-                     free_bob(farcrash_bob[5]);
+                     free_bob(gameinfo->crashbob[5]);
                   }
                   else
                   {
                      printf("Could not create farcrash_bob[5] bob\n");
                   }
-                  free_bob(farcrash_bob[4]);
+                  free_bob(gameinfo->crashbob[4]);
                }
                else
                {
                   printf("Could not create farcrash_bob[4] bob\n");
                }
-               free_bob(farcrash_bob[3]);
+               free_bob(gameinfo->crashbob[3]);
             }
             else
             {
                printf("Could not create farcrash_bob[3] bob\n");
             }
-            free_bob(farcrash_bob[2]);
+            free_bob(gameinfo->crashbob[2]);
          }
          else
          {
             printf("Could not create farcrash_bob[2] bob\n");
          }
-         free_bob(farcrash_bob[1]);
+         free_bob(gameinfo->crashbob[1]);
       }
       else
       {
          printf("Could not create farcrash_bob[1] bob\n");
       }
-      free_bob(farcrash_bob[0]);
+      free_bob(gameinfo->crashbob[0]);
    }
    else
    {
       printf("Could not create farcrash_bob[0] bob\n");
    }
    
-   return FAIL;
+   gameinfo->result = FAIL;
+   gameinfo->state = LEAVE_VIEW;
+   return WAIT_NONE;
 }
 
 
 /*
 ** do_close_view_crash()
 **
-** Display the destruction of the probe in the window.
-** Decrease the amount of fuel remaining for probe.
+** Start the destruction of the probe in a pad view, shown a frame at
+** a time from CRASH_FRAME.
 **
-** RETURNS:  SETUP if successful, FAIL if unsuccessful.
+** RETURNS:  WAIT_NONE, with the view left with result FAIL if
+**           unsuccessful.
 */
-int do_close_view_crash(struct Bob *probebob, struct Bob *landbob,
-   struct Bob *padbob, struct ProbeInfo *probeinfo)
+int do_close_view_crash(struct GameInfo *gameinfo)
 {
-   struct Bob *closecrash_bob[7];
    NEWBOB closecrashNewBob;
-   
-   int x;
-   
+
    closecrashNewBob.nb_Image = NULL;
    closecrashNewBob.nb_WordWidth = 3;
    closecrashNewBob.nb_ImageDepth = 1;
    closecrashNewBob.nb_LineHeight = 42;
    closecrashNewBob.nb_BFlags = SAVEBACK | OVERLAY;
-   closecrashNewBob.nb_X = probebob->BobVSprite->X;
-   closecrashNewBob.nb_Y = probebob->BobVSprite->Y;
+   closecrashNewBob.nb_X = gameinfo->probebob->BobVSprite->X;
+   closecrashNewBob.nb_Y = gameinfo->probebob->BobVSprite->Y;
    closecrashNewBob.nb_HitMask = NULL;
    closecrashNewBob.nb_MeMask = NULL;
    closecrashNewBob.nb_PlanePick = 0x02;
    closecrashNewBob.nb_CollMask = NULL;
    
    closecrashNewBob.nb_Image = closecrash_image[0];
-   closecrash_bob[0] = create_bob(&closecrashNewBob);
-   if (closecrash_bob[0] != NULL)
+   gameinfo->crashbob[0] = create_bob(gameinfo, &closecrashNewBob);
+   if (gameinfo->crashbob[0] != NULL)
    {
       closecrashNewBob.nb_Image = closecrash_image[1];
-      closecrash_bob[1] = create_bob(&closecrashNewBob);
-      if (closecrash_bob[1] != NULL)
+      gameinfo->crashbob[1] = create_bob(gameinfo, &closecrashNewBob);
+      if (gameinfo->crashbob[1] != NULL)
       {
          closecrashNewBob.nb_Image = closecrash_image[2];
-         closecrash_bob[2] = create_bob(&closecrashNewBob);
-         if (closecrash_bob[2] != NULL)
+         gameinfo->crashbob[2] = create_bob(gameinfo, &closecrashNewBob);
+         if (gameinfo->crashbob[2] != NULL)
          {
             closecrashNewBob.nb_Image = closecrash_image[3];
-            closecrash_bob[3] = create_bob(&closecrashNewBob);
-            if (closecrash_bob[3] != NULL)
+            gameinfo->crashbob[3] = create_bob(gameinfo, &closecrashNewBob);
+            if (gameinfo->crashbob[3] != NULL)
             {
                closecrashNewBob.nb_Image = closecrash_image[4];
-               closecrash_bob[4] = create_bob(&closecrashNewBob);
-               if (closecrash_bob[4] != NULL)
+               gameinfo->crashbob[4] = create_bob(gameinfo, &closecrashNewBob);
+               if (gameinfo->crashbob[4] != NULL)
                {
                   closecrashNewBob.nb_Image = closecrash_image[5];
-                  closecrash_bob[5] = create_bob(&closecrashNewBob);
-                  if (closecrash_bob[5] != NULL)
+                  gameinfo->crashbob[5] = create_bob(gameinfo, &closecrashNewBob);
+                  if (gameinfo->crashbob[5] != NULL)
                   {
                      closecrashNewBob.nb_Image = closecrash_image[6];
-                     closecrash_bob[6] = create_bob(&closecrashNewBob);
-                     if (closecrash_bob[6] != NULL)
+                     gameinfo->crashbob[6] = create_bob(gameinfo, &closecrashNewBob);
+                     if (gameinfo->crashbob[6] != NULL)
                      {
                         /* start the probe crash sound */
-                        play_crash_sound();
-                        
+                        play_crash_sound(gameinfo);
+
                         /* remove these to speed up bob redrawing */
-                        RemBob(landbob);
-                        RemBob(probebob);
-                        RemBob(padbob);
-                        /* */
-                        
-                        for (x=0; x<7; x++)
-                        {
-                           /* show each frame of the crash in order */
-                           AddBob(closecrash_bob[x], window->RPort);
-                           redraw_bobs();
-                           WaitTOF();
-                           WaitTOF();
-                           WaitTOF();
-                           WaitTOF();
-                           RemBob(closecrash_bob[x]);
-                        }
-                        
-                        /* clear the last bob in crash sequence */
-                        redraw_bobs();
-                        
-                        /* free the closecrash bobs */
-                        for (x=0; x<7; x++)
-                        {
-                           free_bob(closecrash_bob[x]);
-                        }
-                        /* */
-                        
-                        /* add these back before returning */
-                        AddBob(landbob, window->RPort);
-                        AddBob(probebob, window->RPort);
-                        AddBob(padbob, window->RPort);
-                        /* */
-                        
-                        /* wait for probe crash sound to finish */
-                        end_crash_sound();
-                        
-                        /* decrease fuel (penalty for crashing) */
-                        probeinfo->fuel-=30;
-                        update_fuel_bar(probeinfo);
+                        RemBob(gameinfo->landbob);
+                        RemBob(gameinfo->probebob);
+                        RemBob(gameinfo->padbob);
                         /* */
-                        
-                        Delay(100);
-                        
-                        return SETUP;
+
+                        gameinfo->count = 0;
+                        gameinfo->state = CRASH_FRAME;
+                        return WAIT_NONE;
                      }
                      else
                      {
                         printf("Could not create closecrash_bob[6] bob\n");
                      }
-                     free_bob(closecrash_bob[5]);
+                     free_bob(gameinfo->crashbob[5]);
                   }
                   else
                   {
                      printf("Could not create closecrash_bob[5] bob\n");
                   }
-                  free_bob(closecrash_bob[4]);
+                  free_bob(gameinfo->crashbob[4]);
                }
                else
                {
                   printf("Could not create closecrash_bob[4] bob\n");
                }
-               free_bob(closecrash_bob[3]);
+               free_bob(gameinfo->crashbob[3]);
             }
             else
             {
                printf("Could not create closecrash_bob[3] bob\n");
             }
-            free_bob(closecrash_bob[2]);
+            free_bob(gameinfo->crashbob[2]);
          }
          else
          {
             printf("Could not create closecrash_bob[2] bob\n");
          }
-         free_bob(closecrash_bob[1]);
+         free_bob(gameinfo->crashbob[1]);
       }
       else
       {
          printf("Could not create closecrash_bob[1] bob\n");
       }
-      free_bob(closecrash_bob[0]);
+      free_bob(gameinfo->crashbob[0]);
    }
    else
    {
       printf("Could not create closecrash_bob[0] bob\n");
    }
    
-   return FAIL;
+   gameinfo->result = FAIL;
+   gameinfo->state = LEAVE_VIEW;
+   return WAIT_NONE;
+}
+
+
+/*
+** do_crash_frame()
+**
+** Show each of the 7 frames of the crash in order, for 5 frames of the
+** display apiece.  Once the last has been cleared the view's own Bobs
+** are put back and play goes on to CRASH_SOUND.
+**
+** RETURNS:  WAIT_TOF
+*/
+int do_crash_frame(struct GameInfo *gameinfo)
+{
+   int x;
+
+   if ((gameinfo->count % 5) == 0)
+   {
+      x = gameinfo->count / 5;
+
+      if (x > 0)
+      {
+         RemBob(gameinfo->crashbob[x-1]);
+      }
+
+      if (x == 7)
+      {
+         /* clear the last bob in crash sequence */
+         redraw_bobs(gameinfo);
+
+         /* free the crash bobs */
+         for (x=0; x<7; x++)
+         {
+            free_bob(gameinfo->crashbob[x]);
+         }
+         /* */
+
+         /* add these back */
+         AddBob(gameinfo->landbob, gameinfo->window->RPort);
+         AddBob(gameinfo->probebob, gameinfo->window->RPort);
+         if (gameinfo->padbob != NULL)
+         {
+            AddBob(gameinfo->padbob, gameinfo->window->RPort);
+         }
+         /* */
+
+         gameinfo->state = CRASH_SOUND;
+         return WAIT_TOF;
+      }
+
+      /* show each frame of the crash in order */
+      AddBob(gameinfo->crashbob[x], gameinfo->window->RPort);
+      redraw_bobs(gameinfo);
+   }
+
+   gameinfo->count++;
+   return WAIT_TOF;
+}
+
+
+/*
+** do_crash_sound()
+**
+** Wait for the probe crash sound to finish, then decrease the amount of
+** fuel remaining (penalty for crashing) and go on to the next probe.
+**
+** RETURNS:  WAIT_PORT until the sound has finished, then WAIT_DELAY.
+*/
+int do_crash_sound(struct GameInfo *gameinfo)
+{
+   int wait;
+
+   /* wait for probe crash sound to finish */
+   wait = end_crash_sound(gameinfo);
+   if (wait != WAIT_NONE)
+   {
+      return wait;
+   }
+   /* */
+
+   /* decrease fuel (penalty for crashing) */
+   gameinfo->probeinfo.fuel-=30;
+   update_fuel_bar(gameinfo, &gameinfo->probeinfo);
+   /* */
+
+   gameinfo->result = SETUP;
+   gameinfo->state = LEAVE_VIEW;
+   gameinfo->delay = 100;
+   return WAIT_DELAY;
+}
+
+
+/*
+** put_flames()
+**
+** Put up the thruster flames of the view being played.
+*/
+void put_flames(struct GameInfo *gameinfo)
+{
+   if (gameinfo->view == GO_FAR)
+   {
+      put_small_flames(gameinfo, &gameinfo->probeinfo, gameinfo->probebob,
+         gameinfo->leftflamebob, gameinfo->rightflamebob, gameinfo->downflamebob);
+   }
+   else
+   {
+      put_big_flames(gameinfo, &gameinfo->probeinfo, gameinfo->probebob,
+         gameinfo->leftflamebob, gameinfo->rightflamebob, gameinfo->downflamebob);
+   }
 }
 
 
@@ -2109,32 +2214,34 @@ int do_close_view_crash(struct Bob *probebob, struct Bob *landbob,
 ** according to probe bob's position.  Remove any flame bobs no longer
 ** required.
 */
-void put_small_flames(struct ProbeInfo *probeinfo, struct Bob *probebob,
-   struct Bob *leftflamebob, struct Bob *rightflamebob,
+void put_small_flames(struct GameInfo *gameinfo, struct ProbeInfo *probeinfo,
+   struct Bob *probebob, struct Bob *leftflamebob, struct Bob *rightflamebob,
    struct Bob *downflamebob[2])
 {
-   static int left=FALSE, right=FALSE, down=FALSE, x=0;
+   struct FlameInfo *flames;
+   
    
+   flames = &gameinfo->small_flames;
    
    /* check if left thruster is activated by user */
    if ((probeinfo->user_input & CURSOR_LEFT) && (probeinfo->fuel > 0))
    {
-      if (left == FALSE)
+      if (flames->left == FALSE)
       {
-         AddBob(leftflamebob, window->RPort);
-         begin_left_thruster_sound();
-         left = TRUE;
+         AddBob(leftflamebob, gameinfo->window->RPort);
+         begin_left_thruster_sound(gameinfo);
+         flames->left = TRUE;
       }
       leftflamebob->BobVSprite->X = probebob->BobVSprite->X;
       leftflamebob->BobVSprite->Y = probebob->BobVSprite->Y + 5;
    }
    else
    {
-      if (left == TRUE)
+      if (flames->left == TRUE)
       {
          RemBob(leftflamebob);
-         end_left_thruster_sound();
-         left = FALSE;
+         end_left_thruster_sound(gameinfo);
+         flames->left = FALSE;
       }
    }
    /* */
@@ -2142,22 +2249,22 @@ void put_small_flames(struct ProbeInfo *probeinfo, struct Bob *probebob,
    /* check if right thruster is activated by user */
    if ((probeinfo->user_input & CURSOR_RIGHT) && (probeinfo->fuel > 0))
    {
-      if (right == FALSE)
+      if (flames->right == FALSE)
       {
-         AddBob(rightflamebob, window->RPort);
-         begin_right_thruster_sound();
-         right = TRUE;
+         AddBob(rightflamebob, gameinfo->window->RPort);
+         begin_right_thruster_sound(gameinfo);
+         flames->right = TRUE;
       }
       rightflamebob->BobVSprite->X = probebob->BobVSprite->X + 20;
       rightflamebob->BobVSprite->Y = probebob->BobVSprite->Y + 5;
    }
    else
    {
-      if (right == TRUE)
+      if (flames->right == TRUE)
       {
          RemBob(rightflamebob);
-         end_right_thruster_sound();
-         right = FALSE;
+         end_right_thruster_sound(gameinfo);
+         flames->right = FALSE;
       }
    }
    /* */
@@ -2165,29 +2272,29 @@ void put_small_flames(struct ProbeInfo *probeinfo, struct Bob *probebob,
    /* check if main thruster is activated by user */
    if ((probeinfo->user_input & CURSOR_UP) && (probeinfo->fuel > 0))
    {
-      if (down == FALSE)
+      if (flames->down == FALSE)
       {
-         x ^= 1;  /* alternate x between 0 and 1 */
-         AddBob(downflamebob[x], window->RPort);
-         begin_main_thruster_sound();
-         down = TRUE;
+         flames->x ^= 1;  /* alternate x between 0 and 1 */
+         AddBob(downflamebob[flames->x], gameinfo->window->RPort);
+         begin_main_thruster_sound(gameinfo);
+         flames->down = TRUE;
       }
       else
       {
-         RemBob(downflamebob[x]);
-         x ^= 1;
-         AddBob(downflamebob[x], window->RPort);
+         RemBob(downflamebob[flames->x]);
+         flames->x ^= 1;
+         AddBob(downflamebob[flames->x], gameinfo->window->RPort);
       }
-      downflamebob[x]->BobVSprite->X = probebob->BobVSprite->X + 7;
-      downflamebob[x]->BobVSprite->Y = probebob->BobVSprite->Y + 16;
+      downflamebob[flames->x]->BobVSprite->X = probebob->BobVSprite->X + 7;
+      downflamebob[flames->x]->BobVSprite->Y = probebob->BobVSprite->Y + 16;
    }
    else
    {
-      if (down == TRUE)
+      if (flames->down == TRUE)
       {
-         RemBob(downflamebob[x]);
-         end_main_thruster_sound();
-         down = FALSE;
+         RemBob(downflamebob[flames->x]);
+         end_main_thruster_sound(gameinfo);
+         flames->down = FALSE;
       }
    }
    /* */
@@ -2202,32 +2309,34 @@ void put_small_flames(struct ProbeInfo *probeinfo, struct Bob *probebob,
 ** according to probe bob's position.  Remove any flame bobs no longer
 ** required.
 */
-void put_big_flames(struct ProbeInfo *probeinfo, struct Bob *probebob,
-   struct Bob *leftflamebob, struct Bob *rightflamebob,
+void put_big_flames(struct GameInfo *gameinfo, struct ProbeInfo *probeinfo,
+   struct Bob *probebob, struct Bob *leftflamebob, struct Bob *rightflamebob,
    struct Bob *downflamebob[2])
 {
-   static int left=FALSE, right=FALSE, down=FALSE, x=0;
+   struct FlameInfo *flames;
    
    
+   flames = &gameinfo->big_flames;
+   
    /* check if left thruster is activated by user */
    if ((probeinfo->user_input & CURSOR_LEFT) && (probeinfo->fuel > 0))
    {
-      if (left == FALSE)
+      if (flames->left == FALSE)
       {
-         AddBob(leftflamebob, window->RPort);
-         begin_left_thruster_sound();
-         left = TRUE;
+         AddBob(leftflamebob, gameinfo->window->RPort);
+         begin_left_thruster_sound(gameinfo);
+         flames->left = TRUE;
       }
       leftflamebob->BobVSprite->X = probebob->BobVSprite->X;
       leftflamebob->BobVSprite->Y = probebob->BobVSprite->Y + 10;
    }
    else
    {
-      if (left == TRUE)
+      if (flames->left == TRUE)
       {
          RemBob(leftflamebob);
-         end_left_thruster_sound();
-         left = FALSE;
+         end_left_thruster_sound(gameinfo);
+         flames->left = FALSE;
       }
    }
    /* */
@@ -2235,22 +2344,22 @@ void put_big_flames(struct ProbeInfo *probeinfo, struct Bob *probebob,
    /* check if right thruster is activated by user */
    if ((probeinfo->user_input & CURSOR_RIGHT) && (probeinfo->fuel > 0))
    {
-      if (right == FALSE)
+      if (flames->right == FALSE)
       {
-         AddBob(rightflamebob, window->RPort);
-         begin_right_thruster_sound();
-         right = TRUE;
+         AddBob(rightflamebob, gameinfo->window->RPort);
+         begin_right_thruster_sound(gameinfo);
+         flames->right = TRUE;
       }
       rightflamebob->BobVSprite->X = probebob->BobVSprite->X + 40;
       rightflamebob->BobVSprite->Y = probebob->BobVSprite->Y + 10;
    }
    else
    {
-      if (right == TRUE)
+      if (flames->right == TRUE)
       {
          RemBob(rightflamebob);
-         end_right_thruster_sound();
-         right = FALSE;
+         end_right_thruster_sound(gameinfo);
+         flames->right = FALSE;
       }
    }
    /* */
@@ -2258,30 +2367,31 @@ void put_big_flames(struct ProbeInfo *probeinfo, struct Bob *probebob,
    /* check if main thruster is activated by user */
    if ((probeinfo->user_input & CURSOR_UP) && (probeinfo->fuel > 0))
    {
-      if (down == FALSE)
+      if (flames->down == FALSE)
       {
-         x ^= 1;  /* alternate x between 0 and 1 */
-         AddBob(downflamebob[x], window->RPort);
-         begin_main_thruster_sound();
-         down = TRUE;
+         flames->x ^= 1;  /* alternate x between 0 and 1 */
+         AddBob(downflamebob[flames->x], gameinfo->window->RPort);
+         begin_main_thruster_sound(gameinfo);
+         flames->down = TRUE;
       }
       else
       {
-         RemBob(downflamebob[x]);
-         x ^= 1;
-         AddBob(downflamebob[x], window->RPort);
+         RemBob(downflamebob[flames->x]);
+         flames->x ^= 1;
+         AddBob(downflamebob[flames->x], gameinfo->window->RPort);
       }
-      downflamebob[x]->BobVSprite->X = probebob->BobVSprite->X + 14;
-      downflamebob[x]->BobVSprite->Y = probebob->BobVSprite->Y + 32;
+      downflamebob[flames->x]->BobVSprite->X = probebob->BobVSprite->X + 14;
+      downflamebob[flames->x]->BobVSprite->Y = probebob->BobVSprite->Y + 32;
    }
    else
    {
-      if (down == TRUE)
+      if (flames->down == TRUE)
       {
-         RemBob(downflamebob[x]);
-         end_main_thruster_sound();
-         down = FALSE;
+         RemBob(downflamebob[flames->x]);
+         end_main_thruster_sound(gameinfo);
+         flames->down = FALSE;
       }
    }
    /* */
 }
+
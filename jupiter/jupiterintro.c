@@ -12,22 +12,23 @@
 
 /** PROTOTYPES **/
 
-int intro(void);
+int intro(struct GameInfo *gameinfo);
 
-int game_title(void);
-int put_game_title_gadgets(struct Gadget **glist);
-void draw_game_title(void);
-int process_game_title_events(void);
+int game_title(struct GameInfo *gameinfo);
+int put_game_title_gadgets(struct GameInfo *gameinfo, struct Gadget **glist);
+void draw_game_title(struct GameInfo *gameinfo);
+int process_game_title_events(struct GameInfo *gameinfo);
 
-int instructions(void);
-int put_instructions_gadgets(struct Gadget **glist);
-void draw_instructions(void);
-int process_instructions_events(void);
+int instructions(struct GameInfo *gameinfo);
+int put_instructions_gadgets(struct GameInfo *gameinfo, struct Gadget **glist);
+void draw_instructions(struct GameInfo *gameinfo);
+int process_instructions_events(struct GameInfo *gameinfo);
 
-int clipping_to_borders(void);
+int clipping_to_borders(struct GameInfo *gameinfo);
 
 /* jupitermain.c */
-extern void unclip_window(void);
+extern void unclip_window(struct GameInfo *gameinfo);
+extern void read_screen_info(void);
 
 
 /** GLOBAL VARIABLES **/
@@ -38,10 +39,6 @@ extern struct Library *GfxBase;
 extern struct Library *GadToolsBase;
 extern struct Library *LayersBase;
 
-extern struct Window *window;
-
-extern int title_height;
-
 /* jl_images.c */
 extern UWORD *title_image_plane_1;
 extern UWORD *title_image_plane_2;
@@ -59,17 +56,17 @@ extern UWORD *title_image_plane_2;
 **
 ** RETURNS:  TRUE if successful, FALSE if unsuccessful.
 **/
-int clipping_to_borders()
+int clipping_to_borders(struct GameInfo *gameinfo)
 {
    struct Region *old_region;
    struct Region *new_region;
    struct Rectangle my_rectangle;
    
    /* set up the limits for the clip */
-   my_rectangle.MinX = window->BorderLeft;
-   my_rectangle.MinY = window->BorderTop;
-   my_rectangle.MaxX = (window->Width)-(window->BorderRight)-1;
-   my_rectangle.MaxY = (window->Height)-(window->BorderBottom)-1;
+   my_rectangle.MinX = gameinfo->window->BorderLeft;
+   my_rectangle.MinY = gameinfo->window->BorderTop;
+   my_rectangle.MaxX = (gameinfo->window->Width)-(gameinfo->window->BorderRight)-1;
+   my_rectangle.MaxY = (gameinfo->window->Height)-(gameinfo->window->BorderBottom)-1;
    /* */
    
    /* get a new region and OR in the limits */
@@ -89,7 +86,7 @@ int clipping_to_borders()
    /* */
 
    /* Dispose of previous region if one was previously installed. */   
-   old_region = InstallClipRegion(window->WLayer, new_region);
+   old_region = InstallClipRegion(gameinfo->window->WLayer, new_region);
    
    if (old_region != NULL)
    {
@@ -109,12 +106,12 @@ int clipping_to_borders()
 ** RETURNS:  either PLAY or QUIT depending on user's choice or the
 **           occurence of an error.
 */
-int intro()
+int intro(struct GameInfo *gameinfo)
 {
    int result;
    
    /* set up clipping region for window (to window's borders) */
-   if ( clipping_to_borders() == FALSE)
+   if ( clipping_to_borders(gameinfo) == FALSE)
    {
       return QUIT;
    }
@@ -126,7 +123,7 @@ int intro()
    FOREVER
    {
       /* handle game title */
-      result = game_title();
+      result = game_title(gameinfo);
       
       switch (result)
       {
@@ -142,7 +139,7 @@ int intro()
       /* */
       
       /* handle instructions */
-      result = instructions();
+      result = instructions(gameinfo);
 
       switch (result)
       {
@@ -168,18 +165,18 @@ int intro()
 ** RETURNS:  PLAY, HELP, QUIT or FAIL depending on user's selection
 **           or the occurence of error.
 */
-int game_title()
+int game_title(struct GameInfo *gameinfo)
 {
    int result;
    struct Gadget *glist;
    
-   SetRast(window->RPort, GREY);
+   SetRast(gameinfo->window->RPort, GREY);
    
    /* draw the graphics in this window */
-   draw_game_title();
+   draw_game_title(gameinfo);
    
    /* put the 3 gadgets (play, help, quit) in the window */
-   result = put_game_title_gadgets(&glist);
+   result = put_game_title_gadgets(gameinfo, &glist);
    
    if (result == FALSE)
    {
@@ -188,10 +185,10 @@ int game_title()
    /* */
    
    /* handle input events for this window */
-   result = process_game_title_events();
+   result = process_game_title_events(gameinfo);
    
    /* remove the gadgets from the window */
-   RemoveGList(window, glist, -1);
+   RemoveGList(gameinfo->window, glist, -1);
    FreeGadgets(glist);
    /* */
    
@@ -206,7 +203,7 @@ int game_title()
 **
 ** RETURNS:  TRUE if successful, FALSE if unsuccessful.
 */
-int put_game_title_gadgets(struct Gadget **glist)
+int put_game_title_gadgets(struct GameInfo *gameinfo, struct Gadget **glist)
 {
    struct Gadget *gad;
    struct NewGadget newgad;
@@ -217,7 +214,7 @@ int put_game_title_gadgets(struct Gadget **glist)
    gad = CreateContext(glist);
    
    /* get the visualinfo for Workbench screen for gadget rendering */
-   vi = GetVisualInfo(window->WScreen, TAG_END);
+   vi = GetVisualInfo(gameinfo->window->WScreen, TAG_END);
    
    if (vi == NULL)
    {
@@ -227,7 +224,7 @@ int put_game_title_gadgets(struct Gadget **glist)
    /* */
    
    /* these values are the same for all 3 gadgets */
-   newgad.ng_TopEdge = 168+title_height;
+   newgad.ng_TopEdge = 168+gameinfo->title_height;
    newgad.ng_Width = 54;
    newgad.ng_Height = 12;
    newgad.ng_TextAttr = &Topaz80;
@@ -266,9 +263,9 @@ int put_game_title_gadgets(struct Gadget **glist)
    if (gad != NULL)
    {
       /* put these gadgets in the window */
-      AddGList(window, *glist, ~0, -1, NULL);
-      RefreshGList(*glist, window, NULL, -1);
-      GT_RefreshWindow(window, NULL);
+      AddGList(gameinfo->window, *glist, ~0, -1, NULL);
+      RefreshGList(*glist, gameinfo->window, NULL, -1);
+      GT_RefreshWindow(gameinfo->window, NULL);
       /* */
    
       return TRUE;
@@ -289,7 +286,7 @@ int put_game_title_gadgets(struct Gadget **glist)
 **
 ** Draw the title picture into the game window.
 */
-VOID draw_game_title()
+VOID draw_game_title(struct GameInfo *gameinfo)
 {
    struct BitMap titleBitMap;
    
@@ -301,7 +298,7 @@ VOID draw_game_title()
    /* */
    
    /* blit the contents of the bitmap into the window */
-   BltBitMapRastPort(&titleBitMap, 0, 0, window->RPort, 3, title_height,
+   BltBitMapRastPort(&titleBitMap, 0, 0, gameinfo->window->RPort, 3, gameinfo->title_height,
                      313, 187, 0xc0);
 }
 
@@ -314,7 +311,7 @@ VOID draw_game_title()
 **
 ** RETURNS:  Returns PLAY, HELP or QUIT depending on user selection.
 */
-int process_game_title_events()
+int process_game_title_events(struct GameInfo *gameinfo)
 {
    struct IntuiMessage *imsg;
    struct Gadget *gad;
@@ -323,9 +320,9 @@ int process_game_title_events()
    
    FOREVER
    {
-      Wait(1 << window->UserPort->mp_SigBit);
+      Wait(1 << gameinfo->window->UserPort->mp_SigBit);
       
-      while ( imsg = GT_GetIMsg(window->UserPort) )
+      while ( imsg = GT_GetIMsg(gameinfo->window->UserPort) )
       {
          /* get needed info from this message & then reply to it */
          class = imsg->Class;
@@ -378,10 +375,13 @@ int process_game_title_events()
                   break;
             case IDCMP_REFRESHWINDOW:
                   /* refreshing of gadgets is necessary */
-                  GT_BeginRefresh(window);
-                  GT_EndRefresh(window, TRUE);
+                  GT_BeginRefresh(gameinfo->window);
+                  GT_EndRefresh(gameinfo->window, TRUE);
                   /* */
                   break;
+            case IDCMP_NEWPREFS:
+                  read_screen_info();
+                  break;
          }
          /* */
       }
@@ -398,15 +398,15 @@ int process_game_title_events()
 ** RETURNS:  OK, QUIT or FAIL depending on user's selection
 **           or the occurence of error.
 */
-int instructions()
+int instructions(struct GameInfo *gameinfo)
 {
    int result;
    struct Gadget *glist;
    
-   SetRast(window->RPort, GREY);
+   SetRast(gameinfo->window->RPort, GREY);
    
    /* put the gadget (ok) in the window */
-   result = put_instructions_gadgets(&glist);
+   result = put_instructions_gadgets(gameinfo, &glist);
    
    if (result == FALSE)
    {
@@ -415,13 +415,13 @@ int instructions()
    /* */
    
    /* draw the graphics in this window */
-   draw_instructions();
+   draw_instructions(gameinfo);
    
    /* handle input events for this window */
-   result = process_instructions_events();
+   result = process_instructions_events(gameinfo);
    
    /* remove the gadget from the window */
-   RemoveGList(window, glist, -1);
+   RemoveGList(gameinfo->window, glist, -1);
    FreeGadgets(glist);
    /* */
    
@@ -436,7 +436,7 @@ int instructions()
 **
 ** RETURNS:  TRUE if successful, FALSE if unsuccessful.
 */
-int put_instructions_gadgets(struct Gadget **glist)
+int put_instructions_gadgets(struct GameInfo *gameinfo, struct Gadget **glist)
 {
    struct Gadget *gad;
    struct NewGadget newgad;
@@ -447,7 +447,7 @@ int put_instructions_gadgets(struct Gadget **glist)
    gad = CreateContext(glist);
    
    /* get the visualinfo for Workbench screen for gadget rendering */
-   vi = GetVisualInfo(window->WScreen, TAG_END);
+   vi = GetVisualInfo(gameinfo->window->WScreen, TAG_END);
    
    if (vi == NULL)
    {
@@ -457,7 +457,7 @@ int put_instructions_gadgets(struct Gadget **glist)
    /* */
    
    /* set up newgadget structure & create gadget */
-   newgad.ng_TopEdge = 168+title_height;
+   newgad.ng_TopEdge = 168+gameinfo->title_height;
    newgad.ng_Width = 54;
    newgad.ng_Height = 12;
    newgad.ng_TextAttr = &Topaz80;
@@ -480,9 +480,9 @@ int put_instructions_gadgets(struct Gadget **glist)
    if (gad != NULL)
    {
       /* put this gadget in the window */
-      AddGList(window, *glist, ~0, -1, NULL);
-      RefreshGList(*glist, window, NULL, -1);
-      GT_RefreshWindow(window, NULL);
+      AddGList(gameinfo->window, *glist, ~0, -1, NULL);
+      RefreshGList(*glist, gameinfo->window, NULL, -1);
+      GT_RefreshWindow(gameinfo->window, NULL);
       /* */
    
       return TRUE;
@@ -504,17 +504,17 @@ int put_instructions_gadgets(struct Gadget **glist)
 **
 ** Draw all of the instructions text into the game window.
 */
-VOID draw_instructions()
+VOID draw_instructions(struct GameInfo *gameinfo)
 {
    struct IntuiText instrIText[12];
    struct TextAttr instrTextAttr;
    int x;
    
    /* create a TextAttr that matches our font with bold set */
-   instrTextAttr.ta_Name = window->RPort->Font->tf_Message.mn_Node.ln_Name;
-   instrTextAttr.ta_YSize = window->RPort->Font->tf_YSize;
-   instrTextAttr.ta_Style = window->RPort->Font->tf_Style | FSF_BOLD;
-   instrTextAttr.ta_Flags = window->RPort->Font->tf_Flags;
+   instrTextAttr.ta_Name = gameinfo->window->RPort->Font->tf_Message.mn_Node.ln_Name;
+   instrTextAttr.ta_YSize = gameinfo->window->RPort->Font->tf_YSize;
+   instrTextAttr.ta_Style = gameinfo->window->RPort->Font->tf_Style | FSF_BOLD;
+   instrTextAttr.ta_Flags = gameinfo->window->RPort->Font->tf_Flags;
    /* */
    
    /* set up values similar in all IntuiText structures */
@@ -592,7 +592,7 @@ VOID draw_instructions()
    instrIText[11].FrontPen = BLACK;
       
    /* Draw the text strings relative to base position 0,title_height */
-   PrintIText(window->RPort, instrIText, 1, title_height+5);
+   PrintIText(gameinfo->window->RPort, instrIText, 1, gameinfo->title_height+5);
    /* */
    
    /* Now print the text in it's main color */
@@ -604,7 +604,7 @@ VOID draw_instructions()
    }
    instrIText[11].FrontPen = WHITE;
    
-   PrintIText(window->RPort, instrIText, 0, title_height+4);
+   PrintIText(gameinfo->window->RPort, instrIText, 0, gameinfo->title_height+4);
    /* */
 }
 
@@ -617,7 +617,7 @@ VOID draw_instructions()
 **
 ** RETURNS:  Returns OK or QUIT depending on user selection.
 */
-int process_instructions_events()
+int process_instructions_events(struct GameInfo *gameinfo)
 {
    struct IntuiMessage *imsg;
    struct Gadget *gad;
@@ -626,9 +626,9 @@ int process_instructions_events()
    
    FOREVER
    {
-      Wait(1 << window->UserPort->mp_SigBit);
+      Wait(1 << gameinfo->window->UserPort->mp_SigBit);
       
-      while ( imsg = GT_GetIMsg(window->UserPort) )
+      while ( imsg = GT_GetIMsg(gameinfo->window->UserPort) )
       {
          /* get needed info from this message & then reply to it */
          class = imsg->Class;
@@ -662,10 +662,13 @@ int process_instructions_events()
                   break;
             case IDCMP_REFRESHWINDOW:
                   /* refreshing of gadget is necessary */
-                  GT_BeginRefresh(window);
-                  GT_EndRefresh(window, TRUE);
+                  GT_BeginRefresh(gameinfo->window);
+                  GT_EndRefresh(gameinfo->window, TRUE);
                   /* */
                   break;
+            case IDCMP_NEWPREFS:
+                  read_screen_info();
+                  break;
          }
          /* */
       }
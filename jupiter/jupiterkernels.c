@@ -0,0 +1,471 @@
+/*
+** jupiterkernels.c - timings of the game's hot kernels on the Linux host
+**
+** (c)1993 Paul Grebenc
+**
+** Times each of the game's own inner routines alone, for comparing one
+** change with the next: decompress() of every compressed image, the probe
+** against the land and pad masks of each view (probe_hits()), one frame of
+** the probe's flight in each view (step_probe()), the drawing of a Bob of
+** each sprite size, planar_to_chunky() of the window and the gauges
+** (update_score(), update_fuel_bar() and update_velocity_scale()).
+**
+** Each kernel is called in batches big enough to take BATCH_TIME, and
+** SAMPLES batches are timed.  The results are written as JSON: for each
+** kernel the calls in a batch and the mean, standard deviation, least and
+** most nanoseconds a call over the samples, so that two runs can be told
+** apart from noise.
+**
+** Build (Linux):
+**    cc -std=gnu99 -O2 -pthread -o jupiterkernels jupiterkernels.c \
+**       jupitergame.c jl_*.c -lm
+**
+** Usage:  jupiterkernels [file.json]
+*/
+
+
+/** INCLUDES & DEFINES **/
+
+#include <math.h>
+
+#include "jupiterdefs.h"
+
+/* seconds a batch of calls takes at least, and batches timed */
+#define BATCH_TIME      (0.002)
+#define SAMPLES         (31)
+
+#define TITLE_HEIGHT    (11)
+
+struct Kernel {
+   char *name;
+   void (*function)(int arg, LONG n);
+   int arg;             /* which image, view or sprite */
+};
+
+struct Compressed {
+   UBYTE *source;
+   LONG size;           /* decompressed */
+};
+
+struct Sprite {
+   UWORD *image;
+   SHORT  words;
+   SHORT  height;
+};
+
+
+/** PROTOTYPES **/
+
+static void kernel_decompress(int arg, LONG n);
+static void kernel_probe_hits(int arg, LONG n);
+static void kernel_step_probe(int arg, LONG n);
+static void kernel_bob(int arg, LONG n);
+static void kernel_planar_to_chunky(int arg, LONG n);
+static void kernel_update_score(int arg, LONG n);
+static void kernel_update_fuel_bar(int arg, LONG n);
+static void kernel_update_velocity_scale(int arg, LONG n);
+
+static void time_kernel(struct Kernel *kernel, FILE *file, char *comma);
+
+/* jupitergame.c */
+extern struct GameInfo *alloc_gameinfo(void);
+extern void free_gameinfo(struct GameInfo *gameinfo);
+
+/* jl_gels.c */
+extern int setup_gels(struct GameInfo *gameinfo);
+extern void cleanup_gels(struct GameInfo *gameinfo);
+extern struct Bob *create_bob(struct GameInfo *gameinfo, NEWBOB *nBob);
+extern void free_bob(struct Bob *bob);
+extern void redraw_bobs(struct GameInfo *gameinfo);
+
+/* jl_draw.c */
+extern int draw_game(struct GameInfo *gameinfo);
+
+/* jl_gamestuff.c */
+extern void update_velocity_scale(struct GameInfo *gameinfo,
+   struct ProbeInfo *probeinfo);
+extern void update_fuel_bar(struct GameInfo *gameinfo,
+   struct ProbeInfo *probeinfo);
+extern void update_score(struct GameInfo *gameinfo);
+
+/* jl_physics.c */
+extern int probe_hits(int view, int top, int x, int y);
+extern int step_probe(struct PhysicsInfo *physics, struct ProbeInfo *probeinfo,
+   int view, int top, int *score);
+
+/* jl_memory.c */
+extern void decompress_images(void);
+extern void free_images(void);
+extern void decompress(UBYTE *source, UBYTE *dest);
+
+/* jl_images.c */
+extern UBYTE title_image_plane_1_comp[3378];
+extern UBYTE title_image_plane_2_comp[4416];
+extern UBYTE farview_image_comp[2924];
+extern UBYTE farview_mask_comp[2560];
+extern UBYTE padaview_image_comp[2107];
+extern UBYTE padaview_mask_comp[1887];
+extern UBYTE padbview_image_comp[962];
+extern UBYTE padbview_mask_comp[739];
+extern UBYTE padcview_image_comp[2264];
+extern UBYTE padcview_mask_comp[1113];
+
+extern UWORD chip smallprobe_image[1*21*2];
+extern UWORD chip largeprobe_image[1*42*3];
+extern UWORD chip farflame_down_image[2][1*5*1];
+extern UWORD chip farflame_left_image[1*3*1];
+extern UWORD chip closeflame_down_image[2][1*10*2];
+extern UWORD chip closeflame_left_image[1*6*1];
+
+
+/** GLOBAL VARIABLES **/
+
+static struct Compressed compressed[] = {
+   { title_image_plane_1_comp,   (1*20*187)*2 },
+   { title_image_plane_2_comp,   (1*20*187)*2 },
+   { farview_image_comp,         (2*17*181)*2 },
+   { farview_mask_comp,          (1*17*181)*2 },
+   { padaview_image_comp,        (2*17*181)*2 },
+   { padaview_mask_comp,         (1*17*181)*2 },
+   { padbview_image_comp,        (2*17*181)*2 },
+   { padbview_mask_comp,         (1*17*181)*2 },
+   { padcview_image_comp,        (2*17*181)*2 },
+   { padcview_mask_comp,         (1*17*181)*2 },
+};
+
+static struct Sprite sprites[] = {
+   { smallprobe_image,          2, 21 },
+   { largeprobe_image,          3, 42 },
+   { farflame_down_image[0],    1, 5 },
+   { farflame_left_image,       1, 3 },
+   { closeflame_down_image[0],  2, 10 },
+   { closeflame_left_image,     1, 6 },
+};
+
+static struct Kernel kernels[] = {
+   { "decompress title_image_plane_1",    kernel_decompress, 0 },
+   { "decompress title_image_plane_2",    kernel_decompress, 1 },
+   { "decompress farview_image",          kernel_decompress, 2 },
+   { "decompress farview_mask",           kernel_decompress, 3 },
+   { "decompress padaview_image",         kernel_decompress, 4 },
+   { "decompress padaview_mask",          kernel_decompress, 5 },
+   { "decompress padbview_image",         kernel_decompress, 6 },
+   { "decompress padbview_mask",          kernel_decompress, 7 },
+   { "decompress padcview_image",         kernel_decompress, 8 },
+   { "decompress padcview_mask",          kernel_decompress, 9 },
+   { "probe_hits far",                    kernel_probe_hits, GO_FAR },
+   { "probe_hits pad A",                  kernel_probe_hits, GO_PAD_A },
+   { "probe_hits pad B",                  kernel_probe_hits, GO_PAD_B },
+   { "probe_hits pad C",                  kernel_probe_hits, GO_PAD_C },
+   { "step_probe far",                    kernel_step_probe, GO_FAR },
+   { "step_probe pad A",                  kernel_step_probe, GO_PAD_A },
+   { "step_probe pad B",                  kernel_step_probe, GO_PAD_B },
+   { "step_probe pad C",                  kernel_step_probe, GO_PAD_C },
+   { "Bob 2x21 smallprobe",               kernel_bob, 0 },
+   { "Bob 3x42 largeprobe",               kernel_bob, 1 },
+   { "Bob 1x5 farflame_down",             kernel_bob, 2 },
+   { "Bob 1x3 farflame_left",             kernel_bob, 3 },
+   { "Bob 2x10 closeflame_down",          kernel_bob, 4 },
+   { "Bob 1x6 closeflame_left",           kernel_bob, 5 },
+   { "planar_to_chunky",                  kernel_planar_to_chunky, 0 },
+   { "update_score",                      kernel_update_score, 0 },
+   { "update_fuel_bar",                   kernel_update_fuel_bar, 0 },
+   { "update_velocity_scale",             kernel_update_velocity_scale, 0 },
+};
+
+static struct GameInfo *gameinfo;
+
+/* the Bob moved about by kernel_bob() */
+static struct Bob *bob;
+
+/* decompress() output, as big as the biggest image */
+static UBYTE image[(2*17*181)*2];
+
+static UBYTE chunky[WINDOW_WIDTH*WINDOW_HEIGHT];
+
+static LONG sink;
+
+
+/*-----------------------------------------------------------------------*/
+
+
+main(int argc, char **argv)
+{
+   FILE *file;
+   NEWBOB newbob;
+   char *comma;
+   int n;
+
+   decompress_images();
+
+   if (NULL == (gameinfo = alloc_gameinfo()))
+   {
+      printf("Could not allocate GameInfo\n");
+      exit(RETURN_FAIL);
+   }
+   gameinfo->title_height = TITLE_HEIGHT;
+   gameinfo->window = OpenWindowTags(NULL,
+                        WA_Width,   WINDOW_WIDTH,
+                        WA_Height,  WINDOW_HEIGHT + TITLE_HEIGHT,
+                        TAG_END);
+   if ((gameinfo->window == NULL) || !setup_gels(gameinfo))
+   {
+      printf("Could not open window\n");
+      exit(RETURN_FAIL);
+   }
+   draw_game(gameinfo);
+
+   if (argc > 1)
+   {
+      if (NULL == (file = fopen(argv[1], "w")))
+      {
+         printf("Could not open %s\n", argv[1]);
+         exit(RETURN_FAIL);
+      }
+   }
+   else
+   {
+      file = stdout;
+   }
+
+   fprintf(file, "{\"batch_time_s\":%g,\"samples\":%d,\"kernels\":[",
+      BATCH_TIME, SAMPLES);
+   comma = "\n";
+   for (n=0; n < sizeof(kernels)/sizeof(kernels[0]); n++)
+   {
+      /* a Bob of the sprite's size, as the game makes them */
+      if (kernels[n].function == kernel_bob)
+      {
+         memset(&newbob, 0, sizeof(newbob));
+         newbob.nb_Image = sprites[kernels[n].arg].image;
+         newbob.nb_WordWidth = sprites[kernels[n].arg].words;
+         newbob.nb_ImageDepth = 1;
+         newbob.nb_LineHeight = sprites[kernels[n].arg].height;
+         newbob.nb_BFlags = SAVEBACK | OVERLAY;
+         newbob.nb_X = 20;
+         newbob.nb_Y = 20 + TITLE_HEIGHT;
+         newbob.nb_PlanePick = 0x02;
+
+         if (NULL == (bob = create_bob(gameinfo, &newbob)))
+         {
+            printf("Could not create Bob\n");
+            exit(RETURN_FAIL);
+         }
+         AddBob(bob, gameinfo->window->RPort);
+      }
+
+      time_kernel(&kernels[n], file, comma);
+      comma = ",\n";
+
+      if (kernels[n].function == kernel_bob)
+      {
+         RemBob(bob);
+         redraw_bobs(gameinfo);
+         free_bob(bob);
+      }
+   }
+   fprintf(file, "\n]}\n");
+
+   if (file != stdout)
+   {
+      fclose(file);
+   }
+
+   cleanup_gels(gameinfo);
+   CloseWindow(gameinfo->window);
+   free_gameinfo(gameinfo);
+   free_images();
+
+   exit(RETURN_OK);
+}
+
+
+/*
+** time_kernel()
+**
+** Find how many calls of a kernel take BATCH_TIME, time SAMPLES batches
+** of that many, and write what they came to as a JSON object.
+*/
+static void time_kernel(struct Kernel *kernel, FILE *file, char *comma)
+{
+   double sample[SAMPLES];
+   double start, mean, spread, least, most;
+   LONG batch, calls, n;
+   int s;
+
+   /* double the batch until it is long enough to time */
+   calls = 0;
+   batch = 1;
+   do
+   {
+      start = host_seconds();
+      for (n=0; n < batch; n++)
+      {
+         kernel->function(kernel->arg, calls++);
+      }
+      if (host_seconds() - start >= BATCH_TIME)
+      {
+         break;
+      }
+      batch *= 2;
+   } while (TRUE);
+
+   for (s=0; s < SAMPLES; s++)
+   {
+      start = host_seconds();
+      for (n=0; n < batch; n++)
+      {
+         kernel->function(kernel->arg, calls++);
+      }
+      sample[s] = (host_seconds() - start) * 1e9 / batch;
+   }
+
+   mean = 0.0;
+   least = most = sample[0];
+   for (s=0; s < SAMPLES; s++)
+   {
+      mean += sample[s];
+      least = (sample[s] < least) ? sample[s] : least;
+      most = (sample[s] > most) ? sample[s] : most;
+   }
+   mean /= SAMPLES;
+
+   spread = 0.0;
+   for (s=0; s < SAMPLES; s++)
+   {
+      spread += (sample[s] - mean) * (sample[s] - mean);
+   }
+   spread = sqrt(spread / (SAMPLES - 1));
+
+   fprintf(file, "%s{\"name\":\"%s\",\"calls\":%ld,\"mean_ns\":%.2f,"
+      "\"stddev_ns\":%.2f,\"min_ns\":%.2f,\"max_ns\":%.2f}", comma,
+      kernel->name, (long)batch, mean, spread, least, most);
+}
+
+
+/*
+** kernel_decompress()
+**
+** Decompress image arg of compressed[].
+*/
+static void kernel_decompress(int arg, LONG n)
+{
+   decompress(compressed[arg].source, image);
+   sink += image[n % compressed[arg].size];
+}
+
+
+/*
+** kernel_probe_hits()
+**
+** Test the probe against the land and pad of view arg, along a row just
+** above the land so that most of the masks are compared.
+*/
+static void kernel_probe_hits(int view, LONG n)
+{
+   int x;
+
+   x = n % (WINDOW_WIDTH - 64);
+   if (view == GO_FAR)
+   {
+      sink += probe_hits(view, TITLE_HEIGHT, x, 110 + TITLE_HEIGHT);
+   }
+   else
+   {
+      sink += probe_hits(view, TITLE_HEIGHT, x, 80 + TITLE_HEIGHT);
+   }
+}
+
+
+/*
+** kernel_step_probe()
+**
+** Fly the probe one frame of view arg from the middle of the sky, with
+** each way of holding the thrusters in turn.
+*/
+static void kernel_step_probe(int view, LONG n)
+{
+   struct ProbeInfo probeinfo;
+   int score;
+
+   static int keys[6] = {
+      0, CURSOR_UP, CURSOR_LEFT, CURSOR_RIGHT, CURSOR_UP | CURSOR_LEFT,
+      CURSOR_UP | CURSOR_RIGHT
+   };
+
+   probeinfo.x_pos = (view == GO_FAR) ? 120.0 : 60.0 + (view - GO_PAD_A) * 60;
+   probeinfo.y_pos = (view == GO_FAR) ? 40.0 : 100.0;
+   probeinfo.x_vel = 0.25;
+   probeinfo.y_vel = 0.5;
+   probeinfo.fuel = 100.0;
+   probeinfo.user_input = keys[n % 6];
+
+   sink += step_probe(&gameinfo->physics, &probeinfo, view, TITLE_HEIGHT,
+      &score);
+}
+
+
+/*
+** kernel_bob()
+**
+** Move the Bob made for the sprite along by a pixel and draw it as the
+** game does, with redraw_bobs().
+*/
+static void kernel_bob(int arg, LONG n)
+{
+   bob->BobVSprite->X = 20 + n % 200;
+   redraw_bobs(gameinfo);
+}
+
+
+/*
+** kernel_planar_to_chunky()
+**
+** Convert the game area of the window from bitplanes to pens.
+*/
+static void kernel_planar_to_chunky(int arg, LONG n)
+{
+   struct BitMap game_area;
+
+   game_area = *gameinfo->window->RPort->BitMap;
+   game_area.Rows = WINDOW_HEIGHT;
+
+   planar_to_chunky(&game_area, chunky, WINDOW_WIDTH);
+   sink += chunky[n % sizeof(chunky)];
+}
+
+
+/*
+** kernel_update_score()
+**
+** Print a new score (and hiscore, when it is one).
+*/
+static void kernel_update_score(int arg, LONG n)
+{
+   gameinfo->score = n % 100000;
+   update_score(gameinfo);
+}
+
+
+/*
+** kernel_update_fuel_bar()
+**
+** Burn a little fuel and fill it again, in turns.
+*/
+static void kernel_update_fuel_bar(int arg, LONG n)
+{
+   gameinfo->probeinfo.fuel = (n & 1) ? 150.0 : 140.0;
+   update_fuel_bar(gameinfo, &gameinfo->probeinfo);
+}
+
+
+/*
+** kernel_update_velocity_scale()
+**
+** Move the line on the velocity scale, up and down it.
+*/
+static void kernel_update_velocity_scale(int arg, LONG n)
+{
+   gameinfo->probeinfo.y_vel = (n % 80) / 40.0 - 1.0;
+   update_velocity_scale(gameinfo, &gameinfo->probeinfo);
+}
@@ -0,0 +1,309 @@
+/*
+** jupiterloop.c - throughput of the whole game loop on the Linux host
+**
+** (c)1993 Paul Grebenc
+**
+** Plays the same few flights over and over through the whole game, from
+** setting up to game over, with everything a real game does: drawing the
+** views, the probe and the gauges into the host's in-memory display, the
+** collision checks, and the sounds and states, which are recorded in the
+** game's trace (jl_trace.c) in memory, there being no audio.device on the
+** host.  Only the clock is instant, so nothing is waited for.
+**
+** Each flight is a game of one flight, flown from a set start by a fixed
+** script of the thrusters held each frame, so every run does the same
+** work.  Between them they cover the far view and all three pads, landing
+** on each, crashing in the far view and on a pad and leaving the sky.  A
+** first run checks that each still ends the way it should; if the rules
+** or drawing have been changed so that one does not, the scripts must be
+** made again (with the autopilot) before the times can be compared.
+**
+** Reported are the frames played a second and the nanoseconds a frame,
+** for each view and in all.  The last figure is the one to watch.
+**
+** Build (Linux):
+**    cc -std=gnu99 -O2 -pthread -o jupiterloop jupiterloop.c jupitergame.c \
+**       jl_*.c -lm
+**
+** Usage:  jupiterloop [seconds]
+*/
+
+
+/** INCLUDES & DEFINES **/
+
+#include "jupiterdefs.h"
+
+/* seconds the scripts are played over and over for */
+#define RUN_TIME        (2.0)
+
+#define TITLE_HEIGHT    (11)
+
+#define VIEWS           (4)
+
+struct Script {
+   char  *name;
+   float  x_pos;        /* where the probe starts */
+   float  x_vel;
+   int    result;       /* LANDED, CRASHED or OUT_OF_SKY */
+   int    view;         /* that it ends in */
+   char  *keys;         /* CURSOR_* bits held each frame, as digits */
+};
+
+struct Loop {
+   struct GameInfo *gameinfo;
+   struct Script *script;
+   double time[VIEWS];  /* seconds spent in each view */
+   LONG frames[VIEWS];
+};
+
+
+/** PROTOTYPES **/
+
+static BOOL play(struct Loop *loop, struct Script *script);
+static int script_input(APTR data);
+
+/* jupitergame.c */
+extern struct GameInfo *alloc_gameinfo(void);
+extern void free_gameinfo(struct GameInfo *gameinfo);
+extern int start_game(struct GameInfo *gameinfo);
+extern int step_game(struct GameInfo *gameinfo);
+extern void end_game(struct GameInfo *gameinfo);
+
+/* jl_clock.c */
+extern void set_clock(struct GameInfo *gameinfo, int type, int speed);
+extern void wait_clock(struct GameInfo *gameinfo, int wait);
+
+/* jl_trace.c */
+extern int setup_trace(struct GameInfo *gameinfo);
+extern void cleanup_trace(struct GameInfo *gameinfo);
+
+/* jl_memory.c */
+extern void decompress_images(void);
+extern void free_images(void);
+
+
+/** GLOBAL VARIABLES **/
+
+/* flown by the autopilot once, then written down */
+static struct Script scripts[] = {
+   {  "pad A",       20.0, 0.25, LANDED, GO_PAD_A,
+         "5555544445444444544454445445441001000122322322322322322322322322"
+         "3222222222222220000000000001001001041001001001001001001001001001"
+         "0010001001010010100001010010100010001010001001001010001001001010"
+         "0010010010100010010010250220000002424245001111110411010111001101"
+         "01100110010101010101001010100100101001001001001001001001001001" },
+   {  "pad B",       20.0, 0.25, LANDED, GO_PAD_B,
+         "5555544445444444544454445445441001000100100100100100100100431000"
+         "4310001424310044330421001001001043001001001001023223223223223222"
+         "3322232232232222222222002000042004000110101101010101210101001101"
+         "00100011010100100101001001001001001000101010001001" },
+   {  "pad C",       20.0, 0.25, LANDED, GO_PAD_C,
+         "5555544445444444544454445445441001000100100100100100100100100100"
+         "1001001001001001001001001001001001001001001001001001001001001001"
+         "0010010010010010010010010010010010010010010010010032232232232232"
+         "2322322322322222222222222220000000000100100100104100100100100100"
+         "1001001001001001001001001001001001001001001001001001001001001001"
+         "0010010010010010010010010010010010010032232232232014050414014014"
+         "0105101051010105010101014101001010100101001050010010010010010010"
+         "0100100100332232232223214050450050410400400040000401010510010101"
+         "0345001010010101005001001001001001001001001001" },
+   /* the way to pad A, then nothing */
+   {  "pad A crash", 20.0, 0.25, CRASHED, GO_PAD_A,
+         "5555544445444444544454445445441001000122322322322322322322322322"
+         "3222222222222220000000000001001001041001001001001001001001001001"
+         "0010001001010010100001010010100010001010001001001010001001001010"
+         "0010010010100010010010250220000002424245001111110411010111001101" },
+   {  "far crash",   20.0, 0.25, CRASHED, GO_FAR, "" },
+   {  "out of sky",  20.0, 0.25, OUT_OF_SKY, GO_FAR,
+         "1111111111111111111111111111111111" }
+};
+
+#define SCRIPTS         (sizeof(scripts) / sizeof(struct Script))
+
+static char *view_names[VIEWS] = { "far", "pad A", "pad B", "pad C" };
+
+static char *result_names[] = {
+   "QUIT", "FAIL", "PLAY", "INTRO", "HELP", "OK", "GO_FAR", "GO_PAD_A",
+   "GO_PAD_B", "GO_PAD_C", "LANDED", "CRASHED", "OUT_OF_SKY"
+};
+
+
+/*-----------------------------------------------------------------------*/
+
+
+main(int argc, char **argv)
+{
+   struct Loop loop;
+   struct GameInfo *gameinfo;
+   double run_time, start, time;
+   LONG runs, frames;
+   int n, view;
+   BOOL failed;
+
+   run_time = (argc > 1) ? atof(argv[1]) : RUN_TIME;
+
+   decompress_images();
+
+   if (NULL == (gameinfo = alloc_gameinfo()))
+   {
+      printf("Could not allocate GameInfo\n");
+      exit(RETURN_FAIL);
+   }
+   set_clock(gameinfo, CLOCK_INSTANT, 1);
+   gameinfo->title_height = TITLE_HEIGHT;
+   gameinfo->max_flights = 1;
+   gameinfo->window = OpenWindowTags(NULL,
+                        WA_Width,   WINDOW_WIDTH,
+                        WA_Height,  WINDOW_HEIGHT + TITLE_HEIGHT,
+                        TAG_END);
+   if ((gameinfo->window == NULL) || !setup_trace(gameinfo))
+   {
+      printf("Could not set up the game\n");
+      exit(RETURN_FAIL);
+   }
+
+   memset(&loop, 0, sizeof(loop));
+   loop.gameinfo = gameinfo;
+   host_set_input(script_input, &loop);
+
+   /* each script must still end as it was written down to */
+   printf("%-12s %-11s %-9s %7s\n", "flight", "ended", "in", "frames");
+   failed = FALSE;
+   for (n=0; n < SCRIPTS; n++)
+   {
+      if (!play(&loop, &scripts[n]))
+      {
+         printf("Could not start a game\n");
+         exit(RETURN_FAIL);
+      }
+      printf("%-12s %-11s %-9s %7ld", scripts[n].name,
+         result_names[gameinfo->flight.result],
+         result_names[gameinfo->flight.view], (long)gameinfo->flight.frames);
+      if ((gameinfo->flight.result != scripts[n].result) ||
+         (gameinfo->flight.view != scripts[n].view))
+      {
+         printf("  should be %s in %s", result_names[scripts[n].result],
+            result_names[scripts[n].view]);
+         failed = TRUE;
+      }
+      printf("\n");
+   }
+   if (failed)
+   {
+      printf("The scripts no longer fly as they did, so the times below "
+         "are not comparable\n");
+   }
+
+   memset(loop.time, 0, sizeof(loop.time));
+   memset(loop.frames, 0, sizeof(loop.frames));
+
+   start = host_seconds();
+   for (runs=0; host_seconds() - start < run_time; runs++)
+   {
+      for (n=0; n < SCRIPTS; n++)
+      {
+         play(&loop, &scripts[n]);
+      }
+   }
+
+   printf("\n%-8s %10s %12s %10s\n", "view", "frames", "frames/s", "ns/frame");
+   time = 0.0;
+   frames = 0;
+   for (view=0; view < VIEWS; view++)
+   {
+      if (loop.frames[view] > 0)
+      {
+         printf("%-8s %10ld %12.0f %10.0f\n", view_names[view],
+            (long)loop.frames[view], loop.frames[view] / loop.time[view],
+            loop.time[view] * 1e9 / loop.frames[view]);
+      }
+      time += loop.time[view];
+      frames += loop.frames[view];
+   }
+   printf("%-8s %10ld %12.0f %10.0f\n", "all", (long)frames, frames / time,
+      time * 1e9 / frames);
+   printf("\n%ld runs of %d flights, %lu events traced\n", (long)runs,
+      (int)SCRIPTS, (unsigned long)gameinfo->trace->count);
+
+   cleanup_trace(gameinfo);
+   CloseWindow(gameinfo->window);
+   free_gameinfo(gameinfo);
+   free_images();
+
+   exit(failed ? RETURN_WARN : RETURN_OK);
+}
+
+
+/*
+** play()
+**
+** Play a game of one flight by script, timing each frame (every step up
+** to the one that returns WAIT_TOF) in the view it was played in.
+**
+** RETURNS:  TRUE if the game could be started, FALSE if not.
+*/
+static BOOL play(struct Loop *loop, struct Script *script)
+{
+   struct GameInfo *gameinfo;
+   double start, time;
+   int wait, view;
+
+   gameinfo = loop->gameinfo;
+   gameinfo->physics.x_pos = script->x_pos;
+   gameinfo->physics.x_vel = script->x_vel;
+   loop->script = script;
+
+   if (start_game(gameinfo) == FALSE)
+   {
+      return FALSE;
+   }
+
+   time = 0.0;
+   do
+   {
+      start = host_seconds();
+      wait = step_game(gameinfo);
+      time += host_seconds() - start;
+
+      if (wait == WAIT_TOF)
+      {
+         view = gameinfo->view - GO_FAR;
+         if ((view >= 0) && (view < VIEWS))
+         {
+            loop->time[view] += time;
+            loop->frames[view]++;
+         }
+         time = 0.0;
+      }
+
+      wait_clock(gameinfo, wait);
+   }
+   while (wait != WAIT_END);
+
+   end_game(gameinfo);
+   return TRUE;
+}
+
+
+/*
+** script_input()
+**
+** Input function for the host keyboard: the keys the script holds in the
+** frame of the flight being flown, or none once it has run out.
+**
+** RETURNS:  CURSOR_* bits of the keys held.
+*/
+static int script_input(APTR data)
+{
+   struct Loop *loop;
+   LONG frame;
+
+   loop = (struct Loop *)data;
+   frame = loop->gameinfo->flight.frames;
+
+   if (frame < strlen(loop->script->keys))
+   {
+      return loop->script->keys[frame] - '0';
+   }
+   return 0;
+}
@@ -9,31 +9,65 @@
 
 /** INCLUDES & DEFINES **/
 
+#include <limits.h>
+
 #include "jupiterdefs.h"
 
 
 /** PROTOTYPES **/
 
 /* jl_memory.c */
-extern void decompress_images(void);
+extern void cache_images(char *name);
+extern void start_images(void);
+extern void finish_images(void);
 extern void free_images(void);
 
+/* jl_pack.c */
+extern int load_pack(char *name);
+extern void free_pack(void);
+
 void open_libraries(void);
 void close_libraries(void);
 
-void open_window(void);
-void close_window(void);
+void open_window(struct GameInfo *gameinfo);
+void close_window(struct GameInfo *gameinfo);
 int check_workbench_depth(void);
 int get_workbench_depth(void);
 int get_window_title_height(void);
+void read_screen_info(void);
+
+void unclip_window(struct GameInfo *gameinfo);
+
+int read_speed(char *arg);
+
+/* jl_account.c */
+extern void start_accounting(void);
+extern void end_accounting(BOOL report);
+extern void start_guard(void);
+
+/* jl_clock.c */
+extern void set_clock(struct GameInfo *gameinfo, int type, int speed);
+
+/* jl_autopilot.c */
+extern int setup_autopilot(struct GameInfo *gameinfo, LONG budget);
+extern void cleanup_autopilot(struct GameInfo *gameinfo);
 
-void unclip_window(void);
+/* jl_phases.c */
+extern int setup_phases(struct GameInfo *gameinfo, BOOL overlay);
+extern void cleanup_phases(struct GameInfo *gameinfo);
+
+/* jl_trace.c */
+extern int setup_trace(struct GameInfo *gameinfo);
+extern void cleanup_trace(struct GameInfo *gameinfo);
+extern int write_trace(char *name, struct GameInfo **games, int count);
 
 /* jupiterintro.c */
-extern int intro(void);
+extern int intro(struct GameInfo *gameinfo);
 
 /* jupitergame.c */
-extern int game(void);
+extern struct GameInfo *alloc_gameinfo(void);
+extern void free_gameinfo(struct GameInfo *gameinfo);
+extern int game(struct GameInfo *gameinfo);
 
 
 /** GLOBAL VARIABLES **/
@@ -46,39 +80,186 @@ struct Library *GadToolsBase;
 struct Library *LayersBase;
 struct Library *DOSBase;
 
-struct Window *window;
-
-int title_height;
+#ifndef __linux__
+/* read once when the window opens, and again when preferences change */
+static struct ScreenInfo screen_info;
+#endif
 
 
 /*-----------------------------------------------------------------------*/
 
 
-main()
+main(int argc, char **argv)
 {
-   decompress_images();
+   struct GameInfo *gameinfo;
+   int arg;
+   BOOL overlay, memory;
+   
+   /* every argument must be one of the words below or a speed, else
+   ** the usage is printed and nothing is started
+   */
+   for (arg=1; arg < argc; arg++)
+   {
+      if (strcmp(argv[arg], "auto") && strcmp(argv[arg], "times") &&
+         strcmp(argv[arg], "trace") && strcmp(argv[arg], "guard") &&
+         strcmp(argv[arg], "counters") && strcmp(argv[arg], "memory") &&
+         (read_speed(argv[arg]) == 0))
+      {
+         printf("Usage:  jupiter [speed] [auto] [times] [trace] [guard] "
+            "[memory] [counters]\n");
+         exit(RETURN_FAIL);
+      }
+   }
+   
+   /* every block allocated is accounted for, and any not freed by the
+   ** time the game closes is reported; "jupiter memory" also reports
+   ** how much each part of the game allocated
+   */
+   memory = FALSE;
+   for (arg=1; arg < argc; arg++)
+   {
+      if (!strcmp(argv[arg], "memory"))
+      {
+         memory = TRUE;
+      }
+   }
+   start_accounting();
+   
+#ifdef __linux__
+   /* "jupiter counters" counts cycles, instructions and misses in each
+   ** part of a frame and in decompressing the images, and prints them
+   ** when the game closes
+   */
+   for (arg=1; arg < argc; arg++)
+   {
+      if (!strcmp(argv[arg], "counters"))
+      {
+         host_start_counters();
+      }
+   }
+#endif
+   
+   /* the images and sounds are read from jupiter.pak if there is one
+   ** (see jupiterpack.c), and are otherwise those built in
+   */
+   if (-1 == load_pack(PACK_FILE))
+   {
+      printf("%s is not a good asset pack, using the assets built in\n",
+         PACK_FILE);
+   }
+   
+   /* the images are read from jupiter.cache if it was made from these,
+   ** and are otherwise decompressed and written there for the next time
+   */
+   cache_images(CACHE_FILE);
+   
+   /* the images are decompressed (on the Linux host, on other threads)
+   ** while the libraries and the window are opened, and must be ready
+   ** before the title screen is drawn
+   */
+   start_images();
    
    open_libraries();
    
-   open_window();
+   if (NULL == (gameinfo = alloc_gameinfo()))
+   {
+      printf("Could not allocate GameInfo\n");
+      close_libraries();
+      free_images();
+      free_pack();
+      exit(RETURN_FAIL);
+   }
+   
+   open_window(gameinfo);
+   
+   /* "jupiter 4" plays 4 times faster than real time (and without sound),
+   ** "jupiter auto" lets the autopilot fly, "jupiter times" shows where
+   ** the time of each frame goes (which is always timed), "jupiter
+   ** trace" writes what the game did to jupiter.json when it closes and
+   ** "jupiter guard" aborts if anything is allocated during play
+   */
+   overlay = FALSE;
+   for (arg=1; arg < argc; arg++)
+   {
+      if (!strcmp(argv[arg], "auto"))
+      {
+         if (gameinfo->autopilot == NULL)
+         {
+            setup_autopilot(gameinfo, AUTO_BUDGET);
+         }
+      }
+      else if (!strcmp(argv[arg], "times"))
+      {
+         overlay = TRUE;
+      }
+      else if (!strcmp(argv[arg], "trace"))
+      {
+         if (gameinfo->trace == NULL)
+         {
+            setup_trace(gameinfo);
+         }
+      }
+      else if (!strcmp(argv[arg], "guard"))
+      {
+         start_guard();
+      }
+      else if (!strcmp(argv[arg], "counters") ||
+         !strcmp(argv[arg], "memory"))
+      {
+         /* started before the images were decompressed */
+      }
+      else
+      {
+         set_clock(gameinfo, CLOCK_SCALED, read_speed(argv[arg]));
+      }
+   }
+   setup_phases(gameinfo, overlay);
+   
+   finish_images();
    
    /* set the priority of this program to 127 */
    SetTaskPri( FindTask(0), 127);
     
    FOREVER
    {
-      if ( QUIT == intro() )
+      if ( QUIT == intro(gameinfo) )
          break;
       
-      if ( QUIT == game() )
+      if ( QUIT == game(gameinfo) )
          break;
    }
    
-   close_window();
+   close_window(gameinfo);
+   
+   if (gameinfo->autopilot != NULL)
+   {
+      cleanup_autopilot(gameinfo);
+   }
+   if (gameinfo->phases != NULL)
+   {
+      cleanup_phases(gameinfo);
+   }
+   if (gameinfo->trace != NULL)
+   {
+      if (!write_trace("jupiter.json", &gameinfo, 1))
+      {
+         printf("Could not write jupiter.json\n");
+      }
+      cleanup_trace(gameinfo);
+   }
+   
+   free_gameinfo(gameinfo);
    
    close_libraries();
    
    free_images();
+   free_pack();
+   
+   end_accounting(memory);
+   
+#ifdef __linux__
+   host_stop_counters();
+#endif
    
    exit(RETURN_OK);
 }
@@ -135,6 +316,7 @@ void open_libraries()
    }
    
    free_images();
+   free_pack();
    
    exit(RETURN_FAIL);
 }
@@ -162,44 +344,50 @@ void close_libraries()
 ** Open window on Workbench for program to use.  Exit on error.
 ** Also inform & exit if depth of Workbench is not at least 2 (4 colors).
 */
-void open_window()
+void open_window(struct GameInfo *gameinfo)
 {
    struct TextAttr ta = {"topaz.font", 8, NULL, FPF_ROMFONT | FPF_DESIGNED};
    struct TextFont *windowfont;
    
+   /* find out what the Workbench screen is like, once */
+   read_screen_info();
+   
    /* get the height of the font used in this window's title */
-   title_height = get_window_title_height();
+   gameinfo->title_height = get_window_title_height();
    
    if ( FALSE == check_workbench_depth() )
    {
       printf("Workbench screen must have at least 4 colors!\n");
       close_libraries();
+      free_images();
+      free_pack();
       exit(RETURN_WARN);
    }
    
-   window = OpenWindowTags(NULL,
+   gameinfo->window = OpenWindowTags(NULL,
                WA_Left,          WINDOW_LEFT,
                WA_Top,           WINDOW_TOP,
                WA_Width,         WINDOW_WIDTH,
-               WA_Height,        WINDOW_HEIGHT + title_height,
+               WA_Height,        WINDOW_HEIGHT + gameinfo->title_height,
                WA_DragBar,       TRUE,
                WA_DepthGadget,   TRUE,
                WA_CloseGadget,   TRUE,
                WA_Activate,      TRUE,
                WA_SmartRefresh,  TRUE,
                WA_IDCMP,         IDCMP_CLOSEWINDOW | IDCMP_REFRESHWINDOW |
-                                 IDCMP_VANILLAKEY |
+                                 IDCMP_VANILLAKEY | IDCMP_NEWPREFS |
                                  IDCMP_ACTIVEWINDOW | IDCMP_INACTIVEWINDOW |
                                  BUTTONIDCMP,
                WA_Title,         "Jupiter Lander 0.90e",
                WA_ScreenTitle,   "JUPITER LANDER - (c)1993 Paul Grebenc",
                TAG_END);
    
-   if (window == NULL)
+   if (gameinfo->window == NULL)
    {
       printf("Could not open window\n");
       close_libraries();
       free_images();
+      free_pack();
       exit(RETURN_WARN);
    }
    
@@ -209,12 +397,13 @@ void open_window()
       printf("Could not open font Topaz 8\n");
       close_libraries();
       free_images();
+      free_pack();
       exit(RETURN_WARN);
    }
    /* */
    
    /* set the font for this window to windowfont */
-   SetFont(window->RPort, windowfont);
+   SetFont(gameinfo->window->RPort, windowfont);
 }
 
 
@@ -223,45 +412,59 @@ void open_window()
 **
 ** Close the window opened by open_window (remove any clipping regions).
 */
-void close_window()
+void close_window(struct GameInfo *gameinfo)
 {
    /* remove any existing clipping regions */
-   unclip_window();
+   unclip_window(gameinfo);
    
    /* close the font we opened for this window */
-   CloseFont(window->RPort->Font);
+   CloseFont(gameinfo->window->RPort->Font);
    
-   CloseWindow(window);
+   CloseWindow(gameinfo->window);
 }
 
 
+#ifndef __linux__
+/* the Linux host has its own, in jl_hostintui.c */
+
+
 /*
-** get_window_title_height()
+** read_screen_info()
 **
-** RETURNS:  Height of the window's title bar in pixels, which varies
-**           according to the default screen font selected in Preferences
+** Read the depth and title bar height of the Workbench screen into
+** screen_info, for get_workbench_depth() and get_window_title_height() to
+** answer from without locking the screen.  Called when the window opens and whenever
+** it is sent IDCMP_NEWPREFS, as the screen may have changed.
 */
-int get_window_title_height()
+void read_screen_info()
 {
    struct Screen *wbscrn = NULL;
    struct DrawInfo *wbscrn_drawinfo = NULL;
-   int height;
    
-   /* get the height of the screen font used for window titles */
    wbscrn = LockPubScreen("Workbench");
    if (wbscrn != NULL)
    {
       wbscrn_drawinfo = GetScreenDrawInfo(wbscrn);
       if (wbscrn_drawinfo != NULL)
       {
-         height = wbscrn_drawinfo->dri_Font->tf_YSize + 3;
+         screen_info.depth = wbscrn_drawinfo->dri_Depth;
+         screen_info.title_height = wbscrn_drawinfo->dri_Font->tf_YSize + 3;
          FreeScreenDrawInfo(wbscrn, wbscrn_drawinfo);
       }
       UnlockPubScreen("Workbench", wbscrn);
    }
-   /* */
-   
-   return height;
+}
+
+
+/*
+** get_window_title_height()
+**
+** RETURNS:  Height of the window's title bar in pixels, which varies
+**           according to the default screen font selected in Preferences
+*/
+int get_window_title_height()
+{
+   return screen_info.title_height;
 }
 
 
@@ -272,27 +475,9 @@ int get_window_title_height()
 */
 int get_workbench_depth()
 {
-   /* screen and drawinfo used to check if Workbench depth >= 2 */
-   struct Screen *wbscrn = NULL;
-   struct DrawInfo *wbscrn_drawinfo = NULL;
-   UWORD depth = NULL;
-   
-   /* get the current depth of the Workbench screen */
-   wbscrn = LockPubScreen("Workbench");
-   if (wbscrn != NULL)
-   {
-      wbscrn_drawinfo = GetScreenDrawInfo(wbscrn);
-      if (wbscrn_drawinfo != NULL)
-      {
-         depth = wbscrn_drawinfo->dri_Depth;
-         FreeScreenDrawInfo(wbscrn,wbscrn_drawinfo);
-      }
-      UnlockPubScreen("Workbench",wbscrn);
-   }
-   /* */
-   
-   return depth;
+   return screen_info.depth;
 }
+#endif
 
 
 /*
@@ -321,17 +506,38 @@ int check_workbench_depth()
 }
 
 
+/*
+** read_speed()
+**
+** RETURNS:  The speed arg gives, a whole number of times faster than real
+**           time, or 0 if all of arg is not such a number.
+*/
+int read_speed(char *arg)
+{
+   char *end;
+   long speed;
+   
+   speed = strtol(arg, &end, 10);
+   if ((end == arg) || (*end != '\0') || (speed < 1) || (speed > INT_MAX))
+   {
+      return 0;
+   }
+   
+   return (int)speed;
+}
+
+
 /*
 ** unclip_window()
 **
 ** Remove any existing clipping regions from the window by installing a
 ** NULL region, then dispose of the old region if one was installed.
 */
-void unclip_window()
+void unclip_window(struct GameInfo *gameinfo)
 {
    struct Region *old_region;
    
-   if (NULL != (old_region = InstallClipRegion(window->WLayer,NULL)))
+   if (NULL != (old_region = InstallClipRegion(gameinfo->window->WLayer,NULL)))
    {
       DisposeRegion(old_region);
    }
@@ -0,0 +1,273 @@
+/*
+** jupiterpack.c - write an asset pack on the Linux host
+**
+** (c)1993 Paul Grebenc
+**
+** Writes every asset of jl_pack.c (the compressed images and the sounds)
+** into one pack for the game to read in their place: a PackHeader, a
+** PackEntry for each asset, then the data of each on a PACK_ALIGN byte
+** boundary (see jupiterdefs.h).  An asset is written as it is built in,
+** unless a file is given for it by name, which is then written as it is;
+** an image must be compressed as those in jl_images.c are, and the game
+** will not take a pack in which one does not decompress to the size it
+** must.
+**
+** A pack is in the byte order of the machine it is for.  By default that
+** is the host, and the pack written is read back with load_pack() to
+** check it; "amiga" writes one for the Amiga instead, with the header,
+** the entries and the built-in word samples turned big-endian.
+**
+** Build (Linux):
+**    cc -std=gnu99 -O2 -o jupiterpack jupiterpack.c jl_pack.c jl_images.c \
+**       jl_sounds.c
+**
+** Usage:  jupiterpack [out=file] [amiga] [asset=file] ...
+**
+**    out (file to write, default jupiter.pak), amiga (write it for the
+**    Amiga), asset (the name of an asset, such as crash_sound, and the
+**    file to take it from)
+*/
+
+
+/** INCLUDES & DEFINES **/
+
+#include "jupiterdefs.h"
+
+
+/** PROTOTYPES **/
+
+static BOOL read_asset(struct Asset *asset, char *name);
+static BOOL write_pack(char *name, BOOL amiga);
+static ULONG swap_long(ULONG value, BOOL swap);
+static UWORD swap_word(UWORD value, BOOL swap);
+
+/* jl_pack.c */
+extern int load_pack(char *name);
+extern void free_pack(void);
+
+
+/** GLOBAL VARIABLES **/
+
+extern struct Asset assets[ASSETS];
+
+/* the assets that were read from a file */
+static BOOL from_file[ASSETS];
+
+
+/*-----------------------------------------------------------------------*/
+
+
+main(int argc, char **argv)
+{
+   char *name, *equals;
+   BOOL amiga;
+   int n, asset, count;
+
+   name = PACK_FILE;
+   amiga = FALSE;
+   for (n=1; n < argc; n++)
+   {
+      if (0 == strncmp(argv[n], "out=", 4))
+      {
+         name = &argv[n][4];
+         continue;
+      }
+      if (0 == strcmp(argv[n], "amiga"))
+      {
+         amiga = TRUE;
+         continue;
+      }
+
+      equals = strchr(argv[n], '=');
+      for (asset=0; equals && (asset < ASSETS); asset++)
+      {
+         if ((strlen(assets[asset].name) == equals - argv[n]) &&
+            (0 == strncmp(argv[n], assets[asset].name, equals - argv[n])))
+         {
+            break;
+         }
+      }
+      if ((equals == NULL) || (asset == ASSETS))
+      {
+         fprintf(stderr, "Bad argument \"%s\"\n", argv[n]);
+         exit(RETURN_FAIL);
+      }
+      if (!read_asset(&assets[asset], equals + 1))
+      {
+         fprintf(stderr, "Could not read %s\n", equals + 1);
+         exit(RETURN_FAIL);
+      }
+      from_file[asset] = TRUE;
+   }
+
+   if (!write_pack(name, amiga))
+   {
+      fprintf(stderr, "Could not write %s\n", name);
+      exit(RETURN_FAIL);
+   }
+
+   if (amiga)
+   {
+      printf("Wrote %d assets to %s for the Amiga\n", ASSETS, name);
+      exit(RETURN_OK);
+   }
+
+   if (ASSETS != (count = load_pack(name)))
+   {
+      fprintf(stderr, "%s does not load: %s\n", name,
+         (count == -1) ? "it is not a good pack" : "assets are missing");
+      exit(RETURN_FAIL);
+   }
+   free_pack();
+   printf("Wrote %d assets to %s\n", ASSETS, name);
+
+   exit(RETURN_OK);
+}
+
+
+/*
+** read_asset()
+**
+** Point asset at the whole of file name, read into memory.
+**
+** RETURNS:  TRUE if successful, FALSE if the file could not be read.
+*/
+static BOOL read_asset(struct Asset *asset, char *name)
+{
+   FILE *file;
+   UBYTE *data;
+   long size;
+
+   if (NULL == (file = fopen(name, "rb")))
+   {
+      return FALSE;
+   }
+   if ((fseek(file, 0, SEEK_END) != 0) || ((size = ftell(file)) <= 0) ||
+      (fseek(file, 0, SEEK_SET) != 0) ||
+      (NULL == (data = (UBYTE *)malloc(size))))
+   {
+      fclose(file);
+      return FALSE;
+   }
+   if (fread(data, 1, size, file) != size)
+   {
+      fclose(file);
+      free(data);
+      return FALSE;
+   }
+   fclose(file);
+
+   asset->data = data;
+   asset->size = size;
+
+   return TRUE;
+}
+
+
+/*
+** write_pack()
+**
+** Write every asset to file name, in the byte order of the Amiga if amiga
+** is TRUE.
+**
+** RETURNS:  TRUE if successful, FALSE if the file could not be written.
+*/
+static BOOL write_pack(char *name, BOOL amiga)
+{
+   struct PackHeader header;
+   struct PackEntry entries[ASSETS];
+   FILE *file;
+   ULONG offset, at, n;
+   UWORD word;
+   int asset;
+   BOOL ok;
+
+   memset(entries, 0, sizeof(entries));
+   offset = sizeof(struct PackHeader) + sizeof(entries);
+   for (asset=0; asset < ASSETS; asset++)
+   {
+      offset = (offset + PACK_ALIGN - 1) & ~(PACK_ALIGN - 1);
+      strncpy(entries[asset].name, assets[asset].name, PACK_NAME - 1);
+      entries[asset].offset = swap_long(offset, amiga);
+      entries[asset].size = swap_long(assets[asset].size, amiga);
+      offset += assets[asset].size;
+   }
+
+   header.magic = swap_long(PACK_MAGIC, amiga);
+   header.version = swap_word(PACK_VERSION, amiga);
+   header.order = swap_word(PACK_ORDER, amiga);
+   header.count = swap_long(ASSETS, amiga);
+   header.size = swap_long(offset, amiga);
+
+   if (NULL == (file = fopen(name, "wb")))
+   {
+      return FALSE;
+   }
+
+   ok = (fwrite(&header, sizeof(header), 1, file) == 1) &&
+      (fwrite(entries, sizeof(entries), 1, file) == 1);
+   at = sizeof(struct PackHeader) + sizeof(entries);
+   for (asset=0; ok && (asset < ASSETS); asset++)
+   {
+      for (; ok && (at < swap_long(entries[asset].offset, amiga)); at++)
+      {
+         ok = (putc(0, file) != EOF);
+      }
+
+      if (amiga && assets[asset].words && !from_file[asset])
+      {
+         for (n=0; ok && (n < assets[asset].size); n += 2)
+         {
+            word = swap_word(*(UWORD *)(assets[asset].data + n), TRUE);
+            ok = (fwrite(&word, 2, 1, file) == 1);
+         }
+      }
+      else
+      {
+         ok = (fwrite(assets[asset].data, 1, assets[asset].size, file) ==
+            assets[asset].size);
+      }
+      at += assets[asset].size;
+   }
+
+   if (fclose(file) != 0)
+   {
+      ok = FALSE;
+   }
+
+   return ok;
+}
+
+
+/*
+** swap_long()
+**
+** RETURNS:  value with its bytes the other way around if swap is TRUE.
+*/
+static ULONG swap_long(ULONG value, BOOL swap)
+{
+   if (!swap)
+   {
+      return value;
+   }
+
+   return (value >> 24) | ((value >> 8) & 0xff00) |
+      ((value << 8) & 0xff0000) | (value << 24);
+}
+
+
+/*
+** swap_word()
+**
+** RETURNS:  value with its bytes the other way around if swap is TRUE.
+*/
+static UWORD swap_word(UWORD value, BOOL swap)
+{
+   if (!swap)
+   {
+      return value;
+   }
+
+   return (value >> 8) | (value << 8);
+}
+
@@ -0,0 +1,891 @@
+/*
+** jupiterpolicy.c - solve for a policy table on the Linux host
+**
+** (c)1993 Paul Grebenc
+**
+** Cuts the states a probe can be in (x_pos, y_pos, x_vel, y_vel and fuel)
+** into a grid of cells in each view, and works out for every cell which
+** thrusters to hold for the best score to be expected from do_landed(),
+** less what the fuel burnt is worth.  The result is written as a policy
+** table (see jupiterdefs.h) for jl_policy.c to fly by.
+**
+** From the middle of each cell the probe is flown for frames frames by
+** step_probe(), and so by the rules of the game itself, with each of the
+** six ways of holding the thrusters: the main thruster or not, with the
+** left, the right or neither.  A flight that ends scores what do_landed()
+** gives for it (bonus 5, 2 and 10 on pads A, B and C) or nothing.  One
+** that goes on ends up between cells, and is taken to be in each of the
+** 16 around it in x_pos, y_pos, x_vel and y_vel as likely as it is near
+** it, so it is worth what they are worth on average, kept back by a
+** discount: else a move that costs nothing and stays about a cell would
+** keep the worth of the cells about it without ever landing.  A flight
+** that leaves the grid is taken to be lost, and the top row of the far
+** view lies on the edge of the sky, where step_probe() ends a flight, so
+** its cells are worth nothing.  Fuel is only told apart in bands, since
+** all it changes is whether the thrusters fire.  These moves are worked
+** out once, and the worth of every cell is then found again from them
+** sweep after sweep until it settles.
+**
+** The finished table is then flown from where a flight starts, a frame
+** at a time as jl_policy.c flies it, and the score it lands with is
+** printed beside the one expected.  A table that does not land is not
+** written, and jupiterpolicy fails.
+**
+** The cells of a sweep are shared out over a thread a core a tile at a
+** time, a tile being a few rows of a view with every x_pos and velocity
+** in them, so that the cells a tile reads are the few rows about it and
+** stay in the cache.  Each sweep reads only the worth found by the one
+** before, so the table is the same however many threads solve it.
+**
+** Build (Linux):
+**    cc -std=gnu99 -O2 -pthread -o jupiterpolicy jupiterpolicy.c \
+**       jupitergame.c jl_*.c -lm
+**
+** Usage:  jupiterpolicy [name=value] ...
+**
+**    out (file to write, default jupiter.policy), frames (an input is
+**    held for, default 4), far and pad (x_pos and y_pos from one cell to
+**    the next in the far and pad views, default 4 and 3), vel (x_vel and
+**    y_vel, default 0.25), fuel (bands of fuel, default 3), worth (points
+**    a unit of fuel is worth, default 4), discount (of the worth a move
+**    keeps, default 0.99), sweeps (most to make, default 1000), threads
+**    (default one per core)
+*/
+
+
+/** INCLUDES & DEFINES **/
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include "jupiterdefs.h"
+
+#define TITLE_HEIGHT    (11)
+
+#define ACTIONS         (6)
+
+/* a probe this high in the far view has left the sky, see step_probe() */
+#define SKY_Y           (-21.0)
+
+/* most frames the table is flown for from the start */
+#define FLIGHT_FRAMES   (20000)
+
+/* rows of a view in a tile */
+#define TILE_ROWS       (2)
+
+/* worth a sweep may change by and still have settled */
+#define SETTLED         (0.5)
+
+/* a move ending the flight has ENDS set in to and its score in part */
+#define ENDS            (0x80000000)
+
+/* where one of the ACTIONS takes the probe from a cell */
+struct Move {
+   ULONG to;         /* the cell at the low corner of the 16 */
+   ULONG part;       /* how far past it in x_pos, y_pos, x_vel, y_vel, */
+};                   /* a byte each from x_pos (low) up, 255ths */
+
+struct Tile {
+   int view;
+   LONG first;       /* cells first to end-1 */
+   LONG end;
+};
+
+struct Worker {
+   pthread_t   thread;
+   float       change;  /* most the worth of a cell changed this sweep */
+};
+
+
+/** PROTOTYPES **/
+
+static void set_grid(int view, double x_low, double x_high, double y_low,
+   double y_high, double pos_step);
+static LONG count_cells(double low, double high, double step);
+static void make_tiles(void);
+static void run_workers(void *(*body)(void *));
+static BOOL take_tile(struct Tile **tile);
+static void *find_moves(void *data);
+static void *sweep(void *data);
+static void cell_state(int view, LONG cell, struct ProbeInfo *probeinfo);
+static void place(int view, struct ProbeInfo *probeinfo, struct Move *move);
+static float move_worth(int view, LONG cell, int action, struct Move *move);
+static int fly_table(struct ProbeInfo *probeinfo, int *view, int *score);
+static BOOL write_table(char *name);
+
+/* jl_physics.c */
+extern int step_probe(struct PhysicsInfo *physics, struct ProbeInfo *probeinfo,
+   int view, int top, int *score);
+
+/* jl_policy.c */
+extern LONG policy_cell(struct PolicyGrid *grid, struct ProbeInfo *probeinfo);
+
+/* jl_memory.c */
+extern void decompress_images(void);
+extern void free_images(void);
+
+
+/** GLOBAL VARIABLES **/
+
+/* CURSOR_* bits of each of the ACTIONS */
+static int action_keys[ACTIONS] = {
+   0, CURSOR_LEFT, CURSOR_RIGHT,
+   CURSOR_UP, CURSOR_UP | CURSOR_LEFT, CURSOR_UP | CURSOR_RIGHT
+};
+
+static char *view_names[POLICY_VIEWS] = { "far", "A", "B", "C" };
+
+static struct PhysicsInfo physics = {
+   20.0, 8.0, 0.25, 0.025, 0.075, 0.025, 0.5, 0.25
+};
+
+static struct PolicyHeader header;
+
+static LONG frames = 4;
+static double far_step = 4.0;
+static double pad_step = 3.0;
+static double vel_step = 0.25;
+static LONG fuel_bands = 3;
+static double fuel_worth = 4.0;
+static double discount = 0.99;
+static LONG max_sweeps = 1000;
+
+/* the 16 cells about a move, as offsets from its to, in each view */
+static LONG corners[POLICY_VIEWS][16];
+
+static struct Move *moves;    /* ACTIONS a cell */
+static float *worth;          /* of each cell as last found */
+static float *new_worth;
+static UBYTE *choice;         /* of the ACTIONS, in each cell */
+
+static struct Tile *tiles;
+static LONG tile_count;
+static LONG next_tile;
+static pthread_mutex_t tile_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static struct Worker *workers;
+static int threads;
+
+
+/*-----------------------------------------------------------------------*/
+
+
+main(int argc, char **argv)
+{
+   struct ProbeInfo probeinfo;
+   char *name;
+   double start, moves_time, sweeps_time;
+   float change, *swap;
+   LONG n, sweeps;
+   int w, result, view, score;
+
+   name = "jupiter.policy";
+   threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+
+   for (n=1; n < argc; n++)
+   {
+      if (0 == strncmp(argv[n], "out=", 4))
+      {
+         name = &argv[n][4];
+      }
+      else if (0 == strncmp(argv[n], "frames=", 7))
+      {
+         frames = atoi(&argv[n][7]);
+      }
+      else if (0 == strncmp(argv[n], "far=", 4))
+      {
+         far_step = atof(&argv[n][4]);
+      }
+      else if (0 == strncmp(argv[n], "pad=", 4))
+      {
+         pad_step = atof(&argv[n][4]);
+      }
+      else if (0 == strncmp(argv[n], "vel=", 4))
+      {
+         vel_step = atof(&argv[n][4]);
+      }
+      else if (0 == strncmp(argv[n], "fuel=", 5))
+      {
+         fuel_bands = atoi(&argv[n][5]);
+      }
+      else if (0 == strncmp(argv[n], "worth=", 6))
+      {
+         fuel_worth = atof(&argv[n][6]);
+      }
+      else if (0 == strncmp(argv[n], "discount=", 9))
+      {
+         discount = atof(&argv[n][9]);
+      }
+      else if (0 == strncmp(argv[n], "sweeps=", 7))
+      {
+         max_sweeps = atoi(&argv[n][7]);
+      }
+      else if (0 == strncmp(argv[n], "threads=", 8))
+      {
+         threads = atoi(&argv[n][8]);
+      }
+      else
+      {
+         fprintf(stderr, "Bad argument \"%s\"\n", argv[n]);
+         exit(RETURN_FAIL);
+      }
+   }
+   if ((frames < 1) || (far_step <= 0.0) || (pad_step <= 0.0) ||
+      (vel_step <= 0.0) || (fuel_bands < 1))
+   {
+      fprintf(stderr, "frames, far, pad, vel and fuel must be above 0\n");
+      exit(RETURN_FAIL);
+   }
+   if ((discount <= 0.0) || (discount >= 1.0))
+   {
+      fprintf(stderr, "discount must be above 0 and below 1\n");
+      exit(RETURN_FAIL);
+   }
+   if (threads < 1)
+   {
+      threads = 1;
+   }
+
+   /* the far view from the edge of the sky, and each pad view as far as
+   ** the probe can be drawn in it
+   */
+   header.magic = POLICY_MAGIC;
+   header.frames = frames;
+   set_grid(0, -12.0, 264.0, SKY_Y, 92.0, far_step);
+   set_grid(1, 8.0, 146.0, 88.0, 180.0, pad_step);
+   set_grid(2, 98.0, 182.0, 8.0, 100.0, pad_step);
+   set_grid(3, 178.0, 280.0, 88.0, 180.0, pad_step);
+
+   moves = (struct Move *)malloc((size_t)header.cells * ACTIONS * sizeof(struct Move));
+   worth = (float *)calloc(header.cells, sizeof(float));
+   new_worth = (float *)calloc(header.cells, sizeof(float));
+   choice = (UBYTE *)calloc(header.cells, 1);
+   workers = (struct Worker *)calloc(threads, sizeof(struct Worker));
+   if ((moves == NULL) || (worth == NULL) || (new_worth == NULL) ||
+      (choice == NULL) || (workers == NULL))
+   {
+      fprintf(stderr, "Could not allocate %d cells\n", (int)header.cells);
+      exit(RETURN_FAIL);
+   }
+   make_tiles();
+
+   decompress_images();
+
+   start = host_seconds();
+   run_workers(find_moves);
+   moves_time = host_seconds() - start;
+
+   start = host_seconds();
+   change = 0.0;
+   for (sweeps=0; sweeps < max_sweeps; )
+   {
+      run_workers(sweep);
+      sweeps++;
+
+      change = 0.0;
+      for (w=0; w < threads; w++)
+      {
+         if (workers[w].change > change)
+         {
+            change = workers[w].change;
+         }
+      }
+      swap = worth;
+      worth = new_worth;
+      new_worth = swap;
+
+      if (change < SETTLED)
+      {
+         break;
+      }
+   }
+   sweeps_time = host_seconds() - start;
+
+   memset(&probeinfo, 0, sizeof(struct ProbeInfo));
+   probeinfo.x_pos = physics.x_pos;
+   probeinfo.y_pos = physics.y_pos;
+   probeinfo.x_vel = physics.x_vel;
+   probeinfo.fuel = 219.0;
+   header.expected = worth[policy_cell(&header.grids[0], &probeinfo)];
+
+   printf("%d cells (far %d, A %d, B %d, C %d), %d frames a move\n",
+      (int)header.cells, (int)(header.grids[1].first),
+      (int)(header.grids[2].first - header.grids[1].first),
+      (int)(header.grids[3].first - header.grids[2].first),
+      (int)(header.cells - header.grids[3].first), (int)frames);
+   printf("moves found in %.2fs, %d sweeps in %.2fs (%s, last change %.2f) "
+      "on %d threads\n", moves_time, (int)sweeps, sweeps_time,
+      (change < SETTLED) ? "settled" : "not settled", change, threads);
+
+   result = fly_table(&probeinfo, &view, &score);
+   printf("score expected from the start %.0f, flown %d (%s, view %s)\n",
+      header.expected, score,
+      (result == LANDED) ? "landed" : (result == CRASHED) ? "crashed" :
+      (result == OUT_OF_SKY) ? "left the sky" : "still flying",
+      view_names[view - GO_FAR]);
+   if (result != LANDED)
+   {
+      fprintf(stderr, "The table does not land, so %s is not written\n",
+         name);
+      exit(RETURN_FAIL);
+   }
+
+   if (write_table(name) == FALSE)
+   {
+      fprintf(stderr, "Could not write %s\n", name);
+      exit(RETURN_FAIL);
+   }
+
+   printf("%s: %d bytes (%d of header)\n", name,
+      (int)(sizeof(struct PolicyHeader) + (header.cells + 1) / 2),
+      (int)sizeof(struct PolicyHeader));
+
+   free(tiles);
+   free(workers);
+   free(choice);
+   free(new_worth);
+   free(worth);
+   free(moves);
+   free_images();
+
+   exit(RETURN_OK);
+}
+
+
+/*
+** set_grid()
+**
+** Fill in the grid of view (0 to 3 for GO_FAR to GO_PAD_C) from the
+** range of x_pos and y_pos it covers, placing it in the table after the
+** views before it.
+*/
+static void set_grid(int view, double x_low, double x_high, double y_low,
+   double y_high, double pos_step)
+{
+   struct PolicyGrid *grid;
+   LONG n, x_stride, y_stride;
+   int dim, k;
+
+   grid = &header.grids[view];
+
+   grid->low[0] = x_low;
+   grid->low[1] = y_low;
+   grid->low[2] = -1.5;
+   grid->low[3] = -2.0;
+   grid->low[POLICY_FUEL] = 0.0;
+
+   grid->step[0] = pos_step;
+   grid->step[1] = pos_step;
+   grid->step[2] = vel_step;
+   grid->step[3] = vel_step;
+   grid->step[POLICY_FUEL] = 219.0 / fuel_bands;
+
+   grid->cells[0] = count_cells(x_low, x_high, pos_step);
+   grid->cells[1] = count_cells(y_low, y_high, pos_step);
+   grid->cells[2] = count_cells(-1.5, 1.5, vel_step);
+   grid->cells[3] = count_cells(-2.0, 2.0, vel_step);
+   grid->cells[POLICY_FUEL] = 1 + fuel_bands;
+
+   grid->first = header.cells;
+   n = 1;
+   for (dim=0; dim < POLICY_DIMS; dim++)
+   {
+      n *= grid->cells[dim];
+   }
+   header.cells += n;
+
+   /* corner k is past the low one in x_pos if bit 0 is set, in y_pos
+   ** if bit 1 is, in x_vel if bit 2 is and in y_vel if bit 3 is
+   */
+   x_stride = grid->cells[2] * grid->cells[3];
+   y_stride = x_stride * grid->cells[0];
+   for (k=0; k < 16; k++)
+   {
+      corners[view][k] = ((k & 1) ? x_stride : 0) + ((k & 2) ? y_stride : 0) +
+         ((k & 4) ? 1 : 0) + ((k & 8) ? grid->cells[2] : 0);
+   }
+}
+
+
+/*
+** count_cells()
+**
+** RETURNS:  Cells step apart from low to high, at least 2.
+*/
+static LONG count_cells(double low, double high, double step)
+{
+   LONG cells;
+
+   cells = (LONG)((high - low) / step + 1e-6) + 1;
+
+   return (cells < 2) ? 2 : cells;
+}
+
+
+/*
+** make_tiles()
+**
+** Cut every view into tiles of TILE_ROWS rows of y_pos in each band of
+** fuel.
+*/
+static void make_tiles()
+{
+   struct PolicyGrid *grid;
+   struct Tile *tile;
+   LONG row_cells, band, row;
+   int view, pass;
+
+   for (pass=0; pass < 2; pass++)
+   {
+      tile_count = 0;
+      for (view=0; view < POLICY_VIEWS; view++)
+      {
+         grid = &header.grids[view];
+         row_cells = grid->cells[0] * grid->cells[2] * grid->cells[3];
+
+         for (band=0; band < grid->cells[POLICY_FUEL]; band++)
+         {
+            for (row=0; row < grid->cells[1]; row += TILE_ROWS)
+            {
+               if (pass == 1)
+               {
+                  tile = &tiles[tile_count];
+                  tile->view = view;
+                  tile->first = grid->first +
+                     (band * grid->cells[1] + row) * row_cells;
+                  tile->end = tile->first + row_cells *
+                     ((row + TILE_ROWS <= grid->cells[1]) ?
+                     TILE_ROWS : grid->cells[1] - row);
+               }
+               tile_count++;
+            }
+         }
+      }
+
+      if ((pass == 0) && (NULL == (tiles =
+         (struct Tile *)calloc(tile_count, sizeof(struct Tile)))))
+      {
+         fprintf(stderr, "Could not allocate %d tiles\n", (int)tile_count);
+         exit(RETURN_FAIL);
+      }
+   }
+}
+
+
+/*
+** run_workers()
+**
+** Share out the tiles over a thread a core, each running body, and wait
+** for them all to finish.
+*/
+static void run_workers(void *(*body)(void *))
+{
+   int w;
+
+   next_tile = 0;
+   for (w=0; w < threads; w++)
+   {
+      if (0 != pthread_create(&workers[w].thread, NULL, body, &workers[w]))
+      {
+         fprintf(stderr, "Could not start thread %d\n", w);
+         exit(RETURN_FAIL);
+      }
+   }
+   for (w=0; w < threads; w++)
+   {
+      pthread_join(workers[w].thread, NULL);
+   }
+}
+
+
+/*
+** take_tile()
+**
+** Take the next tile no thread has yet.
+**
+** RETURNS:  TRUE with *tile set, FALSE if none are left.
+*/
+static BOOL take_tile(struct Tile **tile)
+{
+   BOOL found;
+
+   pthread_mutex_lock(&tile_lock);
+   found = (next_tile < tile_count);
+   if (found)
+   {
+      *tile = &tiles[next_tile++];
+   }
+   pthread_mutex_unlock(&tile_lock);
+
+   return found;
+}
+
+
+/*
+** find_moves()
+**
+** Thread body: fly the probe from the middle of each cell of its tiles
+** with each of the ACTIONS and keep where it ends up.  From the top row
+** of the far view, on the edge of the sky, every move ends the flight.
+**
+** RETURNS:  NULL
+*/
+static void *find_moves(void *data)
+{
+   struct Tile *tile;
+   struct ProbeInfo start, probeinfo;
+   struct Move *move;
+   LONG cell, f;
+   int action, view, result, score;
+
+   while (take_tile(&tile))
+   {
+      for (cell=tile->first; cell < tile->end; cell++)
+      {
+         cell_state(tile->view, cell - header.grids[tile->view].first, &start);
+
+         for (action=0; action < ACTIONS; action++)
+         {
+            move = &moves[cell * ACTIONS + action];
+            probeinfo = start;
+            probeinfo.user_input = action_keys[action];
+            view = GO_FAR + tile->view;
+            result = OK;
+
+            if ((view == GO_FAR) && (start.y_pos <= SKY_Y))
+            {
+               move->to = ENDS;
+               move->part = 0;
+               continue;
+            }
+
+            for (f=0; f < frames; f++)
+            {
+               score = 0;
+               result = step_probe(&physics, &probeinfo, view, TITLE_HEIGHT,
+                  &score);
+               if ((result == LANDED) || (result == CRASHED) ||
+                  (result == OUT_OF_SKY))
+               {
+                  break;
+               }
+               if (result != OK)
+               {
+                  view = result;
+               }
+            }
+
+            if (f < frames)
+            {
+               move->to = ENDS;
+               move->part = (result == LANDED) ? score : 0;
+            }
+            else
+            {
+               place(view - GO_FAR, &probeinfo, move);
+            }
+         }
+      }
+   }
+
+   return NULL;
+}
+
+
+/*
+** sweep()
+**
+** Thread body: find the worth of each cell of its tiles from the worth of
+** the cells its moves go to, as found by the last sweep, choosing the
+** best of the ACTIONS.
+**
+** RETURNS:  NULL
+*/
+static void *sweep(void *data)
+{
+   struct Worker *worker;
+   struct Tile *tile;
+   LONG cell;
+   float best, value, change;
+   int action, best_action;
+
+   worker = (struct Worker *)data;
+   worker->change = 0.0;
+
+   while (take_tile(&tile))
+   {
+      for (cell=tile->first; cell < tile->end; cell++)
+      {
+         best = move_worth(tile->view, cell, 0, &moves[cell * ACTIONS]);
+         best_action = 0;
+         for (action=1; action < ACTIONS; action++)
+         {
+            value = move_worth(tile->view, cell, action,
+               &moves[cell * ACTIONS + action]);
+            if (value > best)
+            {
+               best = value;
+               best_action = action;
+            }
+         }
+
+         new_worth[cell] = best;
+         choice[cell] = (UBYTE)best_action;
+
+         change = (best > worth[cell]) ? best - worth[cell] : worth[cell] - best;
+         if (change > worker->change)
+         {
+            worker->change = change;
+         }
+      }
+   }
+
+   return NULL;
+}
+
+
+/*
+** cell_state()
+**
+** Fill in the state of the probe at the middle of cell (counted from the
+** first of view).  A probe in fuel cell 0 has just run out.
+*/
+static void cell_state(int view, LONG cell, struct ProbeInfo *probeinfo)
+{
+   struct PolicyGrid *grid;
+   LONG index[POLICY_DIMS];
+
+   grid = &header.grids[view];
+
+   index[2] = cell % grid->cells[2];
+   cell /= grid->cells[2];
+   index[3] = cell % grid->cells[3];
+   cell /= grid->cells[3];
+   index[0] = cell % grid->cells[0];
+   cell /= grid->cells[0];
+   index[1] = cell % grid->cells[1];
+   index[POLICY_FUEL] = cell / grid->cells[1];
+
+   memset(probeinfo, 0, sizeof(struct ProbeInfo));
+   probeinfo->x_pos = grid->low[0] + index[0] * grid->step[0];
+   probeinfo->y_pos = grid->low[1] + index[1] * grid->step[1];
+   probeinfo->x_vel = grid->low[2] + index[2] * grid->step[2];
+   probeinfo->y_vel = grid->low[3] + index[3] * grid->step[3];
+   probeinfo->fuel = (index[POLICY_FUEL] == 0) ? -0.5 :
+      (index[POLICY_FUEL] - 0.5) * grid->step[POLICY_FUEL];
+}
+
+
+/*
+** place()
+**
+** Work out the move to the cells about the state of the probe in view.
+** A state up to half a cell off the grid is taken to be at its edge, and
+** one further off to be lost, ending the flight with nothing.
+*/
+static void place(int view, struct ProbeInfo *probeinfo, struct Move *move)
+{
+   static int order[4] = { 1, 0, 3, 2 };  /* of the dims in a cell index */
+   struct PolicyGrid *grid;
+   float value[4];
+   double place;
+   LONG cell, index, fuel;
+   int n, dim;
+
+   grid = &header.grids[view];
+   value[0] = probeinfo->x_pos;
+   value[1] = probeinfo->y_pos;
+   value[2] = probeinfo->x_vel;
+   value[3] = probeinfo->y_vel;
+
+   /* the band of fuel is the one policy_cell() finds */
+   if (probeinfo->fuel < 0)
+   {
+      fuel = 0;
+   }
+   else
+   {
+      fuel = 1 + (LONG)(probeinfo->fuel / grid->step[POLICY_FUEL]);
+      if (fuel >= grid->cells[POLICY_FUEL])
+      {
+         fuel = grid->cells[POLICY_FUEL] - 1;
+      }
+   }
+
+   cell = fuel;
+   move->part = 0;
+   for (n=0; n < 4; n++)
+   {
+      dim = order[n];
+
+      place = (value[dim] - grid->low[dim]) / grid->step[dim];
+      if ((place < -0.5) || (place > grid->cells[dim] - 0.5))
+      {
+         move->to = ENDS;
+         move->part = 0;
+         return;
+      }
+      if (place < 0.0)
+      {
+         place = 0.0;
+      }
+      if (place > grid->cells[dim] - 1)
+      {
+         place = grid->cells[dim] - 1;
+      }
+      index = (LONG)place;
+      if (index > grid->cells[dim] - 2)
+      {
+         index = grid->cells[dim] - 2;
+      }
+
+      cell = cell * grid->cells[dim] + index;
+      move->part |= (ULONG)((place - index) * 255.0 + 0.5) << (dim * 8);
+   }
+
+   move->to = ((ULONG)view << 29) | (grid->first + cell);
+}
+
+
+/*
+** move_worth()
+**
+** RETURNS:  What taking action from cell of view is worth: the score if
+**           the flight ends, else the discounted worth of the 16 cells
+**           about where it goes, each weighted by how near it is, less
+**           the fuel burnt.
+*/
+static float move_worth(int view, LONG cell, int action, struct Move *move)
+{
+   struct PolicyGrid *grid;
+   LONG *corner;
+   float *at;
+   float part[4], weight[4][2];
+   float value, fuel;
+   int n, k;
+
+   /* a probe out of fuel (in the first band) burns none */
+   grid = &header.grids[view];
+   fuel = 0.0;
+   if (cell - grid->first >= grid->cells[0] * grid->cells[1] *
+      grid->cells[2] * grid->cells[3])
+   {
+      if (action_keys[action] & CURSOR_UP)
+      {
+         fuel += physics.burn;
+      }
+      if (action_keys[action] & (CURSOR_LEFT | CURSOR_RIGHT))
+      {
+         fuel += physics.side_burn;
+      }
+      fuel *= frames * fuel_worth;
+   }
+
+   if (move->to & ENDS)
+   {
+      return (float)move->part - fuel;
+   }
+
+   for (n=0; n < 4; n++)
+   {
+      part[n] = ((move->part >> (n * 8)) & 0xff) / 255.0;
+      weight[n][0] = 1.0 - part[n];
+      weight[n][1] = part[n];
+   }
+
+   corner = corners[move->to >> 29];
+   at = &worth[move->to & 0x1fffffff];
+   value = 0.0;
+   for (k=0; k < 16; k++)
+   {
+      value += weight[0][k & 1] * weight[1][(k >> 1) & 1] *
+         weight[2][(k >> 2) & 1] * weight[3][(k >> 3) & 1] * at[corner[k]];
+   }
+
+   return value * discount - fuel;
+}
+
+
+/*
+** fly_table()
+**
+** Fly the probe from probeinfo in the far view by the table as solved,
+** looking up the cell it is in every frame as policy_input() does, until
+** the flight ends or FLIGHT_FRAMES have gone by.
+**
+** RETURNS:  LANDED, CRASHED, OUT_OF_SKY, or OK if it is still flying,
+**           with *view the view it was in and *score what it landed with
+**           (0 if it did not).
+*/
+static int fly_table(struct ProbeInfo *probeinfo, int *view, int *score)
+{
+   LONG f, cell;
+   int result;
+
+   *view = GO_FAR;
+   result = OK;
+   for (f=0; f < FLIGHT_FRAMES; f++)
+   {
+      cell = policy_cell(&header.grids[*view - GO_FAR], probeinfo);
+      probeinfo->user_input = action_keys[choice[cell]];
+
+      *score = 0;
+      result = step_probe(&physics, probeinfo, *view, TITLE_HEIGHT, score);
+      if ((result == LANDED) || (result == CRASHED) || (result == OUT_OF_SKY))
+      {
+         break;
+      }
+      if (result != OK)
+      {
+         *view = result;
+      }
+      result = OK;
+   }
+
+   if (result != LANDED)
+   {
+      *score = 0;
+   }
+
+   return result;
+}
+
+
+/*
+** write_table()
+**
+** Write the header and the choice of every cell, two cells a byte, to
+** file name.
+**
+** RETURNS:  TRUE if successful, FALSE if the file could not be written.
+*/
+static BOOL write_table(char *name)
+{
+   FILE *file;
+   UBYTE byte;
+   LONG cell;
+   BOOL ok;
+
+   if (NULL == (file = fopen(name, "wb")))
+   {
+      return FALSE;
+   }
+
+   ok = (fwrite(&header, sizeof(struct PolicyHeader), 1, file) == 1);
+   for (cell=0; ok && (cell < header.cells); cell += 2)
+   {
+      byte = action_keys[choice[cell]];
+      if (cell + 1 < header.cells)
+      {
+         byte |= action_keys[choice[cell+1]] << 4;
+      }
+      ok = (putc(byte, file) != EOF);
+   }
+
+   if (fclose(file) != 0)
+   {
+      ok = FALSE;
+   }
+
+   return ok;
+}
@@ -0,0 +1,335 @@
+/*
+** jupiterscale.c - throughput of many games at once on the Linux host
+**
+** (c)1993 Paul Grebenc
+**
+** Plays whole games, each with its own GameInfo and window, on 1 thread
+** and then on 2, 3 and so on up to one per core.  Every game is played
+** to the instant clock so that nothing but the game itself takes up time,
+** and flies its probe with a random pilot seeded by the thread number.  For each
+** number of threads the frames flown per second and the speedup over one
+** thread are reported; with no state shared between games it should grow
+** with the number of cores.
+**
+** Then as many games again as given (1000 by default) are played on one
+** thread, taking turns a step_game() at a time, to show what a single
+** scheduler gets through with no thread per game.
+**
+** Build (Linux):
+**    cc -std=gnu99 -O2 -pthread -o jupiterscale jupiterscale.c \
+**       jupitergame.c jl_*.c -lm
+**
+** Usage:  jupiterscale [threads [seconds [games]]]
+*/
+
+
+/** INCLUDES & DEFINES **/
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include "jupiterdefs.h"
+
+/* seconds each number of threads plays for (games are finished) */
+#define RUN_TIME        (2.0)
+
+#define TITLE_HEIGHT    (11)
+
+/* games played at once on one thread */
+#define GAMES           (1000)
+
+struct Player {
+   pthread_t      thread;
+   unsigned int   seed;       /* of the pilot's random numbers */
+   int            keys;       /* CURSOR_* bits being held */
+   int            hold;       /* frames left to hold them */
+   double         stop_time;
+   LONG           games;
+   LONG           frames;
+   BOOL           failed;
+   int            wait;       /* what its game last waited for */
+};
+
+
+/** PROTOTYPES **/
+
+static void *play(void *data);
+static void interleave(int count, double run_time);
+static int pilot(APTR data);
+
+/* jupitergame.c */
+extern struct GameInfo *alloc_gameinfo(void);
+extern void free_gameinfo(struct GameInfo *gameinfo);
+extern int game(struct GameInfo *gameinfo);
+extern int start_game(struct GameInfo *gameinfo);
+extern int step_game(struct GameInfo *gameinfo);
+extern void end_game(struct GameInfo *gameinfo);
+
+/* jl_clock.c */
+extern void set_clock(struct GameInfo *gameinfo, int type, int speed);
+
+/* jl_memory.c */
+extern void decompress_images(void);
+extern void free_images(void);
+
+
+/*-----------------------------------------------------------------------*/
+
+
+main(int argc, char **argv)
+{
+   struct Player *players;
+   double run_time, start, elapsed, rate, base_rate;
+   LONG games, frames;
+   int max_threads, threads, count, n;
+
+   max_threads = (argc > 1) ? atoi(argv[1]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+   run_time = (argc > 2) ? atof(argv[2]) : RUN_TIME;
+   count = (argc > 3) ? atoi(argv[3]) : GAMES;
+   if (max_threads < 1)
+   {
+      max_threads = 1;
+   }
+
+   if (NULL == (players = (struct Player *)calloc(max_threads, sizeof(struct Player))))
+   {
+      printf("Could not allocate players\n");
+      exit(RETURN_FAIL);
+   }
+
+   decompress_images();
+
+   printf("%-8s %10s %12s %14s %10s %10s\n", "threads", "games", "frames",
+      "frames/s", "speedup", "per core");
+
+   base_rate = 0.0;
+
+   for (threads=1; threads <= max_threads; threads++)
+   {
+      start = host_seconds();
+
+      for (n=0; n < threads; n++)
+      {
+         memset(&players[n], 0, sizeof(struct Player));
+         players[n].seed = n + 1;
+         players[n].stop_time = start + run_time;
+
+         if (0 != pthread_create(&players[n].thread, NULL, play, &players[n]))
+         {
+            printf("Could not start thread %d\n", n);
+            exit(RETURN_FAIL);
+         }
+      }
+
+      games = 0;
+      frames = 0;
+      for (n=0; n < threads; n++)
+      {
+         pthread_join(players[n].thread, NULL);
+         if (players[n].failed)
+         {
+            printf("Thread %d could not set up its game\n", n);
+            exit(RETURN_FAIL);
+         }
+         games += players[n].games;
+         frames += players[n].frames;
+      }
+
+      elapsed = host_seconds() - start;
+      rate = frames / elapsed;
+      if (threads == 1)
+      {
+         base_rate = rate;
+      }
+
+      printf("%-8d %10d %12d %14.0f %9.2fx %9.0f%%\n", threads, (int)games,
+         (int)frames, rate, rate / base_rate,
+         100.0 * rate / base_rate / threads);
+   }
+
+   free(players);
+   
+   if (count > 0)
+   {
+      interleave(count, run_time);
+   }
+   
+   free_images();
+
+   exit(RETURN_OK);
+}
+
+
+/*
+** play()
+**
+** Thread body: open a window for a game of its own and play games until
+** the player's stop_time has passed.
+**
+** RETURNS:  NULL
+*/
+static void *play(void *data)
+{
+   struct Player *player;
+   struct GameInfo *gameinfo;
+
+   player = (struct Player *)data;
+
+   host_set_input(pilot, player);
+
+   if (NULL != (gameinfo = alloc_gameinfo()))
+   {
+      set_clock(gameinfo, CLOCK_INSTANT, 1);
+      gameinfo->title_height = TITLE_HEIGHT;
+      gameinfo->window = OpenWindowTags(NULL,
+                           WA_Width,   WINDOW_WIDTH,
+                           WA_Height,  WINDOW_HEIGHT + TITLE_HEIGHT,
+                           TAG_END);
+
+      if (gameinfo->window != NULL)
+      {
+         while (host_seconds() < player->stop_time)
+         {
+            if (QUIT == game(gameinfo))
+            {
+               break;
+            }
+            player->games++;
+         }
+
+         CloseWindow(gameinfo->window);
+         free_gameinfo(gameinfo);
+         return NULL;
+      }
+      free_gameinfo(gameinfo);
+   }
+
+   player->failed = TRUE;
+   return NULL;
+}
+
+
+/*
+** interleave()
+**
+** Play count games at once on this thread, stepping each in turn.  A game
+** waiting at a port is passed over until a message arrives; frames and
+** delays are not waited for at all.  New games are started until
+** run_time has passed, and those under way are then played out.
+*/
+static void interleave(int count, double run_time)
+{
+   struct Player *players;
+   struct GameInfo **gameinfos;
+   struct GameInfo *gameinfo;
+   double stop_time, start, elapsed;
+   LONG games, frames;
+   int playing, n;
+
+   players = (struct Player *)calloc(count, sizeof(struct Player));
+   gameinfos = (struct GameInfo **)calloc(count, sizeof(struct GameInfo *));
+   if ((players == NULL) || (gameinfos == NULL))
+   {
+      printf("Could not allocate %d games\n", count);
+      exit(RETURN_FAIL);
+   }
+
+   for (n=0; n < count; n++)
+   {
+      players[n].seed = n + 1;
+      if (NULL == (gameinfo = alloc_gameinfo()))
+      {
+         printf("Could not allocate game %d\n", n);
+         exit(RETURN_FAIL);
+      }
+      set_clock(gameinfo, CLOCK_INSTANT, 1);
+      gameinfo->title_height = TITLE_HEIGHT;
+      gameinfo->window = OpenWindowTags(NULL,
+                           WA_Width,   WINDOW_WIDTH,
+                           WA_Height,  WINDOW_HEIGHT + TITLE_HEIGHT,
+                           TAG_END);
+      if ((gameinfo->window == NULL) || (start_game(gameinfo) == FALSE))
+      {
+         printf("Could not start game %d\n", n);
+         exit(RETURN_FAIL);
+      }
+      gameinfos[n] = gameinfo;
+   }
+
+   start = host_seconds();
+   stop_time = start + run_time;
+   playing = count;
+   games = 0;
+
+   while (playing > 0)
+   {
+      for (n=0; n < count; n++)
+      {
+         gameinfo = gameinfos[n];
+         if (gameinfo == NULL)
+         {
+            continue;
+         }
+         if ((players[n].wait == WAIT_PORT) && (gameinfo->port->mp_Head == NULL))
+         {
+            continue;
+         }
+
+         host_set_input(pilot, &players[n]);
+         players[n].wait = step_game(gameinfo);
+
+         if (players[n].wait == WAIT_END)
+         {
+            end_game(gameinfo);
+            games++;
+
+            if ((host_seconds() >= stop_time) ||
+               (start_game(gameinfo) == FALSE))
+            {
+               CloseWindow(gameinfo->window);
+               free_gameinfo(gameinfo);
+               gameinfos[n] = NULL;
+               playing--;
+            }
+         }
+      }
+   }
+
+   elapsed = host_seconds() - start;
+   frames = 0;
+   for (n=0; n < count; n++)
+   {
+      frames += players[n].frames;
+   }
+
+   printf("\n%d games at once on 1 thread: %d games, %d frames, %.0f frames/s\n",
+      count, (int)games, (int)frames, frames / elapsed);
+
+   free(gameinfos);
+   free(players);
+}
+
+
+/*
+** pilot()
+**
+** Input function for the host keyboard: hold a random mix of thrusters
+** for a random number of frames.  Called once a frame while flying.
+**
+** RETURNS:  CURSOR_* bits of the keys held.
+*/
+static int pilot(APTR data)
+{
+   struct Player *player;
+
+   player = (struct Player *)data;
+   player->frames++;
+
+   if (player->hold-- <= 0)
+   {
+      player->keys = rand_r(&player->seed) & (CURSOR_UP | CURSOR_LEFT | CURSOR_RIGHT);
+      player->hold = rand_r(&player->seed) % 20;
+   }
+
+   return player->keys;
+}
@@ -0,0 +1,678 @@
+/*
+** jupitersweep.c - sweep starting conditions and physics on the Linux host
+**
+** (c)1993 Paul Grebenc
+**
+** Flies one probe a run, at every combination of the values given for
+** where a flight starts (x_pos, y_pos, x_vel, as set by do_game_setup())
+** and the constants it is flown by (gravity, thrust and fuel burn, see
+** struct PhysicsInfo).  At each combination a pilot aims for pad A, B and
+** C in turn, as many times as asked with a little randomness in its
+** hands.  Each run is a game of one flight played to the instant clock.
+**
+** The runs are shared out over a thread a core.  Each thread starts with
+** an even share, and one that finishes early takes half of what is left
+** to another, since a flight may last a few dozen frames or thousands.
+** One row a run is written to stdout as CSV, in run order, once all are
+** done; a summary goes to stderr.  Given heatmap=prefix, each thread also
+** counts where its flights ended in a HeatMap of its own, and these are
+** added together at the end and drawn (see jl_heatmap.c).  Given
+** policy=file, the pilot flies by a policy table from jupiterpolicy
+** instead, to whichever pad the table makes for.
+**
+** Build (Linux):
+**    cc -std=gnu99 -O2 -pthread -o jupitersweep jupitersweep.c \
+**       jupitergame.c jl_*.c -lm
+**
+** Usage:  jupitersweep [name=value | name=from:to:step] ... > runs.csv
+**
+**    names are x_pos, y_pos, x_vel, gravity, thrust, side_thrust, burn,
+**    side_burn, pilots (runs at each combination and pad, default 1),
+**    threads (default one per core), heatmap (prefix of the files to
+**    draw where flights ended in) and policy (table to fly by).
+*/
+
+
+/** INCLUDES & DEFINES **/
+
+#include <math.h>
+#include <pthread.h>
+#include <stddef.h>
+#include <unistd.h>
+
+#include "jupiterdefs.h"
+
+#define TITLE_HEIGHT    (11)
+
+#define PADS            (3)
+
+/* a constant of struct PhysicsInfo and the values it takes */
+struct Sweep {
+   char     *name;
+   size_t   offset;
+   double   from;
+   double   step;
+   LONG     count;
+};
+
+/* how a run came out */
+struct Run {
+   BYTE     result;     /* LANDED, CRASHED, OUT_OF_SKY or OK */
+   BYTE     view;
+   float    y_vel;
+   float    fuel_used;
+   LONG     frames;
+   LONG     score;
+};
+
+struct Worker {
+   pthread_t         thread;
+   pthread_mutex_t   lock;       /* of next and end */
+   LONG              next;       /* runs next to end-1 are still to fly */
+   LONG              end;
+   LONG              steals;
+   BOOL              failed;
+   struct GameInfo   *gameinfo;
+   struct HeatMap    *heatmap;   /* NULL unless asked for */
+   unsigned int      seed;       /* of the pilot's hands */
+   int               pad;        /* it is aiming for, 0 to 2 */
+};
+
+
+/** PROTOTYPES **/
+
+static int parse_sweep(char *arg);
+static void set_physics(struct PhysicsInfo *physics, LONG run, int *pad);
+static void *work(void *data);
+static BOOL take_run(struct Worker *worker, LONG *run);
+static BOOL steal_runs(struct Worker *worker);
+static void fly_run(struct Worker *worker, LONG run);
+static int pilot(APTR data);
+static char *result_name(int result);
+static double clamp(double value, double low, double high);
+
+/* jupitergame.c */
+extern struct GameInfo *alloc_gameinfo(void);
+extern void free_gameinfo(struct GameInfo *gameinfo);
+extern int game(struct GameInfo *gameinfo);
+
+/* jl_clock.c */
+extern void set_clock(struct GameInfo *gameinfo, int type, int speed);
+
+/* jl_heatmap.c */
+extern struct HeatMap *alloc_heatmap(void);
+extern void free_heatmap(struct HeatMap *heatmap);
+extern void add_flight(struct HeatMap *heatmap, struct FlightInfo *flight);
+extern void merge_heatmap(struct HeatMap *to, struct HeatMap *from);
+extern int write_heatmaps(struct HeatMap *heatmap, char *prefix);
+
+/* jl_policy.c */
+extern struct Policy *load_policy(char *name);
+extern void free_policy(struct Policy *policy);
+extern int policy_input(struct Policy *policy, int view,
+   struct ProbeInfo *probeinfo);
+
+/* jl_memory.c */
+extern void decompress_images(void);
+extern void free_images(void);
+
+
+/** GLOBAL VARIABLES **/
+
+static struct Sweep sweeps[] = {
+   { "x_pos",        offsetof(struct PhysicsInfo, x_pos),         20.0,  1.0, 1 },
+   { "y_pos",        offsetof(struct PhysicsInfo, y_pos),          8.0,  1.0, 1 },
+   { "x_vel",        offsetof(struct PhysicsInfo, x_vel),          0.25, 1.0, 1 },
+   { "gravity",      offsetof(struct PhysicsInfo, gravity),        0.025, 1.0, 1 },
+   { "thrust",       offsetof(struct PhysicsInfo, thrust),         0.075, 1.0, 1 },
+   { "side_thrust",  offsetof(struct PhysicsInfo, side_thrust),    0.025, 1.0, 1 },
+   { "burn",         offsetof(struct PhysicsInfo, burn),           0.5,  1.0, 1 },
+   { "side_burn",    offsetof(struct PhysicsInfo, side_burn),      0.25, 1.0, 1 }
+};
+
+#define SWEEPS (sizeof(sweeps) / sizeof(sweeps[0]))
+
+static LONG pilots = 1;    /* runs at each combination and pad */
+
+static char *heatmap_prefix = NULL;
+
+static struct Policy *policy = NULL;   /* flown by instead, if given */
+
+static struct Worker *workers;
+static int threads;
+
+static struct Run *runs;
+static LONG run_count;
+
+/* x_pos to come down at in the far view to reach each pad */
+static double far_x[PADS] = { 66.0, 140.0, 206.0 };
+
+/* in each pad view the pilot comes down at entry_x to hover_y, then
+** moves over to pad_x and sets down, to keep clear of the walls
+*/
+static double entry_x[PADS] = { 65.0, 140.5, 199.0 };
+static double hover_y[PADS] = { 0.0, 0.0, 122.0 };
+static double pad_x[PADS] = { 65.0, 140.5, 190.5 };
+
+/* of GO_FAR to GO_PAD_C */
+static char *view_names[] = { "FAR", "A", "B", "C" };
+
+
+/*-----------------------------------------------------------------------*/
+
+
+main(int argc, char **argv)
+{
+   struct PhysicsInfo physics;
+   struct Run *run;
+   double start, elapsed;
+   LONG n, share, steals, frames;
+   int w, pad;
+   size_t s;
+
+   threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+
+   for (n=1; n < argc; n++)
+   {
+      if (0 == strncmp(argv[n], "threads=", 8))
+      {
+         threads = atoi(&argv[n][8]);
+      }
+      else if (0 == strncmp(argv[n], "pilots=", 7))
+      {
+         pilots = atoi(&argv[n][7]);
+      }
+      else if (0 == strncmp(argv[n], "heatmap=", 8))
+      {
+         heatmap_prefix = &argv[n][8];
+      }
+      else if (0 == strncmp(argv[n], "policy=", 7))
+      {
+         if (NULL == (policy = load_policy(&argv[n][7])))
+         {
+            fprintf(stderr, "Could not load policy table %s\n", &argv[n][7]);
+            exit(RETURN_FAIL);
+         }
+      }
+      else if (parse_sweep(argv[n]) == FALSE)
+      {
+         fprintf(stderr, "Bad sweep \"%s\"\n", argv[n]);
+         exit(RETURN_FAIL);
+      }
+   }
+   if (threads < 1)
+   {
+      threads = 1;
+   }
+   if (pilots < 1)
+   {
+      pilots = 1;
+   }
+
+   run_count = PADS * pilots;
+   for (s=0; s < SWEEPS; s++)
+   {
+      run_count *= sweeps[s].count;
+   }
+
+   runs = (struct Run *)calloc(run_count, sizeof(struct Run));
+   workers = (struct Worker *)calloc(threads, sizeof(struct Worker));
+   if ((runs == NULL) || (workers == NULL))
+   {
+      fprintf(stderr, "Could not allocate %d runs\n", (int)run_count);
+      exit(RETURN_FAIL);
+   }
+
+   decompress_images();
+
+   /* start every thread with an even share of the runs */
+   start = host_seconds();
+   share = run_count / threads;
+   for (w=0; w < threads; w++)
+   {
+      pthread_mutex_init(&workers[w].lock, NULL);
+      workers[w].next = w * share;
+      workers[w].end = (w == threads-1) ? run_count : (w+1) * share;
+
+      if ((heatmap_prefix != NULL) &&
+         (NULL == (workers[w].heatmap = alloc_heatmap())))
+      {
+         fprintf(stderr, "Could not allocate heat map %d\n", w);
+         exit(RETURN_FAIL);
+      }
+   }
+   for (w=0; w < threads; w++)
+   {
+      if (0 != pthread_create(&workers[w].thread, NULL, work, &workers[w]))
+      {
+         fprintf(stderr, "Could not start thread %d\n", w);
+         exit(RETURN_FAIL);
+      }
+   }
+
+   steals = 0;
+   for (w=0; w < threads; w++)
+   {
+      pthread_join(workers[w].thread, NULL);
+      if (workers[w].failed)
+      {
+         fprintf(stderr, "Thread %d could not set up its game\n", w);
+         exit(RETURN_FAIL);
+      }
+      steals += workers[w].steals;
+      pthread_mutex_destroy(&workers[w].lock);
+   }
+   elapsed = host_seconds() - start;
+
+   if (heatmap_prefix != NULL)
+   {
+      for (w=1; w < threads; w++)
+      {
+         merge_heatmap(workers[0].heatmap, workers[w].heatmap);
+         free_heatmap(workers[w].heatmap);
+      }
+      if (write_heatmaps(workers[0].heatmap, heatmap_prefix) == FALSE)
+      {
+         fprintf(stderr, "Could not write heat maps to %s_*\n", heatmap_prefix);
+      }
+      free_heatmap(workers[0].heatmap);
+   }
+
+   /* write out the runs */
+   printf("run");
+   for (s=0; s < SWEEPS; s++)
+   {
+      printf(",%s", sweeps[s].name);
+   }
+   printf(",pilot,pad,outcome,view,touchdown_y_vel,fuel_used,frames,score\n");
+
+   frames = 0;
+   for (n=0; n < run_count; n++)
+   {
+      run = &runs[n];
+      set_physics(&physics, n, &pad);
+
+      printf("%d", (int)n);
+      for (s=0; s < SWEEPS; s++)
+      {
+         printf(",%g", *(double *)((char *)&physics + sweeps[s].offset));
+      }
+      printf(",%d,%s,%s,%s,%.3f,%.2f,%d,%d\n", (int)(n % pilots),
+         view_names[pad+1], result_name(run->result),
+         view_names[run->view - GO_FAR],
+         run->y_vel, run->fuel_used, (int)run->frames, (int)run->score);
+
+      frames += run->frames;
+   }
+
+   fprintf(stderr, "%d runs on %d threads in %.2fs (%.0f runs/s, %.0f frames/s), "
+      "%d steals\n", (int)run_count, threads, elapsed, run_count / elapsed,
+      frames / elapsed, (int)steals);
+
+   if (policy != NULL)
+   {
+      free_policy(policy);
+   }
+   free(workers);
+   free(runs);
+   free_images();
+
+   exit(RETURN_OK);
+}
+
+
+/*
+** parse_sweep()
+**
+** Read a "name=value" or "name=from:to:step" argument into sweeps[].
+**
+** RETURNS:  TRUE if successful, FALSE if the argument is not understood.
+*/
+static int parse_sweep(char *arg)
+{
+   double from, to, step;
+   size_t s, length;
+   int n;
+
+   for (s=0; s < SWEEPS; s++)
+   {
+      length = strlen(sweeps[s].name);
+      if ((0 == strncmp(arg, sweeps[s].name, length)) && (arg[length] == '='))
+      {
+         n = sscanf(&arg[length+1], "%lf:%lf:%lf", &from, &to, &step);
+         if (n == 1)
+         {
+            to = from;
+            step = 1.0;
+         }
+         else if ((n != 3) || (step <= 0.0) || (to < from))
+         {
+            return FALSE;
+         }
+
+         sweeps[s].from = from;
+         sweeps[s].step = step;
+         sweeps[s].count = (LONG)((to - from) / step + 1e-6) + 1;
+         return TRUE;
+      }
+   }
+
+   return FALSE;
+}
+
+
+/*
+** set_physics()
+**
+** Fill in physics for a run, and the pad its pilot aims for.  The pilot
+** number changes fastest, then the pad, then the constants in the order
+** of sweeps[] (so x_pos slowest).
+*/
+static void set_physics(struct PhysicsInfo *physics, LONG run, int *pad)
+{
+   LONG index;
+   int s;
+
+   run /= pilots;
+   *pad = (int)(run % PADS);
+   run /= PADS;
+
+   for (s=SWEEPS-1; s >= 0; s--)
+   {
+      index = run % sweeps[s].count;
+      run /= sweeps[s].count;
+
+      *(double *)((char *)physics + sweeps[s].offset) =
+         sweeps[s].from + index * sweeps[s].step;
+   }
+}
+
+
+/*
+** work()
+**
+** Thread body: fly its own runs, then runs taken from other threads,
+** until none are left anywhere.
+**
+** RETURNS:  NULL
+*/
+static void *work(void *data)
+{
+   struct Worker *worker;
+   struct GameInfo *gameinfo;
+   LONG run;
+
+   worker = (struct Worker *)data;
+
+   host_set_input(pilot, worker);
+
+   if (NULL == (gameinfo = alloc_gameinfo()))
+   {
+      worker->failed = TRUE;
+      return NULL;
+   }
+   gameinfo->title_height = TITLE_HEIGHT;
+   gameinfo->window = OpenWindowTags(NULL,
+                        WA_Width,   WINDOW_WIDTH,
+                        WA_Height,  WINDOW_HEIGHT + TITLE_HEIGHT,
+                        TAG_END);
+   if (gameinfo->window == NULL)
+   {
+      free_gameinfo(gameinfo);
+      worker->failed = TRUE;
+      return NULL;
+   }
+   set_clock(gameinfo, CLOCK_INSTANT, 1);
+   gameinfo->max_flights = 1;
+   worker->gameinfo = gameinfo;
+
+   do
+   {
+      while (take_run(worker, &run))
+      {
+         fly_run(worker, run);
+      }
+   } while (steal_runs(worker));
+
+   CloseWindow(gameinfo->window);
+   free_gameinfo(gameinfo);
+
+   return NULL;
+}
+
+
+/*
+** take_run()
+**
+** Take the next of the worker's own runs.
+**
+** RETURNS:  TRUE with *run set, FALSE if it has none left.
+*/
+static BOOL take_run(struct Worker *worker, LONG *run)
+{
+   BOOL found;
+
+   pthread_mutex_lock(&worker->lock);
+   found = (worker->next < worker->end);
+   if (found)
+   {
+      *run = worker->next++;
+   }
+   pthread_mutex_unlock(&worker->lock);
+
+   return found;
+}
+
+
+/*
+** steal_runs()
+**
+** Give a worker that has run out the later half of the runs left to the
+** thread with the most.  Only one lock is held at a time.
+**
+** RETURNS:  TRUE if runs were taken, FALSE if there are none left.
+*/
+static BOOL steal_runs(struct Worker *worker)
+{
+   struct Worker *victim;
+   LONG left, most, middle, end;
+   int w;
+
+   FOREVER
+   {
+      victim = NULL;
+      most = 0;
+      for (w=0; w < threads; w++)
+      {
+         /* a racy look is enough to choose, the lock is taken to steal */
+         left = workers[w].end - workers[w].next;
+         if ((&workers[w] != worker) && (left > most))
+         {
+            most = left;
+            victim = &workers[w];
+         }
+      }
+      if (victim == NULL)
+      {
+         return FALSE;
+      }
+
+      pthread_mutex_lock(&victim->lock);
+      left = victim->end - victim->next;
+      if (left > 0)
+      {
+         middle = victim->next + left / 2;
+         end = victim->end;
+         victim->end = middle;
+      }
+      pthread_mutex_unlock(&victim->lock);
+
+      if (left > 0)
+      {
+         pthread_mutex_lock(&worker->lock);
+         worker->next = middle;
+         worker->end = end;
+         pthread_mutex_unlock(&worker->lock);
+
+         worker->steals++;
+         return TRUE;
+      }
+   }
+}
+
+
+/*
+** fly_run()
+**
+** Play a game of one flight with the physics of run and keep how it came
+** out.
+*/
+static void fly_run(struct Worker *worker, LONG run)
+{
+   struct GameInfo *gameinfo;
+   struct FlightInfo *flight;
+   struct Run *out;
+
+   gameinfo = worker->gameinfo;
+   set_physics(&gameinfo->physics, run, &worker->pad);
+   worker->seed = (unsigned int)run + 1;
+
+   game(gameinfo);
+
+   flight = &gameinfo->flight;
+   out = &runs[run];
+   out->result = (BYTE)flight->result;
+   out->view = (BYTE)flight->view;
+   out->y_vel = flight->y_vel;
+   out->fuel_used = flight->fuel - flight->fuel_left;
+   out->frames = flight->frames;
+   out->score = gameinfo->score;
+
+   if (worker->heatmap != NULL)
+   {
+      add_flight(worker->heatmap, flight);
+   }
+}
+
+
+/*
+** pilot()
+**
+** Input function for the host keyboard.  Steers for the worker's pad:
+** across the far view high enough to miss the mountains (and, for pad C,
+** the way into pad B), then down over the pad, slowing as it nears it.
+** The pilot's hands slip now and then.  With a policy table it flies
+** by the table alone.
+**
+** RETURNS:  CURSOR_* bits of the keys held.
+*/
+static int pilot(APTR data)
+{
+   struct Worker *worker;
+   struct GameInfo *gameinfo;
+   struct ProbeInfo *probeinfo;
+   double target, want_x_vel, want_y_vel, floor;
+   int keys, pad;
+
+   worker = (struct Worker *)data;
+   gameinfo = worker->gameinfo;
+   probeinfo = &gameinfo->probeinfo;
+
+   if (policy != NULL)
+   {
+      return policy_input(policy, gameinfo->view, probeinfo);
+   }
+
+   if (gameinfo->view == GO_FAR)
+   {
+      target = far_x[worker->pad];
+      if (fabs(target - probeinfo->x_pos) > 1.5)
+      {
+         want_y_vel = clamp((5.0 - probeinfo->y_pos) * 0.1, -0.5, 0.5);
+      }
+      else
+      {
+         want_y_vel = 0.6;
+      }
+   }
+   else
+   {
+      pad = gameinfo->view - GO_PAD_A;
+
+      /* y_pos at which the probe stands on the pad, see do_collision() */
+      floor = ((gameinfo->view == GO_PAD_B) ? 10.0 : 90.0) +
+         (gameinfo->pad_top - 42) / 2.0;
+
+      if (probeinfo->y_pos < hover_y[pad])
+      {
+         target = entry_x[pad];
+         want_y_vel = clamp((hover_y[pad] - probeinfo->y_pos) * 0.04, 0.1, 0.6);
+      }
+      else
+      {
+         target = pad_x[pad];
+         want_y_vel = clamp((floor - probeinfo->y_pos) * 0.04, 0.1, 1.0);
+         if (fabs(target - probeinfo->x_pos) > 3.0)
+         {
+            want_y_vel = clamp(want_y_vel, -0.2, 0.05);
+         }
+      }
+   }
+   want_x_vel = clamp((target - probeinfo->x_pos) * 0.05, -1.0, 1.0);
+
+   keys = 0;
+   if (probeinfo->y_vel > want_y_vel)
+   {
+      keys |= CURSOR_UP;
+   }
+   if (probeinfo->x_vel < want_x_vel - 0.02)
+   {
+      keys |= CURSOR_LEFT;
+   }
+   else if (probeinfo->x_vel > want_x_vel + 0.02)
+   {
+      keys |= CURSOR_RIGHT;
+   }
+
+   if (rand_r(&worker->seed) % 16 == 0)
+   {
+      keys ^= CURSOR_UP;
+   }
+
+   return keys;
+}
+
+
+/*
+** result_name()
+**
+** RETURNS:  The name of the way a flight ended, for the CSV.
+*/
+static char *result_name(int result)
+{
+   switch (result)
+   {
+      case LANDED:
+            return "LANDED";
+            break;
+      case CRASHED:
+            return "CRASHED";
+            break;
+      case OUT_OF_SKY:
+            return "OUT_OF_SKY";
+            break;
+   }
+
+   return "NONE";
+}
+
+
+/*
+** clamp()
+**
+** RETURNS:  value, kept between low and high.
+*/
+static double clamp(double value, double low, double high)
+{
+   return (value < low) ? low : ((value > high) ? high : value);
+}